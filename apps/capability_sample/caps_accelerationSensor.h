@@ -27,10 +27,12 @@ typedef struct caps_accelerationSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *acceleration_value;
+    int acceleration_idx;
 
     const char *(*get_acceleration_value)(struct caps_accelerationSensor_data *caps_data);
     void (*set_acceleration_value)(struct caps_accelerationSensor_data *caps_data, const char *value);
+    int (*get_acceleration_idx)(struct caps_accelerationSensor_data *caps_data);
+    void (*set_acceleration_idx)(struct caps_accelerationSensor_data *caps_data, int idx);
     int (*attr_acceleration_str2idx)(const char *value);
     void (*attr_acceleration_send)(struct caps_accelerationSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_accelerationSensor_data {
 } caps_accelerationSensor_data_t;
 
 caps_accelerationSensor_data_t *caps_accelerationSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_accelerationSensor_deinitialize(caps_accelerationSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_activityLightingMode.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_activityLightingMode_attr_lightingMode_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_activityLightingMode_get_lightingMode_value(caps_activit
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->lightingMode_value;
+    if (caps_data->lightingMode_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_activityLightingMode.attr_lightingMode.values[caps_data->lightingMode_idx];
 }
 
 static void caps_activityLightingMode_set_lightingMode_value(caps_activityLightingMode_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_activityLightingMode_attr_lightingMode_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for lightingMode\n", value);
+        return;
+    }
+    caps_data->lightingMode_idx = index;
+}
+
+static int caps_activityLightingMode_get_lightingMode_idx(caps_activityLightingMode_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->lightingMode_idx;
+}
+
+static void caps_activityLightingMode_set_lightingMode_idx(caps_activityLightingMode_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->lightingMode_value) {
-        free(caps_data->lightingMode_value);
+    if (idx < 0 || idx >= CAP_ENUM_ACTIVITYLIGHTINGMODE_LIGHTINGMODE_VALUE_MAX) {
+        printf("%d is not supported index for lightingMode\n", idx);
+        return;
     }
-    caps_data->lightingMode_value = strdup(value);
+    caps_data->lightingMode_idx = idx;
 }
 
 static void caps_activityLightingMode_attr_lightingMode_send(caps_activityLightingMode_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_activityLightingMode_attr_lightingMode_send(caps_activityLighti
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->lightingMode_value) {
+    if (caps_data->lightingMode_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_activityLightingMode.attr_lightingMode.name,
-            caps_data->lightingMode_value,
+            (char *)caps_helper_activityLightingMode.attr_lightingMode.values[caps_data->lightingMode_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,7 +122,6 @@ static void caps_activityLightingMode_attr_lightingMode_send(caps_activityLighti
 static void caps_activityLightingMode_cmd_setLightingMode_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_activityLightingMode_data_t *caps_data = (caps_activityLightingMode_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -97,9 +131,7 @@ static void caps_activityLightingMode_cmd_setLightingMode_cb(IOT_CAP_HANDLE *han
         printf("%s is not supported value for setLightingMode\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_activityLightingMode.attr_lightingMode.values[index];
-
-    caps_activityLightingMode_set_lightingMode_value(caps_data, value);
+    caps_activityLightingMode_set_lightingMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setLightingMode_usr_cb)
         caps_data->cmd_setLightingMode_usr_cb(caps_data);
     caps_activityLightingMode_attr_lightingMode_send(caps_data);
@@ -108,9 +140,12 @@ static void caps_activityLightingMode_cmd_setLightingMode_cb(IOT_CAP_HANDLE *han
 static void caps_activityLightingMode_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_activityLightingMode_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_activityLightingMode_attr_lightingMode_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_activityLightingMode_data_t *caps_activityLightingMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -131,13 +166,16 @@ caps_activityLightingMode_data_t *caps_activityLightingMode_initialize(IOT_CTX *
 
     caps_data->get_lightingMode_value = caps_activityLightingMode_get_lightingMode_value;
     caps_data->set_lightingMode_value = caps_activityLightingMode_set_lightingMode_value;
+    caps_data->get_lightingMode_idx = caps_activityLightingMode_get_lightingMode_idx;
+    caps_data->set_lightingMode_idx = caps_activityLightingMode_set_lightingMode_idx;
     caps_data->attr_lightingMode_str2idx = caps_activityLightingMode_attr_lightingMode_str2idx;
     caps_data->attr_lightingMode_send = caps_activityLightingMode_attr_lightingMode_send;
+    caps_data->lightingMode_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_activityLightingMode.id, caps_activityLightingMode_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_activityLightingMode.id, caps_activityLightingMode_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_activityLightingMode.cmd_setLightingMode.name, caps_activityLightingMode_cmd_setLightingMode_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_activityLightingMode.cmd_setLightingMode.name, caps_activityLightingMode_cmd_setLightingMode_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setLightingMode of activityLightingMode\n");
     }
@@ -147,3 +185,17 @@ caps_activityLightingMode_data_t *caps_activityLightingMode_initialize(IOT_CTX *
 
     return caps_data;
 }
+
+void caps_activityLightingMode_deinitialize(caps_activityLightingMode_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_activityLightingMode_data {
     void *usr_data;
     void *cmd_data;
 
-    char *lightingMode_value;
+    int lightingMode_idx;
 
     const char *(*get_lightingMode_value)(struct caps_activityLightingMode_data *caps_data);
     void (*set_lightingMode_value)(struct caps_activityLightingMode_data *caps_data, const char *value);
+    int (*get_lightingMode_idx)(struct caps_activityLightingMode_data *caps_data);
+    void (*set_lightingMode_idx)(struct caps_activityLightingMode_data *caps_data, int idx);
     int (*attr_lightingMode_str2idx)(const char *value);
     void (*attr_lightingMode_send)(struct caps_activityLightingMode_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_activityLightingMode_data {
 } caps_activityLightingMode_data_t;
 
 caps_activityLightingMode_data_t *caps_activityLightingMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_activityLightingMode_deinitialize(caps_activityLightingMode_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@ typedef struct caps_airQualitySensor_data {
 } caps_airQualitySensor_data_t;
 
 caps_airQualitySensor_data_t *caps_airQualitySensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_airQualitySensor_deinitialize(caps_airQualitySensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_alarm.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_alarm_attr_alarm_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_alarm_get_alarm_value(caps_alarm_data_t *caps_data)
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->alarm_value;
+    if (caps_data->alarm_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_alarm.attr_alarm.values[caps_data->alarm_idx];
 }
 
 static void caps_alarm_set_alarm_value(caps_alarm_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_alarm_attr_alarm_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for alarm\n", value);
+        return;
+    }
+    caps_data->alarm_idx = index;
+}
+
+static int caps_alarm_get_alarm_idx(caps_alarm_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->alarm_idx;
+}
+
+static void caps_alarm_set_alarm_idx(caps_alarm_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->alarm_value) {
-        free(caps_data->alarm_value);
+    if (idx < 0 || idx >= CAP_ENUM_ALARM_ALARM_VALUE_MAX) {
+        printf("%d is not supported index for alarm\n", idx);
+        return;
     }
-    caps_data->alarm_value = strdup(value);
+    caps_data->alarm_idx = idx;
 }
 
 static void caps_alarm_attr_alarm_send(caps_alarm_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_alarm_attr_alarm_send(caps_alarm_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->alarm_value) {
+    if (caps_data->alarm_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_alarm.attr_alarm.name,
-            caps_data->alarm_value,
+            (char *)caps_helper_alarm.attr_alarm.values[caps_data->alarm_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,11 +122,11 @@ static void caps_alarm_attr_alarm_send(caps_alarm_data_t *caps_data)
 static void caps_alarm_cmd_both_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_alarm_data_t *caps_data = (caps_alarm_data_t *)usr_data;
-    const char* value = caps_helper_alarm.attr_alarm.values[CAP_ENUM_ALARM_ALARM_VALUE_BOTH];
+    int index = CAP_ENUM_ALARM_ALARM_VALUE_BOTH;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_alarm_set_alarm_value(caps_data, value);
+    caps_alarm_set_alarm_idx(caps_data, index);
     if (caps_data && caps_data->cmd_both_usr_cb)
         caps_data->cmd_both_usr_cb(caps_data);
     caps_alarm_attr_alarm_send(caps_data);
@@ -100,11 +135,11 @@ static void caps_alarm_cmd_both_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *c
 static void caps_alarm_cmd_siren_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_alarm_data_t *caps_data = (caps_alarm_data_t *)usr_data;
-    const char* value = caps_helper_alarm.attr_alarm.values[CAP_ENUM_ALARM_ALARM_VALUE_SIREN];
+    int index = CAP_ENUM_ALARM_ALARM_VALUE_SIREN;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_alarm_set_alarm_value(caps_data, value);
+    caps_alarm_set_alarm_idx(caps_data, index);
     if (caps_data && caps_data->cmd_siren_usr_cb)
         caps_data->cmd_siren_usr_cb(caps_data);
     caps_alarm_attr_alarm_send(caps_data);
@@ -113,11 +148,11 @@ static void caps_alarm_cmd_siren_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *
 static void caps_alarm_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_alarm_data_t *caps_data = (caps_alarm_data_t *)usr_data;
-    const char* value = caps_helper_alarm.attr_alarm.values[CAP_ENUM_ALARM_ALARM_VALUE_OFF];
+    int index = CAP_ENUM_ALARM_ALARM_VALUE_OFF;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_alarm_set_alarm_value(caps_data, value);
+    caps_alarm_set_alarm_idx(caps_data, index);
     if (caps_data && caps_data->cmd_off_usr_cb)
         caps_data->cmd_off_usr_cb(caps_data);
     caps_alarm_attr_alarm_send(caps_data);
@@ -126,11 +161,11 @@ static void caps_alarm_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cm
 static void caps_alarm_cmd_strobe_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_alarm_data_t *caps_data = (caps_alarm_data_t *)usr_data;
-    const char* value = caps_helper_alarm.attr_alarm.values[CAP_ENUM_ALARM_ALARM_VALUE_STROBE];
+    int index = CAP_ENUM_ALARM_ALARM_VALUE_STROBE;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_alarm_set_alarm_value(caps_data, value);
+    caps_alarm_set_alarm_idx(caps_data, index);
     if (caps_data && caps_data->cmd_strobe_usr_cb)
         caps_data->cmd_strobe_usr_cb(caps_data);
     caps_alarm_attr_alarm_send(caps_data);
@@ -139,9 +174,12 @@ static void caps_alarm_cmd_strobe_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t
 static void caps_alarm_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_alarm_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_alarm_attr_alarm_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_alarm_data_t *caps_alarm_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -162,25 +200,28 @@ caps_alarm_data_t *caps_alarm_initialize(IOT_CTX *ctx, const char *component, vo
 
     caps_data->get_alarm_value = caps_alarm_get_alarm_value;
     caps_data->set_alarm_value = caps_alarm_set_alarm_value;
+    caps_data->get_alarm_idx = caps_alarm_get_alarm_idx;
+    caps_data->set_alarm_idx = caps_alarm_set_alarm_idx;
     caps_data->attr_alarm_str2idx = caps_alarm_attr_alarm_str2idx;
     caps_data->attr_alarm_send = caps_alarm_attr_alarm_send;
+    caps_data->alarm_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_alarm.id, caps_alarm_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_alarm.id, caps_alarm_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_both.name, caps_alarm_cmd_both_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_both.name, caps_alarm_cmd_both_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for both of alarm\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_siren.name, caps_alarm_cmd_siren_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_siren.name, caps_alarm_cmd_siren_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for siren of alarm\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_off.name, caps_alarm_cmd_off_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_off.name, caps_alarm_cmd_off_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for off of alarm\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_strobe.name, caps_alarm_cmd_strobe_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_alarm.cmd_strobe.name, caps_alarm_cmd_strobe_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for strobe of alarm\n");
     }
@@ -190,3 +231,17 @@ caps_alarm_data_t *caps_alarm_initialize(IOT_CTX *ctx, const char *component, vo
 
     return caps_data;
 }
+
+void caps_alarm_deinitialize(caps_alarm_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
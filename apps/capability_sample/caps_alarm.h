@@ -27,10 +27,12 @@ typedef struct caps_alarm_data {
     void *usr_data;
     void *cmd_data;
 
-    char *alarm_value;
+    int alarm_idx;
 
     const char *(*get_alarm_value)(struct caps_alarm_data *caps_data);
     void (*set_alarm_value)(struct caps_alarm_data *caps_data, const char *value);
+    int (*get_alarm_idx)(struct caps_alarm_data *caps_data);
+    void (*set_alarm_idx)(struct caps_alarm_data *caps_data, int idx);
     int (*attr_alarm_str2idx)(const char *value);
     void (*attr_alarm_send)(struct caps_alarm_data *caps_data);
 
@@ -43,6 +45,7 @@ typedef struct caps_alarm_data {
 } caps_alarm_data_t;
 
 caps_alarm_data_t *caps_alarm_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_alarm_deinitialize(caps_alarm_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
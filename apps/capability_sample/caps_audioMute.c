@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_audioMute.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_audioMute_attr_mute_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_audioMute_get_mute_value(caps_audioMute_data_t *caps_dat
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->mute_value;
+    if (caps_data->mute_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_audioMute.attr_mute.values[caps_data->mute_idx];
 }
 
 static void caps_audioMute_set_mute_value(caps_audioMute_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_audioMute_attr_mute_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for mute\n", value);
+        return;
+    }
+    caps_data->mute_idx = index;
+}
+
+static int caps_audioMute_get_mute_idx(caps_audioMute_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->mute_idx;
+}
+
+static void caps_audioMute_set_mute_idx(caps_audioMute_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->mute_value) {
-        free(caps_data->mute_value);
+    if (idx < 0 || idx >= CAP_ENUM_AUDIOMUTE_MUTE_VALUE_MAX) {
+        printf("%d is not supported index for mute\n", idx);
+        return;
     }
-    caps_data->mute_value = strdup(value);
+    caps_data->mute_idx = idx;
 }
 
 static void caps_audioMute_attr_mute_send(caps_audioMute_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_audioMute_attr_mute_send(caps_audioMute_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->mute_value) {
+    if (caps_data->mute_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_audioMute.attr_mute.name,
-            caps_data->mute_value,
+            (char *)caps_helper_audioMute.attr_mute.values[caps_data->mute_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,11 +122,11 @@ static void caps_audioMute_attr_mute_send(caps_audioMute_data_t *caps_data)
 static void caps_audioMute_cmd_unmute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_audioMute_data_t *caps_data = (caps_audioMute_data_t *)usr_data;
-    const char* value = caps_helper_audioMute.attr_mute.values[CAP_ENUM_AUDIOMUTE_MUTE_VALUE_UNMUTED];
+    int index = CAP_ENUM_AUDIOMUTE_MUTE_VALUE_UNMUTED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_audioMute_set_mute_value(caps_data, value);
+    caps_audioMute_set_mute_idx(caps_data, index);
     if (caps_data && caps_data->cmd_unmute_usr_cb)
         caps_data->cmd_unmute_usr_cb(caps_data);
     caps_audioMute_attr_mute_send(caps_data);
@@ -100,7 +135,6 @@ static void caps_audioMute_cmd_unmute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_dat
 static void caps_audioMute_cmd_setMute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_audioMute_data_t *caps_data = (caps_audioMute_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -110,9 +144,7 @@ static void caps_audioMute_cmd_setMute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_da
         printf("%s is not supported value for setMute\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_audioMute.attr_mute.values[index];
-
-    caps_audioMute_set_mute_value(caps_data, value);
+    caps_audioMute_set_mute_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setMute_usr_cb)
         caps_data->cmd_setMute_usr_cb(caps_data);
     caps_audioMute_attr_mute_send(caps_data);
@@ -121,11 +153,11 @@ static void caps_audioMute_cmd_setMute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_da
 static void caps_audioMute_cmd_mute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_audioMute_data_t *caps_data = (caps_audioMute_data_t *)usr_data;
-    const char* value = caps_helper_audioMute.attr_mute.values[CAP_ENUM_AUDIOMUTE_MUTE_VALUE_MUTED];
+    int index = CAP_ENUM_AUDIOMUTE_MUTE_VALUE_MUTED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_audioMute_set_mute_value(caps_data, value);
+    caps_audioMute_set_mute_idx(caps_data, index);
     if (caps_data && caps_data->cmd_mute_usr_cb)
         caps_data->cmd_mute_usr_cb(caps_data);
     caps_audioMute_attr_mute_send(caps_data);
@@ -134,9 +166,12 @@ static void caps_audioMute_cmd_mute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_
 static void caps_audioMute_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_audioMute_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_audioMute_attr_mute_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_audioMute_data_t *caps_audioMute_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -157,21 +192,24 @@ caps_audioMute_data_t *caps_audioMute_initialize(IOT_CTX *ctx, const char *compo
 
     caps_data->get_mute_value = caps_audioMute_get_mute_value;
     caps_data->set_mute_value = caps_audioMute_set_mute_value;
+    caps_data->get_mute_idx = caps_audioMute_get_mute_idx;
+    caps_data->set_mute_idx = caps_audioMute_set_mute_idx;
     caps_data->attr_mute_str2idx = caps_audioMute_attr_mute_str2idx;
     caps_data->attr_mute_send = caps_audioMute_attr_mute_send;
+    caps_data->mute_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_audioMute.id, caps_audioMute_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_audioMute.id, caps_audioMute_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_unmute.name, caps_audioMute_cmd_unmute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_unmute.name, caps_audioMute_cmd_unmute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for unmute of audioMute\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_setMute.name, caps_audioMute_cmd_setMute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_setMute.name, caps_audioMute_cmd_setMute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setMute of audioMute\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_mute.name, caps_audioMute_cmd_mute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioMute.cmd_mute.name, caps_audioMute_cmd_mute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for mute of audioMute\n");
     }
@@ -181,3 +219,17 @@ caps_audioMute_data_t *caps_audioMute_initialize(IOT_CTX *ctx, const char *compo
 
     return caps_data;
 }
+
+void caps_audioMute_deinitialize(caps_audioMute_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_audioMute_data {
     void *usr_data;
     void *cmd_data;
 
-    char *mute_value;
+    int mute_idx;
 
     const char *(*get_mute_value)(struct caps_audioMute_data *caps_data);
     void (*set_mute_value)(struct caps_audioMute_data *caps_data, const char *value);
+    int (*get_mute_idx)(struct caps_audioMute_data *caps_data);
+    void (*set_mute_idx)(struct caps_audioMute_data *caps_data, int idx);
     int (*attr_mute_str2idx)(const char *value);
     void (*attr_mute_send)(struct caps_audioMute_data *caps_data);
 
@@ -42,6 +44,7 @@ typedef struct caps_audioMute_data {
 } caps_audioMute_data_t;
 
 caps_audioMute_data_t *caps_audioMute_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_audioMute_deinitialize(caps_audioMute_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
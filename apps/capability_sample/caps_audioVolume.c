@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_audioVolume.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_audioVolume_get_volume_value(caps_audioVolume_data_t *caps_data)
 {
@@ -68,7 +70,7 @@ static void caps_audioVolume_attr_volume_send(caps_audioVolume_data_t *caps_data
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_audioVolume.attr_volume.name,
             caps_data->volume_value,
             caps_data->volume_unit,
@@ -120,9 +122,12 @@ static void caps_audioVolume_cmd_setVolume_cb(IOT_CAP_HANDLE *handle, iot_cap_cm
 static void caps_audioVolume_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_audioVolume_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_audioVolume_attr_volume_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_audioVolume_data_t *caps_audioVolume_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -148,18 +153,18 @@ caps_audioVolume_data_t *caps_audioVolume_initialize(IOT_CTX *ctx, const char *c
     caps_data->attr_volume_send = caps_audioVolume_attr_volume_send;
     caps_data->volume_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_audioVolume.id, caps_audioVolume_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_audioVolume.id, caps_audioVolume_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_volumeDown.name, caps_audioVolume_cmd_volumeDown_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_volumeDown.name, caps_audioVolume_cmd_volumeDown_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for volumeDown of audioVolume\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_volumeUp.name, caps_audioVolume_cmd_volumeUp_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_volumeUp.name, caps_audioVolume_cmd_volumeUp_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for volumeUp of audioVolume\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_setVolume.name, caps_audioVolume_cmd_setVolume_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_audioVolume.cmd_setVolume.name, caps_audioVolume_cmd_setVolume_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setVolume of audioVolume\n");
     }
@@ -169,3 +174,17 @@ caps_audioVolume_data_t *caps_audioVolume_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_audioVolume_deinitialize(caps_audioVolume_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -44,6 +44,7 @@ typedef struct caps_audioVolume_data {
 } caps_audioVolume_data_t;
 
 caps_audioVolume_data_t *caps_audioVolume_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_audioVolume_deinitialize(caps_audioVolume_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@ typedef struct caps_battery_data {
 } caps_battery_data_t;
 
 caps_battery_data_t *caps_battery_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_battery_deinitialize(caps_battery_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,123 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_BINDING_HPP_
+#define _CAPS_BINDING_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+
+/*
+ * Common part of the C++17 capability bindings generated by
+ * tools/common/caps_generator.py --cpp.
+ *
+ * A binding is a class template caps::{Capability}<Derived> used as a CRTP base.
+ * The app derives from it and hides the on_init() and on_cmd_{COMMAND}() handlers
+ * it cares about, so the handler is picked at compile time without virtual calls.
+ * State lives in the object, strings are borrowed and never copied, and nothing
+ * is allocated. Handles and commands still go through caps_sender and caps_cmd,
+ * which call st_cap_* of iot-core.
+ */
+
+/* Strings received in commands are copied into a buffer of this size, others are borrowed */
+#ifndef CAPS_BINDING_STRING_SIZE
+#define CAPS_BINDING_STRING_SIZE 64
+#endif
+
+namespace caps {
+
+template <std::size_t N>
+constexpr int table_size(const char *const (&)[N])
+{
+    return static_cast<int>(N);
+}
+
+/* Only for values received in commands, everything else uses the index */
+template <std::size_t N>
+inline int table_index(const char *const (&table)[N], const char *value)
+{
+    if (!value)
+        return -1;
+    for (std::size_t i = 0; i < N; i++) {
+        if (!std::strcmp(table[i], value))
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+inline void copy_string(char (&buf)[CAPS_BINDING_STRING_SIZE], const char *value)
+{
+    std::strncpy(buf, value ? value : "", sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+}
+
+inline void set_attr(caps_attr_t &attr, IOT_CAP_HANDLE *handle, const char *name, const char *unit)
+{
+    attr.handle = handle;
+    attr.name = name;
+    attr.unit = unit;
+    attr.data = nullptr;
+}
+
+inline void set_string(caps_attr_t &attr, const char *value)
+{
+    attr.value.type = IOT_CAP_VAL_TYPE_STRING;
+    attr.value.string = const_cast<char *>(value);
+}
+
+inline void set_integer(caps_attr_t &attr, int value)
+{
+    attr.value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    attr.value.integer = value;
+}
+
+inline void set_json(caps_attr_t &attr, const char *value)
+{
+    attr.value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
+    attr.value.json_object = const_cast<char *>(value);
+}
+
+inline void set_strings(caps_attr_t &attr, const char *const *value, int size)
+{
+    attr.value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+    attr.value.strings = const_cast<char **>(value);
+    attr.value.str_num = static_cast<uint8_t>(size);
+}
+
+/* Sends attr_num attributes as one message, returns the sequence number */
+inline int send(caps_attr_t *attrs, int attr_num)
+{
+    int sequence_no;
+
+    if (attr_num == 0)
+        return CAPS_SEND_SUPPRESSED;
+    sequence_no = caps_sender_send_attrs(attrs, attr_num);
+    if (sequence_no < 0)
+        printf("fail to send %d attributes\n", attr_num);
+    return sequence_no;
+}
+
+} // namespace caps
+
+#endif /* _CAPS_BINDING_HPP_ */
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_bodyMassIndexMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_bodyMassIndexMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double bmiMeasurement_value;
+    int64_t bmiMeasurement_milli;
     char *bmiMeasurement_unit;
 
     double (*get_bmiMeasurement_value)(struct caps_bodyMassIndexMeasurement_data *caps_data);
     void (*set_bmiMeasurement_value)(struct caps_bodyMassIndexMeasurement_data *caps_data, double value);
+    int64_t (*get_bmiMeasurement_milli)(struct caps_bodyMassIndexMeasurement_data *caps_data);
+    void (*set_bmiMeasurement_milli)(struct caps_bodyMassIndexMeasurement_data *caps_data, int64_t milli);
     const char *(*get_bmiMeasurement_unit)(struct caps_bodyMassIndexMeasurement_data *caps_data);
     void (*set_bmiMeasurement_unit)(struct caps_bodyMassIndexMeasurement_data *caps_data, const char *unit);
     void (*attr_bmiMeasurement_send)(struct caps_bodyMassIndexMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_bodyMassIndexMeasurement_data {
 } caps_bodyMassIndexMeasurement_data_t;
 
 caps_bodyMassIndexMeasurement_data_t *caps_bodyMassIndexMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_bodyMassIndexMeasurement_deinitialize(caps_bodyMassIndexMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
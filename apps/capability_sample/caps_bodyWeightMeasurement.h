@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_bodyWeightMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_bodyWeightMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double bodyWeightMeasurement_value;
+    int64_t bodyWeightMeasurement_milli;
     char *bodyWeightMeasurement_unit;
 
     double (*get_bodyWeightMeasurement_value)(struct caps_bodyWeightMeasurement_data *caps_data);
     void (*set_bodyWeightMeasurement_value)(struct caps_bodyWeightMeasurement_data *caps_data, double value);
+    int64_t (*get_bodyWeightMeasurement_milli)(struct caps_bodyWeightMeasurement_data *caps_data);
+    void (*set_bodyWeightMeasurement_milli)(struct caps_bodyWeightMeasurement_data *caps_data, int64_t milli);
     const char *(*get_bodyWeightMeasurement_unit)(struct caps_bodyWeightMeasurement_data *caps_data);
     void (*set_bodyWeightMeasurement_unit)(struct caps_bodyWeightMeasurement_data *caps_data, const char *unit);
     void (*attr_bodyWeightMeasurement_send)(struct caps_bodyWeightMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_bodyWeightMeasurement_data {
 } caps_bodyWeightMeasurement_data_t;
 
 caps_bodyWeightMeasurement_data_t *caps_bodyWeightMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_bodyWeightMeasurement_deinitialize(caps_bodyWeightMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
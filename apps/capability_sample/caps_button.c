@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_button.h"
+#include "caps_sender.h"
 
 static const char **caps_button_get_supportedButtonValues_value(caps_button_data_t *caps_data)
 {
@@ -39,7 +40,7 @@ static void caps_button_set_supportedButtonValues_value(caps_button_data_t *caps
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedButtonValues_value) {
+    if (caps_data->supportedButtonValues_value && !caps_data->supportedButtonValues_borrowed) {
         for (i = 0; i < caps_data->supportedButtonValues_arraySize; i++) {
             free(caps_data->supportedButtonValues_value[i]);
         }
@@ -56,6 +57,27 @@ static void caps_button_set_supportedButtonValues_value(caps_button_data_t *caps
     }
 
     caps_data->supportedButtonValues_arraySize = arraySize;
+    caps_data->supportedButtonValues_borrowed = 0;
+}
+
+static void caps_button_set_supportedButtonValues_value_borrowed(caps_button_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedButtonValues_value && !caps_data->supportedButtonValues_borrowed) {
+        for (i = 0; i < caps_data->supportedButtonValues_arraySize; i++) {
+            free(caps_data->supportedButtonValues_value[i]);
+        }
+        free(caps_data->supportedButtonValues_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedButtonValues_value = (char **)value;
+    caps_data->supportedButtonValues_arraySize = arraySize;
+    caps_data->supportedButtonValues_borrowed = 1;
 }
 
 static void caps_button_attr_supportedButtonValues_send(caps_button_data_t *caps_data)
@@ -71,7 +93,7 @@ static void caps_button_attr_supportedButtonValues_send(caps_button_data_t *caps
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_button.attr_supportedButtonValues.name,
             caps_data->supportedButtonValues_value,
             caps_data->supportedButtonValues_arraySize,
@@ -104,19 +126,52 @@ static const char *caps_button_get_button_value(caps_button_data_t *caps_data)
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->button_value;
+    if (caps_data->button_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_button.attr_button.values[caps_data->button_idx];
 }
 
 static void caps_button_set_button_value(caps_button_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->button_value) {
-        free(caps_data->button_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_button_attr_button_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for button\n", value);
+        return;
     }
-    caps_data->button_value = strdup(value);
+    caps_data->button_idx = index;
+}
+
+static int caps_button_get_button_idx(caps_button_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->button_idx;
+}
+
+static void caps_button_set_button_idx(caps_button_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_BUTTON_BUTTON_VALUE_MAX) {
+        printf("%d is not supported index for button\n", idx);
+        return;
+    }
+    caps_data->button_idx = idx;
 }
 
 static void caps_button_attr_button_send(caps_button_data_t *caps_data)
@@ -127,14 +182,14 @@ static void caps_button_attr_button_send(caps_button_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->button_value) {
+    if (caps_data->button_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_button.attr_button.name,
-            caps_data->button_value,
+            (char *)caps_helper_button.attr_button.values[caps_data->button_idx],
             NULL,
             NULL,
             sequence_no);
@@ -174,7 +229,7 @@ static void caps_button_attr_numberOfButtons_send(caps_button_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_button.attr_numberOfButtons.name,
             caps_data->numberOfButtons_value,
             NULL,
@@ -192,11 +247,14 @@ static void caps_button_attr_numberOfButtons_send(caps_button_data_t *caps_data)
 static void caps_button_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_button_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_button_attr_supportedButtonValues_send(caps_data);
     caps_button_attr_button_send(caps_data);
     caps_button_attr_numberOfButtons_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_button_data_t *caps_button_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -216,17 +274,21 @@ caps_button_data_t *caps_button_initialize(IOT_CTX *ctx, const char *component,
 
     caps_data->get_supportedButtonValues_value = caps_button_get_supportedButtonValues_value;
     caps_data->set_supportedButtonValues_value = caps_button_set_supportedButtonValues_value;
+    caps_data->set_supportedButtonValues_value_borrowed = caps_button_set_supportedButtonValues_value_borrowed;
     caps_data->attr_supportedButtonValues_send = caps_button_attr_supportedButtonValues_send;
     caps_data->get_button_value = caps_button_get_button_value;
     caps_data->set_button_value = caps_button_set_button_value;
+    caps_data->get_button_idx = caps_button_get_button_idx;
+    caps_data->set_button_idx = caps_button_set_button_idx;
     caps_data->attr_button_str2idx = caps_button_attr_button_str2idx;
     caps_data->attr_button_send = caps_button_attr_button_send;
     caps_data->get_numberOfButtons_value = caps_button_get_numberOfButtons_value;
     caps_data->set_numberOfButtons_value = caps_button_set_numberOfButtons_value;
     caps_data->attr_numberOfButtons_send = caps_button_attr_numberOfButtons_send;
     caps_data->numberOfButtons_value = 0;
+    caps_data->button_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_button.id, caps_button_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_button.id, caps_button_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init button handle\n");
@@ -234,3 +296,24 @@ caps_button_data_t *caps_button_initialize(IOT_CTX *ctx, const char *component,
 
     return caps_data;
 }
+
+void caps_button_deinitialize(caps_button_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedButtonValues_value && !caps_data->supportedButtonValues_borrowed) {
+        for (i = 0; i < caps_data->supportedButtonValues_arraySize; i++) {
+            free(caps_data->supportedButtonValues_value[i]);
+        }
+        free(caps_data->supportedButtonValues_value);
+    }
+    free(caps_data);
+}
@@ -30,14 +30,18 @@ typedef struct caps_button_data {
 
     char **supportedButtonValues_value;
     int supportedButtonValues_arraySize;
-    char *button_value;
+    int supportedButtonValues_borrowed;
+    int button_idx;
     int numberOfButtons_value;
 
     const char **(*get_supportedButtonValues_value)(struct caps_button_data *caps_data);
     void (*set_supportedButtonValues_value)(struct caps_button_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedButtonValues_value_borrowed)(struct caps_button_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedButtonValues_send)(struct caps_button_data *caps_data);
     const char *(*get_button_value)(struct caps_button_data *caps_data);
     void (*set_button_value)(struct caps_button_data *caps_data, const char *value);
+    int (*get_button_idx)(struct caps_button_data *caps_data);
+    void (*set_button_idx)(struct caps_button_data *caps_data, int idx);
     int (*attr_button_str2idx)(const char *value);
     void (*attr_button_send)(struct caps_button_data *caps_data);
     int (*get_numberOfButtons_value)(struct caps_button_data *caps_data);
@@ -48,6 +52,7 @@ typedef struct caps_button_data {
 } caps_button_data_t;
 
 caps_button_data_t *caps_button_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_button_deinitialize(caps_button_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@ typedef struct caps_carbonDioxideMeasurement_data {
 } caps_carbonDioxideMeasurement_data_t;
 
 caps_carbonDioxideMeasurement_data_t *caps_carbonDioxideMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_carbonDioxideMeasurement_deinitialize(caps_carbonDioxideMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_carbonMonoxideDetector_data {
     void *usr_data;
     void *cmd_data;
 
-    char *carbonMonoxide_value;
+    int carbonMonoxide_idx;
 
     const char *(*get_carbonMonoxide_value)(struct caps_carbonMonoxideDetector_data *caps_data);
     void (*set_carbonMonoxide_value)(struct caps_carbonMonoxideDetector_data *caps_data, const char *value);
+    int (*get_carbonMonoxide_idx)(struct caps_carbonMonoxideDetector_data *caps_data);
+    void (*set_carbonMonoxide_idx)(struct caps_carbonMonoxideDetector_data *caps_data, int idx);
     int (*attr_carbonMonoxide_str2idx)(const char *value);
     void (*attr_carbonMonoxide_send)(struct caps_carbonMonoxideDetector_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_carbonMonoxideDetector_data {
 } caps_carbonMonoxideDetector_data_t;
 
 caps_carbonMonoxideDetector_data_t *caps_carbonMonoxideDetector_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_carbonMonoxideDetector_deinitialize(caps_carbonMonoxideDetector_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_carbonMonoxideMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_carbonMonoxideMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double carbonMonoxideLevel_value;
+    int64_t carbonMonoxideLevel_milli;
     char *carbonMonoxideLevel_unit;
 
     double (*get_carbonMonoxideLevel_value)(struct caps_carbonMonoxideMeasurement_data *caps_data);
     void (*set_carbonMonoxideLevel_value)(struct caps_carbonMonoxideMeasurement_data *caps_data, double value);
+    int64_t (*get_carbonMonoxideLevel_milli)(struct caps_carbonMonoxideMeasurement_data *caps_data);
+    void (*set_carbonMonoxideLevel_milli)(struct caps_carbonMonoxideMeasurement_data *caps_data, int64_t milli);
     const char *(*get_carbonMonoxideLevel_unit)(struct caps_carbonMonoxideMeasurement_data *caps_data);
     void (*set_carbonMonoxideLevel_unit)(struct caps_carbonMonoxideMeasurement_data *caps_data, const char *unit);
     void (*attr_carbonMonoxideLevel_send)(struct caps_carbonMonoxideMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_carbonMonoxideMeasurement_data {
 } caps_carbonMonoxideMeasurement_data_t;
 
 caps_carbonMonoxideMeasurement_data_t *caps_carbonMonoxideMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_carbonMonoxideMeasurement_deinitialize(caps_carbonMonoxideMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
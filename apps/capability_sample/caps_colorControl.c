@@ -22,82 +22,85 @@
 
 #include "st_dev.h"
 #include "caps_colorControl.h"
-
-static void caps_colorControl_set_color_value(caps_colorControl_data_t *caps_data, double hue, double saturation)
-{
-    if (!caps_data) {
-        printf("caps_data is NULL\n");
-        return;
-    }
-
-    caps_data->hue_value = hue;
-    caps_data->saturation_value = saturation;
-}
+#include "caps_sender.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+#include "caps_json_parser.h"
 
 static void caps_colorControl_attr_color_send(caps_colorControl_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt[2];
-    uint8_t evt_num = 2;
-    int32_t sequence_no;
-    iot_cap_val_t value[2];
+    caps_attr_t attr[2];
+    int sequence_no;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
         return;
     }
 
+    attr[0].handle = caps_data->handle;
+    attr[0].name = caps_helper_colorControl.attr_hue.name;
+    caps_util_milli_to_val(caps_data->hue_milli, &attr[0].value);
+    attr[0].unit = NULL;
+    attr[0].data = NULL;
 
-    value[0].type = IOT_CAP_VAL_TYPE_NUMBER;
-    value[0].number = caps_data->hue_value;
-
-    cap_evt[0] = st_cap_create_attr(caps_data->handle,
-            (char *) caps_helper_colorControl.attr_hue.name,
-            &value[0],
-            NULL,
-            NULL);
-
-    value[1].type = IOT_CAP_VAL_TYPE_NUMBER;
-    value[1].number = caps_data->hue_value;
-
-    cap_evt[1] = st_cap_create_attr(caps_data->handle,
-            (char *) caps_helper_colorControl.attr_saturation.name,
-            &value[1],
-            NULL,
-            NULL);
-
-    if (!cap_evt[0] || !cap_evt[1]) {
-        printf("fail to create cap_evt\n");
-        free(cap_evt[0]);
-        free(cap_evt[1]);
-        return;
-    }
+    attr[1].handle = caps_data->handle;
+    attr[1].name = caps_helper_colorControl.attr_saturation.name;
+    caps_util_milli_to_val(caps_data->saturation_milli, &attr[1].value);
+    attr[1].unit = NULL;
+    attr[1].data = NULL;
 
-    sequence_no = st_cap_send_attr(cap_evt, evt_num);
+    sequence_no = caps_sender_send_attrs(attr, 2);
     if (sequence_no < 0)
         printf("fail to send color data\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt[0]);
-    st_cap_free_attr(cap_evt[1]);
 }
 
 
+static int64_t caps_colorControl_get_hue_milli(caps_colorControl_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_colorControl.attr_hue.min) - 1;
+    }
+    return caps_data->hue_milli;
+}
+
+static void caps_colorControl_set_hue_milli(caps_colorControl_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_colorControl.attr_hue.min)) {
+        printf("%lld is out of range for hue\n", (long long)milli);
+        return;
+    }
+    caps_data->hue_milli = milli;
+}
+
 static double caps_colorControl_get_hue_value(caps_colorControl_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_colorControl.attr_hue.min - 1;
     }
-    return caps_data->hue_value;
+    return caps_util_milli_to_double(caps_data->hue_milli);
 }
 
 static void caps_colorControl_set_hue_value(caps_colorControl_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->hue_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for hue\n");
+        return;
+    }
+    caps_colorControl_set_hue_milli(caps_data, milli);
 }
 
 static void caps_colorControl_attr_hue_send(caps_colorControl_data_t *caps_data)
@@ -109,9 +112,9 @@ static void caps_colorControl_attr_hue_send(caps_colorControl_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_colorControl.attr_hue.name,
-            caps_data->hue_value,
+            caps_data->hue_milli,
             NULL,
             NULL,
             sequence_no);
@@ -123,22 +126,79 @@ static void caps_colorControl_attr_hue_send(caps_colorControl_data_t *caps_data)
 }
 
 
+static int64_t caps_colorControl_get_saturation_milli(caps_colorControl_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_colorControl.attr_saturation.min) - 1;
+    }
+    return caps_data->saturation_milli;
+}
+
+static void caps_colorControl_set_saturation_milli(caps_colorControl_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_colorControl.attr_saturation.min)) {
+        printf("%lld is out of range for saturation\n", (long long)milli);
+        return;
+    }
+    caps_data->saturation_milli = milli;
+}
+
 static double caps_colorControl_get_saturation_value(caps_colorControl_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_colorControl.attr_saturation.min - 1;
     }
-    return caps_data->saturation_value;
+    return caps_util_milli_to_double(caps_data->saturation_milli);
 }
 
 static void caps_colorControl_set_saturation_value(caps_colorControl_data_t *caps_data, double value)
+{
+    int64_t milli;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for saturation\n");
+        return;
+    }
+    caps_colorControl_set_saturation_milli(caps_data, milli);
+}
+
+static void caps_colorControl_set_color_milli(caps_colorControl_data_t *caps_data, int64_t hue, int64_t saturation)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->saturation_value = value;
+
+    caps_colorControl_set_hue_milli(caps_data, hue);
+    caps_colorControl_set_saturation_milli(caps_data, saturation);
+}
+
+static void caps_colorControl_set_color_value(caps_colorControl_data_t *caps_data, double hue, double saturation)
+{
+    int64_t hue_milli;
+    int64_t saturation_milli;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_util_double_to_milli(hue, &hue_milli) < 0 ||
+            caps_util_double_to_milli(saturation, &saturation_milli) < 0) {
+        printf("value is out of range for color\n");
+        return;
+    }
+
+    caps_colorControl_set_color_milli(caps_data, hue_milli, saturation_milli);
 }
 
 static void caps_colorControl_attr_saturation_send(caps_colorControl_data_t *caps_data)
@@ -150,9 +210,9 @@ static void caps_colorControl_attr_saturation_send(caps_colorControl_data_t *cap
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_colorControl.attr_saturation.name,
-            caps_data->saturation_value,
+            caps_data->saturation_milli,
             NULL,
             NULL,
             sequence_no);
@@ -183,30 +243,36 @@ static void caps_colorControl_cmd_setColor_cb(IOT_CAP_HANDLE *handle,
         iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_colorControl_data_t *caps_data = usr_data;
-    JSON_H* json_object;
-    JSON_H* item;
-    double hue = caps_helper_colorControl.attr_hue.min - 1;
-    double saturation = caps_helper_colorControl.attr_saturation.min - 1;
+    caps_json_token_t tokens[CAPS_COLORCONTROL_JSON_TOKENS];
+    const char *json_str;
+    int token_num;
+    int item;
+    int64_t hue = CAPS_UTIL_MILLI(caps_helper_colorControl.attr_hue.min) - 1;
+    int64_t saturation = CAPS_UTIL_MILLI(caps_helper_colorControl.attr_saturation.min) - 1;
 
     printf("called [%s] func with : num_args:%u\n", __func__, cmd_data->num_args);
     caps_data->cmd_data = cmd_data;
 
-    json_object = JSON_PARSE(cmd_data->cmd_data[0].json_object);
-    if (!json_object) {
-        printf("fail to parse json object\n");
+    json_str = cmd_data->cmd_data[0].json_object;
+    if (!json_str) {
+        printf("json object is NULL\n");
         return;
     }
-    item = JSON_GET_OBJECT_ITEM(json_object, "hue");
-    if (JSON_IS_NUMBER(item)) {
-        hue = item->valuedouble;
+    token_num = caps_json_parse(json_str, strlen(json_str), tokens, CAPS_COLORCONTROL_JSON_TOKENS);
+    if (token_num < 0) {
+        printf("fail to parse json object : %d\n", token_num);
+        return;
     }
-    item = JSON_GET_OBJECT_ITEM(json_object, "saturation");
-    if (JSON_IS_NUMBER(item)) {
-        saturation = item->valuedouble;
+    item = caps_json_find(json_str, tokens, token_num, 0, "hue");
+    if (item >= 0) {
+        caps_json_get_milli(json_str, &tokens[item], &hue);
+    }
+    item = caps_json_find(json_str, tokens, token_num, 0, "saturation");
+    if (item >= 0) {
+        caps_json_get_milli(json_str, &tokens[item], &saturation);
     }
-    JSON_DELETE(json_object);
 
-    caps_colorControl_set_color_value(caps_data, hue, saturation);
+    caps_colorControl_set_color_milli(caps_data, hue, saturation);
     if (caps_data && caps_data->cmd_setColor_usr_cb)
         caps_data->cmd_setColor_usr_cb(caps_data);
     caps_colorControl_attr_color_send(caps_data);
@@ -230,11 +296,14 @@ static void caps_colorControl_cmd_setSaturation_cb(IOT_CAP_HANDLE *handle, iot_c
 static void caps_colorControl_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_colorControl_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_colorControl_attr_color_send(caps_data);
     caps_colorControl_attr_hue_send(caps_data);
     caps_colorControl_attr_saturation_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_colorControl_data_t *caps_colorControl_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -254,28 +323,33 @@ caps_colorControl_data_t *caps_colorControl_initialize(IOT_CTX *ctx, const char
     caps_data->usr_data = usr_data;
 
     caps_data->set_color_value = caps_colorControl_set_color_value;
+    caps_data->set_color_milli = caps_colorControl_set_color_milli;
     caps_data->attr_color_send = caps_colorControl_attr_color_send;
     caps_data->get_hue_value = caps_colorControl_get_hue_value;
     caps_data->set_hue_value = caps_colorControl_set_hue_value;
+    caps_data->get_hue_milli = caps_colorControl_get_hue_milli;
+    caps_data->set_hue_milli = caps_colorControl_set_hue_milli;
     caps_data->attr_hue_send = caps_colorControl_attr_hue_send;
     caps_data->get_saturation_value = caps_colorControl_get_saturation_value;
     caps_data->set_saturation_value = caps_colorControl_set_saturation_value;
+    caps_data->get_saturation_milli = caps_colorControl_get_saturation_milli;
+    caps_data->set_saturation_milli = caps_colorControl_set_saturation_milli;
     caps_data->attr_saturation_send = caps_colorControl_attr_saturation_send;
-    caps_data->hue_value = 0;
-    caps_data->saturation_value = 0;
+    caps_data->hue_milli = CAPS_UTIL_MILLI(0);
+    caps_data->saturation_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_colorControl.id, caps_colorControl_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_colorControl.id, caps_colorControl_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setHue.name, caps_colorControl_cmd_setHue_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setHue.name, caps_colorControl_cmd_setHue_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setHue of colorControl\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setColor.name, caps_colorControl_cmd_setColor_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setColor.name, caps_colorControl_cmd_setColor_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setColor of colorControl\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setSaturation.name, caps_colorControl_cmd_setSaturation_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_colorControl.cmd_setSaturation.name, caps_colorControl_cmd_setSaturation_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setSaturation of colorControl\n");
     }
@@ -285,3 +359,17 @@ caps_colorControl_data_t *caps_colorControl_initialize(IOT_CTX *ctx, const char
 
     return caps_data;
 }
+
+void caps_colorControl_deinitialize(caps_colorControl_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
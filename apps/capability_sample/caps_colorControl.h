@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_colorControl.h"
 #include "JSON.h"
 
@@ -23,21 +25,31 @@
 extern "C" {
 #endif
 
+/* setColor argument is a small object like {"hue":50,"saturation":100} */
+#ifndef CAPS_COLORCONTROL_JSON_TOKENS
+#define CAPS_COLORCONTROL_JSON_TOKENS 16
+#endif
+
 typedef struct caps_colorControl_data {
     IOT_CAP_HANDLE* handle;
     void *usr_data;
     void *cmd_data;
 
-    double hue_value;
-    double saturation_value;
+    int64_t hue_milli;
+    int64_t saturation_milli;
 
     void (*set_color_value)(struct caps_colorControl_data *caps_data, double hue, double saturaiton);
+    void (*set_color_milli)(struct caps_colorControl_data *caps_data, int64_t hue, int64_t saturation);
     void (*attr_color_send)(struct caps_colorControl_data *caps_data);
     double (*get_hue_value)(struct caps_colorControl_data *caps_data);
     void (*set_hue_value)(struct caps_colorControl_data *caps_data, double value);
+    int64_t (*get_hue_milli)(struct caps_colorControl_data *caps_data);
+    void (*set_hue_milli)(struct caps_colorControl_data *caps_data, int64_t milli);
     void (*attr_hue_send)(struct caps_colorControl_data *caps_data);
     double (*get_saturation_value)(struct caps_colorControl_data *caps_data);
     void (*set_saturation_value)(struct caps_colorControl_data *caps_data, double value);
+    int64_t (*get_saturation_milli)(struct caps_colorControl_data *caps_data);
+    void (*set_saturation_milli)(struct caps_colorControl_data *caps_data, int64_t milli);
     void (*attr_saturation_send)(struct caps_colorControl_data *caps_data);
 
     void (*init_usr_cb)(struct caps_colorControl_data *caps_data);
@@ -48,6 +60,7 @@ typedef struct caps_colorControl_data {
 } caps_colorControl_data_t;
 
 caps_colorControl_data_t *caps_colorControl_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_colorControl_deinitialize(caps_colorControl_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_contactSensor.h"
+#include "caps_sender.h"
 
 static int caps_contactSensor_attr_contact_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_contactSensor_get_contact_value(caps_contactSensor_data_
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->contact_value;
+    if (caps_data->contact_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_contactSensor.attr_contact.values[caps_data->contact_idx];
 }
 
 static void caps_contactSensor_set_contact_value(caps_contactSensor_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->contact_value) {
-        free(caps_data->contact_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_contactSensor_attr_contact_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for contact\n", value);
+        return;
     }
-    caps_data->contact_value = strdup(value);
+    caps_data->contact_idx = index;
+}
+
+static int caps_contactSensor_get_contact_idx(caps_contactSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->contact_idx;
+}
+
+static void caps_contactSensor_set_contact_idx(caps_contactSensor_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_CONTACTSENSOR_CONTACT_VALUE_MAX) {
+        printf("%d is not supported index for contact\n", idx);
+        return;
+    }
+    caps_data->contact_idx = idx;
 }
 
 static void caps_contactSensor_attr_contact_send(caps_contactSensor_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_contactSensor_attr_contact_send(caps_contactSensor_data_t *caps
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->contact_value) {
+    if (caps_data->contact_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_contactSensor.attr_contact.name,
-            caps_data->contact_value,
+            (char *)caps_helper_contactSensor.attr_contact.values[caps_data->contact_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_contactSensor_attr_contact_send(caps_contactSensor_data_t *caps
 static void caps_contactSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_contactSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_contactSensor_attr_contact_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_contactSensor_data_t *caps_contactSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_contactSensor_data_t *caps_contactSensor_initialize(IOT_CTX *ctx, const cha
 
     caps_data->get_contact_value = caps_contactSensor_get_contact_value;
     caps_data->set_contact_value = caps_contactSensor_set_contact_value;
+    caps_data->get_contact_idx = caps_contactSensor_get_contact_idx;
+    caps_data->set_contact_idx = caps_contactSensor_set_contact_idx;
     caps_data->attr_contact_str2idx = caps_contactSensor_attr_contact_str2idx;
     caps_data->attr_contact_send = caps_contactSensor_attr_contact_send;
+    caps_data->contact_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_contactSensor.id, caps_contactSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_contactSensor.id, caps_contactSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init contactSensor handle\n");
@@ -120,3 +160,16 @@ caps_contactSensor_data_t *caps_contactSensor_initialize(IOT_CTX *ctx, const cha
 
     return caps_data;
 }
+
+void caps_contactSensor_deinitialize(caps_contactSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_contactSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *contact_value;
+    int contact_idx;
 
     const char *(*get_contact_value)(struct caps_contactSensor_data *caps_data);
     void (*set_contact_value)(struct caps_contactSensor_data *caps_data, const char *value);
+    int (*get_contact_idx)(struct caps_contactSensor_data *caps_data);
+    void (*set_contact_idx)(struct caps_contactSensor_data *caps_data, int idx);
     int (*attr_contact_str2idx)(const char *value);
     void (*attr_contact_send)(struct caps_contactSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_contactSensor_data {
 } caps_contactSensor_data_t;
 
 caps_contactSensor_data_t *caps_contactSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_contactSensor_deinitialize(caps_contactSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_doorControl.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_doorControl_attr_door_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_doorControl_get_door_value(caps_doorControl_data_t *caps
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->door_value;
+    if (caps_data->door_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_doorControl.attr_door.values[caps_data->door_idx];
 }
 
 static void caps_doorControl_set_door_value(caps_doorControl_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_doorControl_attr_door_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for door\n", value);
+        return;
+    }
+    caps_data->door_idx = index;
+}
+
+static int caps_doorControl_get_door_idx(caps_doorControl_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->door_idx;
+}
+
+static void caps_doorControl_set_door_idx(caps_doorControl_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->door_value) {
-        free(caps_data->door_value);
+    if (idx < 0 || idx >= CAP_ENUM_DOORCONTROL_DOOR_VALUE_MAX) {
+        printf("%d is not supported index for door\n", idx);
+        return;
     }
-    caps_data->door_value = strdup(value);
+    caps_data->door_idx = idx;
 }
 
 static void caps_doorControl_attr_door_send(caps_doorControl_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_doorControl_attr_door_send(caps_doorControl_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->door_value) {
+    if (caps_data->door_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_doorControl.attr_door.name,
-            caps_data->door_value,
+            (char *)caps_helper_doorControl.attr_door.values[caps_data->door_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,11 +122,11 @@ static void caps_doorControl_attr_door_send(caps_doorControl_data_t *caps_data)
 static void caps_doorControl_cmd_close_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_doorControl_data_t *caps_data = (caps_doorControl_data_t *)usr_data;
-    const char* value = caps_helper_doorControl.attr_door.values[CAP_ENUM_DOORCONTROL_DOOR_VALUE_CLOSED];
+    int index = CAP_ENUM_DOORCONTROL_DOOR_VALUE_CLOSED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_doorControl_set_door_value(caps_data, value);
+    caps_doorControl_set_door_idx(caps_data, index);
     if (caps_data && caps_data->cmd_close_usr_cb)
         caps_data->cmd_close_usr_cb(caps_data);
     caps_doorControl_attr_door_send(caps_data);
@@ -100,11 +135,11 @@ static void caps_doorControl_cmd_close_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_da
 static void caps_doorControl_cmd_open_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_doorControl_data_t *caps_data = (caps_doorControl_data_t *)usr_data;
-    const char* value = caps_helper_doorControl.attr_door.values[CAP_ENUM_DOORCONTROL_DOOR_VALUE_OPEN];
+    int index = CAP_ENUM_DOORCONTROL_DOOR_VALUE_OPEN;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_doorControl_set_door_value(caps_data, value);
+    caps_doorControl_set_door_idx(caps_data, index);
     if (caps_data && caps_data->cmd_open_usr_cb)
         caps_data->cmd_open_usr_cb(caps_data);
     caps_doorControl_attr_door_send(caps_data);
@@ -113,9 +148,12 @@ static void caps_doorControl_cmd_open_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_dat
 static void caps_doorControl_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_doorControl_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_doorControl_attr_door_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_doorControl_data_t *caps_doorControl_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -136,17 +174,20 @@ caps_doorControl_data_t *caps_doorControl_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_door_value = caps_doorControl_get_door_value;
     caps_data->set_door_value = caps_doorControl_set_door_value;
+    caps_data->get_door_idx = caps_doorControl_get_door_idx;
+    caps_data->set_door_idx = caps_doorControl_set_door_idx;
     caps_data->attr_door_str2idx = caps_doorControl_attr_door_str2idx;
     caps_data->attr_door_send = caps_doorControl_attr_door_send;
+    caps_data->door_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_doorControl.id, caps_doorControl_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_doorControl.id, caps_doorControl_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_doorControl.cmd_close.name, caps_doorControl_cmd_close_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_doorControl.cmd_close.name, caps_doorControl_cmd_close_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for close of doorControl\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_doorControl.cmd_open.name, caps_doorControl_cmd_open_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_doorControl.cmd_open.name, caps_doorControl_cmd_open_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for open of doorControl\n");
     }
@@ -156,3 +197,17 @@ caps_doorControl_data_t *caps_doorControl_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_doorControl_deinitialize(caps_doorControl_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -22,6 +22,9 @@
 
 #include "st_dev.h"
 #include "caps_dryerOperatingState.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+#include "caps_cmd.h"
 
 static const char *caps_dryerOperatingState_get_completionTime_value(caps_dryerOperatingState_data_t *caps_data)
 {
@@ -29,19 +32,16 @@ static const char *caps_dryerOperatingState_get_completionTime_value(caps_dryerO
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->completionTime_value;
+    return caps_data->completionTime_value[0] ? caps_data->completionTime_value : NULL;
 }
 
-static void caps_dryerOperatingState_set_completionTime_value(caps_dryerOperatingState_data_t *caps_data, const char *value)
+static int caps_dryerOperatingState_set_completionTime_value(caps_dryerOperatingState_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
-    }
-    if (caps_data->completionTime_value) {
-        free(caps_data->completionTime_value);
+        return -1;
     }
-    caps_data->completionTime_value = strdup(value);
+    return caps_util_copy_string(caps_data->completionTime_value, sizeof(caps_data->completionTime_value), value);
 }
 
 static void caps_dryerOperatingState_attr_completionTime_send(caps_dryerOperatingState_data_t *caps_data)
@@ -52,12 +52,12 @@ static void caps_dryerOperatingState_attr_completionTime_send(caps_dryerOperatin
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->completionTime_value) {
+    if (!caps_data->completionTime_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_dryerOperatingState.attr_completionTime.name,
             caps_data->completionTime_value,
             NULL,
@@ -87,7 +87,7 @@ static void caps_dryerOperatingState_set_supportedMachineStates_value(caps_dryer
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedMachineStates_value) {
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
         for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
             free(caps_data->supportedMachineStates_value[i]);
         }
@@ -104,6 +104,27 @@ static void caps_dryerOperatingState_set_supportedMachineStates_value(caps_dryer
     }
 
     caps_data->supportedMachineStates_arraySize = arraySize;
+    caps_data->supportedMachineStates_borrowed = 0;
+}
+
+static void caps_dryerOperatingState_set_supportedMachineStates_value_borrowed(caps_dryerOperatingState_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
+        for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
+            free(caps_data->supportedMachineStates_value[i]);
+        }
+        free(caps_data->supportedMachineStates_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedMachineStates_value = (char **)value;
+    caps_data->supportedMachineStates_arraySize = arraySize;
+    caps_data->supportedMachineStates_borrowed = 1;
 }
 
 static void caps_dryerOperatingState_attr_supportedMachineStates_send(caps_dryerOperatingState_data_t *caps_data)
@@ -119,7 +140,7 @@ static void caps_dryerOperatingState_attr_supportedMachineStates_send(caps_dryer
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_dryerOperatingState.attr_supportedMachineStates.name,
             caps_data->supportedMachineStates_value,
             caps_data->supportedMachineStates_arraySize,
@@ -152,19 +173,52 @@ static const char *caps_dryerOperatingState_get_machineState_value(caps_dryerOpe
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->machineState_value;
+    if (caps_data->machineState_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_dryerOperatingState.attr_machineState.values[caps_data->machineState_idx];
 }
 
 static void caps_dryerOperatingState_set_machineState_value(caps_dryerOperatingState_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_dryerOperatingState_attr_machineState_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for machineState\n", value);
+        return;
+    }
+    caps_data->machineState_idx = index;
+}
+
+static int caps_dryerOperatingState_get_machineState_idx(caps_dryerOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->machineState_idx;
+}
+
+static void caps_dryerOperatingState_set_machineState_idx(caps_dryerOperatingState_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->machineState_value) {
-        free(caps_data->machineState_value);
+    if (idx < 0 || idx >= CAP_ENUM_DRYEROPERATINGSTATE_MACHINESTATE_VALUE_MAX) {
+        printf("%d is not supported index for machineState\n", idx);
+        return;
     }
-    caps_data->machineState_value = strdup(value);
+    caps_data->machineState_idx = idx;
 }
 
 static void caps_dryerOperatingState_attr_machineState_send(caps_dryerOperatingState_data_t *caps_data)
@@ -175,14 +229,14 @@ static void caps_dryerOperatingState_attr_machineState_send(caps_dryerOperatingS
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->machineState_value) {
+    if (caps_data->machineState_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_dryerOperatingState.attr_machineState.name,
-            caps_data->machineState_value,
+            (char *)caps_helper_dryerOperatingState.attr_machineState.values[caps_data->machineState_idx],
             NULL,
             NULL,
             sequence_no);
@@ -213,19 +267,52 @@ static const char *caps_dryerOperatingState_get_dryerJobState_value(caps_dryerOp
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->dryerJobState_value;
+    if (caps_data->dryerJobState_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_dryerOperatingState.attr_dryerJobState.values[caps_data->dryerJobState_idx];
 }
 
 static void caps_dryerOperatingState_set_dryerJobState_value(caps_dryerOperatingState_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_dryerOperatingState_attr_dryerJobState_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for dryerJobState\n", value);
+        return;
+    }
+    caps_data->dryerJobState_idx = index;
+}
+
+static int caps_dryerOperatingState_get_dryerJobState_idx(caps_dryerOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->dryerJobState_idx;
+}
+
+static void caps_dryerOperatingState_set_dryerJobState_idx(caps_dryerOperatingState_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->dryerJobState_value) {
-        free(caps_data->dryerJobState_value);
+    if (idx < 0 || idx >= CAP_ENUM_DRYEROPERATINGSTATE_DRYERJOBSTATE_VALUE_MAX) {
+        printf("%d is not supported index for dryerJobState\n", idx);
+        return;
     }
-    caps_data->dryerJobState_value = strdup(value);
+    caps_data->dryerJobState_idx = idx;
 }
 
 static void caps_dryerOperatingState_attr_dryerJobState_send(caps_dryerOperatingState_data_t *caps_data)
@@ -236,14 +323,14 @@ static void caps_dryerOperatingState_attr_dryerJobState_send(caps_dryerOperating
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->dryerJobState_value) {
+    if (caps_data->dryerJobState_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_dryerOperatingState.attr_dryerJobState.name,
-            caps_data->dryerJobState_value,
+            (char *)caps_helper_dryerOperatingState.attr_dryerJobState.values[caps_data->dryerJobState_idx],
             NULL,
             NULL,
             sequence_no);
@@ -259,7 +346,6 @@ static void caps_dryerOperatingState_attr_dryerJobState_send(caps_dryerOperating
 static void caps_dryerOperatingState_cmd_setMachineState_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_dryerOperatingState_data_t *caps_data = (caps_dryerOperatingState_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -269,9 +355,7 @@ static void caps_dryerOperatingState_cmd_setMachineState_cb(IOT_CAP_HANDLE *hand
         printf("%s is not supported value for setMachineState\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_dryerOperatingState.attr_machineState.values[index];
-
-    caps_dryerOperatingState_set_machineState_value(caps_data, value);
+    caps_dryerOperatingState_set_machineState_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setMachineState_usr_cb)
         caps_data->cmd_setMachineState_usr_cb(caps_data);
     caps_dryerOperatingState_attr_machineState_send(caps_data);
@@ -280,12 +364,15 @@ static void caps_dryerOperatingState_cmd_setMachineState_cb(IOT_CAP_HANDLE *hand
 static void caps_dryerOperatingState_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_dryerOperatingState_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_dryerOperatingState_attr_completionTime_send(caps_data);
     caps_dryerOperatingState_attr_supportedMachineStates_send(caps_data);
     caps_dryerOperatingState_attr_machineState_send(caps_data);
     caps_dryerOperatingState_attr_dryerJobState_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_dryerOperatingState_data_t *caps_dryerOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -309,20 +396,27 @@ caps_dryerOperatingState_data_t *caps_dryerOperatingState_initialize(IOT_CTX *ct
     caps_data->attr_completionTime_send = caps_dryerOperatingState_attr_completionTime_send;
     caps_data->get_supportedMachineStates_value = caps_dryerOperatingState_get_supportedMachineStates_value;
     caps_data->set_supportedMachineStates_value = caps_dryerOperatingState_set_supportedMachineStates_value;
+    caps_data->set_supportedMachineStates_value_borrowed = caps_dryerOperatingState_set_supportedMachineStates_value_borrowed;
     caps_data->attr_supportedMachineStates_send = caps_dryerOperatingState_attr_supportedMachineStates_send;
     caps_data->get_machineState_value = caps_dryerOperatingState_get_machineState_value;
     caps_data->set_machineState_value = caps_dryerOperatingState_set_machineState_value;
+    caps_data->get_machineState_idx = caps_dryerOperatingState_get_machineState_idx;
+    caps_data->set_machineState_idx = caps_dryerOperatingState_set_machineState_idx;
     caps_data->attr_machineState_str2idx = caps_dryerOperatingState_attr_machineState_str2idx;
     caps_data->attr_machineState_send = caps_dryerOperatingState_attr_machineState_send;
     caps_data->get_dryerJobState_value = caps_dryerOperatingState_get_dryerJobState_value;
     caps_data->set_dryerJobState_value = caps_dryerOperatingState_set_dryerJobState_value;
+    caps_data->get_dryerJobState_idx = caps_dryerOperatingState_get_dryerJobState_idx;
+    caps_data->set_dryerJobState_idx = caps_dryerOperatingState_set_dryerJobState_idx;
     caps_data->attr_dryerJobState_str2idx = caps_dryerOperatingState_attr_dryerJobState_str2idx;
     caps_data->attr_dryerJobState_send = caps_dryerOperatingState_attr_dryerJobState_send;
+    caps_data->machineState_idx = -1;
+    caps_data->dryerJobState_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_dryerOperatingState.id, caps_dryerOperatingState_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_dryerOperatingState.id, caps_dryerOperatingState_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_dryerOperatingState.cmd_setMachineState.name, caps_dryerOperatingState_cmd_setMachineState_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_dryerOperatingState.cmd_setMachineState.name, caps_dryerOperatingState_cmd_setMachineState_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setMachineState of dryerOperatingState\n");
     }
@@ -332,3 +426,25 @@ caps_dryerOperatingState_data_t *caps_dryerOperatingState_initialize(IOT_CTX *ct
 
     return caps_data;
 }
+
+void caps_dryerOperatingState_deinitialize(caps_dryerOperatingState_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
+        for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
+            free(caps_data->supportedMachineStates_value[i]);
+        }
+        free(caps_data->supportedMachineStates_value);
+    }
+    free(caps_data);
+}
@@ -17,6 +17,7 @@
  ****************************************************************************/
 
 #include "caps/iot_caps_helper_dryerOperatingState.h"
+#include "caps_util.h"
 #include "JSON.h"
 
 #ifdef __cplusplus
@@ -28,24 +29,30 @@ typedef struct caps_dryerOperatingState_data {
     void *usr_data;
     void *cmd_data;
 
-    char *completionTime_value;
+    char completionTime_value[CAPS_UTIL_TIME_STRING_SIZE];
     char **supportedMachineStates_value;
     int supportedMachineStates_arraySize;
-    char *machineState_value;
-    char *dryerJobState_value;
+    int supportedMachineStates_borrowed;
+    int machineState_idx;
+    int dryerJobState_idx;
 
     const char *(*get_completionTime_value)(struct caps_dryerOperatingState_data *caps_data);
-    void (*set_completionTime_value)(struct caps_dryerOperatingState_data *caps_data, const char *value);
+    int (*set_completionTime_value)(struct caps_dryerOperatingState_data *caps_data, const char *value);
     void (*attr_completionTime_send)(struct caps_dryerOperatingState_data *caps_data);
     const char **(*get_supportedMachineStates_value)(struct caps_dryerOperatingState_data *caps_data);
     void (*set_supportedMachineStates_value)(struct caps_dryerOperatingState_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedMachineStates_value_borrowed)(struct caps_dryerOperatingState_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedMachineStates_send)(struct caps_dryerOperatingState_data *caps_data);
     const char *(*get_machineState_value)(struct caps_dryerOperatingState_data *caps_data);
     void (*set_machineState_value)(struct caps_dryerOperatingState_data *caps_data, const char *value);
+    int (*get_machineState_idx)(struct caps_dryerOperatingState_data *caps_data);
+    void (*set_machineState_idx)(struct caps_dryerOperatingState_data *caps_data, int idx);
     int (*attr_machineState_str2idx)(const char *value);
     void (*attr_machineState_send)(struct caps_dryerOperatingState_data *caps_data);
     const char *(*get_dryerJobState_value)(struct caps_dryerOperatingState_data *caps_data);
     void (*set_dryerJobState_value)(struct caps_dryerOperatingState_data *caps_data, const char *value);
+    int (*get_dryerJobState_idx)(struct caps_dryerOperatingState_data *caps_data);
+    void (*set_dryerJobState_idx)(struct caps_dryerOperatingState_data *caps_data, int idx);
     int (*attr_dryerJobState_str2idx)(const char *value);
     void (*attr_dryerJobState_send)(struct caps_dryerOperatingState_data *caps_data);
 
@@ -55,6 +62,7 @@ typedef struct caps_dryerOperatingState_data {
 } caps_dryerOperatingState_data_t;
 
 caps_dryerOperatingState_data_t *caps_dryerOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_dryerOperatingState_deinitialize(caps_dryerOperatingState_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
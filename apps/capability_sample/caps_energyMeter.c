@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_energyMeter.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_energyMeter_get_energy_milli(caps_energyMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_energyMeter.attr_energy.min) - 1;
+    }
+    return caps_data->energy_milli;
+}
+
+static void caps_energyMeter_set_energy_milli(caps_energyMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_energyMeter.attr_energy.min)) {
+        printf("%lld is out of range for energy\n", (long long)milli);
+        return;
+    }
+    caps_data->energy_milli = milli;
+}
 
 static double caps_energyMeter_get_energy_value(caps_energyMeter_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_energyMeter_get_energy_value(caps_energyMeter_data_t *caps_da
         printf("caps_data is NULL\n");
         return caps_helper_energyMeter.attr_energy.min - 1;
     }
-    return caps_data->energy_value;
+    return caps_util_milli_to_double(caps_data->energy_milli);
 }
 
 static void caps_energyMeter_set_energy_value(caps_energyMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->energy_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for energy\n");
+        return;
+    }
+    caps_energyMeter_set_energy_milli(caps_data, milli);
 }
 
 static const char *caps_energyMeter_get_energy_unit(caps_energyMeter_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_energyMeter_attr_energy_send(caps_energyMeter_data_t *caps_data
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_energyMeter.attr_energy.name,
-            caps_data->energy_value,
+            caps_data->energy_milli,
             caps_data->energy_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_energyMeter_attr_energy_send(caps_energyMeter_data_t *caps_data
 static void caps_energyMeter_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_energyMeter_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_energyMeter_attr_energy_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_energyMeter_data_t *caps_energyMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_energyMeter_data_t *caps_energyMeter_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_energy_value = caps_energyMeter_get_energy_value;
     caps_data->set_energy_value = caps_energyMeter_set_energy_value;
+    caps_data->get_energy_milli = caps_energyMeter_get_energy_milli;
+    caps_data->set_energy_milli = caps_energyMeter_set_energy_milli;
     caps_data->get_energy_unit = caps_energyMeter_get_energy_unit;
     caps_data->set_energy_unit = caps_energyMeter_set_energy_unit;
     caps_data->attr_energy_send = caps_energyMeter_attr_energy_send;
-    caps_data->energy_value = 0;
+    caps_data->energy_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_energyMeter.id, caps_energyMeter_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_energyMeter.id, caps_energyMeter_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init energyMeter handle\n");
@@ -120,3 +155,16 @@ caps_energyMeter_data_t *caps_energyMeter_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_energyMeter_deinitialize(caps_energyMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
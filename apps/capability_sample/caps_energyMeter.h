@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_energyMeter.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_energyMeter_data {
     void *usr_data;
     void *cmd_data;
 
-    double energy_value;
+    int64_t energy_milli;
     char *energy_unit;
 
     double (*get_energy_value)(struct caps_energyMeter_data *caps_data);
     void (*set_energy_value)(struct caps_energyMeter_data *caps_data, double value);
+    int64_t (*get_energy_milli)(struct caps_energyMeter_data *caps_data);
+    void (*set_energy_milli)(struct caps_energyMeter_data *caps_data, int64_t milli);
     const char *(*get_energy_unit)(struct caps_energyMeter_data *caps_data);
     void (*set_energy_unit)(struct caps_energyMeter_data *caps_data, const char *unit);
     void (*attr_energy_send)(struct caps_energyMeter_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_energyMeter_data {
 } caps_energyMeter_data_t;
 
 caps_energyMeter_data_t *caps_energyMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_energyMeter_deinitialize(caps_energyMeter_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
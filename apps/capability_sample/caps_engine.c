@@ -0,0 +1,565 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "st_dev.h"
+#include "caps_engine.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+
+/* the state block keeps int64_t */
+#define CAPS_ENGINE_ALIGN(size) (((size) + sizeof(int64_t) - 1) & ~(sizeof(int64_t) - 1))
+
+#define CAPS_ENGINE_VALUE(caps_data, attr_desc, type) \
+    ((type *)((caps_data)->state + (attr_desc)->offset))
+#define CAPS_ENGINE_UNIT(caps_data, attr_desc) \
+    ((const char **)((caps_data)->state + (attr_desc)->unit_offset))
+
+static const caps_engine_attr_desc_t *_get_attr(caps_engine_data_t *caps_data, int attr, int type)
+{
+    const caps_engine_attr_desc_t *attr_desc;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return NULL;
+    }
+    if (attr < 0 || attr >= caps_data->desc->attr_num) {
+        printf("%d is not an attribute of %s\n", attr, caps_data->desc->id);
+        return NULL;
+    }
+    attr_desc = &caps_data->desc->attrs[attr];
+    if (type >= 0 && attr_desc->type != type) {
+        printf("%s of %s has a different type\n", attr_desc->name, caps_data->desc->id);
+        return NULL;
+    }
+    return attr_desc;
+}
+
+static int _in_range(const caps_engine_attr_desc_t *attr_desc, int64_t milli)
+{
+    if ((attr_desc->flags & CAPS_ENGINE_ATTR_FLAG_MIN) && milli < attr_desc->min)
+        return 0;
+    if ((attr_desc->flags & CAPS_ENGINE_ATTR_FLAG_MAX) && milli > attr_desc->max)
+        return 0;
+    return 1;
+}
+
+static void _free_array(caps_engine_array_t *array)
+{
+    int i;
+
+    if (array->value && !array->borrowed) {
+        for (i = 0; i < array->size; i++) {
+            free(array->value[i]);
+        }
+        free(array->value);
+    }
+    array->value = NULL;
+    array->size = 0;
+    array->borrowed = 0;
+}
+
+int caps_engine_attr_str2idx(const caps_engine_attr_desc_t *attr, const char *value)
+{
+    int index;
+
+    if (!attr || !value)
+        return -1;
+
+    for (index = 0; index < attr->value_num; index++) {
+        if (!strcmp(value, attr->values[index])) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+const char *caps_engine_get_string(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+    int index;
+
+    if (!attr_desc)
+        return NULL;
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_ENUM:
+        index = *CAPS_ENGINE_VALUE(caps_data, attr_desc, int);
+        if (index < 0) {
+            return NULL;
+        }
+        return attr_desc->values[index];
+    case CAPS_ENGINE_ATTR_STRING:
+    case CAPS_ENGINE_ATTR_OBJECT:
+        return *CAPS_ENGINE_VALUE(caps_data, attr_desc, char *);
+    default:
+        printf("%s of %s is not a string\n", attr_desc->name, caps_data->desc->id);
+        return NULL;
+    }
+}
+
+void caps_engine_set_string(caps_engine_data_t *caps_data, int attr, const char *value)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+    char **string;
+    int index;
+
+    if (!attr_desc)
+        return;
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_ENUM:
+        index = caps_engine_attr_str2idx(attr_desc, value);
+        if (index < 0) {
+            printf("%s is not supported value for %s\n", value, attr_desc->name);
+            return;
+        }
+        *CAPS_ENGINE_VALUE(caps_data, attr_desc, int) = index;
+        break;
+    case CAPS_ENGINE_ATTR_STRING:
+    case CAPS_ENGINE_ATTR_OBJECT:
+        string = CAPS_ENGINE_VALUE(caps_data, attr_desc, char *);
+        if (*string) {
+            free(*string);
+        }
+        *string = strdup(value);
+        break;
+    default:
+        printf("%s of %s is not a string\n", attr_desc->name, caps_data->desc->id);
+        break;
+    }
+}
+
+int caps_engine_get_idx(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, CAPS_ENGINE_ATTR_ENUM);
+
+    if (!attr_desc)
+        return -1;
+    return *CAPS_ENGINE_VALUE(caps_data, attr_desc, int);
+}
+
+void caps_engine_set_idx(caps_engine_data_t *caps_data, int attr, int idx)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, CAPS_ENGINE_ATTR_ENUM);
+
+    if (!attr_desc)
+        return;
+    if (idx < 0 || idx >= attr_desc->value_num) {
+        printf("%d is not supported index for %s\n", idx, attr_desc->name);
+        return;
+    }
+    *CAPS_ENGINE_VALUE(caps_data, attr_desc, int) = idx;
+}
+
+int caps_engine_get_int(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+
+    if (!attr_desc)
+        return -1;
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_INTEGER:
+        return *CAPS_ENGINE_VALUE(caps_data, attr_desc, int);
+    case CAPS_ENGINE_ATTR_NUMBER:
+        return (int)(*CAPS_ENGINE_VALUE(caps_data, attr_desc, int64_t) / 1000);
+    default:
+        printf("%s of %s is not a number\n", attr_desc->name, caps_data->desc->id);
+        return (int)(attr_desc->min / 1000) - 1;
+    }
+}
+
+void caps_engine_set_int(caps_engine_data_t *caps_data, int attr, int value)
+{
+    caps_engine_set_milli(caps_data, attr, (int64_t)value * 1000);
+}
+
+int64_t caps_engine_get_milli(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+
+    if (!attr_desc)
+        return -1;
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_INTEGER:
+        return (int64_t)*CAPS_ENGINE_VALUE(caps_data, attr_desc, int) * 1000;
+    case CAPS_ENGINE_ATTR_NUMBER:
+        return *CAPS_ENGINE_VALUE(caps_data, attr_desc, int64_t);
+    default:
+        printf("%s of %s is not a number\n", attr_desc->name, caps_data->desc->id);
+        return attr_desc->min - 1;
+    }
+}
+
+void caps_engine_set_milli(caps_engine_data_t *caps_data, int attr, int64_t milli)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+
+    if (!attr_desc)
+        return;
+    if (!_in_range(attr_desc, milli)) {
+        printf("%lld is out of range for %s\n", (long long)milli, attr_desc->name);
+        return;
+    }
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_INTEGER:
+        if (milli / 1000 < INT_MIN || milli / 1000 > INT_MAX) {
+            printf("%lld is out of range for %s\n", (long long)milli, attr_desc->name);
+            return;
+        }
+        *CAPS_ENGINE_VALUE(caps_data, attr_desc, int) = (int)(milli / 1000);
+        break;
+    case CAPS_ENGINE_ATTR_NUMBER:
+        *CAPS_ENGINE_VALUE(caps_data, attr_desc, int64_t) = milli;
+        break;
+    default:
+        printf("%s of %s is not a number\n", attr_desc->name, caps_data->desc->id);
+        break;
+    }
+}
+
+double caps_engine_get_number(caps_engine_data_t *caps_data, int attr)
+{
+    return caps_util_milli_to_double(caps_engine_get_milli(caps_data, attr));
+}
+
+void caps_engine_set_number(caps_engine_data_t *caps_data, int attr, double value)
+{
+    int64_t milli;
+
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("%g is out of range\n", value);
+        return;
+    }
+    caps_engine_set_milli(caps_data, attr, milli);
+}
+
+const char *caps_engine_get_unit(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+
+    if (!attr_desc || !attr_desc->unit_num)
+        return NULL;
+    return *CAPS_ENGINE_UNIT(caps_data, attr_desc);
+}
+
+void caps_engine_set_unit(caps_engine_data_t *caps_data, int attr, const char *unit)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+
+    if (!attr_desc)
+        return;
+    if (!attr_desc->unit_num) {
+        printf("%s of %s has no unit\n", attr_desc->name, caps_data->desc->id);
+        return;
+    }
+    *CAPS_ENGINE_UNIT(caps_data, attr_desc) = unit;
+}
+
+const char **caps_engine_get_array(caps_engine_data_t *caps_data, int attr, int *arraySize)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, CAPS_ENGINE_ATTR_ARRAY);
+    caps_engine_array_t *array;
+
+    if (!attr_desc)
+        return NULL;
+    array = CAPS_ENGINE_VALUE(caps_data, attr_desc, caps_engine_array_t);
+    if (arraySize)
+        *arraySize = array->size;
+    return (const char **)array->value;
+}
+
+void caps_engine_set_array(caps_engine_data_t *caps_data, int attr, const char **value, int arraySize)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, CAPS_ENGINE_ATTR_ARRAY);
+    caps_engine_array_t *array;
+    int i;
+
+    if (!attr_desc)
+        return;
+    array = CAPS_ENGINE_VALUE(caps_data, attr_desc, caps_engine_array_t);
+    _free_array(array);
+
+    array->value = malloc(sizeof(char *) * arraySize);
+    if (!array->value) {
+        printf("fail to malloc for %s_value\n", attr_desc->name);
+        return;
+    }
+    for (i = 0; i < arraySize; i++) {
+        array->value[i] = strdup(value[i]);
+    }
+    array->size = arraySize;
+}
+
+void caps_engine_set_array_borrowed(caps_engine_data_t *caps_data, int attr, const char * const *value, int arraySize)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, CAPS_ENGINE_ATTR_ARRAY);
+    caps_engine_array_t *array;
+
+    if (!attr_desc)
+        return;
+    array = CAPS_ENGINE_VALUE(caps_data, attr_desc, caps_engine_array_t);
+    _free_array(array);
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    array->value = (char **)value;
+    array->size = arraySize;
+    array->borrowed = 1;
+}
+
+static void _print_sequence_no(const caps_engine_attr_desc_t *attr_desc, int sequence_no)
+{
+    if (sequence_no < 0)
+        printf("fail to send %s value\n", attr_desc->name);
+    else
+        printf("Sequence number return : %d\n", sequence_no);
+}
+
+void caps_engine_attr_send(caps_engine_data_t *caps_data, int attr)
+{
+    const caps_engine_attr_desc_t *attr_desc = _get_attr(caps_data, attr, -1);
+    caps_engine_array_t *array;
+    caps_attr_t caps_attr;
+    int sequence_no;
+    int index;
+
+    if (!attr_desc)
+        return;
+    if (!caps_data->handle) {
+        printf("fail to get handle\n");
+        return;
+    }
+
+    memset(&caps_attr, 0, sizeof(caps_attr));
+    caps_attr.handle = caps_data->handle;
+    caps_attr.name = attr_desc->name;
+
+    switch (attr_desc->type) {
+    case CAPS_ENGINE_ATTR_ENUM:
+        index = *CAPS_ENGINE_VALUE(caps_data, attr_desc, int);
+        if (index < 0) {
+            printf("value is NULL\n");
+            return;
+        }
+        caps_attr.value.type = IOT_CAP_VAL_TYPE_STRING;
+        caps_attr.value.string = (char *)attr_desc->values[index];
+        break;
+    case CAPS_ENGINE_ATTR_STRING:
+    case CAPS_ENGINE_ATTR_OBJECT:
+        caps_attr.value.type = attr_desc->type == CAPS_ENGINE_ATTR_STRING ?
+                IOT_CAP_VAL_TYPE_STRING : IOT_CAP_VAL_TYPE_JSON_OBJECT;
+        caps_attr.value.string = *CAPS_ENGINE_VALUE(caps_data, attr_desc, char *);
+        if (!caps_attr.value.string) {
+            printf("value is NULL\n");
+            return;
+        }
+        break;
+    case CAPS_ENGINE_ATTR_INTEGER:
+    case CAPS_ENGINE_ATTR_NUMBER:
+        CAPS_SEND_ATTR_MILLI(caps_data->handle,
+                attr_desc->name,
+                caps_engine_get_milli(caps_data, attr),
+                attr_desc->unit_num ? *CAPS_ENGINE_UNIT(caps_data, attr_desc) : NULL,
+                NULL,
+                sequence_no);
+        _print_sequence_no(attr_desc, sequence_no);
+        return;
+    case CAPS_ENGINE_ATTR_ARRAY:
+        array = CAPS_ENGINE_VALUE(caps_data, attr_desc, caps_engine_array_t);
+        if (!array->value) {
+            printf("value is NULL\n");
+            return;
+        }
+        caps_attr.value.type = IOT_CAP_VAL_TYPE_STR_ARRAY;
+        caps_attr.value.strings = array->value;
+        caps_attr.value.str_num = array->size;
+        break;
+    default:
+        return;
+    }
+
+    sequence_no = caps_sender_send_attrs(&caps_attr, 1);
+    _print_sequence_no(attr_desc, sequence_no);
+}
+
+static void caps_engine_cmd_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    caps_engine_cmd_ref_t *cmd_ref = usr_data;
+    caps_engine_data_t *caps_data = cmd_ref->caps_data;
+    const caps_engine_cmd_desc_t *cmd_desc = &caps_data->desc->cmds[cmd_ref->cmd];
+    const caps_engine_attr_desc_t *attr_desc;
+    iot_cap_val_t *arg = &cmd_data->cmd_data[0];
+
+    printf("called [%s] func of %s with num_args:%u\n", cmd_desc->name, caps_data->desc->id, cmd_data->num_args);
+
+    caps_data->cmd_data = cmd_data;
+    if (cmd_desc->attr == CAPS_ENGINE_NO_ATTR) {
+        if (caps_data->cmd_usr_cb)
+            caps_data->cmd_usr_cb(caps_data, cmd_ref->cmd);
+        return;
+    }
+
+    attr_desc = &caps_data->desc->attrs[cmd_desc->attr];
+    if (cmd_desc->value_idx != CAPS_ENGINE_ARG_VALUE) {
+        caps_engine_set_idx(caps_data, cmd_desc->attr, cmd_desc->value_idx);
+    } else if (!cmd_data->num_args) {
+        printf("no argument for %s\n", cmd_desc->name);
+        return;
+    } else {
+        switch (attr_desc->type) {
+        case CAPS_ENGINE_ATTR_ENUM:
+            if (caps_engine_attr_str2idx(attr_desc, arg->string) < 0) {
+                printf("%s is not supported value for %s\n", arg->string, cmd_desc->name);
+                return;
+            }
+            caps_engine_set_string(caps_data, cmd_desc->attr, arg->string);
+            break;
+        case CAPS_ENGINE_ATTR_STRING:
+            caps_engine_set_string(caps_data, cmd_desc->attr, arg->string);
+            break;
+        case CAPS_ENGINE_ATTR_INTEGER:
+            caps_engine_set_int(caps_data, cmd_desc->attr,
+                    arg->type == IOT_CAP_VAL_TYPE_NUMBER ? (int)arg->number : arg->integer);
+            break;
+        case CAPS_ENGINE_ATTR_NUMBER:
+            if (arg->type == IOT_CAP_VAL_TYPE_INTEGER)
+                caps_engine_set_milli(caps_data, cmd_desc->attr, (int64_t)arg->integer * 1000);
+            else
+                caps_engine_set_number(caps_data, cmd_desc->attr, arg->number);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (caps_data->cmd_usr_cb)
+        caps_data->cmd_usr_cb(caps_data, cmd_ref->cmd);
+    caps_engine_attr_send(caps_data, cmd_desc->attr);
+}
+
+static void caps_engine_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    caps_engine_data_t *caps_data = usr_data;
+    int attr;
+
+    caps_sender_init_cb_begin(handle);
+    if (caps_data && caps_data->init_usr_cb)
+        caps_data->init_usr_cb(caps_data);
+    for (attr = 0; caps_data && attr < caps_data->desc->attr_num; attr++) {
+        caps_engine_attr_send(caps_data, attr);
+    }
+    caps_sender_init_cb_end(handle);
+}
+
+caps_engine_data_t *caps_engine_initialize(IOT_CTX *ctx, const char *component, const caps_engine_desc_t *desc, void *init_usr_cb, void *usr_data)
+{
+    caps_engine_data_t *caps_data = NULL;
+    const caps_engine_attr_desc_t *attr_desc;
+    size_t state_offset;
+    size_t size;
+    int err;
+    int i;
+
+    if (!desc) {
+        printf("desc is NULL\n");
+        return NULL;
+    }
+
+    state_offset = CAPS_ENGINE_ALIGN(sizeof(caps_engine_data_t) + sizeof(caps_engine_cmd_ref_t) * desc->cmd_num);
+    size = state_offset + desc->state_size;
+    caps_data = malloc(size);
+    if (!caps_data) {
+        printf("fail to malloc for caps_%s_data\n", desc->id);
+        return NULL;
+    }
+
+    memset(caps_data, 0, size);
+
+    caps_data->init_usr_cb = init_usr_cb;
+    caps_data->usr_data = usr_data;
+    caps_data->desc = desc;
+    caps_data->cmd_refs = (caps_engine_cmd_ref_t *)(caps_data + 1);
+    caps_data->state = (unsigned char *)caps_data + state_offset;
+
+    for (i = 0; i < desc->attr_num; i++) {
+        attr_desc = &desc->attrs[i];
+        if (attr_desc->type == CAPS_ENGINE_ATTR_ENUM)
+            *CAPS_ENGINE_VALUE(caps_data, attr_desc, int) = -1;
+    }
+
+    if (ctx) {
+        caps_data->handle = caps_sender_handle_init(ctx, component, desc->id, caps_engine_init_cb, caps_data);
+    }
+    if (!caps_data->handle) {
+        printf("fail to init %s handle\n", desc->id);
+        return caps_data;
+    }
+
+    for (i = 0; i < desc->attr_num; i++) {
+        if (desc->attrs[i].flags & CAPS_ENGINE_ATTR_FLAG_CRITICAL)
+            caps_sender_set_priority(caps_data->handle, desc->attrs[i].name, CAPS_SEND_PRIORITY_CRITICAL);
+    }
+
+    for (i = 0; i < desc->cmd_num; i++) {
+        caps_data->cmd_refs[i].caps_data = caps_data;
+        caps_data->cmd_refs[i].cmd = i;
+        err = caps_cmd_set_cb(caps_data->handle, desc->cmds[i].name, caps_engine_cmd_cb, &caps_data->cmd_refs[i]);
+        if (err) {
+            printf("fail to set cmd_cb for %s of %s\n", desc->cmds[i].name, desc->id);
+        }
+    }
+
+    return caps_data;
+}
+
+void caps_engine_deinitialize(caps_engine_data_t *caps_data)
+{
+    const caps_engine_attr_desc_t *attr_desc;
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    for (i = 0; i < caps_data->desc->attr_num; i++) {
+        attr_desc = &caps_data->desc->attrs[i];
+        if (attr_desc->type == CAPS_ENGINE_ATTR_STRING || attr_desc->type == CAPS_ENGINE_ATTR_OBJECT) {
+            free(*CAPS_ENGINE_VALUE(caps_data, attr_desc, char *));
+        } else if (attr_desc->type == CAPS_ENGINE_ATTR_ARRAY) {
+            _free_array(CAPS_ENGINE_VALUE(caps_data, attr_desc, caps_engine_array_t));
+        }
+    }
+    free(caps_data);
+}
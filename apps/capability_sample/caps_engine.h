@@ -0,0 +1,155 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_ENGINE_H_
+#define _CAPS_ENGINE_H_
+
+#include <stdint.h>
+
+#include "st_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Table-driven capability engine.
+ *
+ * Instead of one caps_{CAPABILITY}.c per capability, a capability is described by
+ * const tables (caps_engine_desc_t) placed in flash, and this engine does get/set/
+ * send/str2idx/cmd_cb for every capability by attribute index. Values live in a
+ * state block allocated with the instance, at the offsets given by the tables.
+ *
+ * The tables and a typed facade of static inline functions are generated with
+ * tools/common/caps_generator.py --engine.
+ */
+
+typedef enum caps_engine_attr_type {
+    CAPS_ENGINE_ATTR_ENUM,          /* int, index of values */
+    CAPS_ENGINE_ATTR_STRING,        /* char * */
+    CAPS_ENGINE_ATTR_INTEGER,       /* int */
+    CAPS_ENGINE_ATTR_NUMBER,        /* int64_t, milli-units */
+    CAPS_ENGINE_ATTR_ARRAY,         /* caps_engine_array_t */
+    CAPS_ENGINE_ATTR_OBJECT,        /* char *, JSON text */
+} caps_engine_attr_type_t;
+
+#define CAPS_ENGINE_ATTR_FLAG_MIN (1 << 0)
+#define CAPS_ENGINE_ATTR_FLAG_MAX (1 << 1)
+/* sent through the priority lane of caps_sender */
+#define CAPS_ENGINE_ATTR_FLAG_CRITICAL (1 << 2)
+
+/* No attribute, for caps_engine_cmd_desc_t.attr */
+#define CAPS_ENGINE_NO_ATTR (-1)
+/* Take the value from the first argument, for caps_engine_cmd_desc_t.value_idx */
+#define CAPS_ENGINE_ARG_VALUE (-1)
+
+typedef struct caps_engine_array {
+    char **value;
+    int size;
+    int borrowed;
+} caps_engine_array_t;
+
+typedef struct caps_engine_attr_desc {
+    const char *name;
+    unsigned char type;             /* caps_engine_attr_type_t */
+    unsigned char flags;            /* CAPS_ENGINE_ATTR_FLAG_* */
+    unsigned char value_num;
+    unsigned char unit_num;
+    unsigned short offset;          /* offset of the value in the state block */
+    unsigned short unit_offset;     /* offset of the unit (const char *), if unit_num > 0 */
+    const char * const *values;     /* enum values */
+    const char * const *units;
+    int64_t min;                    /* milli-units, CAPS_UTIL_MILLI() */
+    int64_t max;
+} caps_engine_attr_desc_t;
+
+typedef struct caps_engine_cmd_desc {
+    const char *name;
+    signed char attr;               /* attribute updated by the command or CAPS_ENGINE_NO_ATTR */
+    signed char value_idx;          /* enum index set by the command or CAPS_ENGINE_ARG_VALUE */
+} caps_engine_cmd_desc_t;
+
+typedef struct caps_engine_desc {
+    const char *id;
+    const caps_engine_attr_desc_t *attrs;
+    const caps_engine_cmd_desc_t *cmds;
+    unsigned char attr_num;
+    unsigned char cmd_num;
+    unsigned short state_size;
+} caps_engine_desc_t;
+
+struct caps_engine_data;
+
+typedef struct caps_engine_cmd_ref {
+    struct caps_engine_data *caps_data;
+    int cmd;
+} caps_engine_cmd_ref_t;
+
+typedef struct caps_engine_data {
+    IOT_CAP_HANDLE* handle;
+    void *usr_data;
+    void *cmd_data;
+    const caps_engine_desc_t *desc;
+    caps_engine_cmd_ref_t *cmd_refs;
+    unsigned char *state;
+
+    void (*init_usr_cb)(struct caps_engine_data *caps_data);
+
+    /* called for every command, after the attribute is updated and before it is sent */
+    void (*cmd_usr_cb)(struct caps_engine_data *caps_data, int cmd);
+} caps_engine_data_t;
+
+/* The instance, command references and state block are allocated at once */
+caps_engine_data_t *caps_engine_initialize(IOT_CTX *ctx, const char *component, const caps_engine_desc_t *desc, void *init_usr_cb, void *usr_data);
+void caps_engine_deinitialize(caps_engine_data_t *caps_data);
+
+int caps_engine_attr_str2idx(const caps_engine_attr_desc_t *attr, const char *value);
+
+/* ENUM, STRING and OBJECT attributes */
+const char *caps_engine_get_string(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_string(caps_engine_data_t *caps_data, int attr, const char *value);
+
+/* ENUM attributes */
+int caps_engine_get_idx(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_idx(caps_engine_data_t *caps_data, int attr, int idx);
+
+/*
+ * INTEGER and NUMBER attributes. NUMBER values are kept in int64_t milli-units like the
+ * wrappers, so get/set_milli and the send path don't use floating point.
+ */
+int caps_engine_get_int(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_int(caps_engine_data_t *caps_data, int attr, int value);
+int64_t caps_engine_get_milli(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_milli(caps_engine_data_t *caps_data, int attr, int64_t milli);
+double caps_engine_get_number(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_number(caps_engine_data_t *caps_data, int attr, double value);
+const char *caps_engine_get_unit(caps_engine_data_t *caps_data, int attr);
+void caps_engine_set_unit(caps_engine_data_t *caps_data, int attr, const char *unit);
+
+/* ARRAY attributes, see set_X_value_borrowed() of the wrappers for the borrowed variant */
+const char **caps_engine_get_array(caps_engine_data_t *caps_data, int attr, int *arraySize);
+void caps_engine_set_array(caps_engine_data_t *caps_data, int attr, const char **value, int arraySize);
+void caps_engine_set_array_borrowed(caps_engine_data_t *caps_data, int attr, const char * const *value, int arraySize);
+
+void caps_engine_attr_send(caps_engine_data_t *caps_data, int attr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_ENGINE_H_ */
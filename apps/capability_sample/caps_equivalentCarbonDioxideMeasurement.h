@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_equivalentCarbonDioxideMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_equivalentCarbonDioxideMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double equivalentCarbonDioxideMeasurement_value;
+    int64_t equivalentCarbonDioxideMeasurement_milli;
     char *equivalentCarbonDioxideMeasurement_unit;
 
     double (*get_equivalentCarbonDioxideMeasurement_value)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data);
     void (*set_equivalentCarbonDioxideMeasurement_value)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data, double value);
+    int64_t (*get_equivalentCarbonDioxideMeasurement_milli)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data);
+    void (*set_equivalentCarbonDioxideMeasurement_milli)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data, int64_t milli);
     const char *(*get_equivalentCarbonDioxideMeasurement_unit)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data);
     void (*set_equivalentCarbonDioxideMeasurement_unit)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data, const char *unit);
     void (*attr_equivalentCarbonDioxideMeasurement_send)(struct caps_equivalentCarbonDioxideMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_equivalentCarbonDioxideMeasurement_data {
 } caps_equivalentCarbonDioxideMeasurement_data_t;
 
 caps_equivalentCarbonDioxideMeasurement_data_t *caps_equivalentCarbonDioxideMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_equivalentCarbonDioxideMeasurement_deinitialize(caps_equivalentCarbonDioxideMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
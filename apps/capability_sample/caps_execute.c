@@ -22,34 +22,33 @@
 
 #include "st_dev.h"
 #include "caps_execute.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
-static const JSON_H *caps_execute_get_data_value(caps_execute_data_t *caps_data)
+static const char *caps_execute_get_data_value(caps_execute_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return (const JSON_H *)caps_data->data_value;
+    return caps_data->data_value;
 }
 
-static void caps_execute_set_data_value(caps_execute_data_t *caps_data, const JSON_H *value)
+static void caps_execute_set_data_value(caps_execute_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
     if (caps_data->data_value) {
-        JSON_DELETE(caps_data->data_value);
+        free(caps_data->data_value);
     }
-    caps_data->data_value = JSON_DUPLICATE(value, true);
+    caps_data->data_value = strdup(value);
 }
 
 static void caps_execute_attr_data_send(caps_execute_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt;
-    uint8_t evt_num = 1;
     int sequence_no = -1;
-    iot_cap_val_t value;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
@@ -60,26 +59,17 @@ static void caps_execute_attr_data_send(caps_execute_data_t *caps_data)
         return;
     }
 
-    value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
-    value.json_object = JSON_PRINT(caps_data->data_value);
+    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,
+            (char *)caps_helper_execute.attr_data.name,
+            caps_data->data_value,
+            NULL,
+            NULL,
+            sequence_no);
 
-    cap_evt = st_cap_create_attr(caps_data->handle,
-        (char *)caps_helper_execute.attr_data.name,
-        &value,
-        NULL,
-        NULL);
-
-    if (!cap_evt) {
-        printf("fail to create cap_evt\n");
-        return;
-    }
-
-    sequence_no = st_cap_send_attr(&cap_evt, evt_num);
     if (sequence_no < 0)
         printf("fail to send data value\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt);
 }
 
 
@@ -98,9 +88,12 @@ static void caps_execute_cmd_execute_cb(IOT_CAP_HANDLE *handle,
 static void caps_execute_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_execute_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_execute_attr_data_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_execute_data_t *caps_execute_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -123,10 +116,10 @@ caps_execute_data_t *caps_execute_initialize(IOT_CTX *ctx, const char *component
     caps_data->set_data_value = caps_execute_set_data_value;
     caps_data->attr_data_send = caps_execute_attr_data_send;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_execute.id, caps_execute_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_execute.id, caps_execute_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_execute.cmd_execute.name, caps_execute_cmd_execute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_execute.cmd_execute.name, caps_execute_cmd_execute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for execute of execute\n");
     }
@@ -136,3 +129,18 @@ caps_execute_data_t *caps_execute_initialize(IOT_CTX *ctx, const char *component
 
     return caps_data;
 }
+
+void caps_execute_deinitialize(caps_execute_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->data_value);
+    free(caps_data);
+}
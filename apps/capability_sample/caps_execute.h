@@ -28,10 +28,10 @@ typedef struct caps_execute_data {
     void *usr_data;
     void *cmd_data;
 
-    JSON_H *data_value;
+    char *data_value;
 
-    const JSON_H *(*get_data_value)(struct caps_execute_data *caps_data);
-    void (*set_data_value)(struct caps_execute_data *caps_data, const JSON_H *value);
+    const char *(*get_data_value)(struct caps_execute_data *caps_data);
+    void (*set_data_value)(struct caps_execute_data *caps_data, const char *value);
     void (*attr_data_send)(struct caps_execute_data *caps_data);
 
     void (*init_usr_cb)(struct caps_execute_data *caps_data);
@@ -40,6 +40,7 @@ typedef struct caps_execute_data {
 } caps_execute_data_t;
 
 caps_execute_data_t *caps_execute_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_execute_deinitialize(caps_execute_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_fanOscillationMode_data {
     void *usr_data;
     void *cmd_data;
 
-    char *fanOscillationMode_value;
+    int fanOscillationMode_idx;
 
     const char *(*get_fanOscillationMode_value)(struct caps_fanOscillationMode_data *caps_data);
     void (*set_fanOscillationMode_value)(struct caps_fanOscillationMode_data *caps_data, const char *value);
+    int (*get_fanOscillationMode_idx)(struct caps_fanOscillationMode_data *caps_data);
+    void (*set_fanOscillationMode_idx)(struct caps_fanOscillationMode_data *caps_data, int idx);
     int (*attr_fanOscillationMode_str2idx)(const char *value);
     void (*attr_fanOscillationMode_send)(struct caps_fanOscillationMode_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_fanOscillationMode_data {
 } caps_fanOscillationMode_data_t;
 
 caps_fanOscillationMode_data_t *caps_fanOscillationMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_fanOscillationMode_deinitialize(caps_fanOscillationMode_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
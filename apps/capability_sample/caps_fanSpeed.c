@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_fanSpeed.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_fanSpeed_get_fanSpeed_value(caps_fanSpeed_data_t *caps_data)
 {
@@ -50,7 +52,7 @@ static void caps_fanSpeed_attr_fanSpeed_send(caps_fanSpeed_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_fanSpeed.attr_fanSpeed.name,
             caps_data->fanSpeed_value,
             NULL,
@@ -83,9 +85,12 @@ static void caps_fanSpeed_cmd_setFanSpeed_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd
 static void caps_fanSpeed_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_fanSpeed_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_fanSpeed_attr_fanSpeed_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_fanSpeed_data_t *caps_fanSpeed_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +114,10 @@ caps_fanSpeed_data_t *caps_fanSpeed_initialize(IOT_CTX *ctx, const char *compone
     caps_data->attr_fanSpeed_send = caps_fanSpeed_attr_fanSpeed_send;
     caps_data->fanSpeed_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_fanSpeed.id, caps_fanSpeed_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_fanSpeed.id, caps_fanSpeed_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_fanSpeed.cmd_setFanSpeed.name, caps_fanSpeed_cmd_setFanSpeed_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_fanSpeed.cmd_setFanSpeed.name, caps_fanSpeed_cmd_setFanSpeed_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setFanSpeed of fanSpeed\n");
     }
@@ -122,3 +127,17 @@ caps_fanSpeed_data_t *caps_fanSpeed_initialize(IOT_CTX *ctx, const char *compone
 
     return caps_data;
 }
+
+void caps_fanSpeed_deinitialize(caps_fanSpeed_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
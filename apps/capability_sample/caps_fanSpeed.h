@@ -39,6 +39,7 @@ typedef struct caps_fanSpeed_data {
 } caps_fanSpeed_data_t;
 
 caps_fanSpeed_data_t *caps_fanSpeed_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_fanSpeed_deinitialize(caps_fanSpeed_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_filterStatus_data {
     void *usr_data;
     void *cmd_data;
 
-    char *filterStatus_value;
+    int filterStatus_idx;
 
     const char *(*get_filterStatus_value)(struct caps_filterStatus_data *caps_data);
     void (*set_filterStatus_value)(struct caps_filterStatus_data *caps_data, const char *value);
+    int (*get_filterStatus_idx)(struct caps_filterStatus_data *caps_data);
+    void (*set_filterStatus_idx)(struct caps_filterStatus_data *caps_data, int idx);
     int (*attr_filterStatus_str2idx)(const char *value);
     void (*attr_filterStatus_send)(struct caps_filterStatus_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_filterStatus_data {
 } caps_filterStatus_data_t;
 
 caps_filterStatus_data_t *caps_filterStatus_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_filterStatus_deinitialize(caps_filterStatus_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
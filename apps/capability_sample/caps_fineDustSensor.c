@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_fineDustSensor.h"
+#include "caps_sender.h"
 
 static int caps_fineDustSensor_get_fineDustLevel_value(caps_fineDustSensor_data_t *caps_data)
 {
@@ -68,7 +69,7 @@ static void caps_fineDustSensor_attr_fineDustLevel_send(caps_fineDustSensor_data
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_fineDustSensor.attr_fineDustLevel.name,
             caps_data->fineDustLevel_value,
             caps_data->fineDustLevel_unit,
@@ -85,9 +86,12 @@ static void caps_fineDustSensor_attr_fineDustLevel_send(caps_fineDustSensor_data
 static void caps_fineDustSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_fineDustSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_fineDustSensor_attr_fineDustLevel_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_fineDustSensor_data_t *caps_fineDustSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -112,7 +116,7 @@ caps_fineDustSensor_data_t *caps_fineDustSensor_initialize(IOT_CTX *ctx, const c
     caps_data->attr_fineDustLevel_send = caps_fineDustSensor_attr_fineDustLevel_send;
     caps_data->fineDustLevel_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_fineDustSensor.id, caps_fineDustSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_fineDustSensor.id, caps_fineDustSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init fineDustSensor handle\n");
@@ -120,3 +124,16 @@ caps_fineDustSensor_data_t *caps_fineDustSensor_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_fineDustSensor_deinitialize(caps_fineDustSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
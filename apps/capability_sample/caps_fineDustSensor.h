@@ -40,6 +40,7 @@ typedef struct caps_fineDustSensor_data {
 } caps_fineDustSensor_data_t;
 
 caps_fineDustSensor_data_t *caps_fineDustSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_fineDustSensor_deinitialize(caps_fineDustSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
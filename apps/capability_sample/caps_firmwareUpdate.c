@@ -22,6 +22,9 @@
 
 #include "st_dev.h"
 #include "caps_firmwareUpdate.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+#include "caps_cmd.h"
 
 static int caps_firmwareUpdate_attr_lastUpdateStatus_str2idx(const char *value)
 {
@@ -41,19 +44,52 @@ static const char *caps_firmwareUpdate_get_lastUpdateStatus_value(caps_firmwareU
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->lastUpdateStatus_value;
+    if (caps_data->lastUpdateStatus_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_firmwareUpdate.attr_lastUpdateStatus.values[caps_data->lastUpdateStatus_idx];
 }
 
 static void caps_firmwareUpdate_set_lastUpdateStatus_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_firmwareUpdate_attr_lastUpdateStatus_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for lastUpdateStatus\n", value);
+        return;
+    }
+    caps_data->lastUpdateStatus_idx = index;
+}
+
+static int caps_firmwareUpdate_get_lastUpdateStatus_idx(caps_firmwareUpdate_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->lastUpdateStatus_idx;
+}
+
+static void caps_firmwareUpdate_set_lastUpdateStatus_idx(caps_firmwareUpdate_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->lastUpdateStatus_value) {
-        free(caps_data->lastUpdateStatus_value);
+    if (idx < 0 || idx >= CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_MAX) {
+        printf("%d is not supported index for lastUpdateStatus\n", idx);
+        return;
     }
-    caps_data->lastUpdateStatus_value = strdup(value);
+    caps_data->lastUpdateStatus_idx = idx;
 }
 
 static void caps_firmwareUpdate_attr_lastUpdateStatus_send(caps_firmwareUpdate_data_t *caps_data)
@@ -64,14 +100,14 @@ static void caps_firmwareUpdate_attr_lastUpdateStatus_send(caps_firmwareUpdate_d
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->lastUpdateStatus_value) {
+    if (caps_data->lastUpdateStatus_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_lastUpdateStatus.name,
-            caps_data->lastUpdateStatus_value,
+            (char *)caps_helper_firmwareUpdate.attr_lastUpdateStatus.values[caps_data->lastUpdateStatus_idx],
             NULL,
             NULL,
             sequence_no);
@@ -102,19 +138,52 @@ static const char *caps_firmwareUpdate_get_state_value(caps_firmwareUpdate_data_
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->state_value;
+    if (caps_data->state_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_firmwareUpdate.attr_state.values[caps_data->state_idx];
 }
 
 static void caps_firmwareUpdate_set_state_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->state_value) {
-        free(caps_data->state_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_firmwareUpdate_attr_state_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for state\n", value);
+        return;
     }
-    caps_data->state_value = strdup(value);
+    caps_data->state_idx = index;
+}
+
+static int caps_firmwareUpdate_get_state_idx(caps_firmwareUpdate_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->state_idx;
+}
+
+static void caps_firmwareUpdate_set_state_idx(caps_firmwareUpdate_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_MAX) {
+        printf("%d is not supported index for state\n", idx);
+        return;
+    }
+    caps_data->state_idx = idx;
 }
 
 static void caps_firmwareUpdate_attr_state_send(caps_firmwareUpdate_data_t *caps_data)
@@ -125,14 +194,14 @@ static void caps_firmwareUpdate_attr_state_send(caps_firmwareUpdate_data_t *caps
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->state_value) {
+    if (caps_data->state_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_state.name,
-            caps_data->state_value,
+            (char *)caps_helper_firmwareUpdate.attr_state.values[caps_data->state_idx],
             NULL,
             NULL,
             sequence_no);
@@ -151,19 +220,16 @@ static const char *caps_firmwareUpdate_get_currentVersion_value(caps_firmwareUpd
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->currentVersion_value;
+    return caps_data->currentVersion_value[0] ? caps_data->currentVersion_value : NULL;
 }
 
-static void caps_firmwareUpdate_set_currentVersion_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
+static int caps_firmwareUpdate_set_currentVersion_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
-    }
-    if (caps_data->currentVersion_value) {
-        free(caps_data->currentVersion_value);
+        return -1;
     }
-    caps_data->currentVersion_value = strdup(value);
+    return caps_util_copy_string(caps_data->currentVersion_value, sizeof(caps_data->currentVersion_value), value);
 }
 
 static void caps_firmwareUpdate_attr_currentVersion_send(caps_firmwareUpdate_data_t *caps_data)
@@ -174,12 +240,12 @@ static void caps_firmwareUpdate_attr_currentVersion_send(caps_firmwareUpdate_dat
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->currentVersion_value) {
+    if (!caps_data->currentVersion_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_currentVersion.name,
             caps_data->currentVersion_value,
             NULL,
@@ -199,19 +265,16 @@ static const char *caps_firmwareUpdate_get_lastUpdateTime_value(caps_firmwareUpd
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->lastUpdateTime_value;
+    return caps_data->lastUpdateTime_value[0] ? caps_data->lastUpdateTime_value : NULL;
 }
 
-static void caps_firmwareUpdate_set_lastUpdateTime_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
+static int caps_firmwareUpdate_set_lastUpdateTime_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
-    }
-    if (caps_data->lastUpdateTime_value) {
-        free(caps_data->lastUpdateTime_value);
+        return -1;
     }
-    caps_data->lastUpdateTime_value = strdup(value);
+    return caps_util_copy_string(caps_data->lastUpdateTime_value, sizeof(caps_data->lastUpdateTime_value), value);
 }
 
 static void caps_firmwareUpdate_attr_lastUpdateTime_send(caps_firmwareUpdate_data_t *caps_data)
@@ -222,12 +285,12 @@ static void caps_firmwareUpdate_attr_lastUpdateTime_send(caps_firmwareUpdate_dat
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->lastUpdateTime_value) {
+    if (!caps_data->lastUpdateTime_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_lastUpdateTime.name,
             caps_data->lastUpdateTime_value,
             NULL,
@@ -247,19 +310,16 @@ static const char *caps_firmwareUpdate_get_availableVersion_value(caps_firmwareU
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->availableVersion_value;
+    return caps_data->availableVersion_value[0] ? caps_data->availableVersion_value : NULL;
 }
 
-static void caps_firmwareUpdate_set_availableVersion_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
+static int caps_firmwareUpdate_set_availableVersion_value(caps_firmwareUpdate_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
-    }
-    if (caps_data->availableVersion_value) {
-        free(caps_data->availableVersion_value);
+        return -1;
     }
-    caps_data->availableVersion_value = strdup(value);
+    return caps_util_copy_string(caps_data->availableVersion_value, sizeof(caps_data->availableVersion_value), value);
 }
 
 static void caps_firmwareUpdate_attr_availableVersion_send(caps_firmwareUpdate_data_t *caps_data)
@@ -270,12 +330,12 @@ static void caps_firmwareUpdate_attr_availableVersion_send(caps_firmwareUpdate_d
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->availableVersion_value) {
+    if (!caps_data->availableVersion_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_availableVersion.name,
             caps_data->availableVersion_value,
             NULL,
@@ -323,7 +383,7 @@ static void caps_firmwareUpdate_attr_lastUpdateStatusReason_send(caps_firmwareUp
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_firmwareUpdate.attr_lastUpdateStatusReason.name,
             caps_data->lastUpdateStatusReason_value,
             NULL,
@@ -360,6 +420,8 @@ static void caps_firmwareUpdate_cmd_updateFirmware_cb(IOT_CAP_HANDLE *handle, io
 static void caps_firmwareUpdate_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_firmwareUpdate_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_firmwareUpdate_attr_lastUpdateStatus_send(caps_data);
@@ -368,6 +430,7 @@ static void caps_firmwareUpdate_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
     caps_firmwareUpdate_attr_lastUpdateTime_send(caps_data);
     caps_firmwareUpdate_attr_availableVersion_send(caps_data);
     caps_firmwareUpdate_attr_lastUpdateStatusReason_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_firmwareUpdate_data_t *caps_firmwareUpdate_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -388,10 +451,14 @@ caps_firmwareUpdate_data_t *caps_firmwareUpdate_initialize(IOT_CTX *ctx, const c
 
     caps_data->get_lastUpdateStatus_value = caps_firmwareUpdate_get_lastUpdateStatus_value;
     caps_data->set_lastUpdateStatus_value = caps_firmwareUpdate_set_lastUpdateStatus_value;
+    caps_data->get_lastUpdateStatus_idx = caps_firmwareUpdate_get_lastUpdateStatus_idx;
+    caps_data->set_lastUpdateStatus_idx = caps_firmwareUpdate_set_lastUpdateStatus_idx;
     caps_data->attr_lastUpdateStatus_str2idx = caps_firmwareUpdate_attr_lastUpdateStatus_str2idx;
     caps_data->attr_lastUpdateStatus_send = caps_firmwareUpdate_attr_lastUpdateStatus_send;
     caps_data->get_state_value = caps_firmwareUpdate_get_state_value;
     caps_data->set_state_value = caps_firmwareUpdate_set_state_value;
+    caps_data->get_state_idx = caps_firmwareUpdate_get_state_idx;
+    caps_data->set_state_idx = caps_firmwareUpdate_set_state_idx;
     caps_data->attr_state_str2idx = caps_firmwareUpdate_attr_state_str2idx;
     caps_data->attr_state_send = caps_firmwareUpdate_attr_state_send;
     caps_data->get_currentVersion_value = caps_firmwareUpdate_get_currentVersion_value;
@@ -406,15 +473,17 @@ caps_firmwareUpdate_data_t *caps_firmwareUpdate_initialize(IOT_CTX *ctx, const c
     caps_data->get_lastUpdateStatusReason_value = caps_firmwareUpdate_get_lastUpdateStatusReason_value;
     caps_data->set_lastUpdateStatusReason_value = caps_firmwareUpdate_set_lastUpdateStatusReason_value;
     caps_data->attr_lastUpdateStatusReason_send = caps_firmwareUpdate_attr_lastUpdateStatusReason_send;
+    caps_data->lastUpdateStatus_idx = -1;
+    caps_data->state_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_firmwareUpdate.id, caps_firmwareUpdate_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_firmwareUpdate.id, caps_firmwareUpdate_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_firmwareUpdate.cmd_checkForFirmwareUpdate.name, caps_firmwareUpdate_cmd_checkForFirmwareUpdate_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_firmwareUpdate.cmd_checkForFirmwareUpdate.name, caps_firmwareUpdate_cmd_checkForFirmwareUpdate_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for checkForFirmwareUpdate of firmwareUpdate\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_firmwareUpdate.cmd_updateFirmware.name, caps_firmwareUpdate_cmd_updateFirmware_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_firmwareUpdate.cmd_updateFirmware.name, caps_firmwareUpdate_cmd_updateFirmware_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for updateFirmware of firmwareUpdate\n");
     }
@@ -424,3 +493,18 @@ caps_firmwareUpdate_data_t *caps_firmwareUpdate_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_firmwareUpdate_deinitialize(caps_firmwareUpdate_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->lastUpdateStatusReason_value);
+    free(caps_data);
+}
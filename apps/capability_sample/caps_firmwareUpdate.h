@@ -17,39 +17,49 @@
  ****************************************************************************/
 
 #include "caps/iot_caps_helper_firmwareUpdate.h"
+#include "caps_util.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Longest version string kept, including the terminator */
+#ifndef CAPS_FIRMWAREUPDATE_VERSION_SIZE
+#define CAPS_FIRMWAREUPDATE_VERSION_SIZE 32
+#endif
+
 typedef struct caps_firmwareUpdate_data {
     IOT_CAP_HANDLE* handle;
     void *usr_data;
     void *cmd_data;
 
-    char *lastUpdateStatus_value;
-    char *state_value;
-    char *currentVersion_value;
-    char *lastUpdateTime_value;
-    char *availableVersion_value;
+    int lastUpdateStatus_idx;
+    int state_idx;
+    char currentVersion_value[CAPS_FIRMWAREUPDATE_VERSION_SIZE];
+    char lastUpdateTime_value[CAPS_UTIL_TIME_STRING_SIZE];
+    char availableVersion_value[CAPS_FIRMWAREUPDATE_VERSION_SIZE];
     char *lastUpdateStatusReason_value;
 
     const char *(*get_lastUpdateStatus_value)(struct caps_firmwareUpdate_data *caps_data);
     void (*set_lastUpdateStatus_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
+    int (*get_lastUpdateStatus_idx)(struct caps_firmwareUpdate_data *caps_data);
+    void (*set_lastUpdateStatus_idx)(struct caps_firmwareUpdate_data *caps_data, int idx);
     int (*attr_lastUpdateStatus_str2idx)(const char *value);
     void (*attr_lastUpdateStatus_send)(struct caps_firmwareUpdate_data *caps_data);
     const char *(*get_state_value)(struct caps_firmwareUpdate_data *caps_data);
     void (*set_state_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
+    int (*get_state_idx)(struct caps_firmwareUpdate_data *caps_data);
+    void (*set_state_idx)(struct caps_firmwareUpdate_data *caps_data, int idx);
     int (*attr_state_str2idx)(const char *value);
     void (*attr_state_send)(struct caps_firmwareUpdate_data *caps_data);
     const char *(*get_currentVersion_value)(struct caps_firmwareUpdate_data *caps_data);
-    void (*set_currentVersion_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
+    int (*set_currentVersion_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
     void (*attr_currentVersion_send)(struct caps_firmwareUpdate_data *caps_data);
     const char *(*get_lastUpdateTime_value)(struct caps_firmwareUpdate_data *caps_data);
-    void (*set_lastUpdateTime_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
+    int (*set_lastUpdateTime_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
     void (*attr_lastUpdateTime_send)(struct caps_firmwareUpdate_data *caps_data);
     const char *(*get_availableVersion_value)(struct caps_firmwareUpdate_data *caps_data);
-    void (*set_availableVersion_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
+    int (*set_availableVersion_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
     void (*attr_availableVersion_send)(struct caps_firmwareUpdate_data *caps_data);
     const char *(*get_lastUpdateStatusReason_value)(struct caps_firmwareUpdate_data *caps_data);
     void (*set_lastUpdateStatusReason_value)(struct caps_firmwareUpdate_data *caps_data, const char *value);
@@ -62,6 +72,7 @@ typedef struct caps_firmwareUpdate_data {
 } caps_firmwareUpdate_data_t;
 
 caps_firmwareUpdate_data_t *caps_firmwareUpdate_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_firmwareUpdate_deinitialize(caps_firmwareUpdate_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_formaldehydeMeasurement.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_formaldehydeMeasurement_get_formaldehydeLevel_milli(caps_formaldehydeMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_formaldehydeMeasurement.attr_formaldehydeLevel.min) - 1;
+    }
+    return caps_data->formaldehydeLevel_milli;
+}
+
+static void caps_formaldehydeMeasurement_set_formaldehydeLevel_milli(caps_formaldehydeMeasurement_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_formaldehydeMeasurement.attr_formaldehydeLevel.min)) {
+        printf("%lld is out of range for formaldehydeLevel\n", (long long)milli);
+        return;
+    }
+    caps_data->formaldehydeLevel_milli = milli;
+}
 
 static double caps_formaldehydeMeasurement_get_formaldehydeLevel_value(caps_formaldehydeMeasurement_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_formaldehydeMeasurement_get_formaldehydeLevel_value(caps_form
         printf("caps_data is NULL\n");
         return caps_helper_formaldehydeMeasurement.attr_formaldehydeLevel.min - 1;
     }
-    return caps_data->formaldehydeLevel_value;
+    return caps_util_milli_to_double(caps_data->formaldehydeLevel_milli);
 }
 
 static void caps_formaldehydeMeasurement_set_formaldehydeLevel_value(caps_formaldehydeMeasurement_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->formaldehydeLevel_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for formaldehydeLevel\n");
+        return;
+    }
+    caps_formaldehydeMeasurement_set_formaldehydeLevel_milli(caps_data, milli);
 }
 
 static const char *caps_formaldehydeMeasurement_get_formaldehydeLevel_unit(caps_formaldehydeMeasurement_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_formaldehydeMeasurement_attr_formaldehydeLevel_send(caps_formal
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_formaldehydeMeasurement.attr_formaldehydeLevel.name,
-            caps_data->formaldehydeLevel_value,
+            caps_data->formaldehydeLevel_milli,
             caps_data->formaldehydeLevel_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_formaldehydeMeasurement_attr_formaldehydeLevel_send(caps_formal
 static void caps_formaldehydeMeasurement_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_formaldehydeMeasurement_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_formaldehydeMeasurement_attr_formaldehydeLevel_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_formaldehydeMeasurement_data_t *caps_formaldehydeMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_formaldehydeMeasurement_data_t *caps_formaldehydeMeasurement_initialize(IOT
 
     caps_data->get_formaldehydeLevel_value = caps_formaldehydeMeasurement_get_formaldehydeLevel_value;
     caps_data->set_formaldehydeLevel_value = caps_formaldehydeMeasurement_set_formaldehydeLevel_value;
+    caps_data->get_formaldehydeLevel_milli = caps_formaldehydeMeasurement_get_formaldehydeLevel_milli;
+    caps_data->set_formaldehydeLevel_milli = caps_formaldehydeMeasurement_set_formaldehydeLevel_milli;
     caps_data->get_formaldehydeLevel_unit = caps_formaldehydeMeasurement_get_formaldehydeLevel_unit;
     caps_data->set_formaldehydeLevel_unit = caps_formaldehydeMeasurement_set_formaldehydeLevel_unit;
     caps_data->attr_formaldehydeLevel_send = caps_formaldehydeMeasurement_attr_formaldehydeLevel_send;
-    caps_data->formaldehydeLevel_value = 0;
+    caps_data->formaldehydeLevel_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_formaldehydeMeasurement.id, caps_formaldehydeMeasurement_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_formaldehydeMeasurement.id, caps_formaldehydeMeasurement_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init formaldehydeMeasurement handle\n");
@@ -120,3 +155,16 @@ caps_formaldehydeMeasurement_data_t *caps_formaldehydeMeasurement_initialize(IOT
 
     return caps_data;
 }
+
+void caps_formaldehydeMeasurement_deinitialize(caps_formaldehydeMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_formaldehydeMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_formaldehydeMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double formaldehydeLevel_value;
+    int64_t formaldehydeLevel_milli;
     char *formaldehydeLevel_unit;
 
     double (*get_formaldehydeLevel_value)(struct caps_formaldehydeMeasurement_data *caps_data);
     void (*set_formaldehydeLevel_value)(struct caps_formaldehydeMeasurement_data *caps_data, double value);
+    int64_t (*get_formaldehydeLevel_milli)(struct caps_formaldehydeMeasurement_data *caps_data);
+    void (*set_formaldehydeLevel_milli)(struct caps_formaldehydeMeasurement_data *caps_data, int64_t milli);
     const char *(*get_formaldehydeLevel_unit)(struct caps_formaldehydeMeasurement_data *caps_data);
     void (*set_formaldehydeLevel_unit)(struct caps_formaldehydeMeasurement_data *caps_data, const char *unit);
     void (*attr_formaldehydeLevel_send)(struct caps_formaldehydeMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_formaldehydeMeasurement_data {
 } caps_formaldehydeMeasurement_data_t;
 
 caps_formaldehydeMeasurement_data_t *caps_formaldehydeMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_formaldehydeMeasurement_deinitialize(caps_formaldehydeMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_garageDoorControl_data {
     void *usr_data;
     void *cmd_data;
 
-    char *door_value;
+    int door_idx;
 
     const char *(*get_door_value)(struct caps_garageDoorControl_data *caps_data);
     void (*set_door_value)(struct caps_garageDoorControl_data *caps_data, const char *value);
+    int (*get_door_idx)(struct caps_garageDoorControl_data *caps_data);
+    void (*set_door_idx)(struct caps_garageDoorControl_data *caps_data, int idx);
     int (*attr_door_str2idx)(const char *value);
     void (*attr_door_send)(struct caps_garageDoorControl_data *caps_data);
 
@@ -41,6 +43,7 @@ typedef struct caps_garageDoorControl_data {
 } caps_garageDoorControl_data_t;
 
 caps_garageDoorControl_data_t *caps_garageDoorControl_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_garageDoorControl_deinitialize(caps_garageDoorControl_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
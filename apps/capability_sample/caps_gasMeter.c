@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_gasMeter.h"
+#include "caps_sender.h"
+#include "caps_util.h"
 
 static const char *caps_gasMeter_get_gasMeterTime_value(caps_gasMeter_data_t *caps_data)
 {
@@ -29,19 +31,16 @@ static const char *caps_gasMeter_get_gasMeterTime_value(caps_gasMeter_data_t *ca
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->gasMeterTime_value;
+    return caps_data->gasMeterTime_value[0] ? caps_data->gasMeterTime_value : NULL;
 }
 
-static void caps_gasMeter_set_gasMeterTime_value(caps_gasMeter_data_t *caps_data, const char *value)
+static int caps_gasMeter_set_gasMeterTime_value(caps_gasMeter_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
-    }
-    if (caps_data->gasMeterTime_value) {
-        free(caps_data->gasMeterTime_value);
+        return -1;
     }
-    caps_data->gasMeterTime_value = strdup(value);
+    return caps_util_copy_string(caps_data->gasMeterTime_value, sizeof(caps_data->gasMeterTime_value), value);
 }
 
 static void caps_gasMeter_attr_gasMeterTime_send(caps_gasMeter_data_t *caps_data)
@@ -52,12 +51,12 @@ static void caps_gasMeter_attr_gasMeterTime_send(caps_gasMeter_data_t *caps_data
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->gasMeterTime_value) {
+    if (!caps_data->gasMeterTime_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_gasMeter.attr_gasMeterTime.name,
             caps_data->gasMeterTime_value,
             NULL,
@@ -71,22 +70,50 @@ static void caps_gasMeter_attr_gasMeterTime_send(caps_gasMeter_data_t *caps_data
 }
 
 
+static int64_t caps_gasMeter_get_gasMeter_milli(caps_gasMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeter.min) - 1;
+    }
+    return caps_data->gasMeter_milli;
+}
+
+static void caps_gasMeter_set_gasMeter_milli(caps_gasMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeter.min)) {
+        printf("%lld is out of range for gasMeter\n", (long long)milli);
+        return;
+    }
+    caps_data->gasMeter_milli = milli;
+}
+
 static double caps_gasMeter_get_gasMeter_value(caps_gasMeter_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_gasMeter.attr_gasMeter.min - 1;
     }
-    return caps_data->gasMeter_value;
+    return caps_util_milli_to_double(caps_data->gasMeter_milli);
 }
 
 static void caps_gasMeter_set_gasMeter_value(caps_gasMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->gasMeter_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for gasMeter\n");
+        return;
+    }
+    caps_gasMeter_set_gasMeter_milli(caps_data, milli);
 }
 
 static const char *caps_gasMeter_get_gasMeter_unit(caps_gasMeter_data_t *caps_data)
@@ -116,9 +143,9 @@ static void caps_gasMeter_attr_gasMeter_send(caps_gasMeter_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_gasMeter.attr_gasMeter.name,
-            caps_data->gasMeter_value,
+            caps_data->gasMeter_milli,
             caps_data->gasMeter_unit,
             NULL,
             sequence_no);
@@ -130,22 +157,50 @@ static void caps_gasMeter_attr_gasMeter_send(caps_gasMeter_data_t *caps_data)
 }
 
 
+static int64_t caps_gasMeter_get_gasMeterCalorific_milli(caps_gasMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterCalorific.min) - 1;
+    }
+    return caps_data->gasMeterCalorific_milli;
+}
+
+static void caps_gasMeter_set_gasMeterCalorific_milli(caps_gasMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterCalorific.min)) {
+        printf("%lld is out of range for gasMeterCalorific\n", (long long)milli);
+        return;
+    }
+    caps_data->gasMeterCalorific_milli = milli;
+}
+
 static double caps_gasMeter_get_gasMeterCalorific_value(caps_gasMeter_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_gasMeter.attr_gasMeterCalorific.min - 1;
     }
-    return caps_data->gasMeterCalorific_value;
+    return caps_util_milli_to_double(caps_data->gasMeterCalorific_milli);
 }
 
 static void caps_gasMeter_set_gasMeterCalorific_value(caps_gasMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->gasMeterCalorific_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for gasMeterCalorific\n");
+        return;
+    }
+    caps_gasMeter_set_gasMeterCalorific_milli(caps_data, milli);
 }
 
 static void caps_gasMeter_attr_gasMeterCalorific_send(caps_gasMeter_data_t *caps_data)
@@ -157,9 +212,9 @@ static void caps_gasMeter_attr_gasMeterCalorific_send(caps_gasMeter_data_t *caps
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_gasMeter.attr_gasMeterCalorific.name,
-            caps_data->gasMeterCalorific_value,
+            caps_data->gasMeterCalorific_milli,
             NULL,
             NULL,
             sequence_no);
@@ -171,22 +226,50 @@ static void caps_gasMeter_attr_gasMeterCalorific_send(caps_gasMeter_data_t *caps
 }
 
 
+static int64_t caps_gasMeter_get_gasMeterVolume_milli(caps_gasMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterVolume.min) - 1;
+    }
+    return caps_data->gasMeterVolume_milli;
+}
+
+static void caps_gasMeter_set_gasMeterVolume_milli(caps_gasMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterVolume.min)) {
+        printf("%lld is out of range for gasMeterVolume\n", (long long)milli);
+        return;
+    }
+    caps_data->gasMeterVolume_milli = milli;
+}
+
 static double caps_gasMeter_get_gasMeterVolume_value(caps_gasMeter_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_gasMeter.attr_gasMeterVolume.min - 1;
     }
-    return caps_data->gasMeterVolume_value;
+    return caps_util_milli_to_double(caps_data->gasMeterVolume_milli);
 }
 
 static void caps_gasMeter_set_gasMeterVolume_value(caps_gasMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->gasMeterVolume_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for gasMeterVolume\n");
+        return;
+    }
+    caps_gasMeter_set_gasMeterVolume_milli(caps_data, milli);
 }
 
 static const char *caps_gasMeter_get_gasMeterVolume_unit(caps_gasMeter_data_t *caps_data)
@@ -216,9 +299,9 @@ static void caps_gasMeter_attr_gasMeterVolume_send(caps_gasMeter_data_t *caps_da
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_gasMeter.attr_gasMeterVolume.name,
-            caps_data->gasMeterVolume_value,
+            caps_data->gasMeterVolume_milli,
             caps_data->gasMeterVolume_unit,
             NULL,
             sequence_no);
@@ -230,33 +313,30 @@ static void caps_gasMeter_attr_gasMeterVolume_send(caps_gasMeter_data_t *caps_da
 }
 
 
-static const JSON_H *caps_gasMeter_get_gasMeterPrecision_value(caps_gasMeter_data_t *caps_data)
+static const char *caps_gasMeter_get_gasMeterPrecision_value(caps_gasMeter_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return (const JSON_H *)caps_data->gasMeterPrecision_value;
+    return caps_data->gasMeterPrecision_value;
 }
 
-static void caps_gasMeter_set_gasMeterPrecision_value(caps_gasMeter_data_t *caps_data, const JSON_H *value)
+static void caps_gasMeter_set_gasMeterPrecision_value(caps_gasMeter_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
     if (caps_data->gasMeterPrecision_value) {
-        JSON_DELETE(caps_data->gasMeterPrecision_value);
+        free(caps_data->gasMeterPrecision_value);
     }
-    caps_data->gasMeterPrecision_value = JSON_DUPLICATE(value, true);
+    caps_data->gasMeterPrecision_value = strdup(value);
 }
 
 static void caps_gasMeter_attr_gasMeterPrecision_send(caps_gasMeter_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt;
-    uint8_t evt_num = 1;
     int sequence_no = -1;
-    iot_cap_val_t value;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
@@ -267,45 +347,64 @@ static void caps_gasMeter_attr_gasMeterPrecision_send(caps_gasMeter_data_t *caps
         return;
     }
 
-    value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
-    value.json_object = JSON_PRINT(caps_data->gasMeterPrecision_value);
-
-    cap_evt = st_cap_create_attr(caps_data->handle,
-        (char *)caps_helper_gasMeter.attr_gasMeterPrecision.name,
-        &value,
-        NULL,
-        NULL);
-
-    if (!cap_evt) {
-        printf("fail to create cap_evt\n");
-        return;
-    }
+    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,
+            (char *)caps_helper_gasMeter.attr_gasMeterPrecision.name,
+            caps_data->gasMeterPrecision_value,
+            NULL,
+            NULL,
+            sequence_no);
 
-    sequence_no = st_cap_send_attr(&cap_evt, evt_num);
     if (sequence_no < 0)
         printf("fail to send gasMeterPrecision value\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt);
 }
 
 
+static int64_t caps_gasMeter_get_gasMeterConversion_milli(caps_gasMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterConversion.min) - 1;
+    }
+    return caps_data->gasMeterConversion_milli;
+}
+
+static void caps_gasMeter_set_gasMeterConversion_milli(caps_gasMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_gasMeter.attr_gasMeterConversion.min)) {
+        printf("%lld is out of range for gasMeterConversion\n", (long long)milli);
+        return;
+    }
+    caps_data->gasMeterConversion_milli = milli;
+}
+
 static double caps_gasMeter_get_gasMeterConversion_value(caps_gasMeter_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return caps_helper_gasMeter.attr_gasMeterConversion.min - 1;
     }
-    return caps_data->gasMeterConversion_value;
+    return caps_util_milli_to_double(caps_data->gasMeterConversion_milli);
 }
 
 static void caps_gasMeter_set_gasMeterConversion_value(caps_gasMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->gasMeterConversion_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for gasMeterConversion\n");
+        return;
+    }
+    caps_gasMeter_set_gasMeterConversion_milli(caps_data, milli);
 }
 
 static void caps_gasMeter_attr_gasMeterConversion_send(caps_gasMeter_data_t *caps_data)
@@ -317,9 +416,9 @@ static void caps_gasMeter_attr_gasMeterConversion_send(caps_gasMeter_data_t *cap
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_gasMeter.attr_gasMeterConversion.name,
-            caps_data->gasMeterConversion_value,
+            caps_data->gasMeterConversion_milli,
             NULL,
             NULL,
             sequence_no);
@@ -334,6 +433,8 @@ static void caps_gasMeter_attr_gasMeterConversion_send(caps_gasMeter_data_t *cap
 static void caps_gasMeter_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_gasMeter_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_gasMeter_attr_gasMeterTime_send(caps_data);
@@ -342,6 +443,7 @@ static void caps_gasMeter_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
     caps_gasMeter_attr_gasMeterVolume_send(caps_data);
     caps_gasMeter_attr_gasMeterPrecision_send(caps_data);
     caps_gasMeter_attr_gasMeterConversion_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_gasMeter_data_t *caps_gasMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -364,14 +466,20 @@ caps_gasMeter_data_t *caps_gasMeter_initialize(IOT_CTX *ctx, const char *compone
     caps_data->attr_gasMeterTime_send = caps_gasMeter_attr_gasMeterTime_send;
     caps_data->get_gasMeter_value = caps_gasMeter_get_gasMeter_value;
     caps_data->set_gasMeter_value = caps_gasMeter_set_gasMeter_value;
+    caps_data->get_gasMeter_milli = caps_gasMeter_get_gasMeter_milli;
+    caps_data->set_gasMeter_milli = caps_gasMeter_set_gasMeter_milli;
     caps_data->get_gasMeter_unit = caps_gasMeter_get_gasMeter_unit;
     caps_data->set_gasMeter_unit = caps_gasMeter_set_gasMeter_unit;
     caps_data->attr_gasMeter_send = caps_gasMeter_attr_gasMeter_send;
     caps_data->get_gasMeterCalorific_value = caps_gasMeter_get_gasMeterCalorific_value;
     caps_data->set_gasMeterCalorific_value = caps_gasMeter_set_gasMeterCalorific_value;
+    caps_data->get_gasMeterCalorific_milli = caps_gasMeter_get_gasMeterCalorific_milli;
+    caps_data->set_gasMeterCalorific_milli = caps_gasMeter_set_gasMeterCalorific_milli;
     caps_data->attr_gasMeterCalorific_send = caps_gasMeter_attr_gasMeterCalorific_send;
     caps_data->get_gasMeterVolume_value = caps_gasMeter_get_gasMeterVolume_value;
     caps_data->set_gasMeterVolume_value = caps_gasMeter_set_gasMeterVolume_value;
+    caps_data->get_gasMeterVolume_milli = caps_gasMeter_get_gasMeterVolume_milli;
+    caps_data->set_gasMeterVolume_milli = caps_gasMeter_set_gasMeterVolume_milli;
     caps_data->get_gasMeterVolume_unit = caps_gasMeter_get_gasMeterVolume_unit;
     caps_data->set_gasMeterVolume_unit = caps_gasMeter_set_gasMeterVolume_unit;
     caps_data->attr_gasMeterVolume_send = caps_gasMeter_attr_gasMeterVolume_send;
@@ -380,13 +488,15 @@ caps_gasMeter_data_t *caps_gasMeter_initialize(IOT_CTX *ctx, const char *compone
     caps_data->attr_gasMeterPrecision_send = caps_gasMeter_attr_gasMeterPrecision_send;
     caps_data->get_gasMeterConversion_value = caps_gasMeter_get_gasMeterConversion_value;
     caps_data->set_gasMeterConversion_value = caps_gasMeter_set_gasMeterConversion_value;
+    caps_data->get_gasMeterConversion_milli = caps_gasMeter_get_gasMeterConversion_milli;
+    caps_data->set_gasMeterConversion_milli = caps_gasMeter_set_gasMeterConversion_milli;
     caps_data->attr_gasMeterConversion_send = caps_gasMeter_attr_gasMeterConversion_send;
-    caps_data->gasMeter_value = 0;
-    caps_data->gasMeterCalorific_value = 0;
-    caps_data->gasMeterVolume_value = 0;
-    caps_data->gasMeterConversion_value = 0;
+    caps_data->gasMeter_milli = CAPS_UTIL_MILLI(0);
+    caps_data->gasMeterCalorific_milli = CAPS_UTIL_MILLI(0);
+    caps_data->gasMeterVolume_milli = CAPS_UTIL_MILLI(0);
+    caps_data->gasMeterConversion_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_gasMeter.id, caps_gasMeter_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_gasMeter.id, caps_gasMeter_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init gasMeter handle\n");
@@ -394,3 +504,17 @@ caps_gasMeter_data_t *caps_gasMeter_initialize(IOT_CTX *ctx, const char *compone
 
     return caps_data;
 }
+
+void caps_gasMeter_deinitialize(caps_gasMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->gasMeterPrecision_value);
+    free(caps_data);
+}
@@ -16,7 +16,10 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_gasMeter.h"
+#include "caps_util.h"
 #include "JSON.h"
 
 #ifdef __cplusplus
@@ -28,42 +31,51 @@ typedef struct caps_gasMeter_data {
     void *usr_data;
     void *cmd_data;
 
-    char *gasMeterTime_value;
-    double gasMeter_value;
+    char gasMeterTime_value[CAPS_UTIL_TIME_STRING_SIZE];
+    int64_t gasMeter_milli;
     char *gasMeter_unit;
-    double gasMeterCalorific_value;
-    double gasMeterVolume_value;
+    int64_t gasMeterCalorific_milli;
+    int64_t gasMeterVolume_milli;
     char *gasMeterVolume_unit;
-    JSON_H *gasMeterPrecision_value;
-    double gasMeterConversion_value;
+    char *gasMeterPrecision_value;
+    int64_t gasMeterConversion_milli;
 
     const char *(*get_gasMeterTime_value)(struct caps_gasMeter_data *caps_data);
-    void (*set_gasMeterTime_value)(struct caps_gasMeter_data *caps_data, const char *value);
+    int (*set_gasMeterTime_value)(struct caps_gasMeter_data *caps_data, const char *value);
     void (*attr_gasMeterTime_send)(struct caps_gasMeter_data *caps_data);
     double (*get_gasMeter_value)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeter_value)(struct caps_gasMeter_data *caps_data, double value);
+    int64_t (*get_gasMeter_milli)(struct caps_gasMeter_data *caps_data);
+    void (*set_gasMeter_milli)(struct caps_gasMeter_data *caps_data, int64_t milli);
     const char *(*get_gasMeter_unit)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeter_unit)(struct caps_gasMeter_data *caps_data, const char *unit);
     void (*attr_gasMeter_send)(struct caps_gasMeter_data *caps_data);
     double (*get_gasMeterCalorific_value)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeterCalorific_value)(struct caps_gasMeter_data *caps_data, double value);
+    int64_t (*get_gasMeterCalorific_milli)(struct caps_gasMeter_data *caps_data);
+    void (*set_gasMeterCalorific_milli)(struct caps_gasMeter_data *caps_data, int64_t milli);
     void (*attr_gasMeterCalorific_send)(struct caps_gasMeter_data *caps_data);
     double (*get_gasMeterVolume_value)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeterVolume_value)(struct caps_gasMeter_data *caps_data, double value);
+    int64_t (*get_gasMeterVolume_milli)(struct caps_gasMeter_data *caps_data);
+    void (*set_gasMeterVolume_milli)(struct caps_gasMeter_data *caps_data, int64_t milli);
     const char *(*get_gasMeterVolume_unit)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeterVolume_unit)(struct caps_gasMeter_data *caps_data, const char *unit);
     void (*attr_gasMeterVolume_send)(struct caps_gasMeter_data *caps_data);
-    const JSON_H *(*get_gasMeterPrecision_value)(struct caps_gasMeter_data *caps_data);
-    void (*set_gasMeterPrecision_value)(struct caps_gasMeter_data *caps_data, const JSON_H *value);
+    const char *(*get_gasMeterPrecision_value)(struct caps_gasMeter_data *caps_data);
+    void (*set_gasMeterPrecision_value)(struct caps_gasMeter_data *caps_data, const char *value);
     void (*attr_gasMeterPrecision_send)(struct caps_gasMeter_data *caps_data);
     double (*get_gasMeterConversion_value)(struct caps_gasMeter_data *caps_data);
     void (*set_gasMeterConversion_value)(struct caps_gasMeter_data *caps_data, double value);
+    int64_t (*get_gasMeterConversion_milli)(struct caps_gasMeter_data *caps_data);
+    void (*set_gasMeterConversion_milli)(struct caps_gasMeter_data *caps_data, int64_t milli);
     void (*attr_gasMeterConversion_send)(struct caps_gasMeter_data *caps_data);
 
     void (*init_usr_cb)(struct caps_gasMeter_data *caps_data);
 } caps_gasMeter_data_t;
 
 caps_gasMeter_data_t *caps_gasMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_gasMeter_deinitialize(caps_gasMeter_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_illuminanceMeasurement.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_illuminanceMeasurement_get_illuminance_milli(caps_illuminanceMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_illuminanceMeasurement.attr_illuminance.min) - 1;
+    }
+    return caps_data->illuminance_milli;
+}
+
+static void caps_illuminanceMeasurement_set_illuminance_milli(caps_illuminanceMeasurement_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_illuminanceMeasurement.attr_illuminance.min)) {
+        printf("%lld is out of range for illuminance\n", (long long)milli);
+        return;
+    }
+    caps_data->illuminance_milli = milli;
+}
 
 static double caps_illuminanceMeasurement_get_illuminance_value(caps_illuminanceMeasurement_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_illuminanceMeasurement_get_illuminance_value(caps_illuminance
         printf("caps_data is NULL\n");
         return caps_helper_illuminanceMeasurement.attr_illuminance.min - 1;
     }
-    return caps_data->illuminance_value;
+    return caps_util_milli_to_double(caps_data->illuminance_milli);
 }
 
 static void caps_illuminanceMeasurement_set_illuminance_value(caps_illuminanceMeasurement_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->illuminance_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for illuminance\n");
+        return;
+    }
+    caps_illuminanceMeasurement_set_illuminance_milli(caps_data, milli);
 }
 
 static const char *caps_illuminanceMeasurement_get_illuminance_unit(caps_illuminanceMeasurement_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_illuminanceMeasurement_attr_illuminance_send(caps_illuminanceMe
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_illuminanceMeasurement.attr_illuminance.name,
-            caps_data->illuminance_value,
+            caps_data->illuminance_milli,
             caps_data->illuminance_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_illuminanceMeasurement_attr_illuminance_send(caps_illuminanceMe
 static void caps_illuminanceMeasurement_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_illuminanceMeasurement_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_illuminanceMeasurement_attr_illuminance_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_illuminanceMeasurement_data_t *caps_illuminanceMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_illuminanceMeasurement_data_t *caps_illuminanceMeasurement_initialize(IOT_C
 
     caps_data->get_illuminance_value = caps_illuminanceMeasurement_get_illuminance_value;
     caps_data->set_illuminance_value = caps_illuminanceMeasurement_set_illuminance_value;
+    caps_data->get_illuminance_milli = caps_illuminanceMeasurement_get_illuminance_milli;
+    caps_data->set_illuminance_milli = caps_illuminanceMeasurement_set_illuminance_milli;
     caps_data->get_illuminance_unit = caps_illuminanceMeasurement_get_illuminance_unit;
     caps_data->set_illuminance_unit = caps_illuminanceMeasurement_set_illuminance_unit;
     caps_data->attr_illuminance_send = caps_illuminanceMeasurement_attr_illuminance_send;
-    caps_data->illuminance_value = 0;
+    caps_data->illuminance_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_illuminanceMeasurement.id, caps_illuminanceMeasurement_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_illuminanceMeasurement.id, caps_illuminanceMeasurement_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init illuminanceMeasurement handle\n");
@@ -120,3 +155,16 @@ caps_illuminanceMeasurement_data_t *caps_illuminanceMeasurement_initialize(IOT_C
 
     return caps_data;
 }
+
+void caps_illuminanceMeasurement_deinitialize(caps_illuminanceMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_illuminanceMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_illuminanceMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double illuminance_value;
+    int64_t illuminance_milli;
     char *illuminance_unit;
 
     double (*get_illuminance_value)(struct caps_illuminanceMeasurement_data *caps_data);
     void (*set_illuminance_value)(struct caps_illuminanceMeasurement_data *caps_data, double value);
+    int64_t (*get_illuminance_milli)(struct caps_illuminanceMeasurement_data *caps_data);
+    void (*set_illuminance_milli)(struct caps_illuminanceMeasurement_data *caps_data, int64_t milli);
     const char *(*get_illuminance_unit)(struct caps_illuminanceMeasurement_data *caps_data);
     void (*set_illuminance_unit)(struct caps_illuminanceMeasurement_data *caps_data, const char *unit);
     void (*attr_illuminance_send)(struct caps_illuminanceMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_illuminanceMeasurement_data {
 } caps_illuminanceMeasurement_data_t;
 
 caps_illuminanceMeasurement_data_t *caps_illuminanceMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_illuminanceMeasurement_deinitialize(caps_illuminanceMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,9 @@
 
 #include "st_dev.h"
 #include "caps_imageCapture.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+#include "caps_cmd.h"
 
 static const char *caps_imageCapture_get_image_value(caps_imageCapture_data_t *caps_data)
 {
@@ -29,37 +32,58 @@ static const char *caps_imageCapture_get_image_value(caps_imageCapture_data_t *c
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->image_value;
+    if (caps_data->image_long_value) {
+        return caps_data->image_long_value;
+    }
+    return caps_data->image_value[0] ? caps_data->image_value : NULL;
 }
 
-static void caps_imageCapture_set_image_value(caps_imageCapture_data_t *caps_data, const char *value)
+static int caps_imageCapture_set_image_value(caps_imageCapture_data_t *caps_data, const char *value)
 {
+    char *long_value;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
+        return -1;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return -1;
     }
-    if (caps_data->image_value) {
-        free(caps_data->image_value);
+    if (strlen(value) < sizeof(caps_data->image_value)) {
+        free(caps_data->image_long_value);
+        caps_data->image_long_value = NULL;
+        return caps_util_copy_string(caps_data->image_value, sizeof(caps_data->image_value), value);
     }
-    caps_data->image_value = strdup(value);
+
+    long_value = strdup(value);
+    if (!long_value) {
+        printf("fail to strdup image value\n");
+        return -1;
+    }
+    free(caps_data->image_long_value);
+    caps_data->image_long_value = long_value;
+    return 0;
 }
 
 static void caps_imageCapture_attr_image_send(caps_imageCapture_data_t *caps_data)
 {
+    const char *value;
     int sequence_no = -1;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->image_value) {
+    value = caps_imageCapture_get_image_value(caps_data);
+    if (!value) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_imageCapture.attr_image.name,
-            caps_data->image_value,
+            (char *)value,
             NULL,
             NULL,
             sequence_no);
@@ -77,19 +101,16 @@ static const char *caps_imageCapture_get_captureTime_value(caps_imageCapture_dat
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->captureTime_value;
+    return caps_data->captureTime_value[0] ? caps_data->captureTime_value : NULL;
 }
 
-static void caps_imageCapture_set_captureTime_value(caps_imageCapture_data_t *caps_data, const char *value)
+static int caps_imageCapture_set_captureTime_value(caps_imageCapture_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
+        return -1;
     }
-    if (caps_data->captureTime_value) {
-        free(caps_data->captureTime_value);
-    }
-    caps_data->captureTime_value = strdup(value);
+    return caps_util_copy_string(caps_data->captureTime_value, sizeof(caps_data->captureTime_value), value);
 }
 
 static void caps_imageCapture_attr_captureTime_send(caps_imageCapture_data_t *caps_data)
@@ -100,12 +121,12 @@ static void caps_imageCapture_attr_captureTime_send(caps_imageCapture_data_t *ca
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->captureTime_value) {
+    if (!caps_data->captureTime_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_imageCapture.attr_captureTime.name,
             caps_data->captureTime_value,
             NULL,
@@ -134,10 +155,13 @@ static void caps_imageCapture_cmd_take_cb(IOT_CAP_HANDLE *handle,
 static void caps_imageCapture_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_imageCapture_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_imageCapture_attr_image_send(caps_data);
     caps_imageCapture_attr_captureTime_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_imageCapture_data_t *caps_imageCapture_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -163,10 +187,10 @@ caps_imageCapture_data_t *caps_imageCapture_initialize(IOT_CTX *ctx, const char
     caps_data->set_captureTime_value = caps_imageCapture_set_captureTime_value;
     caps_data->attr_captureTime_send = caps_imageCapture_attr_captureTime_send;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_imageCapture.id, caps_imageCapture_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_imageCapture.id, caps_imageCapture_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_imageCapture.cmd_take.name, caps_imageCapture_cmd_take_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_imageCapture.cmd_take.name, caps_imageCapture_cmd_take_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for take of imageCapture\n");
     }
@@ -176,3 +200,18 @@ caps_imageCapture_data_t *caps_imageCapture_initialize(IOT_CTX *ctx, const char
 
     return caps_data;
 }
+
+void caps_imageCapture_deinitialize(caps_imageCapture_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->image_long_value);
+    free(caps_data);
+}
@@ -17,24 +17,31 @@
  ****************************************************************************/
 
 #include "caps/iot_caps_helper_imageCapture.h"
+#include "caps_util.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Image URLs up to this size, including the terminator, are kept inline; longer ones on the heap */
+#ifndef CAPS_IMAGECAPTURE_IMAGE_SIZE
+#define CAPS_IMAGECAPTURE_IMAGE_SIZE 128
+#endif
+
 typedef struct caps_imageCapture_data {
     IOT_CAP_HANDLE* handle;
     void *usr_data;
     void *cmd_data;
 
-    char *image_value;
-    char *captureTime_value;
+    char image_value[CAPS_IMAGECAPTURE_IMAGE_SIZE];
+    char *image_long_value;
+    char captureTime_value[CAPS_UTIL_TIME_STRING_SIZE];
 
     const char *(*get_image_value)(struct caps_imageCapture_data *caps_data);
-    void (*set_image_value)(struct caps_imageCapture_data *caps_data, const char *value);
+    int (*set_image_value)(struct caps_imageCapture_data *caps_data, const char *value);
     void (*attr_image_send)(struct caps_imageCapture_data *caps_data);
     const char *(*get_captureTime_value)(struct caps_imageCapture_data *caps_data);
-    void (*set_captureTime_value)(struct caps_imageCapture_data *caps_data, const char *value);
+    int (*set_captureTime_value)(struct caps_imageCapture_data *caps_data, const char *value);
     void (*attr_captureTime_send)(struct caps_imageCapture_data *caps_data);
 
     void (*init_usr_cb)(struct caps_imageCapture_data *caps_data);
@@ -43,6 +50,7 @@ typedef struct caps_imageCapture_data {
 } caps_imageCapture_data_t;
 
 caps_imageCapture_data_t *caps_imageCapture_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_imageCapture_deinitialize(caps_imageCapture_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,449 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "caps_json_parser.h"
+
+/* what may come next, checked before each token */
+#define _EXPECT_VALUE (1 << 0)
+#define _EXPECT_KEY (1 << 1)
+#define _EXPECT_COLON (1 << 2)
+#define _EXPECT_COMMA (1 << 3)
+#define _EXPECT_CLOSE (1 << 4)
+
+struct caps_json_parser {
+    unsigned int pos;
+    unsigned int next;      /* next free token */
+    int super;              /* container or key which owns the next token */
+    int expect;             /* _EXPECT_* */
+};
+
+static caps_json_token_t *_alloc_token(struct caps_json_parser *parser,
+        caps_json_token_t *tokens, unsigned int num_tokens)
+{
+    caps_json_token_t *token;
+
+    if (parser->next >= num_tokens)
+        return NULL;
+    token = &tokens[parser->next++];
+    token->type = CAPS_JSON_UNDEFINED;
+    token->start = token->end = -1;
+    token->size = 0;
+    token->parent = -1;
+    return token;
+}
+
+/* after a complete value, only ',' or the end of its container may follow */
+static void _value_done(struct caps_json_parser *parser)
+{
+    parser->expect = (parser->super >= 0) ? (_EXPECT_COMMA | _EXPECT_CLOSE) : 0;
+}
+
+static int _parse_primitive(struct caps_json_parser *parser, const char *js, unsigned int len,
+        caps_json_token_t *tokens, unsigned int num_tokens)
+{
+    caps_json_token_t *token;
+    unsigned int start = parser->pos;
+
+    for (; parser->pos < len; parser->pos++) {
+        char c = js[parser->pos];
+
+        if (c == ',' || c == ']' || c == '}' || c == ':' ||
+                c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            break;
+        if (c < 32 || c >= 127)
+            return CAPS_JSON_ERROR_INVAL;
+    }
+    if (parser->pos == start)
+        return CAPS_JSON_ERROR_INVAL;
+
+    token = _alloc_token(parser, tokens, num_tokens);
+    if (!token)
+        return CAPS_JSON_ERROR_NOMEM;
+    token->type = CAPS_JSON_PRIMITIVE;
+    token->start = start;
+    token->end = parser->pos;
+    token->parent = parser->super;
+    parser->pos--;
+    return 0;
+}
+
+static int _parse_string(struct caps_json_parser *parser, const char *js, unsigned int len,
+        caps_json_token_t *tokens, unsigned int num_tokens)
+{
+    caps_json_token_t *token;
+    unsigned int start = parser->pos;
+    int i;
+
+    for (parser->pos++; parser->pos < len; parser->pos++) {
+        char c = js[parser->pos];
+
+        if (c == '"') {
+            token = _alloc_token(parser, tokens, num_tokens);
+            if (!token)
+                return CAPS_JSON_ERROR_NOMEM;
+            token->type = CAPS_JSON_STRING;
+            token->start = start + 1;
+            token->end = parser->pos;
+            token->parent = parser->super;
+            return 0;
+        }
+        if ((unsigned char)c < 32)
+            return CAPS_JSON_ERROR_INVAL;
+        if (c == '\\') {
+            parser->pos++;
+            if (parser->pos >= len)
+                break;
+            switch (js[parser->pos]) {
+            case '"': case '/': case '\\': case 'b':
+            case 'f': case 'r': case 'n': case 't':
+                break;
+            case 'u':
+                for (i = 0; i < 4; i++) {
+                    parser->pos++;
+                    if (parser->pos >= len)
+                        return CAPS_JSON_ERROR_PART;
+                    c = js[parser->pos];
+                    if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f')))
+                        return CAPS_JSON_ERROR_INVAL;
+                }
+                break;
+            default:
+                return CAPS_JSON_ERROR_INVAL;
+            }
+        }
+    }
+    return CAPS_JSON_ERROR_PART;
+}
+
+int caps_json_parse(const char *js, unsigned int len, caps_json_token_t *tokens, unsigned int num_tokens)
+{
+    struct caps_json_parser parser = { 0, 0, -1, _EXPECT_VALUE };
+    caps_json_token_t *token;
+    caps_json_type_t type;
+    int err;
+    int i;
+
+    if (!js || !tokens)
+        return CAPS_JSON_ERROR_INVAL;
+
+    for (; parser.pos < len && js[parser.pos]; parser.pos++) {
+        char c = js[parser.pos];
+
+        switch (c) {
+        case '{':
+        case '[':
+            if (!(parser.expect & _EXPECT_VALUE))
+                return CAPS_JSON_ERROR_INVAL;
+            token = _alloc_token(&parser, tokens, num_tokens);
+            if (!token)
+                return CAPS_JSON_ERROR_NOMEM;
+            if (parser.super >= 0)
+                tokens[parser.super].size++;
+            token->type = (c == '{') ? CAPS_JSON_OBJECT : CAPS_JSON_ARRAY;
+            token->start = parser.pos;
+            token->parent = parser.super;
+            parser.super = parser.next - 1;
+            parser.expect = ((c == '{') ? _EXPECT_KEY : _EXPECT_VALUE) | _EXPECT_CLOSE;
+            break;
+        case '}':
+        case ']':
+            type = (c == '}') ? CAPS_JSON_OBJECT : CAPS_JSON_ARRAY;
+            /* not after ',', a key or ':' */
+            if (!(parser.expect & _EXPECT_CLOSE))
+                return CAPS_JSON_ERROR_INVAL;
+            token = &tokens[parser.super];
+            if (token->type != type || token->end != -1)
+                return CAPS_JSON_ERROR_INVAL;
+            token->end = parser.pos + 1;
+            parser.super = token->parent;
+            /* the closed container was the value of a key */
+            if (parser.super >= 0 && tokens[parser.super].type == CAPS_JSON_STRING)
+                parser.super = tokens[parser.super].parent;
+            _value_done(&parser);
+            break;
+        case '"':
+            if (!(parser.expect & (_EXPECT_KEY | _EXPECT_VALUE)))
+                return CAPS_JSON_ERROR_INVAL;
+            err = _parse_string(&parser, js, len, tokens, num_tokens);
+            if (err < 0)
+                return err;
+            if (parser.super >= 0)
+                tokens[parser.super].size++;
+            if (parser.expect & _EXPECT_KEY) {
+                parser.expect = _EXPECT_COLON;
+                break;
+            }
+            /* the value of a key completes the member */
+            if (parser.super >= 0 && tokens[parser.super].type == CAPS_JSON_STRING)
+                parser.super = tokens[parser.super].parent;
+            _value_done(&parser);
+            break;
+        case ':':
+            if (!(parser.expect & _EXPECT_COLON))
+                return CAPS_JSON_ERROR_INVAL;
+            /* the key becomes the owner of the next value */
+            parser.super = parser.next - 1;
+            parser.expect = _EXPECT_VALUE;
+            break;
+        case ',':
+            if (!(parser.expect & _EXPECT_COMMA))
+                return CAPS_JSON_ERROR_INVAL;
+            parser.expect = (tokens[parser.super].type == CAPS_JSON_OBJECT) ? _EXPECT_KEY : _EXPECT_VALUE;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            break;
+        default:
+            if (!(parser.expect & _EXPECT_VALUE))
+                return CAPS_JSON_ERROR_INVAL;
+            err = _parse_primitive(&parser, js, len, tokens, num_tokens);
+            if (err < 0)
+                return err;
+            if (parser.super >= 0) {
+                tokens[parser.super].size++;
+                if (tokens[parser.super].type == CAPS_JSON_STRING)
+                    parser.super = tokens[parser.super].parent;
+            }
+            _value_done(&parser);
+            break;
+        }
+    }
+
+    if (parser.super >= 0 || parser.next == 0)
+        return CAPS_JSON_ERROR_PART;
+    for (i = 0; i < (int)parser.next; i++) {
+        if (tokens[i].start == -1 || tokens[i].end == -1)
+            return CAPS_JSON_ERROR_PART;
+    }
+    return parser.next;
+}
+
+int caps_json_next(const caps_json_token_t *tokens, int num, int index)
+{
+    int i;
+
+    /* children always follow their parent, so skip until the first token outside */
+    for (i = index + 1; i < num; i++) {
+        int parent = tokens[i].parent;
+
+        while (parent > index)
+            parent = tokens[parent].parent;
+        if (parent != index)
+            break;
+    }
+    return i;
+}
+
+int caps_json_token_equal(const char *js, const caps_json_token_t *token, const char *str)
+{
+    int len = token->end - token->start;
+
+    return token->type == CAPS_JSON_STRING &&
+            (int)strlen(str) == len && !strncmp(js + token->start, str, len);
+}
+
+int caps_json_find(const char *js, const caps_json_token_t *tokens, int num, int object, const char *key)
+{
+    int i;
+
+    if (object < 0 || object >= num || tokens[object].type != CAPS_JSON_OBJECT)
+        return -1;
+
+    for (i = object + 1; i < num && tokens[i].parent == object; ) {
+        if (caps_json_token_equal(js, &tokens[i], key))
+            return (i + 1 < num) ? i + 1 : -1;
+        /* skip the key and its value */
+        i = caps_json_next(tokens, num, i);
+    }
+    return -1;
+}
+
+int caps_json_get_number(const char *js, const caps_json_token_t *token, double *value)
+{
+    char buf[32];
+    char *end;
+    int len = token->end - token->start;
+    char c = js[token->start];
+
+    if (token->type != CAPS_JSON_PRIMITIVE || len >= (int)sizeof(buf))
+        return -1;
+    if (c != '-' && (c < '0' || c > '9'))
+        return -1;
+
+    /* js is not null-terminated at the token */
+    memcpy(buf, js + token->start, len);
+    buf[len] = '\0';
+    *value = strtod(buf, &end);
+    return (*end == '\0') ? 0 : -1;
+}
+
+int caps_json_get_int(const char *js, const caps_json_token_t *token, int *value)
+{
+    double number;
+
+    if (caps_json_get_number(js, token, &number) < 0)
+        return -1;
+    if (number < -2147483648.0 || number > 2147483647.0)
+        return -1;
+    *value = (int)number;
+    return 0;
+}
+
+int caps_json_get_milli(const char *js, const caps_json_token_t *token, int64_t *value)
+{
+    const char *p = js + token->start;
+    const char *end = js + token->end;
+    int64_t milli = 0;
+    int negative = 0;
+    int scale;
+    double number;
+
+    if (token->type != CAPS_JSON_PRIMITIVE)
+        return -1;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9')
+        return -1;
+
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        milli = milli * 10 + (*p - '0');
+        /* leaves room for the fraction and the rounding */
+        if (milli > INT64_MAX / 10000)
+            return -1;
+    }
+    milli *= 1000;
+
+    if (p < end && *p == '.') {
+        p++;
+        if (p == end || *p < '0' || *p > '9')
+            return -1;
+        for (scale = 100; p < end && *p >= '0' && *p <= '9'; p++) {
+            if (scale > 0) {
+                milli += (*p - '0') * scale;
+                scale /= 10;
+            } else if (scale == 0) {
+                /* round half away from zero on the first dropped digit */
+                if (*p >= '5')
+                    milli++;
+                scale = -1;
+            }
+        }
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (caps_json_get_number(js, token, &number) < 0)
+            return -1;
+        number *= 1000;
+        if (!(number > (double)INT64_MIN && number < (double)INT64_MAX))
+            return -1;
+        *value = (int64_t)(number < 0 ? number - 0.5 : number + 0.5);
+        return 0;
+    }
+    if (p != end)
+        return -1;
+
+    *value = negative ? -milli : milli;
+    return 0;
+}
+
+int caps_json_get_bool(const char *js, const caps_json_token_t *token, int *value)
+{
+    int len = token->end - token->start;
+
+    if (token->type != CAPS_JSON_PRIMITIVE)
+        return -1;
+    if (len == 4 && !strncmp(js + token->start, "true", 4)) {
+        *value = 1;
+        return 0;
+    }
+    if (len == 5 && !strncmp(js + token->start, "false", 5)) {
+        *value = 0;
+        return 0;
+    }
+    return -1;
+}
+
+static int _hex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return c - 'A' + 10;
+}
+
+int caps_json_get_string(const char *js, const caps_json_token_t *token, char *buf, unsigned int size)
+{
+    unsigned int out = 0;
+    unsigned int cp;
+    int i;
+
+    if (token->type != CAPS_JSON_STRING || !buf || size == 0)
+        return -1;
+
+    for (i = token->start; i < token->end; i++) {
+        char c = js[i];
+
+        if (c == '\\') {
+            c = js[++i];
+            switch (c) {
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'n': c = '\n'; break;
+            case 'r': c = '\r'; break;
+            case 't': c = '\t'; break;
+            case 'u':
+                cp = (_hex(js[i + 1]) << 12) | (_hex(js[i + 2]) << 8) |
+                        (_hex(js[i + 3]) << 4) | _hex(js[i + 4]);
+                i += 4;
+                /* UTF-8, surrogate pairs are kept as two 3-byte sequences */
+                if (cp < 0x80) {
+                    c = (char)cp;
+                    break;
+                }
+                if (cp < 0x800) {
+                    if (out + 2 >= size)
+                        return -1;
+                    buf[out++] = (char)(0xc0 | (cp >> 6));
+                    buf[out++] = (char)(0x80 | (cp & 0x3f));
+                } else {
+                    if (out + 3 >= size)
+                        return -1;
+                    buf[out++] = (char)(0xe0 | (cp >> 12));
+                    buf[out++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+                    buf[out++] = (char)(0x80 | (cp & 0x3f));
+                }
+                continue;
+            default:
+                break;
+            }
+        }
+        if (out + 1 >= size)
+            return -1;
+        buf[out++] = c;
+    }
+    buf[out] = '\0';
+    return 0;
+}
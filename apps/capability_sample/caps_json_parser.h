@@ -0,0 +1,83 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_JSON_PARSER_H_
+#define _CAPS_JSON_PARSER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum caps_json_type {
+    CAPS_JSON_UNDEFINED = 0,
+    CAPS_JSON_OBJECT,
+    CAPS_JSON_ARRAY,
+    CAPS_JSON_STRING,
+    CAPS_JSON_PRIMITIVE,    /* number, true, false or null */
+} caps_json_type_t;
+
+#define CAPS_JSON_ERROR_NOMEM (-1)  /* not enough tokens */
+#define CAPS_JSON_ERROR_INVAL (-2)  /* invalid character or structure */
+#define CAPS_JSON_ERROR_PART (-3)   /* incomplete JSON text */
+
+/* A token points into the parsed text, js[start] ~ js[end - 1]. Strings exclude the quotes. */
+typedef struct caps_json_token {
+    caps_json_type_t type;
+    int start;
+    int end;
+    int size;       /* members of an object, elements of an array, 1 for a key */
+    int parent;
+} caps_json_token_t;
+
+/**
+ * In-place JSON tokenizer.
+ *
+ * Splits js into tokens stored in the caller-provided array, without heap
+ * allocation and without modifying js. Tokens are in document order, a
+ * container is followed by its children and an object member key is
+ * followed by its value.
+ *
+ * Returns the number of tokens used, or CAPS_JSON_ERROR_*.
+ */
+int caps_json_parse(const char *js, unsigned int len, caps_json_token_t *tokens, unsigned int num_tokens);
+
+/* Index of the token after tokens[index] and all of its children */
+int caps_json_next(const caps_json_token_t *tokens, int num, int index);
+
+/* Index of the value of member key in the object tokens[object], or -1 */
+int caps_json_find(const char *js, const caps_json_token_t *tokens, int num, int object, const char *key);
+
+/* Typed getters return 0 on success, -1 if the token has another type */
+int caps_json_get_number(const char *js, const caps_json_token_t *token, double *value);
+int caps_json_get_int(const char *js, const caps_json_token_t *token, int *value);
+int caps_json_get_bool(const char *js, const caps_json_token_t *token, int *value);
+/* Number in 1/1000 of the unit, rounded, without floating point unless it has an exponent */
+int caps_json_get_milli(const char *js, const caps_json_token_t *token, int64_t *value);
+/* Copies the unescaped string into buf. Returns -1 if it does not fit. */
+int caps_json_get_string(const char *js, const caps_json_token_t *token, char *buf, unsigned int size);
+
+/* Compare a string token with str, without unescaping */
+int caps_json_token_equal(const char *js, const caps_json_token_t *token, const char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_JSON_PARSER_H_ */
@@ -0,0 +1,307 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "caps_json_writer.h"
+
+static void _put(caps_json_writer_t *writer, const char *str, unsigned int len)
+{
+    if (writer->error)
+        return;
+    /* one byte is always kept for the terminator */
+    if (writer->len + len >= writer->size) {
+        writer->error = 1;
+        return;
+    }
+    memcpy(writer->buf + writer->len, str, len);
+    writer->len += len;
+}
+
+static void _putc(caps_json_writer_t *writer, char c)
+{
+    _put(writer, &c, 1);
+}
+
+/* separator before a value or a key */
+static void _begin_value(caps_json_writer_t *writer)
+{
+    unsigned int bit = 1U << writer->depth;
+
+    if (writer->after_key) {
+        writer->after_key = 0;
+        return;
+    }
+    if (writer->has_value & bit)
+        _putc(writer, ',');
+    writer->has_value |= bit;
+}
+
+static void _begin_nest(caps_json_writer_t *writer, char c)
+{
+    _begin_value(writer);
+    if (writer->depth + 1 >= CAPS_JSON_WRITER_MAX_DEPTH) {
+        writer->error = 1;
+        return;
+    }
+    _putc(writer, c);
+    writer->depth++;
+    writer->has_value &= ~(1U << writer->depth);
+}
+
+static void _end_nest(caps_json_writer_t *writer, char c)
+{
+    if (writer->depth == 0 || writer->after_key) {
+        writer->error = 1;
+        return;
+    }
+    writer->depth--;
+    _putc(writer, c);
+}
+
+static void _put_string(caps_json_writer_t *writer, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    const char *start = str;
+    char esc[6];
+
+    _putc(writer, '"');
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        /* flush the plain run before the escape */
+        _put(writer, start, str - start);
+        start = str + 1;
+
+        esc[0] = '\\';
+        switch (c) {
+        case '"': esc[1] = '"'; break;
+        case '\\': esc[1] = '\\'; break;
+        case '\b': esc[1] = 'b'; break;
+        case '\f': esc[1] = 'f'; break;
+        case '\n': esc[1] = 'n'; break;
+        case '\r': esc[1] = 'r'; break;
+        case '\t': esc[1] = 't'; break;
+        default:
+            esc[1] = 'u';
+            esc[2] = '0';
+            esc[3] = '0';
+            esc[4] = hex[c >> 4];
+            esc[5] = hex[c & 0xf];
+            _put(writer, esc, 6);
+            continue;
+        }
+        _put(writer, esc, 2);
+    }
+    _put(writer, start, str - start);
+    _putc(writer, '"');
+}
+
+void caps_json_writer_init(caps_json_writer_t *writer, char *buf, unsigned int size)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->buf = buf;
+    writer->size = size;
+    if (!buf || size == 0)
+        writer->error = 1;
+}
+
+void caps_json_writer_begin_object(caps_json_writer_t *writer)
+{
+    _begin_nest(writer, '{');
+}
+
+void caps_json_writer_end_object(caps_json_writer_t *writer)
+{
+    _end_nest(writer, '}');
+}
+
+void caps_json_writer_begin_array(caps_json_writer_t *writer)
+{
+    _begin_nest(writer, '[');
+}
+
+void caps_json_writer_end_array(caps_json_writer_t *writer)
+{
+    _end_nest(writer, ']');
+}
+
+void caps_json_writer_key(caps_json_writer_t *writer, const char *key)
+{
+    if (!key || writer->depth == 0 || writer->after_key) {
+        writer->error = 1;
+        return;
+    }
+    _begin_value(writer);
+    _put_string(writer, key);
+    _putc(writer, ':');
+    writer->after_key = 1;
+}
+
+void caps_json_writer_string(caps_json_writer_t *writer, const char *value)
+{
+    if (!value) {
+        caps_json_writer_null(writer);
+        return;
+    }
+    _begin_value(writer);
+    _put_string(writer, value);
+}
+
+void caps_json_writer_int(caps_json_writer_t *writer, int value)
+{
+    char tmp[12];
+    char *p = tmp + sizeof(tmp);
+    unsigned int u = (value < 0) ? 0U - (unsigned int)value : (unsigned int)value;
+
+    do {
+        *--p = '0' + (u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0)
+        *--p = '-';
+
+    _begin_value(writer);
+    _put(writer, p, tmp + sizeof(tmp) - p);
+}
+
+#if CAPS_JSON_WRITER_MAX_FRACTION > 15
+#error CAPS_JSON_WRITER_MAX_FRACTION must not be larger than 15
+#endif
+
+static const double pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+};
+
+/* 2^53, integers below it are exact in a double */
+#define EXACT_INTEGER_LIMIT 9007199254740992.0
+
+/*
+ * Shortest fixed-point text of value with at most CAPS_JSON_WRITER_MAX_FRACTION
+ * fraction digits which reads back as value, as a double or as a float.
+ * Candidates are checked with one exact division, so no printf is involved.
+ * Returns the length, or 0 when value needs the exponent form or more digits.
+ */
+static int _format_fixed(char *tmp, unsigned int size, double value, int is_float)
+{
+    unsigned long long digits;
+    double scaled;
+    double magnitude = (value < 0) ? -value : value;
+    char *p = tmp + size;
+    int fraction;
+    int i;
+
+    for (fraction = 0; fraction <= CAPS_JSON_WRITER_MAX_FRACTION; fraction++) {
+        scaled = magnitude * pow10_table[fraction];
+        if (scaled >= EXACT_INTEGER_LIMIT)
+            return 0;
+        digits = (unsigned long long)(scaled + 0.5);
+        if (is_float) {
+            if ((float)(digits / pow10_table[fraction]) == (float)magnitude)
+                break;
+        } else if (digits / pow10_table[fraction] == magnitude) {
+            break;
+        }
+    }
+    if (fraction > CAPS_JSON_WRITER_MAX_FRACTION)
+        return 0;
+
+    for (; fraction > 0 && digits % 10 == 0; fraction--)
+        digits /= 10;
+
+    for (i = 0; i < fraction; i++) {
+        *--p = '0' + (digits % 10);
+        digits /= 10;
+    }
+    if (fraction)
+        *--p = '.';
+    do {
+        *--p = '0' + (digits % 10);
+        digits /= 10;
+    } while (digits);
+    if (value < 0)
+        *--p = '-';
+
+    memmove(tmp, p, tmp + size - p);
+    return tmp + size - p;
+}
+
+static void _put_number(caps_json_writer_t *writer, double value, int is_float)
+{
+    char tmp[32];
+    int len;
+
+    /* JSON has no representation for NaN and infinity */
+    if (value != value || value > 1.7976931348623157e308 || value < -1.7976931348623157e308) {
+        caps_json_writer_null(writer);
+        return;
+    }
+    if (value >= -2147483648.0 && value <= 2147483647.0 && value == (double)(int)value) {
+        caps_json_writer_int(writer, (int)value);
+        return;
+    }
+
+    len = _format_fixed(tmp, sizeof(tmp), value, is_float);
+    if (len == 0) {
+        /* very large, very small or long values */
+        len = snprintf(tmp, sizeof(tmp), "%.*g", is_float ? 9 : 15, value);
+        if (!is_float && strtod(tmp, NULL) != value)
+            len = snprintf(tmp, sizeof(tmp), "%.17g", value);
+    }
+    _begin_value(writer);
+    _put(writer, tmp, len);
+}
+
+void caps_json_writer_number(caps_json_writer_t *writer, double value)
+{
+    _put_number(writer, value, 0);
+}
+
+void caps_json_writer_float(caps_json_writer_t *writer, float value)
+{
+    _put_number(writer, value, 1);
+}
+
+void caps_json_writer_bool(caps_json_writer_t *writer, int value)
+{
+    _begin_value(writer);
+    if (value)
+        _put(writer, "true", 4);
+    else
+        _put(writer, "false", 5);
+}
+
+void caps_json_writer_null(caps_json_writer_t *writer)
+{
+    _begin_value(writer);
+    _put(writer, "null", 4);
+}
+
+const char *caps_json_writer_finish(caps_json_writer_t *writer)
+{
+    if (writer->error || writer->depth != 0 || writer->after_key || writer->len == 0)
+        return NULL;
+    writer->buf[writer->len] = '\0';
+    return writer->buf;
+}
@@ -0,0 +1,95 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_JSON_WRITER_H_
+#define _CAPS_JSON_WRITER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Deepest nesting of objects and arrays */
+#define CAPS_JSON_WRITER_MAX_DEPTH 32
+
+/* Fraction digits tried before a number falls back to snprintf */
+#ifndef CAPS_JSON_WRITER_MAX_FRACTION
+#define CAPS_JSON_WRITER_MAX_FRACTION 9
+#endif
+
+/**
+ * Streaming JSON writer.
+ *
+ * Writes JSON text straight into a caller-provided buffer, usually on the
+ * stack, without building a cJSON tree and without heap allocation.
+ * Errors (buffer too small, unbalanced nesting) are sticky and reported by
+ * caps_json_writer_finish(), so the calls in between need no checks.
+ *
+ *   char buf[32];
+ *   caps_json_writer_t writer;
+ *
+ *   caps_json_writer_init(&writer, buf, sizeof(buf));
+ *   caps_json_writer_begin_array(&writer);
+ *   caps_json_writer_int(&writer, x);
+ *   caps_json_writer_int(&writer, y);
+ *   caps_json_writer_int(&writer, z);
+ *   caps_json_writer_end_array(&writer);
+ *   if (!caps_json_writer_finish(&writer))
+ *       printf("buffer is too small\n");
+ */
+typedef struct caps_json_writer {
+    char *buf;
+    unsigned int size;
+    unsigned int len;
+    int depth;
+    unsigned int has_value;     /* bit per depth, a value was written at that depth */
+    int after_key;
+    int error;
+} caps_json_writer_t;
+
+void caps_json_writer_init(caps_json_writer_t *writer, char *buf, unsigned int size);
+
+void caps_json_writer_begin_object(caps_json_writer_t *writer);
+void caps_json_writer_end_object(caps_json_writer_t *writer);
+void caps_json_writer_begin_array(caps_json_writer_t *writer);
+void caps_json_writer_end_array(caps_json_writer_t *writer);
+
+/* Name of the next member of an object */
+void caps_json_writer_key(caps_json_writer_t *writer, const char *key);
+
+void caps_json_writer_string(caps_json_writer_t *writer, const char *value);
+void caps_json_writer_int(caps_json_writer_t *writer, int value);
+/**
+ * Numbers are written in the shortest text which reads back as the same value.
+ * Whole numbers and values with up to CAPS_JSON_WRITER_MAX_FRACTION fraction
+ * digits, which covers sensor readings, are formatted without printf.
+ * caps_json_writer_float() does the same for the precision of a float, so a
+ * reading of 23.4f is written as 23.4 and not as 23.399999618530273.
+ */
+void caps_json_writer_number(caps_json_writer_t *writer, double value);
+void caps_json_writer_float(caps_json_writer_t *writer, float value);
+void caps_json_writer_bool(caps_json_writer_t *writer, int value);
+void caps_json_writer_null(caps_json_writer_t *writer);
+
+/* Returns the null-terminated JSON text, or NULL on any error */
+const char *caps_json_writer_finish(caps_json_writer_t *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_JSON_WRITER_H_ */
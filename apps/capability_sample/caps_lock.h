@@ -27,10 +27,12 @@ typedef struct caps_lock_data {
     void *usr_data;
     void *cmd_data;
 
-    char *lock_value;
+    int lock_idx;
 
     const char *(*get_lock_value)(struct caps_lock_data *caps_data);
     void (*set_lock_value)(struct caps_lock_data *caps_data, const char *value);
+    int (*get_lock_idx)(struct caps_lock_data *caps_data);
+    void (*set_lock_idx)(struct caps_lock_data *caps_data, int idx);
     int (*attr_lock_str2idx)(const char *value);
     void (*attr_lock_send)(struct caps_lock_data *caps_data);
 
@@ -41,6 +43,7 @@ typedef struct caps_lock_data {
 } caps_lock_data_t;
 
 caps_lock_data_t *caps_lock_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_lock_deinitialize(caps_lock_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
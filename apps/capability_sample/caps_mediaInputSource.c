@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_mediaInputSource.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_mediaInputSource_attr_inputSource_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_mediaInputSource_get_inputSource_value(caps_mediaInputSo
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->inputSource_value;
+    if (caps_data->inputSource_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_mediaInputSource.attr_inputSource.values[caps_data->inputSource_idx];
 }
 
 static void caps_mediaInputSource_set_inputSource_value(caps_mediaInputSource_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->inputSource_value) {
-        free(caps_data->inputSource_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_mediaInputSource_attr_inputSource_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for inputSource\n", value);
+        return;
+    }
+    caps_data->inputSource_idx = index;
+}
+
+static int caps_mediaInputSource_get_inputSource_idx(caps_mediaInputSource_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
     }
-    caps_data->inputSource_value = strdup(value);
+    return caps_data->inputSource_idx;
+}
+
+static void caps_mediaInputSource_set_inputSource_idx(caps_mediaInputSource_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_MEDIAINPUTSOURCE_INPUTSOURCE_VALUE_MAX) {
+        printf("%d is not supported index for inputSource\n", idx);
+        return;
+    }
+    caps_data->inputSource_idx = idx;
 }
 
 static void caps_mediaInputSource_attr_inputSource_send(caps_mediaInputSource_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_mediaInputSource_attr_inputSource_send(caps_mediaInputSource_da
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->inputSource_value) {
+    if (caps_data->inputSource_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_mediaInputSource.attr_inputSource.name,
-            caps_data->inputSource_value,
+            (char *)caps_helper_mediaInputSource.attr_inputSource.values[caps_data->inputSource_idx],
             NULL,
             NULL,
             sequence_no);
@@ -100,7 +135,7 @@ static void caps_mediaInputSource_set_supportedInputSources_value(caps_mediaInpu
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedInputSources_value) {
+    if (caps_data->supportedInputSources_value && !caps_data->supportedInputSources_borrowed) {
         for (i = 0; i < caps_data->supportedInputSources_arraySize; i++) {
             free(caps_data->supportedInputSources_value[i]);
         }
@@ -117,6 +152,27 @@ static void caps_mediaInputSource_set_supportedInputSources_value(caps_mediaInpu
     }
 
     caps_data->supportedInputSources_arraySize = arraySize;
+    caps_data->supportedInputSources_borrowed = 0;
+}
+
+static void caps_mediaInputSource_set_supportedInputSources_value_borrowed(caps_mediaInputSource_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedInputSources_value && !caps_data->supportedInputSources_borrowed) {
+        for (i = 0; i < caps_data->supportedInputSources_arraySize; i++) {
+            free(caps_data->supportedInputSources_value[i]);
+        }
+        free(caps_data->supportedInputSources_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedInputSources_value = (char **)value;
+    caps_data->supportedInputSources_arraySize = arraySize;
+    caps_data->supportedInputSources_borrowed = 1;
 }
 
 static void caps_mediaInputSource_attr_supportedInputSources_send(caps_mediaInputSource_data_t *caps_data)
@@ -132,7 +188,7 @@ static void caps_mediaInputSource_attr_supportedInputSources_send(caps_mediaInpu
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_mediaInputSource.attr_supportedInputSources.name,
             caps_data->supportedInputSources_value,
             caps_data->supportedInputSources_arraySize,
@@ -150,7 +206,6 @@ static void caps_mediaInputSource_attr_supportedInputSources_send(caps_mediaInpu
 static void caps_mediaInputSource_cmd_setInputSource_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaInputSource_data_t *caps_data = (caps_mediaInputSource_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -160,9 +215,7 @@ static void caps_mediaInputSource_cmd_setInputSource_cb(IOT_CAP_HANDLE *handle,
         printf("%s is not supported value for setInputSource\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_mediaInputSource.attr_inputSource.values[index];
-
-    caps_mediaInputSource_set_inputSource_value(caps_data, value);
+    caps_mediaInputSource_set_inputSource_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setInputSource_usr_cb)
         caps_data->cmd_setInputSource_usr_cb(caps_data);
     caps_mediaInputSource_attr_inputSource_send(caps_data);
@@ -171,10 +224,13 @@ static void caps_mediaInputSource_cmd_setInputSource_cb(IOT_CAP_HANDLE *handle,
 static void caps_mediaInputSource_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_mediaInputSource_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_mediaInputSource_attr_inputSource_send(caps_data);
     caps_mediaInputSource_attr_supportedInputSources_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_mediaInputSource_data_t *caps_mediaInputSource_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -195,16 +251,20 @@ caps_mediaInputSource_data_t *caps_mediaInputSource_initialize(IOT_CTX *ctx, con
 
     caps_data->get_inputSource_value = caps_mediaInputSource_get_inputSource_value;
     caps_data->set_inputSource_value = caps_mediaInputSource_set_inputSource_value;
+    caps_data->get_inputSource_idx = caps_mediaInputSource_get_inputSource_idx;
+    caps_data->set_inputSource_idx = caps_mediaInputSource_set_inputSource_idx;
     caps_data->attr_inputSource_str2idx = caps_mediaInputSource_attr_inputSource_str2idx;
     caps_data->attr_inputSource_send = caps_mediaInputSource_attr_inputSource_send;
     caps_data->get_supportedInputSources_value = caps_mediaInputSource_get_supportedInputSources_value;
     caps_data->set_supportedInputSources_value = caps_mediaInputSource_set_supportedInputSources_value;
+    caps_data->set_supportedInputSources_value_borrowed = caps_mediaInputSource_set_supportedInputSources_value_borrowed;
     caps_data->attr_supportedInputSources_send = caps_mediaInputSource_attr_supportedInputSources_send;
+    caps_data->inputSource_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_mediaInputSource.id, caps_mediaInputSource_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_mediaInputSource.id, caps_mediaInputSource_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaInputSource.cmd_setInputSource.name, caps_mediaInputSource_cmd_setInputSource_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaInputSource.cmd_setInputSource.name, caps_mediaInputSource_cmd_setInputSource_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setInputSource of mediaInputSource\n");
     }
@@ -214,3 +274,25 @@ caps_mediaInputSource_data_t *caps_mediaInputSource_initialize(IOT_CTX *ctx, con
 
     return caps_data;
 }
+
+void caps_mediaInputSource_deinitialize(caps_mediaInputSource_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedInputSources_value && !caps_data->supportedInputSources_borrowed) {
+        for (i = 0; i < caps_data->supportedInputSources_arraySize; i++) {
+            free(caps_data->supportedInputSources_value[i]);
+        }
+        free(caps_data->supportedInputSources_value);
+    }
+    free(caps_data);
+}
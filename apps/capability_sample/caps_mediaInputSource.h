@@ -28,16 +28,20 @@ typedef struct caps_mediaInputSource_data {
     void *usr_data;
     void *cmd_data;
 
-    char *inputSource_value;
+    int inputSource_idx;
     char **supportedInputSources_value;
     int supportedInputSources_arraySize;
+    int supportedInputSources_borrowed;
 
     const char *(*get_inputSource_value)(struct caps_mediaInputSource_data *caps_data);
     void (*set_inputSource_value)(struct caps_mediaInputSource_data *caps_data, const char *value);
+    int (*get_inputSource_idx)(struct caps_mediaInputSource_data *caps_data);
+    void (*set_inputSource_idx)(struct caps_mediaInputSource_data *caps_data, int idx);
     int (*attr_inputSource_str2idx)(const char *value);
     void (*attr_inputSource_send)(struct caps_mediaInputSource_data *caps_data);
     const char **(*get_supportedInputSources_value)(struct caps_mediaInputSource_data *caps_data);
     void (*set_supportedInputSources_value)(struct caps_mediaInputSource_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedInputSources_value_borrowed)(struct caps_mediaInputSource_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedInputSources_send)(struct caps_mediaInputSource_data *caps_data);
 
     void (*init_usr_cb)(struct caps_mediaInputSource_data *caps_data);
@@ -46,6 +50,7 @@ typedef struct caps_mediaInputSource_data {
 } caps_mediaInputSource_data_t;
 
 caps_mediaInputSource_data_t *caps_mediaInputSource_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_mediaInputSource_deinitialize(caps_mediaInputSource_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_mediaPlayback.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static const char **caps_mediaPlayback_get_supportedPlaybackCommands_value(caps_mediaPlayback_data_t *caps_data)
 {
@@ -39,7 +41,7 @@ static void caps_mediaPlayback_set_supportedPlaybackCommands_value(caps_mediaPla
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedPlaybackCommands_value) {
+    if (caps_data->supportedPlaybackCommands_value && !caps_data->supportedPlaybackCommands_borrowed) {
         for (i = 0; i < caps_data->supportedPlaybackCommands_arraySize; i++) {
             free(caps_data->supportedPlaybackCommands_value[i]);
         }
@@ -56,6 +58,27 @@ static void caps_mediaPlayback_set_supportedPlaybackCommands_value(caps_mediaPla
     }
 
     caps_data->supportedPlaybackCommands_arraySize = arraySize;
+    caps_data->supportedPlaybackCommands_borrowed = 0;
+}
+
+static void caps_mediaPlayback_set_supportedPlaybackCommands_value_borrowed(caps_mediaPlayback_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedPlaybackCommands_value && !caps_data->supportedPlaybackCommands_borrowed) {
+        for (i = 0; i < caps_data->supportedPlaybackCommands_arraySize; i++) {
+            free(caps_data->supportedPlaybackCommands_value[i]);
+        }
+        free(caps_data->supportedPlaybackCommands_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedPlaybackCommands_value = (char **)value;
+    caps_data->supportedPlaybackCommands_arraySize = arraySize;
+    caps_data->supportedPlaybackCommands_borrowed = 1;
 }
 
 static void caps_mediaPlayback_attr_supportedPlaybackCommands_send(caps_mediaPlayback_data_t *caps_data)
@@ -71,7 +94,7 @@ static void caps_mediaPlayback_attr_supportedPlaybackCommands_send(caps_mediaPla
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_mediaPlayback.attr_supportedPlaybackCommands.name,
             caps_data->supportedPlaybackCommands_value,
             caps_data->supportedPlaybackCommands_arraySize,
@@ -104,19 +127,52 @@ static const char *caps_mediaPlayback_get_playbackStatus_value(caps_mediaPlaybac
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->playbackStatus_value;
+    if (caps_data->playbackStatus_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_mediaPlayback.attr_playbackStatus.values[caps_data->playbackStatus_idx];
 }
 
 static void caps_mediaPlayback_set_playbackStatus_value(caps_mediaPlayback_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_mediaPlayback_attr_playbackStatus_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for playbackStatus\n", value);
+        return;
+    }
+    caps_data->playbackStatus_idx = index;
+}
+
+static int caps_mediaPlayback_get_playbackStatus_idx(caps_mediaPlayback_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->playbackStatus_idx;
+}
+
+static void caps_mediaPlayback_set_playbackStatus_idx(caps_mediaPlayback_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->playbackStatus_value) {
-        free(caps_data->playbackStatus_value);
+    if (idx < 0 || idx >= CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_MAX) {
+        printf("%d is not supported index for playbackStatus\n", idx);
+        return;
     }
-    caps_data->playbackStatus_value = strdup(value);
+    caps_data->playbackStatus_idx = idx;
 }
 
 static void caps_mediaPlayback_attr_playbackStatus_send(caps_mediaPlayback_data_t *caps_data)
@@ -127,14 +183,14 @@ static void caps_mediaPlayback_attr_playbackStatus_send(caps_mediaPlayback_data_
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->playbackStatus_value) {
+    if (caps_data->playbackStatus_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_mediaPlayback.attr_playbackStatus.name,
-            caps_data->playbackStatus_value,
+            (char *)caps_helper_mediaPlayback.attr_playbackStatus.values[caps_data->playbackStatus_idx],
             NULL,
             NULL,
             sequence_no);
@@ -150,7 +206,6 @@ static void caps_mediaPlayback_attr_playbackStatus_send(caps_mediaPlayback_data_
 static void caps_mediaPlayback_cmd_setPlaybackStatus_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -160,9 +215,7 @@ static void caps_mediaPlayback_cmd_setPlaybackStatus_cb(IOT_CAP_HANDLE *handle,
         printf("%s is not supported value for setPlaybackStatus\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_mediaPlayback.attr_playbackStatus.values[index];
-
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setPlaybackStatus_usr_cb)
         caps_data->cmd_setPlaybackStatus_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -171,11 +224,11 @@ static void caps_mediaPlayback_cmd_setPlaybackStatus_cb(IOT_CAP_HANDLE *handle,
 static void caps_mediaPlayback_cmd_play_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    const char* value = caps_helper_mediaPlayback.attr_playbackStatus.values[CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_PLAYING];
+    int index = CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_PLAYING;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_play_usr_cb)
         caps_data->cmd_play_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -184,11 +237,11 @@ static void caps_mediaPlayback_cmd_play_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_d
 static void caps_mediaPlayback_cmd_pause_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    const char* value = caps_helper_mediaPlayback.attr_playbackStatus.values[CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_PAUSED];
+    int index = CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_PAUSED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_pause_usr_cb)
         caps_data->cmd_pause_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -197,11 +250,11 @@ static void caps_mediaPlayback_cmd_pause_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_
 static void caps_mediaPlayback_cmd_rewind_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    const char* value = caps_helper_mediaPlayback.attr_playbackStatus.values[CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_REWINDING];
+    int index = CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_REWINDING;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_rewind_usr_cb)
         caps_data->cmd_rewind_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -210,11 +263,11 @@ static void caps_mediaPlayback_cmd_rewind_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd
 static void caps_mediaPlayback_cmd_fastForward_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    const char* value = caps_helper_mediaPlayback.attr_playbackStatus.values[CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_FAST_FORWARDING];
+    int index = CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_FAST_FORWARDING;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_fastForward_usr_cb)
         caps_data->cmd_fastForward_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -223,11 +276,11 @@ static void caps_mediaPlayback_cmd_fastForward_cb(IOT_CAP_HANDLE *handle, iot_ca
 static void caps_mediaPlayback_cmd_stop_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = (caps_mediaPlayback_data_t *)usr_data;
-    const char* value = caps_helper_mediaPlayback.attr_playbackStatus.values[CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_STOPPED];
+    int index = CAP_ENUM_MEDIAPLAYBACK_PLAYBACKSTATUS_VALUE_STOPPED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_mediaPlayback_set_playbackStatus_value(caps_data, value);
+    caps_mediaPlayback_set_playbackStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_stop_usr_cb)
         caps_data->cmd_stop_usr_cb(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
@@ -236,10 +289,13 @@ static void caps_mediaPlayback_cmd_stop_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_d
 static void caps_mediaPlayback_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_mediaPlayback_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_mediaPlayback_attr_supportedPlaybackCommands_send(caps_data);
     caps_mediaPlayback_attr_playbackStatus_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_mediaPlayback_data_t *caps_mediaPlayback_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -260,36 +316,40 @@ caps_mediaPlayback_data_t *caps_mediaPlayback_initialize(IOT_CTX *ctx, const cha
 
     caps_data->get_supportedPlaybackCommands_value = caps_mediaPlayback_get_supportedPlaybackCommands_value;
     caps_data->set_supportedPlaybackCommands_value = caps_mediaPlayback_set_supportedPlaybackCommands_value;
+    caps_data->set_supportedPlaybackCommands_value_borrowed = caps_mediaPlayback_set_supportedPlaybackCommands_value_borrowed;
     caps_data->attr_supportedPlaybackCommands_send = caps_mediaPlayback_attr_supportedPlaybackCommands_send;
     caps_data->get_playbackStatus_value = caps_mediaPlayback_get_playbackStatus_value;
     caps_data->set_playbackStatus_value = caps_mediaPlayback_set_playbackStatus_value;
+    caps_data->get_playbackStatus_idx = caps_mediaPlayback_get_playbackStatus_idx;
+    caps_data->set_playbackStatus_idx = caps_mediaPlayback_set_playbackStatus_idx;
     caps_data->attr_playbackStatus_str2idx = caps_mediaPlayback_attr_playbackStatus_str2idx;
     caps_data->attr_playbackStatus_send = caps_mediaPlayback_attr_playbackStatus_send;
+    caps_data->playbackStatus_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_mediaPlayback.id, caps_mediaPlayback_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_mediaPlayback.id, caps_mediaPlayback_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_setPlaybackStatus.name, caps_mediaPlayback_cmd_setPlaybackStatus_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_setPlaybackStatus.name, caps_mediaPlayback_cmd_setPlaybackStatus_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setPlaybackStatus of mediaPlayback\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_play.name, caps_mediaPlayback_cmd_play_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_play.name, caps_mediaPlayback_cmd_play_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for play of mediaPlayback\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_pause.name, caps_mediaPlayback_cmd_pause_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_pause.name, caps_mediaPlayback_cmd_pause_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for pause of mediaPlayback\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_rewind.name, caps_mediaPlayback_cmd_rewind_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_rewind.name, caps_mediaPlayback_cmd_rewind_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for rewind of mediaPlayback\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_fastForward.name, caps_mediaPlayback_cmd_fastForward_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_fastForward.name, caps_mediaPlayback_cmd_fastForward_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for fastForward of mediaPlayback\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_stop.name, caps_mediaPlayback_cmd_stop_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_mediaPlayback.cmd_stop.name, caps_mediaPlayback_cmd_stop_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for stop of mediaPlayback\n");
     }
@@ -299,3 +359,25 @@ caps_mediaPlayback_data_t *caps_mediaPlayback_initialize(IOT_CTX *ctx, const cha
 
     return caps_data;
 }
+
+void caps_mediaPlayback_deinitialize(caps_mediaPlayback_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedPlaybackCommands_value && !caps_data->supportedPlaybackCommands_borrowed) {
+        for (i = 0; i < caps_data->supportedPlaybackCommands_arraySize; i++) {
+            free(caps_data->supportedPlaybackCommands_value[i]);
+        }
+        free(caps_data->supportedPlaybackCommands_value);
+    }
+    free(caps_data);
+}
@@ -30,13 +30,17 @@ typedef struct caps_mediaPlayback_data {
 
     char **supportedPlaybackCommands_value;
     int supportedPlaybackCommands_arraySize;
-    char *playbackStatus_value;
+    int supportedPlaybackCommands_borrowed;
+    int playbackStatus_idx;
 
     const char **(*get_supportedPlaybackCommands_value)(struct caps_mediaPlayback_data *caps_data);
     void (*set_supportedPlaybackCommands_value)(struct caps_mediaPlayback_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedPlaybackCommands_value_borrowed)(struct caps_mediaPlayback_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedPlaybackCommands_send)(struct caps_mediaPlayback_data *caps_data);
     const char *(*get_playbackStatus_value)(struct caps_mediaPlayback_data *caps_data);
     void (*set_playbackStatus_value)(struct caps_mediaPlayback_data *caps_data, const char *value);
+    int (*get_playbackStatus_idx)(struct caps_mediaPlayback_data *caps_data);
+    void (*set_playbackStatus_idx)(struct caps_mediaPlayback_data *caps_data, int idx);
     int (*attr_playbackStatus_str2idx)(const char *value);
     void (*attr_playbackStatus_send)(struct caps_mediaPlayback_data *caps_data);
 
@@ -51,6 +55,7 @@ typedef struct caps_mediaPlayback_data {
 } caps_mediaPlayback_data_t;
 
 caps_mediaPlayback_data_t *caps_mediaPlayback_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_mediaPlayback_deinitialize(caps_mediaPlayback_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
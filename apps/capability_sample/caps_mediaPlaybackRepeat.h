@@ -27,10 +27,12 @@ typedef struct caps_mediaPlaybackRepeat_data {
     void *usr_data;
     void *cmd_data;
 
-    char *playbackRepeatMode_value;
+    int playbackRepeatMode_idx;
 
     const char *(*get_playbackRepeatMode_value)(struct caps_mediaPlaybackRepeat_data *caps_data);
     void (*set_playbackRepeatMode_value)(struct caps_mediaPlaybackRepeat_data *caps_data, const char *value);
+    int (*get_playbackRepeatMode_idx)(struct caps_mediaPlaybackRepeat_data *caps_data);
+    void (*set_playbackRepeatMode_idx)(struct caps_mediaPlaybackRepeat_data *caps_data, int idx);
     int (*attr_playbackRepeatMode_str2idx)(const char *value);
     void (*attr_playbackRepeatMode_send)(struct caps_mediaPlaybackRepeat_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_mediaPlaybackRepeat_data {
 } caps_mediaPlaybackRepeat_data_t;
 
 caps_mediaPlaybackRepeat_data_t *caps_mediaPlaybackRepeat_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_mediaPlaybackRepeat_deinitialize(caps_mediaPlaybackRepeat_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_mediaPlaybackShuffle_data {
     void *usr_data;
     void *cmd_data;
 
-    char *playbackShuffle_value;
+    int playbackShuffle_idx;
 
     const char *(*get_playbackShuffle_value)(struct caps_mediaPlaybackShuffle_data *caps_data);
     void (*set_playbackShuffle_value)(struct caps_mediaPlaybackShuffle_data *caps_data, const char *value);
+    int (*get_playbackShuffle_idx)(struct caps_mediaPlaybackShuffle_data *caps_data);
+    void (*set_playbackShuffle_idx)(struct caps_mediaPlaybackShuffle_data *caps_data, int idx);
     int (*attr_playbackShuffle_str2idx)(const char *value);
     void (*attr_playbackShuffle_send)(struct caps_mediaPlaybackShuffle_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_mediaPlaybackShuffle_data {
 } caps_mediaPlaybackShuffle_data_t;
 
 caps_mediaPlaybackShuffle_data_t *caps_mediaPlaybackShuffle_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_mediaPlaybackShuffle_deinitialize(caps_mediaPlaybackShuffle_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_momentary.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static void caps_momentary_cmd_push_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
@@ -36,8 +38,11 @@ static void caps_momentary_cmd_push_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_
 static void caps_momentary_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_momentary_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_momentary_data_t *caps_momentary_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -57,10 +62,10 @@ caps_momentary_data_t *caps_momentary_initialize(IOT_CTX *ctx, const char *compo
     caps_data->usr_data = usr_data;
 
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_momentary.id, caps_momentary_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_momentary.id, caps_momentary_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_momentary.cmd_push.name, caps_momentary_cmd_push_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_momentary.cmd_push.name, caps_momentary_cmd_push_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for push of momentary\n");
     }
@@ -70,3 +75,17 @@ caps_momentary_data_t *caps_momentary_initialize(IOT_CTX *ctx, const char *compo
 
     return caps_data;
 }
+
+void caps_momentary_deinitialize(caps_momentary_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
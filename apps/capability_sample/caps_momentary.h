@@ -35,6 +35,7 @@ typedef struct caps_momentary_data {
 } caps_momentary_data_t;
 
 caps_momentary_data_t *caps_momentary_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_momentary_deinitialize(caps_momentary_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_motionSensor.h"
+#include "caps_sender.h"
 
 static int caps_motionSensor_attr_motion_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_motionSensor_get_motion_value(caps_motionSensor_data_t *
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->motion_value;
+    if (caps_data->motion_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_motionSensor.attr_motion.values[caps_data->motion_idx];
 }
 
 static void caps_motionSensor_set_motion_value(caps_motionSensor_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->motion_value) {
-        free(caps_data->motion_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_motionSensor_attr_motion_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for motion\n", value);
+        return;
     }
-    caps_data->motion_value = strdup(value);
+    caps_data->motion_idx = index;
+}
+
+static int caps_motionSensor_get_motion_idx(caps_motionSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->motion_idx;
+}
+
+static void caps_motionSensor_set_motion_idx(caps_motionSensor_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_MOTIONSENSOR_MOTION_VALUE_MAX) {
+        printf("%d is not supported index for motion\n", idx);
+        return;
+    }
+    caps_data->motion_idx = idx;
 }
 
 static void caps_motionSensor_attr_motion_send(caps_motionSensor_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_motionSensor_attr_motion_send(caps_motionSensor_data_t *caps_da
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->motion_value) {
+    if (caps_data->motion_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_motionSensor.attr_motion.name,
-            caps_data->motion_value,
+            (char *)caps_helper_motionSensor.attr_motion.values[caps_data->motion_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_motionSensor_attr_motion_send(caps_motionSensor_data_t *caps_da
 static void caps_motionSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_motionSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_motionSensor_attr_motion_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_motionSensor_data_t *caps_motionSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_motionSensor_data_t *caps_motionSensor_initialize(IOT_CTX *ctx, const char
 
     caps_data->get_motion_value = caps_motionSensor_get_motion_value;
     caps_data->set_motion_value = caps_motionSensor_set_motion_value;
+    caps_data->get_motion_idx = caps_motionSensor_get_motion_idx;
+    caps_data->set_motion_idx = caps_motionSensor_set_motion_idx;
     caps_data->attr_motion_str2idx = caps_motionSensor_attr_motion_str2idx;
     caps_data->attr_motion_send = caps_motionSensor_attr_motion_send;
+    caps_data->motion_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_motionSensor.id, caps_motionSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_motionSensor.id, caps_motionSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init motionSensor handle\n");
@@ -120,3 +160,16 @@ caps_motionSensor_data_t *caps_motionSensor_initialize(IOT_CTX *ctx, const char
 
     return caps_data;
 }
+
+void caps_motionSensor_deinitialize(caps_motionSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
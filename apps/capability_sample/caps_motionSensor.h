@@ -27,10 +27,12 @@ typedef struct caps_motionSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *motion_value;
+    int motion_idx;
 
     const char *(*get_motion_value)(struct caps_motionSensor_data *caps_data);
     void (*set_motion_value)(struct caps_motionSensor_data *caps_data, const char *value);
+    int (*get_motion_idx)(struct caps_motionSensor_data *caps_data);
+    void (*set_motion_idx)(struct caps_motionSensor_data *caps_data, int idx);
     int (*attr_motion_str2idx)(const char *value);
     void (*attr_motion_send)(struct caps_motionSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_motionSensor_data {
 } caps_motionSensor_data_t;
 
 caps_motionSensor_data_t *caps_motionSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_motionSensor_deinitialize(caps_motionSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
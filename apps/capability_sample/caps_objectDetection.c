@@ -22,34 +22,32 @@
 
 #include "st_dev.h"
 #include "caps_objectDetection.h"
+#include "caps_sender.h"
 
-static const JSON_H *caps_objectDetection_get_detected_value(caps_objectDetection_data_t *caps_data)
+static const char *caps_objectDetection_get_detected_value(caps_objectDetection_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return (const JSON_H *)caps_data->detected_value;
+    return caps_data->detected_value;
 }
 
-static void caps_objectDetection_set_detected_value(caps_objectDetection_data_t *caps_data, const JSON_H *value)
+static void caps_objectDetection_set_detected_value(caps_objectDetection_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
     if (caps_data->detected_value) {
-        JSON_DELETE(caps_data->detected_value);
+        free(caps_data->detected_value);
     }
-    caps_data->detected_value = JSON_DUPLICATE(value, true);
+    caps_data->detected_value = strdup(value);
 }
 
 static void caps_objectDetection_attr_detected_send(caps_objectDetection_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt;
-    uint8_t evt_num = 1;
     int sequence_no = -1;
-    iot_cap_val_t value;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
@@ -60,26 +58,17 @@ static void caps_objectDetection_attr_detected_send(caps_objectDetection_data_t
         return;
     }
 
-    value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
-    value.json_object = JSON_PRINT(caps_data->detected_value);
-
-    cap_evt = st_cap_create_attr(caps_data->handle,
-        (char *)caps_helper_objectDetection.attr_detected.name,
-        &value,
-        NULL,
-        NULL);
-
-    if (!cap_evt) {
-        printf("fail to create cap_evt\n");
-        return;
-    }
+    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,
+            (char *)caps_helper_objectDetection.attr_detected.name,
+            caps_data->detected_value,
+            NULL,
+            NULL,
+            sequence_no);
 
-    sequence_no = st_cap_send_attr(&cap_evt, evt_num);
     if (sequence_no < 0)
         printf("fail to send detected value\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt);
 }
 
 
@@ -99,7 +88,7 @@ static void caps_objectDetection_set_supportedValues_value(caps_objectDetection_
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedValues_value) {
+    if (caps_data->supportedValues_value && !caps_data->supportedValues_borrowed) {
         for (i = 0; i < caps_data->supportedValues_arraySize; i++) {
             free(caps_data->supportedValues_value[i]);
         }
@@ -116,6 +105,27 @@ static void caps_objectDetection_set_supportedValues_value(caps_objectDetection_
     }
 
     caps_data->supportedValues_arraySize = arraySize;
+    caps_data->supportedValues_borrowed = 0;
+}
+
+static void caps_objectDetection_set_supportedValues_value_borrowed(caps_objectDetection_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedValues_value && !caps_data->supportedValues_borrowed) {
+        for (i = 0; i < caps_data->supportedValues_arraySize; i++) {
+            free(caps_data->supportedValues_value[i]);
+        }
+        free(caps_data->supportedValues_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedValues_value = (char **)value;
+    caps_data->supportedValues_arraySize = arraySize;
+    caps_data->supportedValues_borrowed = 1;
 }
 
 static void caps_objectDetection_attr_supportedValues_send(caps_objectDetection_data_t *caps_data)
@@ -131,7 +141,7 @@ static void caps_objectDetection_attr_supportedValues_send(caps_objectDetection_
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_objectDetection.attr_supportedValues.name,
             caps_data->supportedValues_value,
             caps_data->supportedValues_arraySize,
@@ -149,10 +159,13 @@ static void caps_objectDetection_attr_supportedValues_send(caps_objectDetection_
 static void caps_objectDetection_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_objectDetection_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_objectDetection_attr_detected_send(caps_data);
     caps_objectDetection_attr_supportedValues_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_objectDetection_data_t *caps_objectDetection_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -175,9 +188,10 @@ caps_objectDetection_data_t *caps_objectDetection_initialize(IOT_CTX *ctx, const
     caps_data->attr_detected_send = caps_objectDetection_attr_detected_send;
     caps_data->get_supportedValues_value = caps_objectDetection_get_supportedValues_value;
     caps_data->set_supportedValues_value = caps_objectDetection_set_supportedValues_value;
+    caps_data->set_supportedValues_value_borrowed = caps_objectDetection_set_supportedValues_value_borrowed;
     caps_data->attr_supportedValues_send = caps_objectDetection_attr_supportedValues_send;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_objectDetection.id, caps_objectDetection_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_objectDetection.id, caps_objectDetection_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init objectDetection handle\n");
@@ -185,3 +199,25 @@ caps_objectDetection_data_t *caps_objectDetection_initialize(IOT_CTX *ctx, const
 
     return caps_data;
 }
+
+void caps_objectDetection_deinitialize(caps_objectDetection_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedValues_value && !caps_data->supportedValues_borrowed) {
+        for (i = 0; i < caps_data->supportedValues_arraySize; i++) {
+            free(caps_data->supportedValues_value[i]);
+        }
+        free(caps_data->supportedValues_value);
+    }
+    free(caps_data->detected_value);
+    free(caps_data);
+}
@@ -28,21 +28,24 @@ typedef struct caps_objectDetection_data {
     void *usr_data;
     void *cmd_data;
 
-    JSON_H *detected_value;
+    char *detected_value;
     char **supportedValues_value;
     int supportedValues_arraySize;
+    int supportedValues_borrowed;
 
-    const JSON_H *(*get_detected_value)(struct caps_objectDetection_data *caps_data);
-    void (*set_detected_value)(struct caps_objectDetection_data *caps_data, const JSON_H *value);
+    const char *(*get_detected_value)(struct caps_objectDetection_data *caps_data);
+    void (*set_detected_value)(struct caps_objectDetection_data *caps_data, const char *value);
     void (*attr_detected_send)(struct caps_objectDetection_data *caps_data);
     const char **(*get_supportedValues_value)(struct caps_objectDetection_data *caps_data);
     void (*set_supportedValues_value)(struct caps_objectDetection_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedValues_value_borrowed)(struct caps_objectDetection_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedValues_send)(struct caps_objectDetection_data *caps_data);
 
     void (*init_usr_cb)(struct caps_objectDetection_data *caps_data);
 } caps_objectDetection_data_t;
 
 caps_objectDetection_data_t *caps_objectDetection_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_objectDetection_deinitialize(caps_objectDetection_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_odorSensor.h"
+#include "caps_sender.h"
 
 static int caps_odorSensor_get_odorLevel_value(caps_odorSensor_data_t *caps_data)
 {
@@ -50,7 +51,7 @@ static void caps_odorSensor_attr_odorLevel_send(caps_odorSensor_data_t *caps_dat
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_odorSensor.attr_odorLevel.name,
             caps_data->odorLevel_value,
             NULL,
@@ -68,9 +69,12 @@ static void caps_odorSensor_attr_odorLevel_send(caps_odorSensor_data_t *caps_dat
 static void caps_odorSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_odorSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_odorSensor_attr_odorLevel_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_odorSensor_data_t *caps_odorSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -93,7 +97,7 @@ caps_odorSensor_data_t *caps_odorSensor_initialize(IOT_CTX *ctx, const char *com
     caps_data->attr_odorLevel_send = caps_odorSensor_attr_odorLevel_send;
     caps_data->odorLevel_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_odorSensor.id, caps_odorSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_odorSensor.id, caps_odorSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init odorSensor handle\n");
@@ -101,3 +105,16 @@ caps_odorSensor_data_t *caps_odorSensor_initialize(IOT_CTX *ctx, const char *com
 
     return caps_data;
 }
+
+void caps_odorSensor_deinitialize(caps_odorSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -37,6 +37,7 @@ typedef struct caps_odorSensor_data {
 } caps_odorSensor_data_t;
 
 caps_odorSensor_data_t *caps_odorSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_odorSensor_deinitialize(caps_odorSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,9 @@
 
 #include "st_dev.h"
 #include "caps_ovenOperatingState.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+#include "caps_cmd.h"
 
 static int caps_ovenOperatingState_attr_ovenJobState_str2idx(const char *value)
 {
@@ -41,19 +44,52 @@ static const char *caps_ovenOperatingState_get_ovenJobState_value(caps_ovenOpera
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->ovenJobState_value;
+    if (caps_data->ovenJobState_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_ovenOperatingState.attr_ovenJobState.values[caps_data->ovenJobState_idx];
 }
 
 static void caps_ovenOperatingState_set_ovenJobState_value(caps_ovenOperatingState_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->ovenJobState_value) {
-        free(caps_data->ovenJobState_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
     }
-    caps_data->ovenJobState_value = strdup(value);
+    index = caps_ovenOperatingState_attr_ovenJobState_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for ovenJobState\n", value);
+        return;
+    }
+    caps_data->ovenJobState_idx = index;
+}
+
+static int caps_ovenOperatingState_get_ovenJobState_idx(caps_ovenOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->ovenJobState_idx;
+}
+
+static void caps_ovenOperatingState_set_ovenJobState_idx(caps_ovenOperatingState_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_MAX) {
+        printf("%d is not supported index for ovenJobState\n", idx);
+        return;
+    }
+    caps_data->ovenJobState_idx = idx;
 }
 
 static void caps_ovenOperatingState_attr_ovenJobState_send(caps_ovenOperatingState_data_t *caps_data)
@@ -64,14 +100,14 @@ static void caps_ovenOperatingState_attr_ovenJobState_send(caps_ovenOperatingSta
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->ovenJobState_value) {
+    if (caps_data->ovenJobState_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_ovenJobState.name,
-            caps_data->ovenJobState_value,
+            (char *)caps_helper_ovenOperatingState.attr_ovenJobState.values[caps_data->ovenJobState_idx],
             NULL,
             NULL,
             sequence_no);
@@ -90,19 +126,16 @@ static const char *caps_ovenOperatingState_get_completionTime_value(caps_ovenOpe
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->completionTime_value;
+    return caps_data->completionTime_value[0] ? caps_data->completionTime_value : NULL;
 }
 
-static void caps_ovenOperatingState_set_completionTime_value(caps_ovenOperatingState_data_t *caps_data, const char *value)
+static int caps_ovenOperatingState_set_completionTime_value(caps_ovenOperatingState_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
-        return;
+        return -1;
     }
-    if (caps_data->completionTime_value) {
-        free(caps_data->completionTime_value);
-    }
-    caps_data->completionTime_value = strdup(value);
+    return caps_util_copy_string(caps_data->completionTime_value, sizeof(caps_data->completionTime_value), value);
 }
 
 static void caps_ovenOperatingState_attr_completionTime_send(caps_ovenOperatingState_data_t *caps_data)
@@ -113,12 +146,12 @@ static void caps_ovenOperatingState_attr_completionTime_send(caps_ovenOperatingS
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->completionTime_value) {
+    if (!caps_data->completionTime_value[0]) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_completionTime.name,
             caps_data->completionTime_value,
             NULL,
@@ -148,7 +181,7 @@ static void caps_ovenOperatingState_set_supportedMachineStates_value(caps_ovenOp
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedMachineStates_value) {
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
         for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
             free(caps_data->supportedMachineStates_value[i]);
         }
@@ -165,6 +198,27 @@ static void caps_ovenOperatingState_set_supportedMachineStates_value(caps_ovenOp
     }
 
     caps_data->supportedMachineStates_arraySize = arraySize;
+    caps_data->supportedMachineStates_borrowed = 0;
+}
+
+static void caps_ovenOperatingState_set_supportedMachineStates_value_borrowed(caps_ovenOperatingState_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
+        for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
+            free(caps_data->supportedMachineStates_value[i]);
+        }
+        free(caps_data->supportedMachineStates_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedMachineStates_value = (char **)value;
+    caps_data->supportedMachineStates_arraySize = arraySize;
+    caps_data->supportedMachineStates_borrowed = 1;
 }
 
 static void caps_ovenOperatingState_attr_supportedMachineStates_send(caps_ovenOperatingState_data_t *caps_data)
@@ -180,7 +234,7 @@ static void caps_ovenOperatingState_attr_supportedMachineStates_send(caps_ovenOp
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_supportedMachineStates.name,
             caps_data->supportedMachineStates_value,
             caps_data->supportedMachineStates_arraySize,
@@ -240,7 +294,7 @@ static void caps_ovenOperatingState_attr_progress_send(caps_ovenOperatingState_d
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_progress.name,
             caps_data->progress_value,
             caps_data->progress_unit,
@@ -281,7 +335,7 @@ static void caps_ovenOperatingState_attr_operationTime_send(caps_ovenOperatingSt
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_operationTime.name,
             caps_data->operationTime_value,
             NULL,
@@ -314,19 +368,52 @@ static const char *caps_ovenOperatingState_get_machineState_value(caps_ovenOpera
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->machineState_value;
+    if (caps_data->machineState_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_ovenOperatingState.attr_machineState.values[caps_data->machineState_idx];
 }
 
 static void caps_ovenOperatingState_set_machineState_value(caps_ovenOperatingState_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_ovenOperatingState_attr_machineState_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for machineState\n", value);
+        return;
+    }
+    caps_data->machineState_idx = index;
+}
+
+static int caps_ovenOperatingState_get_machineState_idx(caps_ovenOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->machineState_idx;
+}
+
+static void caps_ovenOperatingState_set_machineState_idx(caps_ovenOperatingState_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->machineState_value) {
-        free(caps_data->machineState_value);
+    if (idx < 0 || idx >= CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_MAX) {
+        printf("%d is not supported index for machineState\n", idx);
+        return;
     }
-    caps_data->machineState_value = strdup(value);
+    caps_data->machineState_idx = idx;
 }
 
 static void caps_ovenOperatingState_attr_machineState_send(caps_ovenOperatingState_data_t *caps_data)
@@ -337,14 +424,14 @@ static void caps_ovenOperatingState_attr_machineState_send(caps_ovenOperatingSta
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->machineState_value) {
+    if (caps_data->machineState_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_ovenOperatingState.attr_machineState.name,
-            caps_data->machineState_value,
+            (char *)caps_helper_ovenOperatingState.attr_machineState.values[caps_data->machineState_idx],
             NULL,
             NULL,
             sequence_no);
@@ -394,6 +481,8 @@ static void caps_ovenOperatingState_cmd_setMachineState_cb(IOT_CAP_HANDLE *handl
 static void caps_ovenOperatingState_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_ovenOperatingState_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_ovenOperatingState_attr_ovenJobState_send(caps_data);
@@ -402,6 +491,7 @@ static void caps_ovenOperatingState_init_cb(IOT_CAP_HANDLE *handle, void *usr_da
     caps_ovenOperatingState_attr_progress_send(caps_data);
     caps_ovenOperatingState_attr_operationTime_send(caps_data);
     caps_ovenOperatingState_attr_machineState_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -422,6 +512,8 @@ caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx,
 
     caps_data->get_ovenJobState_value = caps_ovenOperatingState_get_ovenJobState_value;
     caps_data->set_ovenJobState_value = caps_ovenOperatingState_set_ovenJobState_value;
+    caps_data->get_ovenJobState_idx = caps_ovenOperatingState_get_ovenJobState_idx;
+    caps_data->set_ovenJobState_idx = caps_ovenOperatingState_set_ovenJobState_idx;
     caps_data->attr_ovenJobState_str2idx = caps_ovenOperatingState_attr_ovenJobState_str2idx;
     caps_data->attr_ovenJobState_send = caps_ovenOperatingState_attr_ovenJobState_send;
     caps_data->get_completionTime_value = caps_ovenOperatingState_get_completionTime_value;
@@ -429,6 +521,7 @@ caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx,
     caps_data->attr_completionTime_send = caps_ovenOperatingState_attr_completionTime_send;
     caps_data->get_supportedMachineStates_value = caps_ovenOperatingState_get_supportedMachineStates_value;
     caps_data->set_supportedMachineStates_value = caps_ovenOperatingState_set_supportedMachineStates_value;
+    caps_data->set_supportedMachineStates_value_borrowed = caps_ovenOperatingState_set_supportedMachineStates_value_borrowed;
     caps_data->attr_supportedMachineStates_send = caps_ovenOperatingState_attr_supportedMachineStates_send;
     caps_data->get_progress_value = caps_ovenOperatingState_get_progress_value;
     caps_data->set_progress_value = caps_ovenOperatingState_set_progress_value;
@@ -440,23 +533,27 @@ caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx,
     caps_data->attr_operationTime_send = caps_ovenOperatingState_attr_operationTime_send;
     caps_data->get_machineState_value = caps_ovenOperatingState_get_machineState_value;
     caps_data->set_machineState_value = caps_ovenOperatingState_set_machineState_value;
+    caps_data->get_machineState_idx = caps_ovenOperatingState_get_machineState_idx;
+    caps_data->set_machineState_idx = caps_ovenOperatingState_set_machineState_idx;
     caps_data->attr_machineState_str2idx = caps_ovenOperatingState_attr_machineState_str2idx;
     caps_data->attr_machineState_send = caps_ovenOperatingState_attr_machineState_send;
     caps_data->progress_value = 0;
     caps_data->operationTime_value = 0;
+    caps_data->ovenJobState_idx = -1;
+    caps_data->machineState_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_ovenOperatingState.id, caps_ovenOperatingState_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_ovenOperatingState.id, caps_ovenOperatingState_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_start.name, caps_ovenOperatingState_cmd_start_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_start.name, caps_ovenOperatingState_cmd_start_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for start of ovenOperatingState\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_stop.name, caps_ovenOperatingState_cmd_stop_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_stop.name, caps_ovenOperatingState_cmd_stop_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for stop of ovenOperatingState\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_setMachineState.name, caps_ovenOperatingState_cmd_setMachineState_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_ovenOperatingState.cmd_setMachineState.name, caps_ovenOperatingState_cmd_setMachineState_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setMachineState of ovenOperatingState\n");
     }
@@ -466,3 +563,25 @@ caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx,
 
     return caps_data;
 }
+
+void caps_ovenOperatingState_deinitialize(caps_ovenOperatingState_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedMachineStates_value && !caps_data->supportedMachineStates_borrowed) {
+        for (i = 0; i < caps_data->supportedMachineStates_arraySize; i++) {
+            free(caps_data->supportedMachineStates_value[i]);
+        }
+        free(caps_data->supportedMachineStates_value);
+    }
+    free(caps_data);
+}
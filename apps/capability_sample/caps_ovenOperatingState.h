@@ -17,6 +17,7 @@
  ****************************************************************************/
 
 #include "caps/iot_caps_helper_ovenOperatingState.h"
+#include "caps_util.h"
 #include "JSON.h"
 
 #ifdef __cplusplus
@@ -28,24 +29,28 @@ typedef struct caps_ovenOperatingState_data {
     void *usr_data;
     void *cmd_data;
 
-    char *ovenJobState_value;
-    char *completionTime_value;
+    int ovenJobState_idx;
+    char completionTime_value[CAPS_UTIL_TIME_STRING_SIZE];
     char **supportedMachineStates_value;
     int supportedMachineStates_arraySize;
+    int supportedMachineStates_borrowed;
     int progress_value;
     char *progress_unit;
     int operationTime_value;
-    char *machineState_value;
+    int machineState_idx;
 
     const char *(*get_ovenJobState_value)(struct caps_ovenOperatingState_data *caps_data);
     void (*set_ovenJobState_value)(struct caps_ovenOperatingState_data *caps_data, const char *value);
+    int (*get_ovenJobState_idx)(struct caps_ovenOperatingState_data *caps_data);
+    void (*set_ovenJobState_idx)(struct caps_ovenOperatingState_data *caps_data, int idx);
     int (*attr_ovenJobState_str2idx)(const char *value);
     void (*attr_ovenJobState_send)(struct caps_ovenOperatingState_data *caps_data);
     const char *(*get_completionTime_value)(struct caps_ovenOperatingState_data *caps_data);
-    void (*set_completionTime_value)(struct caps_ovenOperatingState_data *caps_data, const char *value);
+    int (*set_completionTime_value)(struct caps_ovenOperatingState_data *caps_data, const char *value);
     void (*attr_completionTime_send)(struct caps_ovenOperatingState_data *caps_data);
     const char **(*get_supportedMachineStates_value)(struct caps_ovenOperatingState_data *caps_data);
     void (*set_supportedMachineStates_value)(struct caps_ovenOperatingState_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedMachineStates_value_borrowed)(struct caps_ovenOperatingState_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedMachineStates_send)(struct caps_ovenOperatingState_data *caps_data);
     int (*get_progress_value)(struct caps_ovenOperatingState_data *caps_data);
     void (*set_progress_value)(struct caps_ovenOperatingState_data *caps_data, int value);
@@ -57,6 +62,8 @@ typedef struct caps_ovenOperatingState_data {
     void (*attr_operationTime_send)(struct caps_ovenOperatingState_data *caps_data);
     const char *(*get_machineState_value)(struct caps_ovenOperatingState_data *caps_data);
     void (*set_machineState_value)(struct caps_ovenOperatingState_data *caps_data, const char *value);
+    int (*get_machineState_idx)(struct caps_ovenOperatingState_data *caps_data);
+    void (*set_machineState_idx)(struct caps_ovenOperatingState_data *caps_data, int idx);
     int (*attr_machineState_str2idx)(const char *value);
     void (*attr_machineState_send)(struct caps_ovenOperatingState_data *caps_data);
 
@@ -68,6 +75,7 @@ typedef struct caps_ovenOperatingState_data {
 } caps_ovenOperatingState_data_t;
 
 caps_ovenOperatingState_data_t *caps_ovenOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_ovenOperatingState_deinitialize(caps_ovenOperatingState_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,7 @@ typedef struct caps_ovenSetpoint_data {
 } caps_ovenSetpoint_data_t;
 
 caps_ovenSetpoint_data_t *caps_ovenSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_ovenSetpoint_deinitialize(caps_ovenSetpoint_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,73 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_PAYLOAD_CACHE_H_
+#define _CAPS_PAYLOAD_CACHE_H_
+
+#include "st_dev.h"
+#include "caps_sender.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of attributes which can keep a built event */
+#ifndef CAPS_PAYLOAD_CACHE_SIZE
+#define CAPS_PAYLOAD_CACHE_SIZE 16
+#endif
+
+typedef struct caps_payload_cache_stats {
+    unsigned int hit_count;     /* sends which reused the kept event */
+    unsigned int build_count;   /* events built for a new value */
+    unsigned int busy_count;    /* kept event still queued, a one-off event was built */
+} caps_payload_cache_stats_t;
+
+/**
+ * Built event cache for capability attributes.
+ *
+ * Every send builds an IOT_EVENT with st_cap_create_attr(), which allocates
+ * and copies the name, value, unit and data. For a registered attribute the
+ * event is kept after the send and reused while the value, unit and data stay
+ * the same, so a refresh, an init publish after a reconnect or a heartbeat
+ * of an unchanged value costs a compare instead of the allocations. Values
+ * longer than CAPS_SEND_CACHE_VALUE_SIZE with the unit and data can't be
+ * compared in full and get a new event every time.
+ *
+ * attribute must stay valid while registered, e.g. caps_helper_X.attr_Y.name.
+ */
+int caps_payload_cache_register(IOT_CAP_HANDLE *handle, const char *attribute);
+
+/* Free the kept events of a handle, or of every handle if handle is NULL */
+void caps_payload_cache_invalidate(IOT_CAP_HANDLE *handle);
+
+void caps_payload_cache_get_stats(caps_payload_cache_stats_t *stats);
+void caps_payload_cache_reset_stats(void);
+
+/*
+ * Used by caps_sender. get returns the kept or a rebuilt event of attr, or NULL
+ * if attr is not registered or its event is still queued. Every sent or dropped
+ * event goes to free_events, which keeps the events of the cache and frees the others.
+ */
+IOT_EVENT *caps_payload_cache_get(const caps_attr_t *attr);
+void caps_payload_cache_free_events(IOT_EVENT **cap_evt, int evt_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_PAYLOAD_CACHE_H_ */
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_powerMeter.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_powerMeter_get_power_milli(caps_powerMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_powerMeter.attr_power.min) - 1;
+    }
+    return caps_data->power_milli;
+}
+
+static void caps_powerMeter_set_power_milli(caps_powerMeter_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_powerMeter.attr_power.min)) {
+        printf("%lld is out of range for power\n", (long long)milli);
+        return;
+    }
+    caps_data->power_milli = milli;
+}
 
 static double caps_powerMeter_get_power_value(caps_powerMeter_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_powerMeter_get_power_value(caps_powerMeter_data_t *caps_data)
         printf("caps_data is NULL\n");
         return caps_helper_powerMeter.attr_power.min - 1;
     }
-    return caps_data->power_value;
+    return caps_util_milli_to_double(caps_data->power_milli);
 }
 
 static void caps_powerMeter_set_power_value(caps_powerMeter_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->power_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for power\n");
+        return;
+    }
+    caps_powerMeter_set_power_milli(caps_data, milli);
 }
 
 static const char *caps_powerMeter_get_power_unit(caps_powerMeter_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_powerMeter_attr_power_send(caps_powerMeter_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_powerMeter.attr_power.name,
-            caps_data->power_value,
+            caps_data->power_milli,
             caps_data->power_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_powerMeter_attr_power_send(caps_powerMeter_data_t *caps_data)
 static void caps_powerMeter_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_powerMeter_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_powerMeter_attr_power_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_powerMeter_data_t *caps_powerMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_powerMeter_data_t *caps_powerMeter_initialize(IOT_CTX *ctx, const char *com
 
     caps_data->get_power_value = caps_powerMeter_get_power_value;
     caps_data->set_power_value = caps_powerMeter_set_power_value;
+    caps_data->get_power_milli = caps_powerMeter_get_power_milli;
+    caps_data->set_power_milli = caps_powerMeter_set_power_milli;
     caps_data->get_power_unit = caps_powerMeter_get_power_unit;
     caps_data->set_power_unit = caps_powerMeter_set_power_unit;
     caps_data->attr_power_send = caps_powerMeter_attr_power_send;
-    caps_data->power_value = 0;
+    caps_data->power_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_powerMeter.id, caps_powerMeter_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_powerMeter.id, caps_powerMeter_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init powerMeter handle\n");
@@ -120,3 +155,16 @@ caps_powerMeter_data_t *caps_powerMeter_initialize(IOT_CTX *ctx, const char *com
 
     return caps_data;
 }
+
+void caps_powerMeter_deinitialize(caps_powerMeter_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
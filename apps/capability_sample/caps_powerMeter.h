@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_powerMeter.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_powerMeter_data {
     void *usr_data;
     void *cmd_data;
 
-    double power_value;
+    int64_t power_milli;
     char *power_unit;
 
     double (*get_power_value)(struct caps_powerMeter_data *caps_data);
     void (*set_power_value)(struct caps_powerMeter_data *caps_data, double value);
+    int64_t (*get_power_milli)(struct caps_powerMeter_data *caps_data);
+    void (*set_power_milli)(struct caps_powerMeter_data *caps_data, int64_t milli);
     const char *(*get_power_unit)(struct caps_powerMeter_data *caps_data);
     void (*set_power_unit)(struct caps_powerMeter_data *caps_data, const char *unit);
     void (*attr_power_send)(struct caps_powerMeter_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_powerMeter_data {
 } caps_powerMeter_data_t;
 
 caps_powerMeter_data_t *caps_powerMeter_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_powerMeter_deinitialize(caps_powerMeter_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
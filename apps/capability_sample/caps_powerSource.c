@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_powerSource.h"
+#include "caps_sender.h"
 
 static int caps_powerSource_attr_powerSource_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_powerSource_get_powerSource_value(caps_powerSource_data_
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->powerSource_value;
+    if (caps_data->powerSource_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_powerSource.attr_powerSource.values[caps_data->powerSource_idx];
 }
 
 static void caps_powerSource_set_powerSource_value(caps_powerSource_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->powerSource_value) {
-        free(caps_data->powerSource_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_powerSource_attr_powerSource_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for powerSource\n", value);
+        return;
     }
-    caps_data->powerSource_value = strdup(value);
+    caps_data->powerSource_idx = index;
+}
+
+static int caps_powerSource_get_powerSource_idx(caps_powerSource_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->powerSource_idx;
+}
+
+static void caps_powerSource_set_powerSource_idx(caps_powerSource_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_POWERSOURCE_POWERSOURCE_VALUE_MAX) {
+        printf("%d is not supported index for powerSource\n", idx);
+        return;
+    }
+    caps_data->powerSource_idx = idx;
 }
 
 static void caps_powerSource_attr_powerSource_send(caps_powerSource_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_powerSource_attr_powerSource_send(caps_powerSource_data_t *caps
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->powerSource_value) {
+    if (caps_data->powerSource_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_powerSource.attr_powerSource.name,
-            caps_data->powerSource_value,
+            (char *)caps_helper_powerSource.attr_powerSource.values[caps_data->powerSource_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_powerSource_attr_powerSource_send(caps_powerSource_data_t *caps
 static void caps_powerSource_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_powerSource_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_powerSource_attr_powerSource_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_powerSource_data_t *caps_powerSource_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_powerSource_data_t *caps_powerSource_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_powerSource_value = caps_powerSource_get_powerSource_value;
     caps_data->set_powerSource_value = caps_powerSource_set_powerSource_value;
+    caps_data->get_powerSource_idx = caps_powerSource_get_powerSource_idx;
+    caps_data->set_powerSource_idx = caps_powerSource_set_powerSource_idx;
     caps_data->attr_powerSource_str2idx = caps_powerSource_attr_powerSource_str2idx;
     caps_data->attr_powerSource_send = caps_powerSource_attr_powerSource_send;
+    caps_data->powerSource_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_powerSource.id, caps_powerSource_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_powerSource.id, caps_powerSource_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init powerSource handle\n");
@@ -120,3 +160,16 @@ caps_powerSource_data_t *caps_powerSource_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_powerSource_deinitialize(caps_powerSource_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_powerSource_data {
     void *usr_data;
     void *cmd_data;
 
-    char *powerSource_value;
+    int powerSource_idx;
 
     const char *(*get_powerSource_value)(struct caps_powerSource_data *caps_data);
     void (*set_powerSource_value)(struct caps_powerSource_data *caps_data, const char *value);
+    int (*get_powerSource_idx)(struct caps_powerSource_data *caps_data);
+    void (*set_powerSource_idx)(struct caps_powerSource_data *caps_data, int idx);
     int (*attr_powerSource_str2idx)(const char *value);
     void (*attr_powerSource_send)(struct caps_powerSource_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_powerSource_data {
 } caps_powerSource_data_t;
 
 caps_powerSource_data_t *caps_powerSource_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_powerSource_deinitialize(caps_powerSource_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_presenceSensor.h"
+#include "caps_sender.h"
 
 static int caps_presenceSensor_attr_presence_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_presenceSensor_get_presence_value(caps_presenceSensor_da
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->presence_value;
+    if (caps_data->presence_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_presenceSensor.attr_presence.values[caps_data->presence_idx];
 }
 
 static void caps_presenceSensor_set_presence_value(caps_presenceSensor_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->presence_value) {
-        free(caps_data->presence_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_presenceSensor_attr_presence_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for presence\n", value);
+        return;
     }
-    caps_data->presence_value = strdup(value);
+    caps_data->presence_idx = index;
+}
+
+static int caps_presenceSensor_get_presence_idx(caps_presenceSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->presence_idx;
+}
+
+static void caps_presenceSensor_set_presence_idx(caps_presenceSensor_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_PRESENCESENSOR_PRESENCE_VALUE_MAX) {
+        printf("%d is not supported index for presence\n", idx);
+        return;
+    }
+    caps_data->presence_idx = idx;
 }
 
 static void caps_presenceSensor_attr_presence_send(caps_presenceSensor_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_presenceSensor_attr_presence_send(caps_presenceSensor_data_t *c
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->presence_value) {
+    if (caps_data->presence_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_presenceSensor.attr_presence.name,
-            caps_data->presence_value,
+            (char *)caps_helper_presenceSensor.attr_presence.values[caps_data->presence_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_presenceSensor_attr_presence_send(caps_presenceSensor_data_t *c
 static void caps_presenceSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_presenceSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_presenceSensor_attr_presence_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_presenceSensor_data_t *caps_presenceSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_presenceSensor_data_t *caps_presenceSensor_initialize(IOT_CTX *ctx, const c
 
     caps_data->get_presence_value = caps_presenceSensor_get_presence_value;
     caps_data->set_presence_value = caps_presenceSensor_set_presence_value;
+    caps_data->get_presence_idx = caps_presenceSensor_get_presence_idx;
+    caps_data->set_presence_idx = caps_presenceSensor_set_presence_idx;
     caps_data->attr_presence_str2idx = caps_presenceSensor_attr_presence_str2idx;
     caps_data->attr_presence_send = caps_presenceSensor_attr_presence_send;
+    caps_data->presence_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_presenceSensor.id, caps_presenceSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_presenceSensor.id, caps_presenceSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init presenceSensor handle\n");
@@ -120,3 +160,16 @@ caps_presenceSensor_data_t *caps_presenceSensor_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_presenceSensor_deinitialize(caps_presenceSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_presenceSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *presence_value;
+    int presence_idx;
 
     const char *(*get_presence_value)(struct caps_presenceSensor_data *caps_data);
     void (*set_presence_value)(struct caps_presenceSensor_data *caps_data, const char *value);
+    int (*get_presence_idx)(struct caps_presenceSensor_data *caps_data);
+    void (*set_presence_idx)(struct caps_presenceSensor_data *caps_data, int idx);
     int (*attr_presence_str2idx)(const char *value);
     void (*attr_presence_send)(struct caps_presenceSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_presenceSensor_data {
 } caps_presenceSensor_data_t;
 
 caps_presenceSensor_data_t *caps_presenceSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_presenceSensor_deinitialize(caps_presenceSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_rapidCooling.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_rapidCooling_attr_rapidCooling_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_rapidCooling_get_rapidCooling_value(caps_rapidCooling_da
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->rapidCooling_value;
+    if (caps_data->rapidCooling_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_rapidCooling.attr_rapidCooling.values[caps_data->rapidCooling_idx];
 }
 
 static void caps_rapidCooling_set_rapidCooling_value(caps_rapidCooling_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_rapidCooling_attr_rapidCooling_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for rapidCooling\n", value);
+        return;
+    }
+    caps_data->rapidCooling_idx = index;
+}
+
+static int caps_rapidCooling_get_rapidCooling_idx(caps_rapidCooling_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->rapidCooling_idx;
+}
+
+static void caps_rapidCooling_set_rapidCooling_idx(caps_rapidCooling_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->rapidCooling_value) {
-        free(caps_data->rapidCooling_value);
+    if (idx < 0 || idx >= CAP_ENUM_RAPIDCOOLING_RAPIDCOOLING_VALUE_MAX) {
+        printf("%d is not supported index for rapidCooling\n", idx);
+        return;
     }
-    caps_data->rapidCooling_value = strdup(value);
+    caps_data->rapidCooling_idx = idx;
 }
 
 static void caps_rapidCooling_attr_rapidCooling_send(caps_rapidCooling_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_rapidCooling_attr_rapidCooling_send(caps_rapidCooling_data_t *c
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->rapidCooling_value) {
+    if (caps_data->rapidCooling_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_rapidCooling.attr_rapidCooling.name,
-            caps_data->rapidCooling_value,
+            (char *)caps_helper_rapidCooling.attr_rapidCooling.values[caps_data->rapidCooling_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,7 +122,6 @@ static void caps_rapidCooling_attr_rapidCooling_send(caps_rapidCooling_data_t *c
 static void caps_rapidCooling_cmd_setRapidCooling_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_rapidCooling_data_t *caps_data = (caps_rapidCooling_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -97,9 +131,7 @@ static void caps_rapidCooling_cmd_setRapidCooling_cb(IOT_CAP_HANDLE *handle, iot
         printf("%s is not supported value for setRapidCooling\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_rapidCooling.attr_rapidCooling.values[index];
-
-    caps_rapidCooling_set_rapidCooling_value(caps_data, value);
+    caps_rapidCooling_set_rapidCooling_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setRapidCooling_usr_cb)
         caps_data->cmd_setRapidCooling_usr_cb(caps_data);
     caps_rapidCooling_attr_rapidCooling_send(caps_data);
@@ -108,9 +140,12 @@ static void caps_rapidCooling_cmd_setRapidCooling_cb(IOT_CAP_HANDLE *handle, iot
 static void caps_rapidCooling_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_rapidCooling_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_rapidCooling_attr_rapidCooling_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_rapidCooling_data_t *caps_rapidCooling_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -131,13 +166,16 @@ caps_rapidCooling_data_t *caps_rapidCooling_initialize(IOT_CTX *ctx, const char
 
     caps_data->get_rapidCooling_value = caps_rapidCooling_get_rapidCooling_value;
     caps_data->set_rapidCooling_value = caps_rapidCooling_set_rapidCooling_value;
+    caps_data->get_rapidCooling_idx = caps_rapidCooling_get_rapidCooling_idx;
+    caps_data->set_rapidCooling_idx = caps_rapidCooling_set_rapidCooling_idx;
     caps_data->attr_rapidCooling_str2idx = caps_rapidCooling_attr_rapidCooling_str2idx;
     caps_data->attr_rapidCooling_send = caps_rapidCooling_attr_rapidCooling_send;
+    caps_data->rapidCooling_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_rapidCooling.id, caps_rapidCooling_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_rapidCooling.id, caps_rapidCooling_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_rapidCooling.cmd_setRapidCooling.name, caps_rapidCooling_cmd_setRapidCooling_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_rapidCooling.cmd_setRapidCooling.name, caps_rapidCooling_cmd_setRapidCooling_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setRapidCooling of rapidCooling\n");
     }
@@ -147,3 +185,17 @@ caps_rapidCooling_data_t *caps_rapidCooling_initialize(IOT_CTX *ctx, const char
 
     return caps_data;
 }
+
+void caps_rapidCooling_deinitialize(caps_rapidCooling_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
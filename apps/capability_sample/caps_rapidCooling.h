@@ -27,10 +27,12 @@ typedef struct caps_rapidCooling_data {
     void *usr_data;
     void *cmd_data;
 
-    char *rapidCooling_value;
+    int rapidCooling_idx;
 
     const char *(*get_rapidCooling_value)(struct caps_rapidCooling_data *caps_data);
     void (*set_rapidCooling_value)(struct caps_rapidCooling_data *caps_data, const char *value);
+    int (*get_rapidCooling_idx)(struct caps_rapidCooling_data *caps_data);
+    void (*set_rapidCooling_idx)(struct caps_rapidCooling_data *caps_data, int idx);
     int (*attr_rapidCooling_str2idx)(const char *value);
     void (*attr_rapidCooling_send)(struct caps_rapidCooling_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_rapidCooling_data {
 } caps_rapidCooling_data_t;
 
 caps_rapidCooling_data_t *caps_rapidCooling_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_rapidCooling_deinitialize(caps_rapidCooling_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_refresh.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static void caps_refresh_cmd_refresh_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
@@ -36,8 +38,11 @@ static void caps_refresh_cmd_refresh_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data
 static void caps_refresh_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_refresh_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_refresh_data_t *caps_refresh_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -57,10 +62,10 @@ caps_refresh_data_t *caps_refresh_initialize(IOT_CTX *ctx, const char *component
     caps_data->usr_data = usr_data;
 
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_refresh.id, caps_refresh_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_refresh.id, caps_refresh_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_refresh.cmd_refresh.name, caps_refresh_cmd_refresh_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_refresh.cmd_refresh.name, caps_refresh_cmd_refresh_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for refresh of refresh\n");
     }
@@ -70,3 +75,17 @@ caps_refresh_data_t *caps_refresh_initialize(IOT_CTX *ctx, const char *component
 
     return caps_data;
 }
+
+void caps_refresh_deinitialize(caps_refresh_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
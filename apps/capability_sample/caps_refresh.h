@@ -35,6 +35,7 @@ typedef struct caps_refresh_data {
 } caps_refresh_data_t;
 
 caps_refresh_data_t *caps_refresh_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_refresh_deinitialize(caps_refresh_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
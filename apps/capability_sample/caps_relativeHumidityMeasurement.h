@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_relativeHumidityMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_relativeHumidityMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double humidity_value;
+    int64_t humidity_milli;
     char *humidity_unit;
 
     double (*get_humidity_value)(struct caps_relativeHumidityMeasurement_data *caps_data);
     void (*set_humidity_value)(struct caps_relativeHumidityMeasurement_data *caps_data, double value);
+    int64_t (*get_humidity_milli)(struct caps_relativeHumidityMeasurement_data *caps_data);
+    void (*set_humidity_milli)(struct caps_relativeHumidityMeasurement_data *caps_data, int64_t milli);
     const char *(*get_humidity_unit)(struct caps_relativeHumidityMeasurement_data *caps_data);
     void (*set_humidity_unit)(struct caps_relativeHumidityMeasurement_data *caps_data, const char *unit);
     void (*attr_humidity_send)(struct caps_relativeHumidityMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_relativeHumidityMeasurement_data {
 } caps_relativeHumidityMeasurement_data_t;
 
 caps_relativeHumidityMeasurement_data_t *caps_relativeHumidityMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_relativeHumidityMeasurement_deinitialize(caps_relativeHumidityMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
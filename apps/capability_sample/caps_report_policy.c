@@ -0,0 +1,479 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "st_dev.h"
+#include "JSON.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_report_policy.h"
+#include "caps_util.h"
+
+/* caps_sender only consults report policies when built with the flag */
+#ifndef CAPS_SENDER_USE_REPORT_POLICY
+#error "caps_report_policy needs CAPS_SENDER_USE_REPORT_POLICY defined for the whole build"
+#endif
+
+struct caps_report_policy_entry {
+    IOT_CAP_HANDLE *handle;
+    const char *attribute;      /* NULL when the name is kept in name */
+    char name[CAPS_REPORT_POLICY_NAME_SIZE];
+    caps_report_policy_t policy;
+
+    iot_cap_val_type_t type;
+    double current;             /* latest value given to the sender */
+    const char *current_unit;
+    int has_current;
+
+    double reported;            /* last value successfully sent */
+    const char *reported_unit;
+    unsigned int reported_ms;
+    int has_reported;
+
+    int held;                   /* a reportable change waits for min_interval_ms */
+};
+
+static struct caps_report_policy_entry policy_entry[CAPS_REPORT_POLICY_SIZE];
+static int policy_entry_num;
+static caps_report_policy_stats_t policy_stats;
+static iot_os_mutex policy_mutex;
+static int policy_ready;
+static iot_os_thread policy_thread;     /* created with the first policy, under policy_mutex */
+
+static int _is_numeric(const caps_attr_t *attr)
+{
+    return (attr->value.type == IOT_CAP_VAL_TYPE_INTEGER ||
+            attr->value.type == IOT_CAP_VAL_TYPE_NUMBER ||
+            attr->value.type == IOT_CAP_VAL_TYPE_INT_OR_NUM);
+}
+
+static double _numeric_value(const caps_attr_t *attr)
+{
+    if (attr->value.type == IOT_CAP_VAL_TYPE_INTEGER)
+        return attr->value.integer;
+    return attr->value.number;
+}
+
+static int _unit_changed(const char *a, const char *b)
+{
+    if (a == b)
+        return 0;
+    if (!a || !b)
+        return 1;
+    return strcmp(a, b) != 0;
+}
+
+static const char *_entry_name(const struct caps_report_policy_entry *entry)
+{
+    return entry->attribute ? entry->attribute : entry->name;
+}
+
+static struct caps_report_policy_entry *_find_entry(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    int i;
+
+    for (i = 0; i < policy_entry_num; i++) {
+        if (policy_entry[i].handle == handle &&
+                (policy_entry[i].attribute == attribute || !strcmp(_entry_name(&policy_entry[i]), attribute))) {
+            return &policy_entry[i];
+        }
+    }
+    return NULL;
+}
+
+static int _is_reportable_change(struct caps_report_policy_entry *entry)
+{
+    double delta = fabs(entry->current - entry->reported);
+    double threshold = entry->policy.change;
+
+    if (_unit_changed(entry->current_unit, entry->reported_unit))
+        return 1;
+    if (delta == 0)
+        return 0;
+    if (entry->policy.change_percent)
+        threshold = fabs(entry->reported) * entry->policy.change / 100;
+
+    return delta >= threshold;
+}
+
+static void _report_policy_task(void *arg)
+{
+    caps_attr_t attr[CAPS_SENDER_MAX_EVENTS];
+    /* kept names may be removed while the reports are sent */
+    char name[CAPS_SENDER_MAX_EVENTS][CAPS_REPORT_POLICY_NAME_SIZE];
+    unsigned int now_ms;
+    unsigned int elapsed_ms;
+    int attr_num;
+    int due;
+    int i;
+
+    for (;;) {
+        iot_os_delay(CAPS_REPORT_POLICY_TICK_MS);
+
+        attr_num = 0;
+        iot_os_mutex_lock(&policy_mutex);
+        now_ms = caps_util_get_time_ms();
+        for (i = 0; i < policy_entry_num && attr_num < CAPS_SENDER_MAX_EVENTS; i++) {
+            struct caps_report_policy_entry *entry = &policy_entry[i];
+
+            if (!entry->has_current || !entry->has_reported)
+                continue;
+
+            elapsed_ms = now_ms - entry->reported_ms;
+            due = 0;
+            if (entry->held && elapsed_ms >= entry->policy.min_interval_ms) {
+                policy_stats.deferred_count++;
+                due = 1;
+            } else if (entry->policy.max_interval_ms && elapsed_ms >= entry->policy.max_interval_ms) {
+                policy_stats.heartbeat_count++;
+                due = 1;
+            }
+            if (!due)
+                continue;
+
+            attr[attr_num].handle = entry->handle;
+            if (entry->attribute) {
+                attr[attr_num].name = entry->attribute;
+            } else {
+                memcpy(name[attr_num], entry->name, sizeof(entry->name));
+                attr[attr_num].name = name[attr_num];
+            }
+            attr[attr_num].value.type = entry->type;
+            if (entry->type == IOT_CAP_VAL_TYPE_INTEGER)
+                attr[attr_num].value.integer = (int)entry->current;
+            else
+                attr[attr_num].value.number = entry->current;
+            attr[attr_num].unit = entry->current_unit;
+            attr[attr_num].data = NULL;
+            attr_num++;
+
+            /* retried on the next heartbeat if the send fails */
+            entry->held = 0;
+            entry->reported_ms = now_ms;
+        }
+        iot_os_mutex_unlock(&policy_mutex);
+
+        if (attr_num > 0) {
+            if (caps_sender_send_attrs_flags(attr, attr_num, CAPS_SEND_FLAG_NO_FILTER) < 0)
+                printf("fail to send %d reports\n", attr_num);
+        }
+    }
+}
+
+int caps_report_policy_init(void)
+{
+    if (policy_ready)
+        return 0;
+
+    if (iot_os_mutex_init(&policy_mutex) != IOT_OS_TRUE) {
+        printf("fail to init policy mutex\n");
+        return -1;
+    }
+    policy_ready = 1;
+    return 0;
+}
+
+/* With copy, the policy keeps its own copy of attribute */
+static int _set_policy(IOT_CAP_HANDLE *handle, const char *attribute, const caps_report_policy_t *policy, int copy)
+{
+    struct caps_report_policy_entry *entry;
+    int i;
+
+    if (!handle || !attribute) {
+        printf("invalid handle or attribute\n");
+        return -1;
+    }
+    if (copy && strlen(attribute) >= CAPS_REPORT_POLICY_NAME_SIZE) {
+        printf("attribute %s is too long\n", attribute);
+        return -1;
+    }
+
+    if (!policy_ready) {
+        printf("caps_sender is not initialized\n");
+        return -1;
+    }
+
+    iot_os_mutex_lock(&policy_mutex);
+    if (!policy_thread && policy) {
+        if (iot_os_thread_create(_report_policy_task, "caps_report", CAPS_REPORT_POLICY_TASK_STACK_SIZE,
+                NULL, CAPS_REPORT_POLICY_TASK_PRIORITY, &policy_thread) != IOT_OS_TRUE) {
+            iot_os_mutex_unlock(&policy_mutex);
+            printf("fail to create report policy task\n");
+            return -1;
+        }
+    }
+    entry = _find_entry(handle, attribute);
+    if (!policy) {
+        if (entry) {
+            i = entry - policy_entry;
+            memmove(entry, entry + 1, (policy_entry_num - i - 1) * sizeof(*entry));
+            policy_entry_num--;
+        }
+        iot_os_mutex_unlock(&policy_mutex);
+        return 0;
+    }
+
+    if (!entry) {
+        if (policy_entry_num >= CAPS_REPORT_POLICY_SIZE) {
+            iot_os_mutex_unlock(&policy_mutex);
+            printf("report policy is full for %s\n", attribute);
+            return -1;
+        }
+        entry = &policy_entry[policy_entry_num++];
+        memset(entry, 0, sizeof(*entry));
+        entry->handle = handle;
+        if (copy) {
+            strcpy(entry->name, attribute);
+        } else {
+            entry->attribute = attribute;
+        }
+    }
+    entry->policy = *policy;
+    iot_os_mutex_unlock(&policy_mutex);
+
+    return 0;
+}
+
+int caps_report_policy_set(IOT_CAP_HANDLE *handle, const char *attribute, const caps_report_policy_t *policy)
+{
+    return _set_policy(handle, attribute, policy, 0);
+}
+
+int caps_report_policy_set_by_name(const char *component, const char *capability,
+        const char *attribute, const caps_report_policy_t *policy)
+{
+    IOT_CAP_HANDLE *handle;
+
+    handle = caps_sender_find_handle(component, capability);
+    if (!handle) {
+        printf("no handle for %s/%s\n", component ? component : "", capability ? capability : "");
+        return -1;
+    }
+    return _set_policy(handle, attribute, policy, 1);
+}
+
+static const char *_json_string(JSON_H *item, const char *name)
+{
+    JSON_H *obj = JSON_GET_OBJECT_ITEM(item, name);
+
+    if (!obj || !JSON_IS_STRING(obj))
+        return NULL;
+    return obj->valuestring;
+}
+
+static double _json_number(JSON_H *item, const char *name)
+{
+    JSON_H *obj = JSON_GET_OBJECT_ITEM(item, name);
+
+    if (!obj || !JSON_IS_NUMBER(obj))
+        return 0;
+    return obj->valuedouble;
+}
+
+/* "change" is either a number or a string like "5%" */
+static double _json_change(JSON_H *item, int *percent)
+{
+    JSON_H *obj = JSON_GET_OBJECT_ITEM(item, "change");
+    char *end;
+    double change;
+
+    *percent = 0;
+    if (!obj)
+        return 0;
+    if (JSON_IS_NUMBER(obj))
+        return obj->valuedouble;
+    if (!JSON_IS_STRING(obj))
+        return 0;
+
+    change = strtod(obj->valuestring, &end);
+    if (*end == '%')
+        *percent = 1;
+    return change;
+}
+
+int caps_report_policy_load_json(const char *json_str)
+{
+    JSON_H *root;
+    JSON_H *list;
+    JSON_H *item;
+    caps_report_policy_t policy;
+    const char *component;
+    const char *capability;
+    const char *attribute;
+    int applied = 0;
+    int num;
+    int i;
+
+    if (!json_str) {
+        printf("json_str is NULL\n");
+        return -1;
+    }
+
+    root = JSON_PARSE(json_str);
+    if (!root) {
+        printf("fail to parse report policy\n");
+        return -1;
+    }
+
+    list = JSON_GET_OBJECT_ITEM(root, "reportPolicy");
+    if (!list) {
+        printf("reportPolicy is not found\n");
+        JSON_DELETE(root);
+        return -1;
+    }
+
+    num = JSON_GET_ARRAY_SIZE(list);
+    for (i = 0; i < num; i++) {
+        item = JSON_GET_ARRAY_ITEM(list, i);
+        component = _json_string(item, "component");
+        capability = _json_string(item, "capability");
+        attribute = _json_string(item, "attribute");
+        if (!component || !capability || !attribute) {
+            printf("skip report policy %d : component, capability and attribute are required\n", i);
+            continue;
+        }
+
+        memset(&policy, 0, sizeof(policy));
+        policy.min_interval_ms = (unsigned int)(_json_number(item, "minInterval") * 1000);
+        policy.max_interval_ms = (unsigned int)(_json_number(item, "maxInterval") * 1000);
+        policy.change = _json_change(item, &policy.change_percent);
+
+        /* the policy keeps a copy of the name, which goes away with root */
+        if (caps_report_policy_set_by_name(component, capability, attribute, &policy) < 0)
+            continue;
+        applied++;
+    }
+
+    JSON_DELETE(root);
+    return applied;
+}
+
+void caps_report_policy_dump(void)
+{
+    int i;
+
+    if (!policy_ready) {
+        printf("no report policy\n");
+        return;
+    }
+
+    iot_os_mutex_lock(&policy_mutex);
+    for (i = 0; i < policy_entry_num; i++) {
+        struct caps_report_policy_entry *entry = &policy_entry[i];
+
+        printf("[%d] %s min:%u ms max:%u ms change:%g%s reported:%g\n", i, _entry_name(entry),
+                entry->policy.min_interval_ms, entry->policy.max_interval_ms,
+                entry->policy.change, entry->policy.change_percent ? "%" : "",
+                entry->reported);
+    }
+    printf("dropped:%u held:%u deferred:%u heartbeat:%u\n",
+            policy_stats.dropped_count, policy_stats.held_count,
+            policy_stats.deferred_count, policy_stats.heartbeat_count);
+    iot_os_mutex_unlock(&policy_mutex);
+}
+
+void caps_report_policy_get_stats(caps_report_policy_stats_t *stats)
+{
+    if (!stats)
+        return;
+
+    if (!policy_ready) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    iot_os_mutex_lock(&policy_mutex);
+    *stats = policy_stats;
+    iot_os_mutex_unlock(&policy_mutex);
+}
+
+void caps_report_policy_invalidate(IOT_CAP_HANDLE *handle)
+{
+    int i;
+
+    if (policy_entry_num == 0)
+        return;
+
+    iot_os_mutex_lock(&policy_mutex);
+    for (i = 0; i < policy_entry_num; i++) {
+        if (!handle || policy_entry[i].handle == handle) {
+            policy_entry[i].has_reported = 0;
+            policy_entry[i].held = 0;
+        }
+    }
+    iot_os_mutex_unlock(&policy_mutex);
+}
+
+int caps_report_policy_check(const caps_attr_t *attr)
+{
+    struct caps_report_policy_entry *entry;
+    unsigned int elapsed_ms;
+    int filtered = 0;
+
+    if (policy_entry_num == 0 || !_is_numeric(attr))
+        return 0;
+
+    iot_os_mutex_lock(&policy_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (entry) {
+        entry->type = attr->value.type;
+        entry->current = _numeric_value(attr);
+        entry->current_unit = attr->unit;
+        entry->has_current = 1;
+
+        if (entry->has_reported) {
+            if (!_is_reportable_change(entry)) {
+                entry->held = 0;
+                policy_stats.dropped_count++;
+                filtered = 1;
+            } else {
+                elapsed_ms = caps_util_get_time_ms() - entry->reported_ms;
+                if (elapsed_ms < entry->policy.min_interval_ms) {
+                    entry->held = 1;
+                    policy_stats.held_count++;
+                    filtered = 1;
+                }
+            }
+        }
+    }
+    iot_os_mutex_unlock(&policy_mutex);
+
+    return filtered;
+}
+
+void caps_report_policy_update(const caps_attr_t *attr)
+{
+    struct caps_report_policy_entry *entry;
+
+    if (policy_entry_num == 0 || !_is_numeric(attr))
+        return;
+
+    iot_os_mutex_lock(&policy_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (entry) {
+        entry->reported = _numeric_value(attr);
+        entry->reported_unit = attr->unit;
+        entry->reported_ms = caps_util_get_time_ms();
+        entry->has_reported = 1;
+        entry->held = 0;
+    }
+    iot_os_mutex_unlock(&policy_mutex);
+}
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_robotCleanerMovement.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_robotCleanerMovement_attr_robotCleanerMovement_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_robotCleanerMovement_get_robotCleanerMovement_value(caps
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->robotCleanerMovement_value;
+    if (caps_data->robotCleanerMovement_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_robotCleanerMovement.attr_robotCleanerMovement.values[caps_data->robotCleanerMovement_idx];
 }
 
 static void caps_robotCleanerMovement_set_robotCleanerMovement_value(caps_robotCleanerMovement_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_robotCleanerMovement_attr_robotCleanerMovement_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for robotCleanerMovement\n", value);
+        return;
+    }
+    caps_data->robotCleanerMovement_idx = index;
+}
+
+static int caps_robotCleanerMovement_get_robotCleanerMovement_idx(caps_robotCleanerMovement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->robotCleanerMovement_idx;
+}
+
+static void caps_robotCleanerMovement_set_robotCleanerMovement_idx(caps_robotCleanerMovement_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->robotCleanerMovement_value) {
-        free(caps_data->robotCleanerMovement_value);
+    if (idx < 0 || idx >= CAP_ENUM_ROBOTCLEANERMOVEMENT_ROBOTCLEANERMOVEMENT_VALUE_MAX) {
+        printf("%d is not supported index for robotCleanerMovement\n", idx);
+        return;
     }
-    caps_data->robotCleanerMovement_value = strdup(value);
+    caps_data->robotCleanerMovement_idx = idx;
 }
 
 static void caps_robotCleanerMovement_attr_robotCleanerMovement_send(caps_robotCleanerMovement_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_robotCleanerMovement_attr_robotCleanerMovement_send(caps_robotC
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->robotCleanerMovement_value) {
+    if (caps_data->robotCleanerMovement_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_robotCleanerMovement.attr_robotCleanerMovement.name,
-            caps_data->robotCleanerMovement_value,
+            (char *)caps_helper_robotCleanerMovement.attr_robotCleanerMovement.values[caps_data->robotCleanerMovement_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,7 +122,6 @@ static void caps_robotCleanerMovement_attr_robotCleanerMovement_send(caps_robotC
 static void caps_robotCleanerMovement_cmd_setRobotCleanerMovement_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_robotCleanerMovement_data_t *caps_data = (caps_robotCleanerMovement_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -97,9 +131,7 @@ static void caps_robotCleanerMovement_cmd_setRobotCleanerMovement_cb(IOT_CAP_HAN
         printf("%s is not supported value for setRobotCleanerMovement\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_robotCleanerMovement.attr_robotCleanerMovement.values[index];
-
-    caps_robotCleanerMovement_set_robotCleanerMovement_value(caps_data, value);
+    caps_robotCleanerMovement_set_robotCleanerMovement_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setRobotCleanerMovement_usr_cb)
         caps_data->cmd_setRobotCleanerMovement_usr_cb(caps_data);
     caps_robotCleanerMovement_attr_robotCleanerMovement_send(caps_data);
@@ -108,9 +140,12 @@ static void caps_robotCleanerMovement_cmd_setRobotCleanerMovement_cb(IOT_CAP_HAN
 static void caps_robotCleanerMovement_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_robotCleanerMovement_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_robotCleanerMovement_attr_robotCleanerMovement_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_robotCleanerMovement_data_t *caps_robotCleanerMovement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -131,13 +166,16 @@ caps_robotCleanerMovement_data_t *caps_robotCleanerMovement_initialize(IOT_CTX *
 
     caps_data->get_robotCleanerMovement_value = caps_robotCleanerMovement_get_robotCleanerMovement_value;
     caps_data->set_robotCleanerMovement_value = caps_robotCleanerMovement_set_robotCleanerMovement_value;
+    caps_data->get_robotCleanerMovement_idx = caps_robotCleanerMovement_get_robotCleanerMovement_idx;
+    caps_data->set_robotCleanerMovement_idx = caps_robotCleanerMovement_set_robotCleanerMovement_idx;
     caps_data->attr_robotCleanerMovement_str2idx = caps_robotCleanerMovement_attr_robotCleanerMovement_str2idx;
     caps_data->attr_robotCleanerMovement_send = caps_robotCleanerMovement_attr_robotCleanerMovement_send;
+    caps_data->robotCleanerMovement_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_robotCleanerMovement.id, caps_robotCleanerMovement_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_robotCleanerMovement.id, caps_robotCleanerMovement_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_robotCleanerMovement.cmd_setRobotCleanerMovement.name, caps_robotCleanerMovement_cmd_setRobotCleanerMovement_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_robotCleanerMovement.cmd_setRobotCleanerMovement.name, caps_robotCleanerMovement_cmd_setRobotCleanerMovement_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setRobotCleanerMovement of robotCleanerMovement\n");
     }
@@ -147,3 +185,17 @@ caps_robotCleanerMovement_data_t *caps_robotCleanerMovement_initialize(IOT_CTX *
 
     return caps_data;
 }
+
+void caps_robotCleanerMovement_deinitialize(caps_robotCleanerMovement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_robotCleanerMovement_data {
     void *usr_data;
     void *cmd_data;
 
-    char *robotCleanerMovement_value;
+    int robotCleanerMovement_idx;
 
     const char *(*get_robotCleanerMovement_value)(struct caps_robotCleanerMovement_data *caps_data);
     void (*set_robotCleanerMovement_value)(struct caps_robotCleanerMovement_data *caps_data, const char *value);
+    int (*get_robotCleanerMovement_idx)(struct caps_robotCleanerMovement_data *caps_data);
+    void (*set_robotCleanerMovement_idx)(struct caps_robotCleanerMovement_data *caps_data, int idx);
     int (*attr_robotCleanerMovement_str2idx)(const char *value);
     void (*attr_robotCleanerMovement_send)(struct caps_robotCleanerMovement_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_robotCleanerMovement_data {
 } caps_robotCleanerMovement_data_t;
 
 caps_robotCleanerMovement_data_t *caps_robotCleanerMovement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_robotCleanerMovement_deinitialize(caps_robotCleanerMovement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -27,10 +27,12 @@ typedef struct caps_robotCleanerTurboMode_data {
     void *usr_data;
     void *cmd_data;
 
-    char *robotCleanerTurboMode_value;
+    int robotCleanerTurboMode_idx;
 
     const char *(*get_robotCleanerTurboMode_value)(struct caps_robotCleanerTurboMode_data *caps_data);
     void (*set_robotCleanerTurboMode_value)(struct caps_robotCleanerTurboMode_data *caps_data, const char *value);
+    int (*get_robotCleanerTurboMode_idx)(struct caps_robotCleanerTurboMode_data *caps_data);
+    void (*set_robotCleanerTurboMode_idx)(struct caps_robotCleanerTurboMode_data *caps_data, int idx);
     int (*attr_robotCleanerTurboMode_str2idx)(const char *value);
     void (*attr_robotCleanerTurboMode_send)(struct caps_robotCleanerTurboMode_data *caps_data);
 
@@ -40,6 +42,7 @@ typedef struct caps_robotCleanerTurboMode_data {
 } caps_robotCleanerTurboMode_data_t;
 
 caps_robotCleanerTurboMode_data_t *caps_robotCleanerTurboMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_robotCleanerTurboMode_deinitialize(caps_robotCleanerTurboMode_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
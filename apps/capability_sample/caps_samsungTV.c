@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_samsungTV.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_samsungTV_get_volume_value(caps_samsungTV_data_t *caps_data)
 {
@@ -50,7 +52,7 @@ static void caps_samsungTV_attr_volume_send(caps_samsungTV_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_samsungTV.attr_volume.name,
             caps_data->volume_value,
             NULL,
@@ -65,33 +67,30 @@ static void caps_samsungTV_attr_volume_send(caps_samsungTV_data_t *caps_data)
 }
 
 
-static const JSON_H *caps_samsungTV_get_messageButton_value(caps_samsungTV_data_t *caps_data)
+static const char *caps_samsungTV_get_messageButton_value(caps_samsungTV_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return (const JSON_H *)caps_data->messageButton_value;
+    return caps_data->messageButton_value;
 }
 
-static void caps_samsungTV_set_messageButton_value(caps_samsungTV_data_t *caps_data, const JSON_H *value)
+static void caps_samsungTV_set_messageButton_value(caps_samsungTV_data_t *caps_data, const char *value)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
     if (caps_data->messageButton_value) {
-        JSON_DELETE(caps_data->messageButton_value);
+        free(caps_data->messageButton_value);
     }
-    caps_data->messageButton_value = JSON_DUPLICATE(value, true);
+    caps_data->messageButton_value = strdup(value);
 }
 
 static void caps_samsungTV_attr_messageButton_send(caps_samsungTV_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt;
-    uint8_t evt_num = 1;
     int sequence_no = -1;
-    iot_cap_val_t value;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
@@ -102,26 +101,17 @@ static void caps_samsungTV_attr_messageButton_send(caps_samsungTV_data_t *caps_d
         return;
     }
 
-    value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
-    value.json_object = JSON_PRINT(caps_data->messageButton_value);
-
-    cap_evt = st_cap_create_attr(caps_data->handle,
-        (char *)caps_helper_samsungTV.attr_messageButton.name,
-        &value,
-        NULL,
-        NULL);
-
-    if (!cap_evt) {
-        printf("fail to create cap_evt\n");
-        return;
-    }
+    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,
+            (char *)caps_helper_samsungTV.attr_messageButton.name,
+            caps_data->messageButton_value,
+            NULL,
+            NULL,
+            sequence_no);
 
-    sequence_no = st_cap_send_attr(&cap_evt, evt_num);
     if (sequence_no < 0)
         printf("fail to send messageButton value\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt);
 }
 
 
@@ -143,19 +133,52 @@ static const char *caps_samsungTV_get_switch_value(caps_samsungTV_data_t *caps_d
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->switch_value;
+    if (caps_data->switch_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_samsungTV.attr_switch.values[caps_data->switch_idx];
 }
 
 static void caps_samsungTV_set_switch_value(caps_samsungTV_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_samsungTV_attr_switch_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for switch\n", value);
+        return;
+    }
+    caps_data->switch_idx = index;
+}
+
+static int caps_samsungTV_get_switch_idx(caps_samsungTV_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->switch_idx;
+}
+
+static void caps_samsungTV_set_switch_idx(caps_samsungTV_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->switch_value) {
-        free(caps_data->switch_value);
+    if (idx < 0 || idx >= CAP_ENUM_SAMSUNGTV_SWITCH_VALUE_MAX) {
+        printf("%d is not supported index for switch\n", idx);
+        return;
     }
-    caps_data->switch_value = strdup(value);
+    caps_data->switch_idx = idx;
 }
 
 static void caps_samsungTV_attr_switch_send(caps_samsungTV_data_t *caps_data)
@@ -166,14 +189,14 @@ static void caps_samsungTV_attr_switch_send(caps_samsungTV_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->switch_value) {
+    if (caps_data->switch_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_samsungTV.attr_switch.name,
-            caps_data->switch_value,
+            (char *)caps_helper_samsungTV.attr_switch.values[caps_data->switch_idx],
             NULL,
             NULL,
             sequence_no);
@@ -204,19 +227,52 @@ static const char *caps_samsungTV_get_mute_value(caps_samsungTV_data_t *caps_dat
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->mute_value;
+    if (caps_data->mute_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_samsungTV.attr_mute.values[caps_data->mute_idx];
 }
 
 static void caps_samsungTV_set_mute_value(caps_samsungTV_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->mute_value) {
-        free(caps_data->mute_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
     }
-    caps_data->mute_value = strdup(value);
+    index = caps_samsungTV_attr_mute_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for mute\n", value);
+        return;
+    }
+    caps_data->mute_idx = index;
+}
+
+static int caps_samsungTV_get_mute_idx(caps_samsungTV_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->mute_idx;
+}
+
+static void caps_samsungTV_set_mute_idx(caps_samsungTV_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_SAMSUNGTV_MUTE_VALUE_MAX) {
+        printf("%d is not supported index for mute\n", idx);
+        return;
+    }
+    caps_data->mute_idx = idx;
 }
 
 static void caps_samsungTV_attr_mute_send(caps_samsungTV_data_t *caps_data)
@@ -227,14 +283,14 @@ static void caps_samsungTV_attr_mute_send(caps_samsungTV_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->mute_value) {
+    if (caps_data->mute_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_samsungTV.attr_mute.name,
-            caps_data->mute_value,
+            (char *)caps_helper_samsungTV.attr_mute.values[caps_data->mute_idx],
             NULL,
             NULL,
             sequence_no);
@@ -265,19 +321,52 @@ static const char *caps_samsungTV_get_pictureMode_value(caps_samsungTV_data_t *c
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->pictureMode_value;
+    if (caps_data->pictureMode_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_samsungTV.attr_pictureMode.values[caps_data->pictureMode_idx];
 }
 
 static void caps_samsungTV_set_pictureMode_value(caps_samsungTV_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_samsungTV_attr_pictureMode_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for pictureMode\n", value);
+        return;
+    }
+    caps_data->pictureMode_idx = index;
+}
+
+static int caps_samsungTV_get_pictureMode_idx(caps_samsungTV_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->pictureMode_idx;
+}
+
+static void caps_samsungTV_set_pictureMode_idx(caps_samsungTV_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->pictureMode_value) {
-        free(caps_data->pictureMode_value);
+    if (idx < 0 || idx >= CAP_ENUM_SAMSUNGTV_PICTUREMODE_VALUE_MAX) {
+        printf("%d is not supported index for pictureMode\n", idx);
+        return;
     }
-    caps_data->pictureMode_value = strdup(value);
+    caps_data->pictureMode_idx = idx;
 }
 
 static void caps_samsungTV_attr_pictureMode_send(caps_samsungTV_data_t *caps_data)
@@ -288,14 +377,14 @@ static void caps_samsungTV_attr_pictureMode_send(caps_samsungTV_data_t *caps_dat
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->pictureMode_value) {
+    if (caps_data->pictureMode_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_samsungTV.attr_pictureMode.name,
-            caps_data->pictureMode_value,
+            (char *)caps_helper_samsungTV.attr_pictureMode.values[caps_data->pictureMode_idx],
             NULL,
             NULL,
             sequence_no);
@@ -326,19 +415,52 @@ static const char *caps_samsungTV_get_soundMode_value(caps_samsungTV_data_t *cap
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->soundMode_value;
+    if (caps_data->soundMode_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_samsungTV.attr_soundMode.values[caps_data->soundMode_idx];
 }
 
 static void caps_samsungTV_set_soundMode_value(caps_samsungTV_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_samsungTV_attr_soundMode_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for soundMode\n", value);
+        return;
+    }
+    caps_data->soundMode_idx = index;
+}
+
+static int caps_samsungTV_get_soundMode_idx(caps_samsungTV_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->soundMode_idx;
+}
+
+static void caps_samsungTV_set_soundMode_idx(caps_samsungTV_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->soundMode_value) {
-        free(caps_data->soundMode_value);
+    if (idx < 0 || idx >= CAP_ENUM_SAMSUNGTV_SOUNDMODE_VALUE_MAX) {
+        printf("%d is not supported index for soundMode\n", idx);
+        return;
     }
-    caps_data->soundMode_value = strdup(value);
+    caps_data->soundMode_idx = idx;
 }
 
 static void caps_samsungTV_attr_soundMode_send(caps_samsungTV_data_t *caps_data)
@@ -349,14 +471,14 @@ static void caps_samsungTV_attr_soundMode_send(caps_samsungTV_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->soundMode_value) {
+    if (caps_data->soundMode_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_samsungTV.attr_soundMode.name,
-            caps_data->soundMode_value,
+            (char *)caps_helper_samsungTV.attr_soundMode.values[caps_data->soundMode_idx],
             NULL,
             NULL,
             sequence_no);
@@ -372,11 +494,11 @@ static void caps_samsungTV_attr_soundMode_send(caps_samsungTV_data_t *caps_data)
 static void caps_samsungTV_cmd_on_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    const char* value = caps_helper_samsungTV.attr_switch.values[CAP_ENUM_SAMSUNGTV_SWITCH_VALUE_ON];
+    int index = CAP_ENUM_SAMSUNGTV_SWITCH_VALUE_ON;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_samsungTV_set_switch_value(caps_data, value);
+    caps_samsungTV_set_switch_idx(caps_data, index);
     if (caps_data && caps_data->cmd_on_usr_cb)
         caps_data->cmd_on_usr_cb(caps_data);
     caps_samsungTV_attr_switch_send(caps_data);
@@ -385,11 +507,11 @@ static void caps_samsungTV_cmd_on_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t
 static void caps_samsungTV_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    const char* value = caps_helper_samsungTV.attr_switch.values[CAP_ENUM_SAMSUNGTV_SWITCH_VALUE_OFF];
+    int index = CAP_ENUM_SAMSUNGTV_SWITCH_VALUE_OFF;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_samsungTV_set_switch_value(caps_data, value);
+    caps_samsungTV_set_switch_idx(caps_data, index);
     if (caps_data && caps_data->cmd_off_usr_cb)
         caps_data->cmd_off_usr_cb(caps_data);
     caps_samsungTV_attr_switch_send(caps_data);
@@ -398,11 +520,11 @@ static void caps_samsungTV_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t
 static void caps_samsungTV_cmd_mute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    const char* value = caps_helper_samsungTV.attr_mute.values[CAP_ENUM_SAMSUNGTV_MUTE_VALUE_MUTED];
+    int index = CAP_ENUM_SAMSUNGTV_MUTE_VALUE_MUTED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_samsungTV_set_mute_value(caps_data, value);
+    caps_samsungTV_set_mute_idx(caps_data, index);
     if (caps_data && caps_data->cmd_mute_usr_cb)
         caps_data->cmd_mute_usr_cb(caps_data);
     caps_samsungTV_attr_mute_send(caps_data);
@@ -411,11 +533,11 @@ static void caps_samsungTV_cmd_mute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_
 static void caps_samsungTV_cmd_unmute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    const char* value = caps_helper_samsungTV.attr_mute.values[CAP_ENUM_SAMSUNGTV_MUTE_VALUE_UNMUTED];
+    int index = CAP_ENUM_SAMSUNGTV_MUTE_VALUE_UNMUTED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_samsungTV_set_mute_value(caps_data, value);
+    caps_samsungTV_set_mute_idx(caps_data, index);
     if (caps_data && caps_data->cmd_unmute_usr_cb)
         caps_data->cmd_unmute_usr_cb(caps_data);
     caps_samsungTV_attr_mute_send(caps_data);
@@ -424,7 +546,6 @@ static void caps_samsungTV_cmd_unmute_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_dat
 static void caps_samsungTV_cmd_setPictureMode_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -434,9 +555,7 @@ static void caps_samsungTV_cmd_setPictureMode_cb(IOT_CAP_HANDLE *handle, iot_cap
         printf("%s is not supported value for setPictureMode\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_samsungTV.attr_pictureMode.values[index];
-
-    caps_samsungTV_set_pictureMode_value(caps_data, value);
+    caps_samsungTV_set_pictureMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setPictureMode_usr_cb)
         caps_data->cmd_setPictureMode_usr_cb(caps_data);
     caps_samsungTV_attr_pictureMode_send(caps_data);
@@ -445,7 +564,6 @@ static void caps_samsungTV_cmd_setPictureMode_cb(IOT_CAP_HANDLE *handle, iot_cap
 static void caps_samsungTV_cmd_setSoundMode_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = (caps_samsungTV_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -455,9 +573,7 @@ static void caps_samsungTV_cmd_setSoundMode_cb(IOT_CAP_HANDLE *handle, iot_cap_c
         printf("%s is not supported value for setSoundMode\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_samsungTV.attr_soundMode.values[index];
-
-    caps_samsungTV_set_soundMode_value(caps_data, value);
+    caps_samsungTV_set_soundMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setSoundMode_usr_cb)
         caps_data->cmd_setSoundMode_usr_cb(caps_data);
     caps_samsungTV_attr_soundMode_send(caps_data);
@@ -513,6 +629,8 @@ static void caps_samsungTV_cmd_setVolume_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_
 static void caps_samsungTV_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_samsungTV_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_samsungTV_attr_volume_send(caps_data);
@@ -521,6 +639,7 @@ static void caps_samsungTV_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
     caps_samsungTV_attr_mute_send(caps_data);
     caps_samsungTV_attr_pictureMode_send(caps_data);
     caps_samsungTV_attr_soundMode_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_samsungTV_data_t *caps_samsungTV_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -547,62 +666,74 @@ caps_samsungTV_data_t *caps_samsungTV_initialize(IOT_CTX *ctx, const char *compo
     caps_data->attr_messageButton_send = caps_samsungTV_attr_messageButton_send;
     caps_data->get_switch_value = caps_samsungTV_get_switch_value;
     caps_data->set_switch_value = caps_samsungTV_set_switch_value;
+    caps_data->get_switch_idx = caps_samsungTV_get_switch_idx;
+    caps_data->set_switch_idx = caps_samsungTV_set_switch_idx;
     caps_data->attr_switch_str2idx = caps_samsungTV_attr_switch_str2idx;
     caps_data->attr_switch_send = caps_samsungTV_attr_switch_send;
     caps_data->get_mute_value = caps_samsungTV_get_mute_value;
     caps_data->set_mute_value = caps_samsungTV_set_mute_value;
+    caps_data->get_mute_idx = caps_samsungTV_get_mute_idx;
+    caps_data->set_mute_idx = caps_samsungTV_set_mute_idx;
     caps_data->attr_mute_str2idx = caps_samsungTV_attr_mute_str2idx;
     caps_data->attr_mute_send = caps_samsungTV_attr_mute_send;
     caps_data->get_pictureMode_value = caps_samsungTV_get_pictureMode_value;
     caps_data->set_pictureMode_value = caps_samsungTV_set_pictureMode_value;
+    caps_data->get_pictureMode_idx = caps_samsungTV_get_pictureMode_idx;
+    caps_data->set_pictureMode_idx = caps_samsungTV_set_pictureMode_idx;
     caps_data->attr_pictureMode_str2idx = caps_samsungTV_attr_pictureMode_str2idx;
     caps_data->attr_pictureMode_send = caps_samsungTV_attr_pictureMode_send;
     caps_data->get_soundMode_value = caps_samsungTV_get_soundMode_value;
     caps_data->set_soundMode_value = caps_samsungTV_set_soundMode_value;
+    caps_data->get_soundMode_idx = caps_samsungTV_get_soundMode_idx;
+    caps_data->set_soundMode_idx = caps_samsungTV_set_soundMode_idx;
     caps_data->attr_soundMode_str2idx = caps_samsungTV_attr_soundMode_str2idx;
     caps_data->attr_soundMode_send = caps_samsungTV_attr_soundMode_send;
     caps_data->volume_value = 0;
+    caps_data->switch_idx = -1;
+    caps_data->mute_idx = -1;
+    caps_data->pictureMode_idx = -1;
+    caps_data->soundMode_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_samsungTV.id, caps_samsungTV_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_samsungTV.id, caps_samsungTV_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_on.name, caps_samsungTV_cmd_on_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_on.name, caps_samsungTV_cmd_on_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for on of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_off.name, caps_samsungTV_cmd_off_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_off.name, caps_samsungTV_cmd_off_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for off of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_mute.name, caps_samsungTV_cmd_mute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_mute.name, caps_samsungTV_cmd_mute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for mute of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_unmute.name, caps_samsungTV_cmd_unmute_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_unmute.name, caps_samsungTV_cmd_unmute_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for unmute of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setPictureMode.name, caps_samsungTV_cmd_setPictureMode_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setPictureMode.name, caps_samsungTV_cmd_setPictureMode_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setPictureMode of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setSoundMode.name, caps_samsungTV_cmd_setSoundMode_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setSoundMode.name, caps_samsungTV_cmd_setSoundMode_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setSoundMode of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_volumeDown.name, caps_samsungTV_cmd_volumeDown_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_volumeDown.name, caps_samsungTV_cmd_volumeDown_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for volumeDown of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_showMessage.name, caps_samsungTV_cmd_showMessage_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_showMessage.name, caps_samsungTV_cmd_showMessage_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for showMessage of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_volumeUp.name, caps_samsungTV_cmd_volumeUp_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_volumeUp.name, caps_samsungTV_cmd_volumeUp_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for volumeUp of samsungTV\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setVolume.name, caps_samsungTV_cmd_setVolume_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_samsungTV.cmd_setVolume.name, caps_samsungTV_cmd_setVolume_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setVolume of samsungTV\n");
     }
@@ -612,3 +743,18 @@ caps_samsungTV_data_t *caps_samsungTV_initialize(IOT_CTX *ctx, const char *compo
 
     return caps_data;
 }
+
+void caps_samsungTV_deinitialize(caps_samsungTV_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->messageButton_value);
+    free(caps_data);
+}
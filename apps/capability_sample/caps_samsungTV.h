@@ -29,32 +29,40 @@ typedef struct caps_samsungTV_data {
     void *cmd_data;
 
     int volume_value;
-    JSON_H *messageButton_value;
-    char *switch_value;
-    char *mute_value;
-    char *pictureMode_value;
-    char *soundMode_value;
+    char *messageButton_value;
+    int switch_idx;
+    int mute_idx;
+    int pictureMode_idx;
+    int soundMode_idx;
 
     int (*get_volume_value)(struct caps_samsungTV_data *caps_data);
     void (*set_volume_value)(struct caps_samsungTV_data *caps_data, int value);
     void (*attr_volume_send)(struct caps_samsungTV_data *caps_data);
-    const JSON_H *(*get_messageButton_value)(struct caps_samsungTV_data *caps_data);
-    void (*set_messageButton_value)(struct caps_samsungTV_data *caps_data, const JSON_H *value);
+    const char *(*get_messageButton_value)(struct caps_samsungTV_data *caps_data);
+    void (*set_messageButton_value)(struct caps_samsungTV_data *caps_data, const char *value);
     void (*attr_messageButton_send)(struct caps_samsungTV_data *caps_data);
     const char *(*get_switch_value)(struct caps_samsungTV_data *caps_data);
     void (*set_switch_value)(struct caps_samsungTV_data *caps_data, const char *value);
+    int (*get_switch_idx)(struct caps_samsungTV_data *caps_data);
+    void (*set_switch_idx)(struct caps_samsungTV_data *caps_data, int idx);
     int (*attr_switch_str2idx)(const char *value);
     void (*attr_switch_send)(struct caps_samsungTV_data *caps_data);
     const char *(*get_mute_value)(struct caps_samsungTV_data *caps_data);
     void (*set_mute_value)(struct caps_samsungTV_data *caps_data, const char *value);
+    int (*get_mute_idx)(struct caps_samsungTV_data *caps_data);
+    void (*set_mute_idx)(struct caps_samsungTV_data *caps_data, int idx);
     int (*attr_mute_str2idx)(const char *value);
     void (*attr_mute_send)(struct caps_samsungTV_data *caps_data);
     const char *(*get_pictureMode_value)(struct caps_samsungTV_data *caps_data);
     void (*set_pictureMode_value)(struct caps_samsungTV_data *caps_data, const char *value);
+    int (*get_pictureMode_idx)(struct caps_samsungTV_data *caps_data);
+    void (*set_pictureMode_idx)(struct caps_samsungTV_data *caps_data, int idx);
     int (*attr_pictureMode_str2idx)(const char *value);
     void (*attr_pictureMode_send)(struct caps_samsungTV_data *caps_data);
     const char *(*get_soundMode_value)(struct caps_samsungTV_data *caps_data);
     void (*set_soundMode_value)(struct caps_samsungTV_data *caps_data, const char *value);
+    int (*get_soundMode_idx)(struct caps_samsungTV_data *caps_data);
+    void (*set_soundMode_idx)(struct caps_samsungTV_data *caps_data, int idx);
     int (*attr_soundMode_str2idx)(const char *value);
     void (*attr_soundMode_send)(struct caps_samsungTV_data *caps_data);
 
@@ -73,6 +81,7 @@ typedef struct caps_samsungTV_data {
 } caps_samsungTV_data_t;
 
 caps_samsungTV_data_t *caps_samsungTV_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_samsungTV_deinitialize(caps_samsungTV_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_securitySystem.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static const char *caps_securitySystem_get_alarm_value(caps_securitySystem_data_t *caps_data)
 {
@@ -57,7 +59,7 @@ static void caps_securitySystem_attr_alarm_send(caps_securitySystem_data_t *caps
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_securitySystem.attr_alarm.name,
             caps_data->alarm_value,
             NULL,
@@ -89,19 +91,52 @@ static const char *caps_securitySystem_get_securitySystemStatus_value(caps_secur
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->securitySystemStatus_value;
+    if (caps_data->securitySystemStatus_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_securitySystem.attr_securitySystemStatus.values[caps_data->securitySystemStatus_idx];
 }
 
 static void caps_securitySystem_set_securitySystemStatus_value(caps_securitySystem_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_securitySystem_attr_securitySystemStatus_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for securitySystemStatus\n", value);
+        return;
+    }
+    caps_data->securitySystemStatus_idx = index;
+}
+
+static int caps_securitySystem_get_securitySystemStatus_idx(caps_securitySystem_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->securitySystemStatus_idx;
+}
+
+static void caps_securitySystem_set_securitySystemStatus_idx(caps_securitySystem_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->securitySystemStatus_value) {
-        free(caps_data->securitySystemStatus_value);
+    if (idx < 0 || idx >= CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_MAX) {
+        printf("%d is not supported index for securitySystemStatus\n", idx);
+        return;
     }
-    caps_data->securitySystemStatus_value = strdup(value);
+    caps_data->securitySystemStatus_idx = idx;
 }
 
 static void caps_securitySystem_attr_securitySystemStatus_send(caps_securitySystem_data_t *caps_data)
@@ -112,14 +147,14 @@ static void caps_securitySystem_attr_securitySystemStatus_send(caps_securitySyst
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->securitySystemStatus_value) {
+    if (caps_data->securitySystemStatus_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_securitySystem.attr_securitySystemStatus.name,
-            caps_data->securitySystemStatus_value,
+            (char *)caps_helper_securitySystem.attr_securitySystemStatus.values[caps_data->securitySystemStatus_idx],
             NULL,
             NULL,
             sequence_no);
@@ -135,11 +170,11 @@ static void caps_securitySystem_attr_securitySystemStatus_send(caps_securitySyst
 static void caps_securitySystem_cmd_armStay_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_securitySystem_data_t *caps_data = (caps_securitySystem_data_t *)usr_data;
-    const char* value = caps_helper_securitySystem.attr_securitySystemStatus.values[CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_ARMEDSTAY];
+    int index = CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_ARMEDSTAY;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_securitySystem_set_securitySystemStatus_value(caps_data, value);
+    caps_securitySystem_set_securitySystemStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_armStay_usr_cb)
         caps_data->cmd_armStay_usr_cb(caps_data);
     caps_securitySystem_attr_securitySystemStatus_send(caps_data);
@@ -148,11 +183,11 @@ static void caps_securitySystem_cmd_armStay_cb(IOT_CAP_HANDLE *handle, iot_cap_c
 static void caps_securitySystem_cmd_disarm_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_securitySystem_data_t *caps_data = (caps_securitySystem_data_t *)usr_data;
-    const char* value = caps_helper_securitySystem.attr_securitySystemStatus.values[CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_DISARMED];
+    int index = CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_DISARMED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_securitySystem_set_securitySystemStatus_value(caps_data, value);
+    caps_securitySystem_set_securitySystemStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_disarm_usr_cb)
         caps_data->cmd_disarm_usr_cb(caps_data);
     caps_securitySystem_attr_securitySystemStatus_send(caps_data);
@@ -161,11 +196,11 @@ static void caps_securitySystem_cmd_disarm_cb(IOT_CAP_HANDLE *handle, iot_cap_cm
 static void caps_securitySystem_cmd_armAway_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_securitySystem_data_t *caps_data = (caps_securitySystem_data_t *)usr_data;
-    const char* value = caps_helper_securitySystem.attr_securitySystemStatus.values[CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_ARMEDAWAY];
+    int index = CAP_ENUM_SECURITYSYSTEM_SECURITYSYSTEMSTATUS_VALUE_ARMEDAWAY;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_securitySystem_set_securitySystemStatus_value(caps_data, value);
+    caps_securitySystem_set_securitySystemStatus_idx(caps_data, index);
     if (caps_data && caps_data->cmd_armAway_usr_cb)
         caps_data->cmd_armAway_usr_cb(caps_data);
     caps_securitySystem_attr_securitySystemStatus_send(caps_data);
@@ -174,10 +209,13 @@ static void caps_securitySystem_cmd_armAway_cb(IOT_CAP_HANDLE *handle, iot_cap_c
 static void caps_securitySystem_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_securitySystem_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_securitySystem_attr_alarm_send(caps_data);
     caps_securitySystem_attr_securitySystemStatus_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_securitySystem_data_t *caps_securitySystem_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -201,21 +239,25 @@ caps_securitySystem_data_t *caps_securitySystem_initialize(IOT_CTX *ctx, const c
     caps_data->attr_alarm_send = caps_securitySystem_attr_alarm_send;
     caps_data->get_securitySystemStatus_value = caps_securitySystem_get_securitySystemStatus_value;
     caps_data->set_securitySystemStatus_value = caps_securitySystem_set_securitySystemStatus_value;
+    caps_data->get_securitySystemStatus_idx = caps_securitySystem_get_securitySystemStatus_idx;
+    caps_data->set_securitySystemStatus_idx = caps_securitySystem_set_securitySystemStatus_idx;
     caps_data->attr_securitySystemStatus_str2idx = caps_securitySystem_attr_securitySystemStatus_str2idx;
     caps_data->attr_securitySystemStatus_send = caps_securitySystem_attr_securitySystemStatus_send;
+    caps_data->securitySystemStatus_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_securitySystem.id, caps_securitySystem_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_securitySystem.id, caps_securitySystem_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_armStay.name, caps_securitySystem_cmd_armStay_cb, caps_data);
+        caps_sender_set_priority(caps_data->handle, caps_helper_securitySystem.attr_alarm.name, CAPS_SEND_PRIORITY_CRITICAL);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_armStay.name, caps_securitySystem_cmd_armStay_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for armStay of securitySystem\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_disarm.name, caps_securitySystem_cmd_disarm_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_disarm.name, caps_securitySystem_cmd_disarm_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for disarm of securitySystem\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_armAway.name, caps_securitySystem_cmd_armAway_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_securitySystem.cmd_armAway.name, caps_securitySystem_cmd_armAway_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for armAway of securitySystem\n");
     }
@@ -225,3 +267,18 @@ caps_securitySystem_data_t *caps_securitySystem_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_securitySystem_deinitialize(caps_securitySystem_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data->alarm_value);
+    free(caps_data);
+}
@@ -28,13 +28,15 @@ typedef struct caps_securitySystem_data {
     void *cmd_data;
 
     char *alarm_value;
-    char *securitySystemStatus_value;
+    int securitySystemStatus_idx;
 
     const char *(*get_alarm_value)(struct caps_securitySystem_data *caps_data);
     void (*set_alarm_value)(struct caps_securitySystem_data *caps_data, const char *value);
     void (*attr_alarm_send)(struct caps_securitySystem_data *caps_data);
     const char *(*get_securitySystemStatus_value)(struct caps_securitySystem_data *caps_data);
     void (*set_securitySystemStatus_value)(struct caps_securitySystem_data *caps_data, const char *value);
+    int (*get_securitySystemStatus_idx)(struct caps_securitySystem_data *caps_data);
+    void (*set_securitySystemStatus_idx)(struct caps_securitySystem_data *caps_data, int idx);
     int (*attr_securitySystemStatus_str2idx)(const char *value);
     void (*attr_securitySystemStatus_send)(struct caps_securitySystem_data *caps_data);
 
@@ -46,6 +48,7 @@ typedef struct caps_securitySystem_data {
 } caps_securitySystem_data_t;
 
 caps_securitySystem_data_t *caps_securitySystem_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_securitySystem_deinitialize(caps_securitySystem_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,284 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_send_cache.h"
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+struct caps_send_cache_entry {
+    IOT_CAP_HANDLE *handle;
+    const char *attribute;
+    caps_send_cache_value_t sent;
+    caps_send_cache_value_t next;   /* checked and on its way, sent once updated */
+    int valid;
+    int next_valid;
+};
+
+struct caps_send_cache_encoder {
+    caps_send_cache_value_t *value;
+    unsigned int hash;
+    unsigned int len;
+};
+
+static struct caps_send_cache_entry cache_entry[CAPS_SEND_CACHE_SIZE];
+static int cache_entry_num;
+static unsigned int cache_suppressed;
+static iot_os_mutex cache_mutex;
+
+static void _put_bytes(struct caps_send_cache_encoder *enc, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+    size_t i;
+
+    if (enc->value && enc->len < CAPS_SEND_CACHE_VALUE_SIZE) {
+        i = CAPS_SEND_CACHE_VALUE_SIZE - enc->len;
+        memcpy(enc->value->data + enc->len, data, len < i ? len : i);
+    }
+    for (i = 0; i < len; i++) {
+        enc->hash ^= p[i];
+        enc->hash *= FNV_PRIME;
+    }
+    enc->len += len;
+}
+
+static void _put_string(struct caps_send_cache_encoder *enc, const char *str)
+{
+    if (!str) {
+        _put_bytes(enc, "\xff", 1);
+        return;
+    }
+    /* including the terminator keeps {"ab", "c"} and {"a", "bc"} apart */
+    _put_bytes(enc, str, strlen(str) + 1);
+}
+
+static void _encode(struct caps_send_cache_encoder *enc, const caps_attr_t *attr)
+{
+    int i;
+
+    enc->hash = FNV_OFFSET_BASIS;
+    enc->len = 0;
+    _put_bytes(enc, &attr->value.type, sizeof(attr->value.type));
+    switch (attr->value.type) {
+    case IOT_CAP_VAL_TYPE_INTEGER:
+        _put_bytes(enc, &attr->value.integer, sizeof(attr->value.integer));
+        break;
+    case IOT_CAP_VAL_TYPE_NUMBER:
+    case IOT_CAP_VAL_TYPE_INT_OR_NUM:
+        _put_bytes(enc, &attr->value.number, sizeof(attr->value.number));
+        break;
+    case IOT_CAP_VAL_TYPE_BOOLEAN:
+        _put_bytes(enc, &attr->value.boolean, sizeof(attr->value.boolean));
+        break;
+    case IOT_CAP_VAL_TYPE_STRING:
+        _put_string(enc, attr->value.string);
+        break;
+    case IOT_CAP_VAL_TYPE_JSON_OBJECT:
+        _put_string(enc, attr->value.json_object);
+        break;
+    case IOT_CAP_VAL_TYPE_STR_ARRAY:
+        _put_bytes(enc, &attr->value.str_num, sizeof(attr->value.str_num));
+        for (i = 0; i < attr->value.str_num; i++) {
+            _put_string(enc, attr->value.strings[i]);
+        }
+        break;
+    default:
+        break;
+    }
+    _put_string(enc, attr->unit);
+    _put_string(enc, attr->data);
+}
+
+unsigned int caps_send_cache_hash(const caps_attr_t *attr)
+{
+    struct caps_send_cache_encoder enc = { NULL };
+
+    _encode(&enc, attr);
+    return enc.hash;
+}
+
+void caps_send_cache_value_set(caps_send_cache_value_t *value, const caps_attr_t *attr)
+{
+    struct caps_send_cache_encoder enc = { value };
+
+    _encode(&enc, attr);
+    value->hash = enc.hash;
+    value->len = enc.len;
+}
+
+int caps_send_cache_value_equal(const caps_send_cache_value_t *a, const caps_send_cache_value_t *b)
+{
+    /* the hash only rules out, the kept bytes decide */
+    if (a->hash != b->hash || a->len != b->len) {
+        return 0;
+    }
+    /* a long value may differ beyond the kept bytes */
+    if (a->len > CAPS_SEND_CACHE_VALUE_SIZE) {
+        return 0;
+    }
+    return !memcmp(a->data, b->data, a->len);
+}
+
+static struct caps_send_cache_entry *_find_entry(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    int i;
+
+    for (i = 0; i < cache_entry_num; i++) {
+        if (cache_entry[i].handle == handle &&
+                (cache_entry[i].attribute == attribute || !strcmp(cache_entry[i].attribute, attribute))) {
+            return &cache_entry[i];
+        }
+    }
+    return NULL;
+}
+
+int caps_send_cache_register(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    struct caps_send_cache_entry *entry;
+
+    if (!handle || !attribute) {
+        printf("invalid handle or attribute\n");
+        return -1;
+    }
+
+    if (cache_entry_num == 0) {
+        if (iot_os_mutex_init(&cache_mutex) != IOT_OS_TRUE) {
+            printf("fail to init cache mutex\n");
+            return -1;
+        }
+    }
+
+    iot_os_mutex_lock(&cache_mutex);
+    entry = _find_entry(handle, attribute);
+    if (!entry) {
+        if (cache_entry_num >= CAPS_SEND_CACHE_SIZE) {
+            iot_os_mutex_unlock(&cache_mutex);
+            printf("send cache is full for %s\n", attribute);
+            return -1;
+        }
+        entry = &cache_entry[cache_entry_num];
+        entry->handle = handle;
+        entry->attribute = attribute;
+        cache_entry_num++;
+    }
+    entry->valid = 0;
+    entry->next_valid = 0;
+    iot_os_mutex_unlock(&cache_mutex);
+
+    return 0;
+}
+
+void caps_send_cache_invalidate(IOT_CAP_HANDLE *handle)
+{
+    int i;
+
+    if (cache_entry_num == 0) {
+        return;
+    }
+
+    iot_os_mutex_lock(&cache_mutex);
+    for (i = 0; i < cache_entry_num; i++) {
+        if (!handle || cache_entry[i].handle == handle) {
+            cache_entry[i].valid = 0;
+        }
+    }
+    iot_os_mutex_unlock(&cache_mutex);
+}
+
+unsigned int caps_send_cache_get_suppressed(void)
+{
+    return cache_suppressed;
+}
+
+void caps_send_cache_reset_suppressed(void)
+{
+    cache_suppressed = 0;
+}
+
+int caps_send_cache_get_registered(void)
+{
+    return cache_entry_num;
+}
+
+/* With compare 0, attr is only kept as the value on its way */
+static int _check(const caps_attr_t *attr, unsigned int *hash, int compare)
+{
+    struct caps_send_cache_entry *entry;
+    caps_send_cache_value_t value;
+    int duplicated = 0;
+
+    if (cache_entry_num == 0) {
+        return 0;
+    }
+
+    iot_os_mutex_lock(&cache_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (entry) {
+        caps_send_cache_value_set(&value, attr);
+        *hash = value.hash;
+        if (compare && entry->valid && caps_send_cache_value_equal(&entry->sent, &value)) {
+            cache_suppressed++;
+            duplicated = 1;
+        } else {
+            /* attr may be gone when the send is done, keep what has to be compared */
+            entry->next = value;
+            entry->next_valid = 1;
+        }
+    }
+    iot_os_mutex_unlock(&cache_mutex);
+
+    return duplicated;
+}
+
+int caps_send_cache_check(const caps_attr_t *attr, unsigned int *hash)
+{
+    return _check(attr, hash, 1);
+}
+
+void caps_send_cache_expect(const caps_attr_t *attr, unsigned int *hash)
+{
+    _check(attr, hash, 0);
+}
+
+void caps_send_cache_update(const caps_attr_t *attr, unsigned int hash)
+{
+    struct caps_send_cache_entry *entry;
+
+    if (cache_entry_num == 0) {
+        return;
+    }
+
+    iot_os_mutex_lock(&cache_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (entry) {
+        if (entry->next_valid && entry->next.hash == hash) {
+            entry->sent = entry->next;
+            entry->next_valid = 0;
+            entry->valid = 1;
+        } else {
+            /* sent without a check, or another value was checked meanwhile */
+            entry->valid = 0;
+        }
+    }
+    iot_os_mutex_unlock(&cache_mutex);
+}
@@ -0,0 +1,51 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+
+#include "iot_os_util.h"
+#include "caps_seqlock.h"
+
+int caps_seqlock_init(caps_seqlock_t *lock)
+{
+    if (!lock) {
+        printf("lock is NULL\n");
+        return -1;
+    }
+
+    lock->sequence = 0;
+    if (iot_os_mutex_init(&lock->writer) != IOT_OS_TRUE) {
+        printf("fail to init seqlock mutex\n");
+        return -1;
+    }
+    return 0;
+}
+
+void caps_seqlock_write_begin(caps_seqlock_t *lock)
+{
+    /* one writer at a time, so the sequence is only changed by its holder */
+    iot_os_mutex_lock(&lock->writer);
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void caps_seqlock_write_end(caps_seqlock_t *lock)
+{
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELEASE);
+    iot_os_mutex_unlock(&lock->writer);
+}
@@ -0,0 +1,99 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_SEQLOCK_H_
+#define _CAPS_SEQLOCK_H_
+
+#include <string.h>
+
+#include "iot_os_util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reads retried this many times in a row give the preempted writer 1 ms to finish */
+#ifndef CAPS_SEQLOCK_SPIN_LIMIT
+#define CAPS_SEQLOCK_SPIN_LIMIT 100
+#endif
+
+/**
+ * Sequence lock for state shared between tasks.
+ *
+ * Writers from any task (iot-core command callbacks, the app task, button and
+ * CLI handlers) go one at a time through caps_seqlock_write_begin/end, which
+ * take a mutex of the lock. Readers never take a mutex: they copy the state and
+ * copy again if a write ran meanwhile, so a reader always sees a whole update.
+ *
+ *   caps_seqlock_write_begin(&state_lock);
+ *   state.monitor_enable = !state.monitor_enable;
+ *   caps_seqlock_write_end(&state_lock);
+ *
+ *   caps_seqlock_read(&state_lock, &snapshot, &state, sizeof(state));
+ *
+ * The protected state must be plain data, a pointer in it is only valid as long
+ * as what it points to, e.g. caps_helper strings. String, JSON and array values
+ * of the capability wrappers don't qualify: their set functions free or overwrite
+ * what a get returned, so such a value is set and read from one task only.
+ */
+typedef struct caps_seqlock {
+    unsigned int sequence;      /* odd while a write is in progress */
+    iot_os_mutex writer;
+} caps_seqlock_t;
+
+int caps_seqlock_init(caps_seqlock_t *lock);
+void caps_seqlock_write_begin(caps_seqlock_t *lock);
+void caps_seqlock_write_end(caps_seqlock_t *lock);
+
+static inline unsigned int caps_seqlock_read_begin(caps_seqlock_t *lock)
+{
+    unsigned int sequence;
+    int spin = 0;
+
+    while ((sequence = __atomic_load_n(&lock->sequence, __ATOMIC_ACQUIRE)) & 1) {
+        /* on a single core a spinning reader would keep the writer from finishing */
+        if (++spin >= CAPS_SEQLOCK_SPIN_LIMIT) {
+            iot_os_delay(1);
+            spin = 0;
+        }
+    }
+    return sequence;
+}
+
+/* Returns 1 if what was read since caps_seqlock_read_begin() has to be read again */
+static inline int caps_seqlock_read_retry(caps_seqlock_t *lock, unsigned int sequence)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED) != sequence;
+}
+
+static inline void caps_seqlock_read(caps_seqlock_t *lock, void *dst, const void *src, unsigned int size)
+{
+    unsigned int sequence;
+
+    do {
+        sequence = caps_seqlock_read_begin(lock);
+        memcpy(dst, src, size);
+    } while (caps_seqlock_read_retry(lock, sequence));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_SEQLOCK_H_ */
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_signalStrength.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_signalStrength_get_rssi_milli(caps_signalStrength_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_signalStrength.attr_rssi.min) - 1;
+    }
+    return caps_data->rssi_milli;
+}
+
+static void caps_signalStrength_set_rssi_milli(caps_signalStrength_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_signalStrength.attr_rssi.min)) {
+        printf("%lld is out of range for rssi\n", (long long)milli);
+        return;
+    }
+    caps_data->rssi_milli = milli;
+}
 
 static double caps_signalStrength_get_rssi_value(caps_signalStrength_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_signalStrength_get_rssi_value(caps_signalStrength_data_t *cap
         printf("caps_data is NULL\n");
         return caps_helper_signalStrength.attr_rssi.min - 1;
     }
-    return caps_data->rssi_value;
+    return caps_util_milli_to_double(caps_data->rssi_milli);
 }
 
 static void caps_signalStrength_set_rssi_value(caps_signalStrength_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->rssi_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for rssi\n");
+        return;
+    }
+    caps_signalStrength_set_rssi_milli(caps_data, milli);
 }
 
 static const char *caps_signalStrength_get_rssi_unit(caps_signalStrength_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_signalStrength_attr_rssi_send(caps_signalStrength_data_t *caps_
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_signalStrength.attr_rssi.name,
-            caps_data->rssi_value,
+            caps_data->rssi_milli,
             caps_data->rssi_unit,
             NULL,
             sequence_no);
@@ -109,7 +139,7 @@ static void caps_signalStrength_attr_lqi_send(caps_signalStrength_data_t *caps_d
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_signalStrength.attr_lqi.name,
             caps_data->lqi_value,
             NULL,
@@ -127,10 +157,13 @@ static void caps_signalStrength_attr_lqi_send(caps_signalStrength_data_t *caps_d
 static void caps_signalStrength_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_signalStrength_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_signalStrength_attr_rssi_send(caps_data);
     caps_signalStrength_attr_lqi_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_signalStrength_data_t *caps_signalStrength_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -150,16 +183,18 @@ caps_signalStrength_data_t *caps_signalStrength_initialize(IOT_CTX *ctx, const c
 
     caps_data->get_rssi_value = caps_signalStrength_get_rssi_value;
     caps_data->set_rssi_value = caps_signalStrength_set_rssi_value;
+    caps_data->get_rssi_milli = caps_signalStrength_get_rssi_milli;
+    caps_data->set_rssi_milli = caps_signalStrength_set_rssi_milli;
     caps_data->get_rssi_unit = caps_signalStrength_get_rssi_unit;
     caps_data->set_rssi_unit = caps_signalStrength_set_rssi_unit;
     caps_data->attr_rssi_send = caps_signalStrength_attr_rssi_send;
     caps_data->get_lqi_value = caps_signalStrength_get_lqi_value;
     caps_data->set_lqi_value = caps_signalStrength_set_lqi_value;
     caps_data->attr_lqi_send = caps_signalStrength_attr_lqi_send;
-    caps_data->rssi_value = -200;
+    caps_data->rssi_milli = CAPS_UTIL_MILLI(-200);
     caps_data->lqi_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_signalStrength.id, caps_signalStrength_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_signalStrength.id, caps_signalStrength_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init signalStrength handle\n");
@@ -167,3 +202,16 @@ caps_signalStrength_data_t *caps_signalStrength_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_signalStrength_deinitialize(caps_signalStrength_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
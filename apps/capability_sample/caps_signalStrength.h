@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_signalStrength.h"
 
 #ifdef __cplusplus
@@ -27,12 +29,14 @@ typedef struct caps_signalStrength_data {
     void *usr_data;
     void *cmd_data;
 
-    double rssi_value;
+    int64_t rssi_milli;
     char *rssi_unit;
     int lqi_value;
 
     double (*get_rssi_value)(struct caps_signalStrength_data *caps_data);
     void (*set_rssi_value)(struct caps_signalStrength_data *caps_data, double value);
+    int64_t (*get_rssi_milli)(struct caps_signalStrength_data *caps_data);
+    void (*set_rssi_milli)(struct caps_signalStrength_data *caps_data, int64_t milli);
     const char *(*get_rssi_unit)(struct caps_signalStrength_data *caps_data);
     void (*set_rssi_unit)(struct caps_signalStrength_data *caps_data, const char *unit);
     void (*attr_rssi_send)(struct caps_signalStrength_data *caps_data);
@@ -44,6 +48,7 @@ typedef struct caps_signalStrength_data {
 } caps_signalStrength_data_t;
 
 caps_signalStrength_data_t *caps_signalStrength_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_signalStrength_deinitialize(caps_signalStrength_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
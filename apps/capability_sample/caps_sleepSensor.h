@@ -27,10 +27,12 @@ typedef struct caps_sleepSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *sleeping_value;
+    int sleeping_idx;
 
     const char *(*get_sleeping_value)(struct caps_sleepSensor_data *caps_data);
     void (*set_sleeping_value)(struct caps_sleepSensor_data *caps_data, const char *value);
+    int (*get_sleeping_idx)(struct caps_sleepSensor_data *caps_data);
+    void (*set_sleeping_idx)(struct caps_sleepSensor_data *caps_data, int idx);
     int (*attr_sleeping_str2idx)(const char *value);
     void (*attr_sleeping_send)(struct caps_sleepSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_sleepSensor_data {
 } caps_sleepSensor_data_t;
 
 caps_sleepSensor_data_t *caps_sleepSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_sleepSensor_deinitialize(caps_sleepSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
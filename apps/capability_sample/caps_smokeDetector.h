@@ -27,10 +27,12 @@ typedef struct caps_smokeDetector_data {
     void *usr_data;
     void *cmd_data;
 
-    char *smoke_value;
+    int smoke_idx;
 
     const char *(*get_smoke_value)(struct caps_smokeDetector_data *caps_data);
     void (*set_smoke_value)(struct caps_smokeDetector_data *caps_data, const char *value);
+    int (*get_smoke_idx)(struct caps_smokeDetector_data *caps_data);
+    void (*set_smoke_idx)(struct caps_smokeDetector_data *caps_data, int idx);
     int (*attr_smoke_str2idx)(const char *value);
     void (*attr_smoke_send)(struct caps_smokeDetector_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_smokeDetector_data {
 } caps_smokeDetector_data_t;
 
 caps_smokeDetector_data_t *caps_smokeDetector_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_smokeDetector_deinitialize(caps_smokeDetector_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
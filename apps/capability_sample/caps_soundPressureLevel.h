@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_soundPressureLevel.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_soundPressureLevel_data {
     void *usr_data;
     void *cmd_data;
 
-    double soundPressureLevel_value;
+    int64_t soundPressureLevel_milli;
     char *soundPressureLevel_unit;
 
     double (*get_soundPressureLevel_value)(struct caps_soundPressureLevel_data *caps_data);
     void (*set_soundPressureLevel_value)(struct caps_soundPressureLevel_data *caps_data, double value);
+    int64_t (*get_soundPressureLevel_milli)(struct caps_soundPressureLevel_data *caps_data);
+    void (*set_soundPressureLevel_milli)(struct caps_soundPressureLevel_data *caps_data, int64_t milli);
     const char *(*get_soundPressureLevel_unit)(struct caps_soundPressureLevel_data *caps_data);
     void (*set_soundPressureLevel_unit)(struct caps_soundPressureLevel_data *caps_data, const char *unit);
     void (*attr_soundPressureLevel_send)(struct caps_soundPressureLevel_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_soundPressureLevel_data {
 } caps_soundPressureLevel_data_t;
 
 caps_soundPressureLevel_data_t *caps_soundPressureLevel_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_soundPressureLevel_deinitialize(caps_soundPressureLevel_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_soundSensor.h"
+#include "caps_sender.h"
 
 static int caps_soundSensor_attr_sound_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_soundSensor_get_sound_value(caps_soundSensor_data_t *cap
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->sound_value;
+    if (caps_data->sound_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_soundSensor.attr_sound.values[caps_data->sound_idx];
 }
 
 static void caps_soundSensor_set_sound_value(caps_soundSensor_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->sound_value) {
-        free(caps_data->sound_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_soundSensor_attr_sound_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for sound\n", value);
+        return;
     }
-    caps_data->sound_value = strdup(value);
+    caps_data->sound_idx = index;
+}
+
+static int caps_soundSensor_get_sound_idx(caps_soundSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->sound_idx;
+}
+
+static void caps_soundSensor_set_sound_idx(caps_soundSensor_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_SOUNDSENSOR_SOUND_VALUE_MAX) {
+        printf("%d is not supported index for sound\n", idx);
+        return;
+    }
+    caps_data->sound_idx = idx;
 }
 
 static void caps_soundSensor_attr_sound_send(caps_soundSensor_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_soundSensor_attr_sound_send(caps_soundSensor_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->sound_value) {
+    if (caps_data->sound_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_soundSensor.attr_sound.name,
-            caps_data->sound_value,
+            (char *)caps_helper_soundSensor.attr_sound.values[caps_data->sound_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_soundSensor_attr_sound_send(caps_soundSensor_data_t *caps_data)
 static void caps_soundSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_soundSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_soundSensor_attr_sound_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_soundSensor_data_t *caps_soundSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_soundSensor_data_t *caps_soundSensor_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_sound_value = caps_soundSensor_get_sound_value;
     caps_data->set_sound_value = caps_soundSensor_set_sound_value;
+    caps_data->get_sound_idx = caps_soundSensor_get_sound_idx;
+    caps_data->set_sound_idx = caps_soundSensor_set_sound_idx;
     caps_data->attr_sound_str2idx = caps_soundSensor_attr_sound_str2idx;
     caps_data->attr_sound_send = caps_soundSensor_attr_sound_send;
+    caps_data->sound_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_soundSensor.id, caps_soundSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_soundSensor.id, caps_soundSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init soundSensor handle\n");
@@ -120,3 +160,16 @@ caps_soundSensor_data_t *caps_soundSensor_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_soundSensor_deinitialize(caps_soundSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
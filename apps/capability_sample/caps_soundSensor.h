@@ -27,10 +27,12 @@ typedef struct caps_soundSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *sound_value;
+    int sound_idx;
 
     const char *(*get_sound_value)(struct caps_soundSensor_data *caps_data);
     void (*set_sound_value)(struct caps_soundSensor_data *caps_data, const char *value);
+    int (*get_sound_idx)(struct caps_soundSensor_data *caps_data);
+    void (*set_sound_idx)(struct caps_soundSensor_data *caps_data, int idx);
     int (*attr_sound_str2idx)(const char *value);
     void (*attr_sound_send)(struct caps_soundSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_soundSensor_data {
 } caps_soundSensor_data_t;
 
 caps_soundSensor_data_t *caps_soundSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_soundSensor_deinitialize(caps_soundSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
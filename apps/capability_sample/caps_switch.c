@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_switch.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_switch_attr_switch_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_switch_get_switch_value(caps_switch_data_t *caps_data)
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->switch_value;
+    if (caps_data->switch_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_switch.attr_switch.values[caps_data->switch_idx];
 }
 
 static void caps_switch_set_switch_value(caps_switch_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_switch_attr_switch_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for switch\n", value);
+        return;
+    }
+    caps_data->switch_idx = index;
+}
+
+static int caps_switch_get_switch_idx(caps_switch_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->switch_idx;
+}
+
+static void caps_switch_set_switch_idx(caps_switch_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->switch_value) {
-        free(caps_data->switch_value);
+    if (idx < 0 || idx >= CAP_ENUM_SWITCH_SWITCH_VALUE_MAX) {
+        printf("%d is not supported index for switch\n", idx);
+        return;
     }
-    caps_data->switch_value = strdup(value);
+    caps_data->switch_idx = idx;
 }
 
 static void caps_switch_attr_switch_send(caps_switch_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_switch_attr_switch_send(caps_switch_data_t *caps_data)
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->switch_value) {
+    if (caps_data->switch_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_switch.attr_switch.name,
-            caps_data->switch_value,
+            (char *)caps_helper_switch.attr_switch.values[caps_data->switch_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,11 +122,11 @@ static void caps_switch_attr_switch_send(caps_switch_data_t *caps_data)
 static void caps_switch_cmd_on_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_switch_data_t *caps_data = (caps_switch_data_t *)usr_data;
-    const char* value = caps_helper_switch.attr_switch.values[CAP_ENUM_SWITCH_SWITCH_VALUE_ON];
+    int index = CAP_ENUM_SWITCH_SWITCH_VALUE_ON;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_switch_set_switch_value(caps_data, value);
+    caps_switch_set_switch_idx(caps_data, index);
     if (caps_data && caps_data->cmd_on_usr_cb)
         caps_data->cmd_on_usr_cb(caps_data);
     caps_switch_attr_switch_send(caps_data);
@@ -100,11 +135,11 @@ static void caps_switch_cmd_on_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cm
 static void caps_switch_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_switch_data_t *caps_data = (caps_switch_data_t *)usr_data;
-    const char* value = caps_helper_switch.attr_switch.values[CAP_ENUM_SWITCH_SWITCH_VALUE_OFF];
+    int index = CAP_ENUM_SWITCH_SWITCH_VALUE_OFF;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_switch_set_switch_value(caps_data, value);
+    caps_switch_set_switch_idx(caps_data, index);
     if (caps_data && caps_data->cmd_off_usr_cb)
         caps_data->cmd_off_usr_cb(caps_data);
     caps_switch_attr_switch_send(caps_data);
@@ -113,9 +148,12 @@ static void caps_switch_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *c
 static void caps_switch_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_switch_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_switch_attr_switch_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_switch_data_t *caps_switch_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -136,17 +174,20 @@ caps_switch_data_t *caps_switch_initialize(IOT_CTX *ctx, const char *component,
 
     caps_data->get_switch_value = caps_switch_get_switch_value;
     caps_data->set_switch_value = caps_switch_set_switch_value;
+    caps_data->get_switch_idx = caps_switch_get_switch_idx;
+    caps_data->set_switch_idx = caps_switch_set_switch_idx;
     caps_data->attr_switch_str2idx = caps_switch_attr_switch_str2idx;
     caps_data->attr_switch_send = caps_switch_attr_switch_send;
+    caps_data->switch_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_switch.id, caps_switch_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_switch.id, caps_switch_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_switch.cmd_on.name, caps_switch_cmd_on_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_switch.cmd_on.name, caps_switch_cmd_on_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for on of switch\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_switch.cmd_off.name, caps_switch_cmd_off_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_switch.cmd_off.name, caps_switch_cmd_off_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for off of switch\n");
     }
@@ -156,3 +197,268 @@ caps_switch_data_t *caps_switch_initialize(IOT_CTX *ctx, const char *component,
 
     return caps_data;
 }
+
+void caps_switch_deinitialize(caps_switch_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
+
+static int caps_switch_n_channel(caps_switch_n_data_t *caps_data, IOT_CAP_HANDLE *handle)
+{
+    int ch;
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch] == handle) {
+            return ch;
+        }
+    }
+    return -1;
+}
+
+static const char *caps_switch_n_get_switch_value(caps_switch_n_data_t *caps_data, int ch)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return NULL;
+    }
+    if (ch < 0 || ch >= caps_data->num || caps_data->switch_idx[ch] < 0) {
+        return NULL;
+    }
+    return caps_helper_switch.attr_switch.values[caps_data->switch_idx[ch]];
+}
+
+static void caps_switch_n_set_switch_idx(caps_switch_n_data_t *caps_data, int ch, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (ch < 0 || ch >= caps_data->num) {
+        printf("%d is not a channel of switch\n", ch);
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_SWITCH_SWITCH_VALUE_MAX) {
+        printf("%d is not supported index for switch\n", idx);
+        return;
+    }
+    caps_data->switch_idx[ch] = idx;
+}
+
+static void caps_switch_n_set_switch_value(caps_switch_n_data_t *caps_data, int ch, const char *value)
+{
+    int index;
+
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_switch_attr_switch_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for switch\n", value);
+        return;
+    }
+    caps_switch_n_set_switch_idx(caps_data, ch, index);
+}
+
+static int caps_switch_n_get_switch_idx(caps_switch_n_data_t *caps_data, int ch)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    if (ch < 0 || ch >= caps_data->num) {
+        return -1;
+    }
+    return caps_data->switch_idx[ch];
+}
+
+static void caps_switch_n_attr_switch_send(caps_switch_n_data_t *caps_data, int ch)
+{
+    int sequence_no = -1;
+
+    if (!caps_data || ch < 0 || ch >= caps_data->num || !caps_data->handle[ch]) {
+        printf("fail to get handle\n");
+        return;
+    }
+    if (caps_data->switch_idx[ch] < 0) {
+        printf("value is NULL\n");
+        return;
+    }
+
+    CAPS_SEND_ATTR_STRING(caps_data->handle[ch],
+            (char *)caps_helper_switch.attr_switch.name,
+            (char *)caps_helper_switch.attr_switch.values[caps_data->switch_idx[ch]],
+            NULL,
+            NULL,
+            sequence_no);
+
+    if (sequence_no < 0)
+        printf("fail to send switch value\n");
+    else
+        printf("Sequence number return : %d\n", sequence_no);
+}
+
+/* all channels go out in as few messages as caps_sender allows */
+static void caps_switch_n_attr_switch_send_all(caps_switch_n_data_t *caps_data)
+{
+    caps_attr_t attrs[CAPS_SENDER_MAX_EVENTS];
+    int attr_num = 0;
+    int sequence_no;
+    int ch;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch] && caps_data->switch_idx[ch] >= 0) {
+            attrs[attr_num].handle = caps_data->handle[ch];
+            attrs[attr_num].name = caps_helper_switch.attr_switch.name;
+            attrs[attr_num].value.type = IOT_CAP_VAL_TYPE_STRING;
+            attrs[attr_num].value.string = (char *)caps_helper_switch.attr_switch.values[caps_data->switch_idx[ch]];
+            attrs[attr_num].unit = NULL;
+            attrs[attr_num].data = NULL;
+            attr_num++;
+        }
+        if (attr_num == CAPS_SENDER_MAX_EVENTS || (attr_num > 0 && ch == caps_data->num - 1)) {
+            sequence_no = caps_sender_send_attrs(attrs, attr_num);
+            if (sequence_no < 0)
+                printf("fail to send switch values\n");
+            else
+                printf("Sequence number return : %d\n", sequence_no);
+            attr_num = 0;
+        }
+    }
+}
+
+static void caps_switch_n_cmd_on_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    caps_switch_n_data_t *caps_data = (caps_switch_n_data_t *)usr_data;
+    int ch = caps_switch_n_channel(caps_data, handle);
+
+    printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
+
+    if (ch < 0) {
+        printf("unknown handle for switch\n");
+        return;
+    }
+    caps_switch_n_set_switch_idx(caps_data, ch, CAP_ENUM_SWITCH_SWITCH_VALUE_ON);
+    if (caps_data->cmd_on_usr_cb)
+        caps_data->cmd_on_usr_cb(caps_data, ch);
+    caps_switch_n_attr_switch_send(caps_data, ch);
+}
+
+static void caps_switch_n_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    caps_switch_n_data_t *caps_data = (caps_switch_n_data_t *)usr_data;
+    int ch = caps_switch_n_channel(caps_data, handle);
+
+    printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
+
+    if (ch < 0) {
+        printf("unknown handle for switch\n");
+        return;
+    }
+    caps_switch_n_set_switch_idx(caps_data, ch, CAP_ENUM_SWITCH_SWITCH_VALUE_OFF);
+    if (caps_data->cmd_off_usr_cb)
+        caps_data->cmd_off_usr_cb(caps_data, ch);
+    caps_switch_n_attr_switch_send(caps_data, ch);
+}
+
+static void caps_switch_n_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    caps_switch_n_data_t *caps_data = usr_data;
+    int ch = caps_switch_n_channel(caps_data, handle);
+
+    caps_sender_init_cb_begin(handle);
+    if (ch >= 0) {
+        if (caps_data->init_usr_cb)
+            caps_data->init_usr_cb(caps_data, ch);
+        caps_switch_n_attr_switch_send(caps_data, ch);
+    }
+    caps_sender_init_cb_end(handle);
+}
+
+caps_switch_n_data_t *caps_switch_initialize_n(IOT_CTX *ctx, const char **components, int num, void *init_usr_cb, void *usr_data)
+{
+    caps_switch_n_data_t *caps_data = NULL;
+    size_t size;
+    int err;
+
+    if (!components || num <= 0) {
+        printf("invalid parameter\n");
+        return NULL;
+    }
+
+    /* the struct, handles and states of all channels at once */
+    size = sizeof(caps_switch_n_data_t) + (sizeof(IOT_CAP_HANDLE *) + sizeof(signed char)) * num;
+    caps_data = malloc(size);
+    if (!caps_data) {
+        printf("fail to malloc for caps_switch_n_data\n");
+        return NULL;
+    }
+
+    memset(caps_data, 0, size);
+
+    caps_data->handle = (IOT_CAP_HANDLE **)(caps_data + 1);
+    caps_data->switch_idx = (signed char *)(caps_data->handle + num);
+    caps_data->num = num;
+    caps_data->init_usr_cb = init_usr_cb;
+    caps_data->usr_data = usr_data;
+
+    caps_data->get_switch_value = caps_switch_n_get_switch_value;
+    caps_data->set_switch_value = caps_switch_n_set_switch_value;
+    caps_data->get_switch_idx = caps_switch_n_get_switch_idx;
+    caps_data->set_switch_idx = caps_switch_n_set_switch_idx;
+    caps_data->attr_switch_send = caps_switch_n_attr_switch_send;
+    caps_data->attr_switch_send_all = caps_switch_n_attr_switch_send_all;
+    memset(caps_data->switch_idx, -1, num);
+
+    if (!ctx) {
+        return caps_data;
+    }
+    /* every channel or none, a device with some channels missing is not usable */
+    if (caps_sender_handle_init_n(ctx, components, num, caps_helper_switch.id, caps_switch_n_init_cb, caps_data, caps_data->handle)) {
+        printf("fail to init %d switch handles\n", num);
+        free(caps_data);
+        return NULL;
+    }
+    err = caps_cmd_set_cb_n(caps_data->handle, num, caps_helper_switch.cmd_on.name, caps_switch_n_cmd_on_cb, caps_data);
+    if (err) {
+        printf("fail to set cmd_cb for on of switch\n");
+    }
+    err = caps_cmd_set_cb_n(caps_data->handle, num, caps_helper_switch.cmd_off.name, caps_switch_n_cmd_off_cb, caps_data);
+    if (err) {
+        printf("fail to set cmd_cb for off of switch\n");
+    }
+
+    return caps_data;
+}
+
+void caps_switch_deinitialize_n(caps_switch_n_data_t *caps_data)
+{
+    int ch;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch]) {
+            caps_cmd_unset_cb(caps_data->handle[ch]);
+            caps_sender_handle_detach(caps_data->handle[ch]);
+        }
+    }
+    free(caps_data);
+}
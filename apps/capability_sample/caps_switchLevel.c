@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_switchLevel.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_switchLevel_get_level_value(caps_switchLevel_data_t *caps_data)
 {
@@ -68,7 +70,7 @@ static void caps_switchLevel_attr_level_send(caps_switchLevel_data_t *caps_data)
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_switchLevel.attr_level.name,
             caps_data->level_value,
             caps_data->level_unit,
@@ -100,9 +102,12 @@ static void caps_switchLevel_cmd_setLevel_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd
 static void caps_switchLevel_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_switchLevel_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_switchLevel_attr_level_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_switchLevel_data_t *caps_switchLevel_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -128,10 +133,10 @@ caps_switchLevel_data_t *caps_switchLevel_initialize(IOT_CTX *ctx, const char *c
     caps_data->attr_level_send = caps_switchLevel_attr_level_send;
     caps_data->level_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_switchLevel.id, caps_switchLevel_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_switchLevel.id, caps_switchLevel_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_switchLevel.cmd_setLevel.name, caps_switchLevel_cmd_setLevel_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_switchLevel.cmd_setLevel.name, caps_switchLevel_cmd_setLevel_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setLevel of switchLevel\n");
     }
@@ -141,3 +146,236 @@ caps_switchLevel_data_t *caps_switchLevel_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_switchLevel_deinitialize(caps_switchLevel_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
+
+static int caps_switchLevel_n_channel(caps_switchLevel_n_data_t *caps_data, IOT_CAP_HANDLE *handle)
+{
+    int ch;
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch] == handle) {
+            return ch;
+        }
+    }
+    return -1;
+}
+
+static int caps_switchLevel_n_get_level_value(caps_switchLevel_n_data_t *caps_data, int ch)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return caps_helper_switchLevel.attr_level.min - 1;
+    }
+    if (ch < 0 || ch >= caps_data->num) {
+        return caps_helper_switchLevel.attr_level.min - 1;
+    }
+    return caps_data->level_value[ch];
+}
+
+static void caps_switchLevel_n_set_level_value(caps_switchLevel_n_data_t *caps_data, int ch, int value)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (ch < 0 || ch >= caps_data->num) {
+        printf("%d is not a channel of switchLevel\n", ch);
+        return;
+    }
+    /* kept in a byte per channel */
+    if (value < caps_helper_switchLevel.attr_level.min || value > caps_helper_switchLevel.attr_level.max) {
+        printf("%d is out of range for level\n", value);
+        return;
+    }
+    caps_data->level_value[ch] = value;
+}
+
+static const char *caps_switchLevel_n_get_level_unit(caps_switchLevel_n_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return NULL;
+    }
+    return caps_data->level_unit;
+}
+
+static void caps_switchLevel_n_set_level_unit(caps_switchLevel_n_data_t *caps_data, const char *unit)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    caps_data->level_unit = (char *)unit;
+}
+
+static void caps_switchLevel_n_attr_level_send(caps_switchLevel_n_data_t *caps_data, int ch)
+{
+    int sequence_no = -1;
+
+    if (!caps_data || ch < 0 || ch >= caps_data->num || !caps_data->handle[ch]) {
+        printf("fail to get handle\n");
+        return;
+    }
+
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle[ch],
+            (char *)caps_helper_switchLevel.attr_level.name,
+            caps_data->level_value[ch],
+            caps_data->level_unit,
+            NULL,
+            sequence_no);
+
+    if (sequence_no < 0)
+        printf("fail to send level value\n");
+    else
+        printf("Sequence number return : %d\n", sequence_no);
+}
+
+/* all channels go out in as few messages as caps_sender allows */
+static void caps_switchLevel_n_attr_level_send_all(caps_switchLevel_n_data_t *caps_data)
+{
+    caps_attr_t attrs[CAPS_SENDER_MAX_EVENTS];
+    int attr_num = 0;
+    int sequence_no;
+    int ch;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch]) {
+            attrs[attr_num].handle = caps_data->handle[ch];
+            attrs[attr_num].name = caps_helper_switchLevel.attr_level.name;
+            attrs[attr_num].value.type = IOT_CAP_VAL_TYPE_NUMBER;
+            attrs[attr_num].value.number = caps_data->level_value[ch];
+            attrs[attr_num].unit = caps_data->level_unit;
+            attrs[attr_num].data = NULL;
+            attr_num++;
+        }
+        if (attr_num == CAPS_SENDER_MAX_EVENTS || (attr_num > 0 && ch == caps_data->num - 1)) {
+            sequence_no = caps_sender_send_attrs(attrs, attr_num);
+            if (sequence_no < 0)
+                printf("fail to send level values\n");
+            else
+                printf("Sequence number return : %d\n", sequence_no);
+            attr_num = 0;
+        }
+    }
+}
+
+static void caps_switchLevel_n_cmd_setLevel_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    caps_switchLevel_n_data_t *caps_data = (caps_switchLevel_n_data_t *)usr_data;
+    int ch = caps_switchLevel_n_channel(caps_data, handle);
+    int value;
+
+    printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
+
+    if (ch < 0) {
+        printf("unknown handle for switchLevel\n");
+        return;
+    }
+    value = cmd_data->cmd_data[0].integer;
+
+    caps_switchLevel_n_set_level_value(caps_data, ch, value);
+    if (caps_data->cmd_setLevel_usr_cb)
+        caps_data->cmd_setLevel_usr_cb(caps_data, ch);
+    caps_switchLevel_n_attr_level_send(caps_data, ch);
+}
+
+static void caps_switchLevel_n_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    caps_switchLevel_n_data_t *caps_data = usr_data;
+    int ch = caps_switchLevel_n_channel(caps_data, handle);
+
+    caps_sender_init_cb_begin(handle);
+    if (ch >= 0) {
+        if (caps_data->init_usr_cb)
+            caps_data->init_usr_cb(caps_data, ch);
+        caps_switchLevel_n_attr_level_send(caps_data, ch);
+    }
+    caps_sender_init_cb_end(handle);
+}
+
+caps_switchLevel_n_data_t *caps_switchLevel_initialize_n(IOT_CTX *ctx, const char **components, int num, void *init_usr_cb, void *usr_data)
+{
+    caps_switchLevel_n_data_t *caps_data = NULL;
+    size_t size;
+    int err;
+
+    if (!components || num <= 0) {
+        printf("invalid parameter\n");
+        return NULL;
+    }
+
+    /* the struct, handles and levels of all channels at once */
+    size = sizeof(caps_switchLevel_n_data_t) + (sizeof(IOT_CAP_HANDLE *) + sizeof(unsigned char)) * num;
+    caps_data = malloc(size);
+    if (!caps_data) {
+        printf("fail to malloc for caps_switchLevel_n_data\n");
+        return NULL;
+    }
+
+    memset(caps_data, 0, size);
+
+    caps_data->handle = (IOT_CAP_HANDLE **)(caps_data + 1);
+    caps_data->level_value = (unsigned char *)(caps_data->handle + num);
+    caps_data->num = num;
+    caps_data->init_usr_cb = init_usr_cb;
+    caps_data->usr_data = usr_data;
+
+    caps_data->get_level_value = caps_switchLevel_n_get_level_value;
+    caps_data->set_level_value = caps_switchLevel_n_set_level_value;
+    caps_data->get_level_unit = caps_switchLevel_n_get_level_unit;
+    caps_data->set_level_unit = caps_switchLevel_n_set_level_unit;
+    caps_data->attr_level_send = caps_switchLevel_n_attr_level_send;
+    caps_data->attr_level_send_all = caps_switchLevel_n_attr_level_send_all;
+
+    if (!ctx) {
+        return caps_data;
+    }
+    /* every channel or none, a device with some channels missing is not usable */
+    if (caps_sender_handle_init_n(ctx, components, num, caps_helper_switchLevel.id, caps_switchLevel_n_init_cb, caps_data, caps_data->handle)) {
+        printf("fail to init %d switchLevel handles\n", num);
+        free(caps_data);
+        return NULL;
+    }
+    err = caps_cmd_set_cb_n(caps_data->handle, num, caps_helper_switchLevel.cmd_setLevel.name, caps_switchLevel_n_cmd_setLevel_cb, caps_data);
+    if (err) {
+        printf("fail to set cmd_cb for setLevel of switchLevel\n");
+    }
+
+    return caps_data;
+}
+
+void caps_switchLevel_deinitialize_n(caps_switchLevel_n_data_t *caps_data)
+{
+    int ch;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    for (ch = 0; ch < caps_data->num; ch++) {
+        if (caps_data->handle[ch]) {
+            caps_cmd_unset_cb(caps_data->handle[ch]);
+            caps_sender_handle_detach(caps_data->handle[ch]);
+        }
+    }
+    free(caps_data);
+}
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_tamperAlert.h"
+#include "caps_sender.h"
 
 static int caps_tamperAlert_attr_tamper_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_tamperAlert_get_tamper_value(caps_tamperAlert_data_t *ca
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->tamper_value;
+    if (caps_data->tamper_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_tamperAlert.attr_tamper.values[caps_data->tamper_idx];
 }
 
 static void caps_tamperAlert_set_tamper_value(caps_tamperAlert_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->tamper_value) {
-        free(caps_data->tamper_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_tamperAlert_attr_tamper_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for tamper\n", value);
+        return;
     }
-    caps_data->tamper_value = strdup(value);
+    caps_data->tamper_idx = index;
+}
+
+static int caps_tamperAlert_get_tamper_idx(caps_tamperAlert_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->tamper_idx;
+}
+
+static void caps_tamperAlert_set_tamper_idx(caps_tamperAlert_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_TAMPERALERT_TAMPER_VALUE_MAX) {
+        printf("%d is not supported index for tamper\n", idx);
+        return;
+    }
+    caps_data->tamper_idx = idx;
 }
 
 static void caps_tamperAlert_attr_tamper_send(caps_tamperAlert_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_tamperAlert_attr_tamper_send(caps_tamperAlert_data_t *caps_data
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->tamper_value) {
+    if (caps_data->tamper_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_tamperAlert.attr_tamper.name,
-            caps_data->tamper_value,
+            (char *)caps_helper_tamperAlert.attr_tamper.values[caps_data->tamper_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_tamperAlert_attr_tamper_send(caps_tamperAlert_data_t *caps_data
 static void caps_tamperAlert_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_tamperAlert_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_tamperAlert_attr_tamper_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_tamperAlert_data_t *caps_tamperAlert_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,14 +146,32 @@ caps_tamperAlert_data_t *caps_tamperAlert_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_tamper_value = caps_tamperAlert_get_tamper_value;
     caps_data->set_tamper_value = caps_tamperAlert_set_tamper_value;
+    caps_data->get_tamper_idx = caps_tamperAlert_get_tamper_idx;
+    caps_data->set_tamper_idx = caps_tamperAlert_set_tamper_idx;
     caps_data->attr_tamper_str2idx = caps_tamperAlert_attr_tamper_str2idx;
     caps_data->attr_tamper_send = caps_tamperAlert_attr_tamper_send;
+    caps_data->tamper_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_tamperAlert.id, caps_tamperAlert_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_tamperAlert.id, caps_tamperAlert_init_cb, caps_data);
     }
-    if (!caps_data->handle) {
+    if (caps_data->handle) {
+        caps_sender_set_priority(caps_data->handle, caps_helper_tamperAlert.attr_tamper.name, CAPS_SEND_PRIORITY_CRITICAL);
+    } else {
         printf("fail to init tamperAlert handle\n");
     }
 
     return caps_data;
 }
+
+void caps_tamperAlert_deinitialize(caps_tamperAlert_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
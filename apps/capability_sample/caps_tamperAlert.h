@@ -27,10 +27,12 @@ typedef struct caps_tamperAlert_data {
     void *usr_data;
     void *cmd_data;
 
-    char *tamper_value;
+    int tamper_idx;
 
     const char *(*get_tamper_value)(struct caps_tamperAlert_data *caps_data);
     void (*set_tamper_value)(struct caps_tamperAlert_data *caps_data, const char *value);
+    int (*get_tamper_idx)(struct caps_tamperAlert_data *caps_data);
+    void (*set_tamper_idx)(struct caps_tamperAlert_data *caps_data, int idx);
     int (*attr_tamper_str2idx)(const char *value);
     void (*attr_tamper_send)(struct caps_tamperAlert_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_tamperAlert_data {
 } caps_tamperAlert_data_t;
 
 caps_tamperAlert_data_t *caps_tamperAlert_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_tamperAlert_deinitialize(caps_tamperAlert_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
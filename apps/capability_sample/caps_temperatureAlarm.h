@@ -27,10 +27,12 @@ typedef struct caps_temperatureAlarm_data {
     void *usr_data;
     void *cmd_data;
 
-    char *temperatureAlarm_value;
+    int temperatureAlarm_idx;
 
     const char *(*get_temperatureAlarm_value)(struct caps_temperatureAlarm_data *caps_data);
     void (*set_temperatureAlarm_value)(struct caps_temperatureAlarm_data *caps_data, const char *value);
+    int (*get_temperatureAlarm_idx)(struct caps_temperatureAlarm_data *caps_data);
+    void (*set_temperatureAlarm_idx)(struct caps_temperatureAlarm_data *caps_data, int idx);
     int (*attr_temperatureAlarm_str2idx)(const char *value);
     void (*attr_temperatureAlarm_send)(struct caps_temperatureAlarm_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_temperatureAlarm_data {
 } caps_temperatureAlarm_data_t;
 
 caps_temperatureAlarm_data_t *caps_temperatureAlarm_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_temperatureAlarm_deinitialize(caps_temperatureAlarm_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_temperatureMeasurement.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_temperatureMeasurement_get_temperature_milli(caps_temperatureMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_temperatureMeasurement.attr_temperature.min) - 1;
+    }
+    return caps_data->temperature_milli;
+}
+
+static void caps_temperatureMeasurement_set_temperature_milli(caps_temperatureMeasurement_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_temperatureMeasurement.attr_temperature.min)) {
+        printf("%lld is out of range for temperature\n", (long long)milli);
+        return;
+    }
+    caps_data->temperature_milli = milli;
+}
 
 static double caps_temperatureMeasurement_get_temperature_value(caps_temperatureMeasurement_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_temperatureMeasurement_get_temperature_value(caps_temperature
         printf("caps_data is NULL\n");
         return caps_helper_temperatureMeasurement.attr_temperature.min - 1;
     }
-    return caps_data->temperature_value;
+    return caps_util_milli_to_double(caps_data->temperature_milli);
 }
 
 static void caps_temperatureMeasurement_set_temperature_value(caps_temperatureMeasurement_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->temperature_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for temperature\n");
+        return;
+    }
+    caps_temperatureMeasurement_set_temperature_milli(caps_data, milli);
 }
 
 static const char *caps_temperatureMeasurement_get_temperature_unit(caps_temperatureMeasurement_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_temperatureMeasurement_attr_temperature_send(caps_temperatureMe
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_temperatureMeasurement.attr_temperature.name,
-            caps_data->temperature_value,
+            caps_data->temperature_milli,
             caps_data->temperature_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_temperatureMeasurement_attr_temperature_send(caps_temperatureMe
 static void caps_temperatureMeasurement_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_temperatureMeasurement_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_temperatureMeasurement_attr_temperature_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_temperatureMeasurement_data_t *caps_temperatureMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_temperatureMeasurement_data_t *caps_temperatureMeasurement_initialize(IOT_C
 
     caps_data->get_temperature_value = caps_temperatureMeasurement_get_temperature_value;
     caps_data->set_temperature_value = caps_temperatureMeasurement_set_temperature_value;
+    caps_data->get_temperature_milli = caps_temperatureMeasurement_get_temperature_milli;
+    caps_data->set_temperature_milli = caps_temperatureMeasurement_set_temperature_milli;
     caps_data->get_temperature_unit = caps_temperatureMeasurement_get_temperature_unit;
     caps_data->set_temperature_unit = caps_temperatureMeasurement_set_temperature_unit;
     caps_data->attr_temperature_send = caps_temperatureMeasurement_attr_temperature_send;
-    caps_data->temperature_value = -460;
+    caps_data->temperature_milli = CAPS_UTIL_MILLI(-460);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_temperatureMeasurement.id, caps_temperatureMeasurement_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_temperatureMeasurement.id, caps_temperatureMeasurement_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init temperatureMeasurement handle\n");
@@ -120,3 +155,16 @@ caps_temperatureMeasurement_data_t *caps_temperatureMeasurement_initialize(IOT_C
 
     return caps_data;
 }
+
+void caps_temperatureMeasurement_deinitialize(caps_temperatureMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_temperatureMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_temperatureMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double temperature_value;
+    int64_t temperature_milli;
     char *temperature_unit;
 
     double (*get_temperature_value)(struct caps_temperatureMeasurement_data *caps_data);
     void (*set_temperature_value)(struct caps_temperatureMeasurement_data *caps_data, double value);
+    int64_t (*get_temperature_milli)(struct caps_temperatureMeasurement_data *caps_data);
+    void (*set_temperature_milli)(struct caps_temperatureMeasurement_data *caps_data, int64_t milli);
     const char *(*get_temperature_unit)(struct caps_temperatureMeasurement_data *caps_data);
     void (*set_temperature_unit)(struct caps_temperatureMeasurement_data *caps_data, const char *unit);
     void (*attr_temperature_send)(struct caps_temperatureMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_temperatureMeasurement_data {
 } caps_temperatureMeasurement_data_t;
 
 caps_temperatureMeasurement_data_t *caps_temperatureMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_temperatureMeasurement_deinitialize(caps_temperatureMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,31 @@
 
 #include "st_dev.h"
 #include "caps_thermostatCoolingSetpoint.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+
+static int64_t caps_thermostatCoolingSetpoint_get_coolingSetpoint_milli(caps_thermostatCoolingSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_thermostatCoolingSetpoint.attr_coolingSetpoint.min) - 1;
+    }
+    return caps_data->coolingSetpoint_milli;
+}
+
+static void caps_thermostatCoolingSetpoint_set_coolingSetpoint_milli(caps_thermostatCoolingSetpoint_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_thermostatCoolingSetpoint.attr_coolingSetpoint.min)) {
+        printf("%lld is out of range for coolingSetpoint\n", (long long)milli);
+        return;
+    }
+    caps_data->coolingSetpoint_milli = milli;
+}
 
 static double caps_thermostatCoolingSetpoint_get_coolingSetpoint_value(caps_thermostatCoolingSetpoint_data_t *caps_data)
 {
@@ -29,16 +54,22 @@ static double caps_thermostatCoolingSetpoint_get_coolingSetpoint_value(caps_ther
         printf("caps_data is NULL\n");
         return caps_helper_thermostatCoolingSetpoint.attr_coolingSetpoint.min - 1;
     }
-    return caps_data->coolingSetpoint_value;
+    return caps_util_milli_to_double(caps_data->coolingSetpoint_milli);
 }
 
 static void caps_thermostatCoolingSetpoint_set_coolingSetpoint_value(caps_thermostatCoolingSetpoint_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->coolingSetpoint_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for coolingSetpoint\n");
+        return;
+    }
+    caps_thermostatCoolingSetpoint_set_coolingSetpoint_milli(caps_data, milli);
 }
 
 static const char *caps_thermostatCoolingSetpoint_get_coolingSetpoint_unit(caps_thermostatCoolingSetpoint_data_t *caps_data)
@@ -68,9 +99,9 @@ static void caps_thermostatCoolingSetpoint_attr_coolingSetpoint_send(caps_thermo
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_thermostatCoolingSetpoint.attr_coolingSetpoint.name,
-            caps_data->coolingSetpoint_value,
+            caps_data->coolingSetpoint_milli,
             caps_data->coolingSetpoint_unit,
             NULL,
             sequence_no);
@@ -100,9 +131,12 @@ static void caps_thermostatCoolingSetpoint_cmd_setCoolingSetpoint_cb(IOT_CAP_HAN
 static void caps_thermostatCoolingSetpoint_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatCoolingSetpoint_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatCoolingSetpoint_attr_coolingSetpoint_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatCoolingSetpoint_data_t *caps_thermostatCoolingSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -123,15 +157,17 @@ caps_thermostatCoolingSetpoint_data_t *caps_thermostatCoolingSetpoint_initialize
 
     caps_data->get_coolingSetpoint_value = caps_thermostatCoolingSetpoint_get_coolingSetpoint_value;
     caps_data->set_coolingSetpoint_value = caps_thermostatCoolingSetpoint_set_coolingSetpoint_value;
+    caps_data->get_coolingSetpoint_milli = caps_thermostatCoolingSetpoint_get_coolingSetpoint_milli;
+    caps_data->set_coolingSetpoint_milli = caps_thermostatCoolingSetpoint_set_coolingSetpoint_milli;
     caps_data->get_coolingSetpoint_unit = caps_thermostatCoolingSetpoint_get_coolingSetpoint_unit;
     caps_data->set_coolingSetpoint_unit = caps_thermostatCoolingSetpoint_set_coolingSetpoint_unit;
     caps_data->attr_coolingSetpoint_send = caps_thermostatCoolingSetpoint_attr_coolingSetpoint_send;
-    caps_data->coolingSetpoint_value = -460;
+    caps_data->coolingSetpoint_milli = CAPS_UTIL_MILLI(-460);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatCoolingSetpoint.id, caps_thermostatCoolingSetpoint_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatCoolingSetpoint.id, caps_thermostatCoolingSetpoint_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatCoolingSetpoint.cmd_setCoolingSetpoint.name, caps_thermostatCoolingSetpoint_cmd_setCoolingSetpoint_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatCoolingSetpoint.cmd_setCoolingSetpoint.name, caps_thermostatCoolingSetpoint_cmd_setCoolingSetpoint_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setCoolingSetpoint of thermostatCoolingSetpoint\n");
     }
@@ -141,3 +177,17 @@ caps_thermostatCoolingSetpoint_data_t *caps_thermostatCoolingSetpoint_initialize
 
     return caps_data;
 }
+
+void caps_thermostatCoolingSetpoint_deinitialize(caps_thermostatCoolingSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
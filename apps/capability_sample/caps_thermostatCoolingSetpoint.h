@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_thermostatCoolingSetpoint.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_thermostatCoolingSetpoint_data {
     void *usr_data;
     void *cmd_data;
 
-    double coolingSetpoint_value;
+    int64_t coolingSetpoint_milli;
     char *coolingSetpoint_unit;
 
     double (*get_coolingSetpoint_value)(struct caps_thermostatCoolingSetpoint_data *caps_data);
     void (*set_coolingSetpoint_value)(struct caps_thermostatCoolingSetpoint_data *caps_data, double value);
+    int64_t (*get_coolingSetpoint_milli)(struct caps_thermostatCoolingSetpoint_data *caps_data);
+    void (*set_coolingSetpoint_milli)(struct caps_thermostatCoolingSetpoint_data *caps_data, int64_t milli);
     const char *(*get_coolingSetpoint_unit)(struct caps_thermostatCoolingSetpoint_data *caps_data);
     void (*set_coolingSetpoint_unit)(struct caps_thermostatCoolingSetpoint_data *caps_data, const char *unit);
     void (*attr_coolingSetpoint_send)(struct caps_thermostatCoolingSetpoint_data *caps_data);
@@ -42,6 +46,7 @@ typedef struct caps_thermostatCoolingSetpoint_data {
 } caps_thermostatCoolingSetpoint_data_t;
 
 caps_thermostatCoolingSetpoint_data_t *caps_thermostatCoolingSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatCoolingSetpoint_deinitialize(caps_thermostatCoolingSetpoint_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_thermostatFanMode.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_thermostatFanMode_attr_thermostatFanMode_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_thermostatFanMode_get_thermostatFanMode_value(caps_therm
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->thermostatFanMode_value;
+    if (caps_data->thermostatFanMode_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_thermostatFanMode.attr_thermostatFanMode.values[caps_data->thermostatFanMode_idx];
 }
 
 static void caps_thermostatFanMode_set_thermostatFanMode_value(caps_thermostatFanMode_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->thermostatFanMode_value) {
-        free(caps_data->thermostatFanMode_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_thermostatFanMode_attr_thermostatFanMode_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for thermostatFanMode\n", value);
+        return;
+    }
+    caps_data->thermostatFanMode_idx = index;
+}
+
+static int caps_thermostatFanMode_get_thermostatFanMode_idx(caps_thermostatFanMode_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
     }
-    caps_data->thermostatFanMode_value = strdup(value);
+    return caps_data->thermostatFanMode_idx;
+}
+
+static void caps_thermostatFanMode_set_thermostatFanMode_idx(caps_thermostatFanMode_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_MAX) {
+        printf("%d is not supported index for thermostatFanMode\n", idx);
+        return;
+    }
+    caps_data->thermostatFanMode_idx = idx;
 }
 
 static void caps_thermostatFanMode_attr_thermostatFanMode_send(caps_thermostatFanMode_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_thermostatFanMode_attr_thermostatFanMode_send(caps_thermostatFa
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->thermostatFanMode_value) {
+    if (caps_data->thermostatFanMode_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_thermostatFanMode.attr_thermostatFanMode.name,
-            caps_data->thermostatFanMode_value,
+            (char *)caps_helper_thermostatFanMode.attr_thermostatFanMode.values[caps_data->thermostatFanMode_idx],
             NULL,
             NULL,
             sequence_no);
@@ -100,7 +135,7 @@ static void caps_thermostatFanMode_set_supportedThermostatFanModes_value(caps_th
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedThermostatFanModes_value) {
+    if (caps_data->supportedThermostatFanModes_value && !caps_data->supportedThermostatFanModes_borrowed) {
         for (i = 0; i < caps_data->supportedThermostatFanModes_arraySize; i++) {
             free(caps_data->supportedThermostatFanModes_value[i]);
         }
@@ -117,6 +152,27 @@ static void caps_thermostatFanMode_set_supportedThermostatFanModes_value(caps_th
     }
 
     caps_data->supportedThermostatFanModes_arraySize = arraySize;
+    caps_data->supportedThermostatFanModes_borrowed = 0;
+}
+
+static void caps_thermostatFanMode_set_supportedThermostatFanModes_value_borrowed(caps_thermostatFanMode_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedThermostatFanModes_value && !caps_data->supportedThermostatFanModes_borrowed) {
+        for (i = 0; i < caps_data->supportedThermostatFanModes_arraySize; i++) {
+            free(caps_data->supportedThermostatFanModes_value[i]);
+        }
+        free(caps_data->supportedThermostatFanModes_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedThermostatFanModes_value = (char **)value;
+    caps_data->supportedThermostatFanModes_arraySize = arraySize;
+    caps_data->supportedThermostatFanModes_borrowed = 1;
 }
 
 static void caps_thermostatFanMode_attr_supportedThermostatFanModes_send(caps_thermostatFanMode_data_t *caps_data)
@@ -132,7 +188,7 @@ static void caps_thermostatFanMode_attr_supportedThermostatFanModes_send(caps_th
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_thermostatFanMode.attr_supportedThermostatFanModes.name,
             caps_data->supportedThermostatFanModes_value,
             caps_data->supportedThermostatFanModes_arraySize,
@@ -150,11 +206,11 @@ static void caps_thermostatFanMode_attr_supportedThermostatFanModes_send(caps_th
 static void caps_thermostatFanMode_cmd_fanOn_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatFanMode_data_t *caps_data = (caps_thermostatFanMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatFanMode.attr_thermostatFanMode.values[CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_ON];
+    int index = CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_ON;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatFanMode_set_thermostatFanMode_value(caps_data, value);
+    caps_thermostatFanMode_set_thermostatFanMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_fanOn_usr_cb)
         caps_data->cmd_fanOn_usr_cb(caps_data);
     caps_thermostatFanMode_attr_thermostatFanMode_send(caps_data);
@@ -163,11 +219,11 @@ static void caps_thermostatFanMode_cmd_fanOn_cb(IOT_CAP_HANDLE *handle, iot_cap_
 static void caps_thermostatFanMode_cmd_fanCirculate_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatFanMode_data_t *caps_data = (caps_thermostatFanMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatFanMode.attr_thermostatFanMode.values[CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_CIRCULATE];
+    int index = CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_CIRCULATE;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatFanMode_set_thermostatFanMode_value(caps_data, value);
+    caps_thermostatFanMode_set_thermostatFanMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_fanCirculate_usr_cb)
         caps_data->cmd_fanCirculate_usr_cb(caps_data);
     caps_thermostatFanMode_attr_thermostatFanMode_send(caps_data);
@@ -176,11 +232,11 @@ static void caps_thermostatFanMode_cmd_fanCirculate_cb(IOT_CAP_HANDLE *handle, i
 static void caps_thermostatFanMode_cmd_fanAuto_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatFanMode_data_t *caps_data = (caps_thermostatFanMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatFanMode.attr_thermostatFanMode.values[CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_AUTO];
+    int index = CAP_ENUM_THERMOSTATFANMODE_THERMOSTATFANMODE_VALUE_AUTO;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatFanMode_set_thermostatFanMode_value(caps_data, value);
+    caps_thermostatFanMode_set_thermostatFanMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_fanAuto_usr_cb)
         caps_data->cmd_fanAuto_usr_cb(caps_data);
     caps_thermostatFanMode_attr_thermostatFanMode_send(caps_data);
@@ -189,7 +245,6 @@ static void caps_thermostatFanMode_cmd_fanAuto_cb(IOT_CAP_HANDLE *handle, iot_ca
 static void caps_thermostatFanMode_cmd_setThermostatFanMode_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatFanMode_data_t *caps_data = (caps_thermostatFanMode_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -199,9 +254,7 @@ static void caps_thermostatFanMode_cmd_setThermostatFanMode_cb(IOT_CAP_HANDLE *h
         printf("%s is not supported value for setThermostatFanMode\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_thermostatFanMode.attr_thermostatFanMode.values[index];
-
-    caps_thermostatFanMode_set_thermostatFanMode_value(caps_data, value);
+    caps_thermostatFanMode_set_thermostatFanMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setThermostatFanMode_usr_cb)
         caps_data->cmd_setThermostatFanMode_usr_cb(caps_data);
     caps_thermostatFanMode_attr_thermostatFanMode_send(caps_data);
@@ -210,10 +263,13 @@ static void caps_thermostatFanMode_cmd_setThermostatFanMode_cb(IOT_CAP_HANDLE *h
 static void caps_thermostatFanMode_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatFanMode_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatFanMode_attr_thermostatFanMode_send(caps_data);
     caps_thermostatFanMode_attr_supportedThermostatFanModes_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatFanMode_data_t *caps_thermostatFanMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -234,28 +290,32 @@ caps_thermostatFanMode_data_t *caps_thermostatFanMode_initialize(IOT_CTX *ctx, c
 
     caps_data->get_thermostatFanMode_value = caps_thermostatFanMode_get_thermostatFanMode_value;
     caps_data->set_thermostatFanMode_value = caps_thermostatFanMode_set_thermostatFanMode_value;
+    caps_data->get_thermostatFanMode_idx = caps_thermostatFanMode_get_thermostatFanMode_idx;
+    caps_data->set_thermostatFanMode_idx = caps_thermostatFanMode_set_thermostatFanMode_idx;
     caps_data->attr_thermostatFanMode_str2idx = caps_thermostatFanMode_attr_thermostatFanMode_str2idx;
     caps_data->attr_thermostatFanMode_send = caps_thermostatFanMode_attr_thermostatFanMode_send;
     caps_data->get_supportedThermostatFanModes_value = caps_thermostatFanMode_get_supportedThermostatFanModes_value;
     caps_data->set_supportedThermostatFanModes_value = caps_thermostatFanMode_set_supportedThermostatFanModes_value;
+    caps_data->set_supportedThermostatFanModes_value_borrowed = caps_thermostatFanMode_set_supportedThermostatFanModes_value_borrowed;
     caps_data->attr_supportedThermostatFanModes_send = caps_thermostatFanMode_attr_supportedThermostatFanModes_send;
+    caps_data->thermostatFanMode_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatFanMode.id, caps_thermostatFanMode_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatFanMode.id, caps_thermostatFanMode_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanOn.name, caps_thermostatFanMode_cmd_fanOn_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanOn.name, caps_thermostatFanMode_cmd_fanOn_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for fanOn of thermostatFanMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanCirculate.name, caps_thermostatFanMode_cmd_fanCirculate_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanCirculate.name, caps_thermostatFanMode_cmd_fanCirculate_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for fanCirculate of thermostatFanMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanAuto.name, caps_thermostatFanMode_cmd_fanAuto_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_fanAuto.name, caps_thermostatFanMode_cmd_fanAuto_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for fanAuto of thermostatFanMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_setThermostatFanMode.name, caps_thermostatFanMode_cmd_setThermostatFanMode_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatFanMode.cmd_setThermostatFanMode.name, caps_thermostatFanMode_cmd_setThermostatFanMode_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setThermostatFanMode of thermostatFanMode\n");
     }
@@ -265,3 +325,25 @@ caps_thermostatFanMode_data_t *caps_thermostatFanMode_initialize(IOT_CTX *ctx, c
 
     return caps_data;
 }
+
+void caps_thermostatFanMode_deinitialize(caps_thermostatFanMode_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedThermostatFanModes_value && !caps_data->supportedThermostatFanModes_borrowed) {
+        for (i = 0; i < caps_data->supportedThermostatFanModes_arraySize; i++) {
+            free(caps_data->supportedThermostatFanModes_value[i]);
+        }
+        free(caps_data->supportedThermostatFanModes_value);
+    }
+    free(caps_data);
+}
@@ -28,16 +28,20 @@ typedef struct caps_thermostatFanMode_data {
     void *usr_data;
     void *cmd_data;
 
-    char *thermostatFanMode_value;
+    int thermostatFanMode_idx;
     char **supportedThermostatFanModes_value;
     int supportedThermostatFanModes_arraySize;
+    int supportedThermostatFanModes_borrowed;
 
     const char *(*get_thermostatFanMode_value)(struct caps_thermostatFanMode_data *caps_data);
     void (*set_thermostatFanMode_value)(struct caps_thermostatFanMode_data *caps_data, const char *value);
+    int (*get_thermostatFanMode_idx)(struct caps_thermostatFanMode_data *caps_data);
+    void (*set_thermostatFanMode_idx)(struct caps_thermostatFanMode_data *caps_data, int idx);
     int (*attr_thermostatFanMode_str2idx)(const char *value);
     void (*attr_thermostatFanMode_send)(struct caps_thermostatFanMode_data *caps_data);
     const char **(*get_supportedThermostatFanModes_value)(struct caps_thermostatFanMode_data *caps_data);
     void (*set_supportedThermostatFanModes_value)(struct caps_thermostatFanMode_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedThermostatFanModes_value_borrowed)(struct caps_thermostatFanMode_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedThermostatFanModes_send)(struct caps_thermostatFanMode_data *caps_data);
 
     void (*init_usr_cb)(struct caps_thermostatFanMode_data *caps_data);
@@ -49,6 +53,7 @@ typedef struct caps_thermostatFanMode_data {
 } caps_thermostatFanMode_data_t;
 
 caps_thermostatFanMode_data_t *caps_thermostatFanMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatFanMode_deinitialize(caps_thermostatFanMode_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
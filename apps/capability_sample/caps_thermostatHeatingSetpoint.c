@@ -22,6 +22,31 @@
 
 #include "st_dev.h"
 #include "caps_thermostatHeatingSetpoint.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+
+static int64_t caps_thermostatHeatingSetpoint_get_heatingSetpoint_milli(caps_thermostatHeatingSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_thermostatHeatingSetpoint.attr_heatingSetpoint.min) - 1;
+    }
+    return caps_data->heatingSetpoint_milli;
+}
+
+static void caps_thermostatHeatingSetpoint_set_heatingSetpoint_milli(caps_thermostatHeatingSetpoint_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_thermostatHeatingSetpoint.attr_heatingSetpoint.min)) {
+        printf("%lld is out of range for heatingSetpoint\n", (long long)milli);
+        return;
+    }
+    caps_data->heatingSetpoint_milli = milli;
+}
 
 static double caps_thermostatHeatingSetpoint_get_heatingSetpoint_value(caps_thermostatHeatingSetpoint_data_t *caps_data)
 {
@@ -29,16 +54,22 @@ static double caps_thermostatHeatingSetpoint_get_heatingSetpoint_value(caps_ther
         printf("caps_data is NULL\n");
         return caps_helper_thermostatHeatingSetpoint.attr_heatingSetpoint.min - 1;
     }
-    return caps_data->heatingSetpoint_value;
+    return caps_util_milli_to_double(caps_data->heatingSetpoint_milli);
 }
 
 static void caps_thermostatHeatingSetpoint_set_heatingSetpoint_value(caps_thermostatHeatingSetpoint_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->heatingSetpoint_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for heatingSetpoint\n");
+        return;
+    }
+    caps_thermostatHeatingSetpoint_set_heatingSetpoint_milli(caps_data, milli);
 }
 
 static const char *caps_thermostatHeatingSetpoint_get_heatingSetpoint_unit(caps_thermostatHeatingSetpoint_data_t *caps_data)
@@ -68,9 +99,9 @@ static void caps_thermostatHeatingSetpoint_attr_heatingSetpoint_send(caps_thermo
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_thermostatHeatingSetpoint.attr_heatingSetpoint.name,
-            caps_data->heatingSetpoint_value,
+            caps_data->heatingSetpoint_milli,
             caps_data->heatingSetpoint_unit,
             NULL,
             sequence_no);
@@ -100,9 +131,12 @@ static void caps_thermostatHeatingSetpoint_cmd_setHeatingSetpoint_cb(IOT_CAP_HAN
 static void caps_thermostatHeatingSetpoint_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatHeatingSetpoint_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatHeatingSetpoint_attr_heatingSetpoint_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatHeatingSetpoint_data_t *caps_thermostatHeatingSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -123,15 +157,17 @@ caps_thermostatHeatingSetpoint_data_t *caps_thermostatHeatingSetpoint_initialize
 
     caps_data->get_heatingSetpoint_value = caps_thermostatHeatingSetpoint_get_heatingSetpoint_value;
     caps_data->set_heatingSetpoint_value = caps_thermostatHeatingSetpoint_set_heatingSetpoint_value;
+    caps_data->get_heatingSetpoint_milli = caps_thermostatHeatingSetpoint_get_heatingSetpoint_milli;
+    caps_data->set_heatingSetpoint_milli = caps_thermostatHeatingSetpoint_set_heatingSetpoint_milli;
     caps_data->get_heatingSetpoint_unit = caps_thermostatHeatingSetpoint_get_heatingSetpoint_unit;
     caps_data->set_heatingSetpoint_unit = caps_thermostatHeatingSetpoint_set_heatingSetpoint_unit;
     caps_data->attr_heatingSetpoint_send = caps_thermostatHeatingSetpoint_attr_heatingSetpoint_send;
-    caps_data->heatingSetpoint_value = -460;
+    caps_data->heatingSetpoint_milli = CAPS_UTIL_MILLI(-460);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatHeatingSetpoint.id, caps_thermostatHeatingSetpoint_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatHeatingSetpoint.id, caps_thermostatHeatingSetpoint_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatHeatingSetpoint.cmd_setHeatingSetpoint.name, caps_thermostatHeatingSetpoint_cmd_setHeatingSetpoint_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatHeatingSetpoint.cmd_setHeatingSetpoint.name, caps_thermostatHeatingSetpoint_cmd_setHeatingSetpoint_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setHeatingSetpoint of thermostatHeatingSetpoint\n");
     }
@@ -141,3 +177,17 @@ caps_thermostatHeatingSetpoint_data_t *caps_thermostatHeatingSetpoint_initialize
 
     return caps_data;
 }
+
+void caps_thermostatHeatingSetpoint_deinitialize(caps_thermostatHeatingSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_thermostatHeatingSetpoint.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_thermostatHeatingSetpoint_data {
     void *usr_data;
     void *cmd_data;
 
-    double heatingSetpoint_value;
+    int64_t heatingSetpoint_milli;
     char *heatingSetpoint_unit;
 
     double (*get_heatingSetpoint_value)(struct caps_thermostatHeatingSetpoint_data *caps_data);
     void (*set_heatingSetpoint_value)(struct caps_thermostatHeatingSetpoint_data *caps_data, double value);
+    int64_t (*get_heatingSetpoint_milli)(struct caps_thermostatHeatingSetpoint_data *caps_data);
+    void (*set_heatingSetpoint_milli)(struct caps_thermostatHeatingSetpoint_data *caps_data, int64_t milli);
     const char *(*get_heatingSetpoint_unit)(struct caps_thermostatHeatingSetpoint_data *caps_data);
     void (*set_heatingSetpoint_unit)(struct caps_thermostatHeatingSetpoint_data *caps_data, const char *unit);
     void (*attr_heatingSetpoint_send)(struct caps_thermostatHeatingSetpoint_data *caps_data);
@@ -42,6 +46,7 @@ typedef struct caps_thermostatHeatingSetpoint_data {
 } caps_thermostatHeatingSetpoint_data_t;
 
 caps_thermostatHeatingSetpoint_data_t *caps_thermostatHeatingSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatHeatingSetpoint_deinitialize(caps_thermostatHeatingSetpoint_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_thermostatMode.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_thermostatMode_attr_thermostatMode_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_thermostatMode_get_thermostatMode_value(caps_thermostatM
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->thermostatMode_value;
+    if (caps_data->thermostatMode_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_thermostatMode.attr_thermostatMode.values[caps_data->thermostatMode_idx];
 }
 
 static void caps_thermostatMode_set_thermostatMode_value(caps_thermostatMode_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->thermostatMode_value) {
-        free(caps_data->thermostatMode_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_thermostatMode_attr_thermostatMode_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for thermostatMode\n", value);
+        return;
+    }
+    caps_data->thermostatMode_idx = index;
+}
+
+static int caps_thermostatMode_get_thermostatMode_idx(caps_thermostatMode_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
     }
-    caps_data->thermostatMode_value = strdup(value);
+    return caps_data->thermostatMode_idx;
+}
+
+static void caps_thermostatMode_set_thermostatMode_idx(caps_thermostatMode_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_MAX) {
+        printf("%d is not supported index for thermostatMode\n", idx);
+        return;
+    }
+    caps_data->thermostatMode_idx = idx;
 }
 
 static void caps_thermostatMode_attr_thermostatMode_send(caps_thermostatMode_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_thermostatMode_attr_thermostatMode_send(caps_thermostatMode_dat
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->thermostatMode_value) {
+    if (caps_data->thermostatMode_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_thermostatMode.attr_thermostatMode.name,
-            caps_data->thermostatMode_value,
+            (char *)caps_helper_thermostatMode.attr_thermostatMode.values[caps_data->thermostatMode_idx],
             NULL,
             NULL,
             sequence_no);
@@ -100,7 +135,7 @@ static void caps_thermostatMode_set_supportedThermostatModes_value(caps_thermost
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedThermostatModes_value) {
+    if (caps_data->supportedThermostatModes_value && !caps_data->supportedThermostatModes_borrowed) {
         for (i = 0; i < caps_data->supportedThermostatModes_arraySize; i++) {
             free(caps_data->supportedThermostatModes_value[i]);
         }
@@ -117,6 +152,27 @@ static void caps_thermostatMode_set_supportedThermostatModes_value(caps_thermost
     }
 
     caps_data->supportedThermostatModes_arraySize = arraySize;
+    caps_data->supportedThermostatModes_borrowed = 0;
+}
+
+static void caps_thermostatMode_set_supportedThermostatModes_value_borrowed(caps_thermostatMode_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedThermostatModes_value && !caps_data->supportedThermostatModes_borrowed) {
+        for (i = 0; i < caps_data->supportedThermostatModes_arraySize; i++) {
+            free(caps_data->supportedThermostatModes_value[i]);
+        }
+        free(caps_data->supportedThermostatModes_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedThermostatModes_value = (char **)value;
+    caps_data->supportedThermostatModes_arraySize = arraySize;
+    caps_data->supportedThermostatModes_borrowed = 1;
 }
 
 static void caps_thermostatMode_attr_supportedThermostatModes_send(caps_thermostatMode_data_t *caps_data)
@@ -132,7 +188,7 @@ static void caps_thermostatMode_attr_supportedThermostatModes_send(caps_thermost
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_thermostatMode.attr_supportedThermostatModes.name,
             caps_data->supportedThermostatModes_value,
             caps_data->supportedThermostatModes_arraySize,
@@ -150,11 +206,11 @@ static void caps_thermostatMode_attr_supportedThermostatModes_send(caps_thermost
 static void caps_thermostatMode_cmd_heat_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatMode.attr_thermostatMode.values[CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_HEAT];
+    int index = CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_HEAT;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_heat_usr_cb)
         caps_data->cmd_heat_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -163,11 +219,11 @@ static void caps_thermostatMode_cmd_heat_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_
 static void caps_thermostatMode_cmd_emergencyHeat_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatMode.attr_thermostatMode.values[CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_EMERGENCY_HEAT];
+    int index = CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_EMERGENCY_HEAT;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_emergencyHeat_usr_cb)
         caps_data->cmd_emergencyHeat_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -176,11 +232,11 @@ static void caps_thermostatMode_cmd_emergencyHeat_cb(IOT_CAP_HANDLE *handle, iot
 static void caps_thermostatMode_cmd_auto_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatMode.attr_thermostatMode.values[CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_AUTO];
+    int index = CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_AUTO;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_auto_usr_cb)
         caps_data->cmd_auto_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -189,11 +245,11 @@ static void caps_thermostatMode_cmd_auto_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_
 static void caps_thermostatMode_cmd_cool_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatMode.attr_thermostatMode.values[CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_COOL];
+    int index = CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_COOL;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_cool_usr_cb)
         caps_data->cmd_cool_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -202,11 +258,11 @@ static void caps_thermostatMode_cmd_cool_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_
 static void caps_thermostatMode_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    const char* value = caps_helper_thermostatMode.attr_thermostatMode.values[CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_OFF];
+    int index = CAP_ENUM_THERMOSTATMODE_THERMOSTATMODE_VALUE_OFF;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_off_usr_cb)
         caps_data->cmd_off_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -215,7 +271,6 @@ static void caps_thermostatMode_cmd_off_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_d
 static void caps_thermostatMode_cmd_setThermostatMode_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = (caps_thermostatMode_data_t *)usr_data;
-    char *value;
     int index;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
@@ -225,9 +280,7 @@ static void caps_thermostatMode_cmd_setThermostatMode_cb(IOT_CAP_HANDLE *handle,
         printf("%s is not supported value for setThermostatMode\n", cmd_data->cmd_data[0].string);
         return;
     }
-    value = (char *)caps_helper_thermostatMode.attr_thermostatMode.values[index];
-
-    caps_thermostatMode_set_thermostatMode_value(caps_data, value);
+    caps_thermostatMode_set_thermostatMode_idx(caps_data, index);
     if (caps_data && caps_data->cmd_setThermostatMode_usr_cb)
         caps_data->cmd_setThermostatMode_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
@@ -236,10 +289,13 @@ static void caps_thermostatMode_cmd_setThermostatMode_cb(IOT_CAP_HANDLE *handle,
 static void caps_thermostatMode_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatMode_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatMode_attr_thermostatMode_send(caps_data);
     caps_thermostatMode_attr_supportedThermostatModes_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatMode_data_t *caps_thermostatMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -260,36 +316,40 @@ caps_thermostatMode_data_t *caps_thermostatMode_initialize(IOT_CTX *ctx, const c
 
     caps_data->get_thermostatMode_value = caps_thermostatMode_get_thermostatMode_value;
     caps_data->set_thermostatMode_value = caps_thermostatMode_set_thermostatMode_value;
+    caps_data->get_thermostatMode_idx = caps_thermostatMode_get_thermostatMode_idx;
+    caps_data->set_thermostatMode_idx = caps_thermostatMode_set_thermostatMode_idx;
     caps_data->attr_thermostatMode_str2idx = caps_thermostatMode_attr_thermostatMode_str2idx;
     caps_data->attr_thermostatMode_send = caps_thermostatMode_attr_thermostatMode_send;
     caps_data->get_supportedThermostatModes_value = caps_thermostatMode_get_supportedThermostatModes_value;
     caps_data->set_supportedThermostatModes_value = caps_thermostatMode_set_supportedThermostatModes_value;
+    caps_data->set_supportedThermostatModes_value_borrowed = caps_thermostatMode_set_supportedThermostatModes_value_borrowed;
     caps_data->attr_supportedThermostatModes_send = caps_thermostatMode_attr_supportedThermostatModes_send;
+    caps_data->thermostatMode_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatMode.id, caps_thermostatMode_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatMode.id, caps_thermostatMode_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_heat.name, caps_thermostatMode_cmd_heat_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_heat.name, caps_thermostatMode_cmd_heat_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for heat of thermostatMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_emergencyHeat.name, caps_thermostatMode_cmd_emergencyHeat_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_emergencyHeat.name, caps_thermostatMode_cmd_emergencyHeat_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for emergencyHeat of thermostatMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_auto.name, caps_thermostatMode_cmd_auto_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_auto.name, caps_thermostatMode_cmd_auto_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for auto of thermostatMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_cool.name, caps_thermostatMode_cmd_cool_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_cool.name, caps_thermostatMode_cmd_cool_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for cool of thermostatMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_off.name, caps_thermostatMode_cmd_off_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_off.name, caps_thermostatMode_cmd_off_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for off of thermostatMode\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_setThermostatMode.name, caps_thermostatMode_cmd_setThermostatMode_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_thermostatMode.cmd_setThermostatMode.name, caps_thermostatMode_cmd_setThermostatMode_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setThermostatMode of thermostatMode\n");
     }
@@ -299,3 +359,25 @@ caps_thermostatMode_data_t *caps_thermostatMode_initialize(IOT_CTX *ctx, const c
 
     return caps_data;
 }
+
+void caps_thermostatMode_deinitialize(caps_thermostatMode_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedThermostatModes_value && !caps_data->supportedThermostatModes_borrowed) {
+        for (i = 0; i < caps_data->supportedThermostatModes_arraySize; i++) {
+            free(caps_data->supportedThermostatModes_value[i]);
+        }
+        free(caps_data->supportedThermostatModes_value);
+    }
+    free(caps_data);
+}
@@ -28,16 +28,20 @@ typedef struct caps_thermostatMode_data {
     void *usr_data;
     void *cmd_data;
 
-    char *thermostatMode_value;
+    int thermostatMode_idx;
     char **supportedThermostatModes_value;
     int supportedThermostatModes_arraySize;
+    int supportedThermostatModes_borrowed;
 
     const char *(*get_thermostatMode_value)(struct caps_thermostatMode_data *caps_data);
     void (*set_thermostatMode_value)(struct caps_thermostatMode_data *caps_data, const char *value);
+    int (*get_thermostatMode_idx)(struct caps_thermostatMode_data *caps_data);
+    void (*set_thermostatMode_idx)(struct caps_thermostatMode_data *caps_data, int idx);
     int (*attr_thermostatMode_str2idx)(const char *value);
     void (*attr_thermostatMode_send)(struct caps_thermostatMode_data *caps_data);
     const char **(*get_supportedThermostatModes_value)(struct caps_thermostatMode_data *caps_data);
     void (*set_supportedThermostatModes_value)(struct caps_thermostatMode_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedThermostatModes_value_borrowed)(struct caps_thermostatMode_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedThermostatModes_send)(struct caps_thermostatMode_data *caps_data);
 
     void (*init_usr_cb)(struct caps_thermostatMode_data *caps_data);
@@ -51,6 +55,7 @@ typedef struct caps_thermostatMode_data {
 } caps_thermostatMode_data_t;
 
 caps_thermostatMode_data_t *caps_thermostatMode_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatMode_deinitialize(caps_thermostatMode_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_thermostatOperatingState.h"
+#include "caps_sender.h"
 
 static int caps_thermostatOperatingState_attr_thermostatOperatingState_str2idx(const char *value)
 {
@@ -41,19 +42,52 @@ static const char *caps_thermostatOperatingState_get_thermostatOperatingState_va
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->thermostatOperatingState_value;
+    if (caps_data->thermostatOperatingState_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_thermostatOperatingState.attr_thermostatOperatingState.values[caps_data->thermostatOperatingState_idx];
 }
 
 static void caps_thermostatOperatingState_set_thermostatOperatingState_value(caps_thermostatOperatingState_data_t *caps_data, const char *value)
 {
+    int index;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->thermostatOperatingState_value) {
-        free(caps_data->thermostatOperatingState_value);
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_thermostatOperatingState_attr_thermostatOperatingState_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for thermostatOperatingState\n", value);
+        return;
     }
-    caps_data->thermostatOperatingState_value = strdup(value);
+    caps_data->thermostatOperatingState_idx = index;
+}
+
+static int caps_thermostatOperatingState_get_thermostatOperatingState_idx(caps_thermostatOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->thermostatOperatingState_idx;
+}
+
+static void caps_thermostatOperatingState_set_thermostatOperatingState_idx(caps_thermostatOperatingState_data_t *caps_data, int idx)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (idx < 0 || idx >= CAP_ENUM_THERMOSTATOPERATINGSTATE_THERMOSTATOPERATINGSTATE_VALUE_MAX) {
+        printf("%d is not supported index for thermostatOperatingState\n", idx);
+        return;
+    }
+    caps_data->thermostatOperatingState_idx = idx;
 }
 
 static void caps_thermostatOperatingState_attr_thermostatOperatingState_send(caps_thermostatOperatingState_data_t *caps_data)
@@ -64,14 +98,14 @@ static void caps_thermostatOperatingState_attr_thermostatOperatingState_send(cap
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->thermostatOperatingState_value) {
+    if (caps_data->thermostatOperatingState_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_thermostatOperatingState.attr_thermostatOperatingState.name,
-            caps_data->thermostatOperatingState_value,
+            (char *)caps_helper_thermostatOperatingState.attr_thermostatOperatingState.values[caps_data->thermostatOperatingState_idx],
             NULL,
             NULL,
             sequence_no);
@@ -87,9 +121,12 @@ static void caps_thermostatOperatingState_attr_thermostatOperatingState_send(cap
 static void caps_thermostatOperatingState_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatOperatingState_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatOperatingState_attr_thermostatOperatingState_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatOperatingState_data_t *caps_thermostatOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -109,10 +146,13 @@ caps_thermostatOperatingState_data_t *caps_thermostatOperatingState_initialize(I
 
     caps_data->get_thermostatOperatingState_value = caps_thermostatOperatingState_get_thermostatOperatingState_value;
     caps_data->set_thermostatOperatingState_value = caps_thermostatOperatingState_set_thermostatOperatingState_value;
+    caps_data->get_thermostatOperatingState_idx = caps_thermostatOperatingState_get_thermostatOperatingState_idx;
+    caps_data->set_thermostatOperatingState_idx = caps_thermostatOperatingState_set_thermostatOperatingState_idx;
     caps_data->attr_thermostatOperatingState_str2idx = caps_thermostatOperatingState_attr_thermostatOperatingState_str2idx;
     caps_data->attr_thermostatOperatingState_send = caps_thermostatOperatingState_attr_thermostatOperatingState_send;
+    caps_data->thermostatOperatingState_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatOperatingState.id, caps_thermostatOperatingState_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatOperatingState.id, caps_thermostatOperatingState_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init thermostatOperatingState handle\n");
@@ -120,3 +160,16 @@ caps_thermostatOperatingState_data_t *caps_thermostatOperatingState_initialize(I
 
     return caps_data;
 }
+
+void caps_thermostatOperatingState_deinitialize(caps_thermostatOperatingState_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -27,10 +27,12 @@ typedef struct caps_thermostatOperatingState_data {
     void *usr_data;
     void *cmd_data;
 
-    char *thermostatOperatingState_value;
+    int thermostatOperatingState_idx;
 
     const char *(*get_thermostatOperatingState_value)(struct caps_thermostatOperatingState_data *caps_data);
     void (*set_thermostatOperatingState_value)(struct caps_thermostatOperatingState_data *caps_data, const char *value);
+    int (*get_thermostatOperatingState_idx)(struct caps_thermostatOperatingState_data *caps_data);
+    void (*set_thermostatOperatingState_idx)(struct caps_thermostatOperatingState_data *caps_data, int idx);
     int (*attr_thermostatOperatingState_str2idx)(const char *value);
     void (*attr_thermostatOperatingState_send)(struct caps_thermostatOperatingState_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_thermostatOperatingState_data {
 } caps_thermostatOperatingState_data_t;
 
 caps_thermostatOperatingState_data_t *caps_thermostatOperatingState_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatOperatingState_deinitialize(caps_thermostatOperatingState_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_thermostatSetpoint.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_thermostatSetpoint_get_thermostatSetpoint_milli(caps_thermostatSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_thermostatSetpoint.attr_thermostatSetpoint.min) - 1;
+    }
+    return caps_data->thermostatSetpoint_milli;
+}
+
+static void caps_thermostatSetpoint_set_thermostatSetpoint_milli(caps_thermostatSetpoint_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_thermostatSetpoint.attr_thermostatSetpoint.min)) {
+        printf("%lld is out of range for thermostatSetpoint\n", (long long)milli);
+        return;
+    }
+    caps_data->thermostatSetpoint_milli = milli;
+}
 
 static double caps_thermostatSetpoint_get_thermostatSetpoint_value(caps_thermostatSetpoint_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_thermostatSetpoint_get_thermostatSetpoint_value(caps_thermost
         printf("caps_data is NULL\n");
         return caps_helper_thermostatSetpoint.attr_thermostatSetpoint.min - 1;
     }
-    return caps_data->thermostatSetpoint_value;
+    return caps_util_milli_to_double(caps_data->thermostatSetpoint_milli);
 }
 
 static void caps_thermostatSetpoint_set_thermostatSetpoint_value(caps_thermostatSetpoint_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->thermostatSetpoint_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for thermostatSetpoint\n");
+        return;
+    }
+    caps_thermostatSetpoint_set_thermostatSetpoint_milli(caps_data, milli);
 }
 
 static const char *caps_thermostatSetpoint_get_thermostatSetpoint_unit(caps_thermostatSetpoint_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_thermostatSetpoint_attr_thermostatSetpoint_send(caps_thermostat
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_thermostatSetpoint.attr_thermostatSetpoint.name,
-            caps_data->thermostatSetpoint_value,
+            caps_data->thermostatSetpoint_milli,
             caps_data->thermostatSetpoint_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_thermostatSetpoint_attr_thermostatSetpoint_send(caps_thermostat
 static void caps_thermostatSetpoint_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_thermostatSetpoint_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_thermostatSetpoint_attr_thermostatSetpoint_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_thermostatSetpoint_data_t *caps_thermostatSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_thermostatSetpoint_data_t *caps_thermostatSetpoint_initialize(IOT_CTX *ctx,
 
     caps_data->get_thermostatSetpoint_value = caps_thermostatSetpoint_get_thermostatSetpoint_value;
     caps_data->set_thermostatSetpoint_value = caps_thermostatSetpoint_set_thermostatSetpoint_value;
+    caps_data->get_thermostatSetpoint_milli = caps_thermostatSetpoint_get_thermostatSetpoint_milli;
+    caps_data->set_thermostatSetpoint_milli = caps_thermostatSetpoint_set_thermostatSetpoint_milli;
     caps_data->get_thermostatSetpoint_unit = caps_thermostatSetpoint_get_thermostatSetpoint_unit;
     caps_data->set_thermostatSetpoint_unit = caps_thermostatSetpoint_set_thermostatSetpoint_unit;
     caps_data->attr_thermostatSetpoint_send = caps_thermostatSetpoint_attr_thermostatSetpoint_send;
-    caps_data->thermostatSetpoint_value = -460;
+    caps_data->thermostatSetpoint_milli = CAPS_UTIL_MILLI(-460);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_thermostatSetpoint.id, caps_thermostatSetpoint_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_thermostatSetpoint.id, caps_thermostatSetpoint_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init thermostatSetpoint handle\n");
@@ -120,3 +155,16 @@ caps_thermostatSetpoint_data_t *caps_thermostatSetpoint_initialize(IOT_CTX *ctx,
 
     return caps_data;
 }
+
+void caps_thermostatSetpoint_deinitialize(caps_thermostatSetpoint_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
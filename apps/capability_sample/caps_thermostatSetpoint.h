@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_thermostatSetpoint.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_thermostatSetpoint_data {
     void *usr_data;
     void *cmd_data;
 
-    double thermostatSetpoint_value;
+    int64_t thermostatSetpoint_milli;
     char *thermostatSetpoint_unit;
 
     double (*get_thermostatSetpoint_value)(struct caps_thermostatSetpoint_data *caps_data);
     void (*set_thermostatSetpoint_value)(struct caps_thermostatSetpoint_data *caps_data, double value);
+    int64_t (*get_thermostatSetpoint_milli)(struct caps_thermostatSetpoint_data *caps_data);
+    void (*set_thermostatSetpoint_milli)(struct caps_thermostatSetpoint_data *caps_data, int64_t milli);
     const char *(*get_thermostatSetpoint_unit)(struct caps_thermostatSetpoint_data *caps_data);
     void (*set_thermostatSetpoint_unit)(struct caps_thermostatSetpoint_data *caps_data, const char *unit);
     void (*attr_thermostatSetpoint_send)(struct caps_thermostatSetpoint_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_thermostatSetpoint_data {
 } caps_thermostatSetpoint_data_t;
 
 caps_thermostatSetpoint_data_t *caps_thermostatSetpoint_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_thermostatSetpoint_deinitialize(caps_thermostatSetpoint_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
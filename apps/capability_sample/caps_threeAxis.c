@@ -22,79 +22,73 @@
 
 #include "st_dev.h"
 #include "caps_threeAxis.h"
+#include "caps_sender.h"
+#include "caps_json_writer.h"
 
-static const JSON_H *caps_threeAxis_get_threeAxis_value(caps_threeAxis_data_t *caps_data)
+static const int *caps_threeAxis_get_threeAxis_value(caps_threeAxis_data_t *caps_data)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return NULL;
-    }  
+    }
+    if (!caps_data->threeAxis_valid) {
+        return NULL;
+    }
     return caps_data->threeAxis_value;
 }
 
 static void caps_threeAxis_set_threeAxis_value(caps_threeAxis_data_t *caps_data, int x, int y, int z)
 {
-    JSON_H *array = NULL;
-    JSON_H *array_obj = NULL;
-
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
 
-    array = JSON_CREATE_ARRAY();
-    if (!array) {
-        printf("fail to create json array\n");
-        return;
-    }
-    array_obj = JSON_CREATE_NUMBER((double) x);
-    JSON_ADD_ITEM_TO_ARRAY(array, array_obj);
-    array_obj = JSON_CREATE_NUMBER((double) y);
-    JSON_ADD_ITEM_TO_ARRAY(array, array_obj);
-    array_obj = JSON_CREATE_NUMBER((double) z);
-    JSON_ADD_ITEM_TO_ARRAY(array, array_obj);
-
-    JSON_DELETE(caps_data->threeAxis_value);
-    caps_data->threeAxis_value = array;
+    caps_data->threeAxis_value[0] = x;
+    caps_data->threeAxis_value[1] = y;
+    caps_data->threeAxis_value[2] = z;
+    caps_data->threeAxis_valid = 1;
 }
 
 static void caps_threeAxis_attr_threeAxis_send(caps_threeAxis_data_t *caps_data)
 {
-    IOT_EVENT *cap_evt;
-    uint8_t evt_num = 1;
+    char json_buf[CAPS_THREEAXIS_JSON_SIZE];
+    caps_json_writer_t writer;
     int sequence_no = -1;
-    iot_cap_val_t value;
+    int i;
 
     if (!caps_data || !caps_data->handle) {
         printf("fail to get handle\n");
         return;
     }
 
-    if (!caps_data->threeAxis_value) {
+    if (!caps_data->threeAxis_valid) {
         printf("value is NULL\n");
         return;
     }
 
-    value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT;
-    value.json_object = JSON_PRINT(caps_data->threeAxis_value);
+    caps_json_writer_init(&writer, json_buf, sizeof(json_buf));
+    caps_json_writer_begin_array(&writer);
+    for (i = 0; i < 3; i++) {
+        caps_json_writer_int(&writer, caps_data->threeAxis_value[i]);
+    }
+    caps_json_writer_end_array(&writer);
+    if (!caps_json_writer_finish(&writer)) {
+        printf("fail to write threeAxis value\n");
+        return;
+    }
 
-    cap_evt = st_cap_create_attr(caps_data->handle,
+    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,
             (char *)caps_helper_threeAxis.attr_threeAxis.name,
-            &value,
+            json_buf,
             NULL,
-            NULL);
-
-    if (!cap_evt) {
-        printf("fail to create cap_evt\n");
-        return;
-    }
+            NULL,
+            sequence_no);
 
-    sequence_no = st_cap_send_attr(&cap_evt, evt_num);
     if (sequence_no < 0)
         printf("fail to send threeAxis value\n");
 
     printf("Sequence number return : %d\n", sequence_no);
-    st_cap_free_attr(cap_evt);
 }
 
 
@@ -102,9 +96,12 @@ static void caps_threeAxis_attr_threeAxis_send(caps_threeAxis_data_t *caps_data)
 static void caps_threeAxis_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_threeAxis_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_threeAxis_attr_threeAxis_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_threeAxis_data_t *caps_threeAxis_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -126,7 +123,7 @@ caps_threeAxis_data_t *caps_threeAxis_initialize(IOT_CTX *ctx, const char *compo
     caps_data->set_threeAxis_value = caps_threeAxis_set_threeAxis_value;
     caps_data->attr_threeAxis_send = caps_threeAxis_attr_threeAxis_send;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_threeAxis.id, caps_threeAxis_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_threeAxis.id, caps_threeAxis_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init threeAxis handle\n");
@@ -134,3 +131,16 @@ caps_threeAxis_data_t *caps_threeAxis_initialize(IOT_CTX *ctx, const char *compo
 
     return caps_data;
 }
+
+void caps_threeAxis_deinitialize(caps_threeAxis_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -17,20 +17,23 @@
  ****************************************************************************/
 
 #include "caps/iot_caps_helper_threeAxis.h"
-#include "JSON.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* "[-2147483648,-2147483648,-2147483648]" */
+#define CAPS_THREEAXIS_JSON_SIZE 40
+
 typedef struct caps_threeAxis_data {
     IOT_CAP_HANDLE* handle;
     void *usr_data;
     void *cmd_data;
 
-    JSON_H *threeAxis_value;
+    int threeAxis_value[3];
+    int threeAxis_valid;
 
-    const JSON_H *(*get_threeAxis_value)(struct caps_threeAxis_data *caps_data);
+    const int *(*get_threeAxis_value)(struct caps_threeAxis_data *caps_data);
     void (*set_threeAxis_value)(struct caps_threeAxis_data *caps_data, int x, int y, int z);
     void (*attr_threeAxis_send)(struct caps_threeAxis_data *caps_data);
 
@@ -38,6 +41,7 @@ typedef struct caps_threeAxis_data {
 } caps_threeAxis_data_t;
 
 caps_threeAxis_data_t *caps_threeAxis_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_threeAxis_deinitialize(caps_threeAxis_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,7 @@ typedef struct caps_tone_data {
 } caps_tone_data_t;
 
 caps_tone_data_t *caps_tone_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_tone_deinitialize(caps_tone_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
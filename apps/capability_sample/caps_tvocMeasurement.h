@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_tvocMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_tvocMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double tvocLevel_value;
+    int64_t tvocLevel_milli;
     char *tvocLevel_unit;
 
     double (*get_tvocLevel_value)(struct caps_tvocMeasurement_data *caps_data);
     void (*set_tvocLevel_value)(struct caps_tvocMeasurement_data *caps_data, double value);
+    int64_t (*get_tvocLevel_milli)(struct caps_tvocMeasurement_data *caps_data);
+    void (*set_tvocLevel_milli)(struct caps_tvocMeasurement_data *caps_data, int64_t milli);
     const char *(*get_tvocLevel_unit)(struct caps_tvocMeasurement_data *caps_data);
     void (*set_tvocLevel_unit)(struct caps_tvocMeasurement_data *caps_data, const char *unit);
     void (*attr_tvocLevel_send)(struct caps_tvocMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_tvocMeasurement_data {
 } caps_tvocMeasurement_data_t;
 
 caps_tvocMeasurement_data_t *caps_tvocMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_tvocMeasurement_deinitialize(caps_tvocMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
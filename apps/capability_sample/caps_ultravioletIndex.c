@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_ultravioletIndex.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_ultravioletIndex_get_ultravioletIndex_milli(caps_ultravioletIndex_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_ultravioletIndex.attr_ultravioletIndex.min) - 1;
+    }
+    return caps_data->ultravioletIndex_milli;
+}
+
+static void caps_ultravioletIndex_set_ultravioletIndex_milli(caps_ultravioletIndex_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_ultravioletIndex.attr_ultravioletIndex.min)) {
+        printf("%lld is out of range for ultravioletIndex\n", (long long)milli);
+        return;
+    }
+    caps_data->ultravioletIndex_milli = milli;
+}
 
 static double caps_ultravioletIndex_get_ultravioletIndex_value(caps_ultravioletIndex_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_ultravioletIndex_get_ultravioletIndex_value(caps_ultravioletI
         printf("caps_data is NULL\n");
         return caps_helper_ultravioletIndex.attr_ultravioletIndex.min - 1;
     }
-    return caps_data->ultravioletIndex_value;
+    return caps_util_milli_to_double(caps_data->ultravioletIndex_milli);
 }
 
 static void caps_ultravioletIndex_set_ultravioletIndex_value(caps_ultravioletIndex_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->ultravioletIndex_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for ultravioletIndex\n");
+        return;
+    }
+    caps_ultravioletIndex_set_ultravioletIndex_milli(caps_data, milli);
 }
 
 static void caps_ultravioletIndex_attr_ultravioletIndex_send(caps_ultravioletIndex_data_t *caps_data)
@@ -50,9 +80,9 @@ static void caps_ultravioletIndex_attr_ultravioletIndex_send(caps_ultravioletInd
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_ultravioletIndex.attr_ultravioletIndex.name,
-            caps_data->ultravioletIndex_value,
+            caps_data->ultravioletIndex_milli,
             NULL,
             NULL,
             sequence_no);
@@ -67,9 +97,12 @@ static void caps_ultravioletIndex_attr_ultravioletIndex_send(caps_ultravioletInd
 static void caps_ultravioletIndex_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_ultravioletIndex_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_ultravioletIndex_attr_ultravioletIndex_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_ultravioletIndex_data_t *caps_ultravioletIndex_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -89,10 +122,12 @@ caps_ultravioletIndex_data_t *caps_ultravioletIndex_initialize(IOT_CTX *ctx, con
 
     caps_data->get_ultravioletIndex_value = caps_ultravioletIndex_get_ultravioletIndex_value;
     caps_data->set_ultravioletIndex_value = caps_ultravioletIndex_set_ultravioletIndex_value;
+    caps_data->get_ultravioletIndex_milli = caps_ultravioletIndex_get_ultravioletIndex_milli;
+    caps_data->set_ultravioletIndex_milli = caps_ultravioletIndex_set_ultravioletIndex_milli;
     caps_data->attr_ultravioletIndex_send = caps_ultravioletIndex_attr_ultravioletIndex_send;
-    caps_data->ultravioletIndex_value = 0;
+    caps_data->ultravioletIndex_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_ultravioletIndex.id, caps_ultravioletIndex_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_ultravioletIndex.id, caps_ultravioletIndex_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init ultravioletIndex handle\n");
@@ -100,3 +135,16 @@ caps_ultravioletIndex_data_t *caps_ultravioletIndex_initialize(IOT_CTX *ctx, con
 
     return caps_data;
 }
+
+void caps_ultravioletIndex_deinitialize(caps_ultravioletIndex_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
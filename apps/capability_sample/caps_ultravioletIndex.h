@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_ultravioletIndex.h"
 
 #ifdef __cplusplus
@@ -27,16 +29,19 @@ typedef struct caps_ultravioletIndex_data {
     void *usr_data;
     void *cmd_data;
 
-    double ultravioletIndex_value;
+    int64_t ultravioletIndex_milli;
 
     double (*get_ultravioletIndex_value)(struct caps_ultravioletIndex_data *caps_data);
     void (*set_ultravioletIndex_value)(struct caps_ultravioletIndex_data *caps_data, double value);
+    int64_t (*get_ultravioletIndex_milli)(struct caps_ultravioletIndex_data *caps_data);
+    void (*set_ultravioletIndex_milli)(struct caps_ultravioletIndex_data *caps_data, int64_t milli);
     void (*attr_ultravioletIndex_send)(struct caps_ultravioletIndex_data *caps_data);
 
     void (*init_usr_cb)(struct caps_ultravioletIndex_data *caps_data);
 } caps_ultravioletIndex_data_t;
 
 caps_ultravioletIndex_data_t *caps_ultravioletIndex_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_ultravioletIndex_deinitialize(caps_ultravioletIndex_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
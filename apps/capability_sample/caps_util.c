@@ -0,0 +1,113 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+
+#include "iot_os_util.h"
+#include "caps_util.h"
+
+static iot_os_timer time_timer;
+static iot_os_mutex time_mutex;
+static unsigned int time_base_ms;
+static int time_ready;
+
+unsigned int caps_util_get_time_ms(void)
+{
+    unsigned int left_ms;
+    unsigned int now_ms;
+
+    if (!time_ready) {
+        if (iot_os_mutex_init(&time_mutex) != IOT_OS_TRUE) {
+            printf("fail to init time mutex\n");
+            return 0;
+        }
+        if (iot_os_timer_init(&time_timer) != IOT_OS_TRUE) {
+            printf("fail to init time timer\n");
+            iot_os_mutex_destroy(&time_mutex);
+            return 0;
+        }
+        iot_os_timer_count_ms(time_timer, CAPS_UTIL_TIME_RANGE_MS);
+        time_ready = 1;
+    }
+
+    iot_os_mutex_lock(&time_mutex);
+    left_ms = iot_os_timer_left_ms(time_timer);
+    now_ms = time_base_ms + (CAPS_UTIL_TIME_RANGE_MS - left_ms);
+    if (left_ms < CAPS_UTIL_TIME_RANGE_MS / 2) {
+        /* re-arm before the timer runs out, time keeps counting from now_ms */
+        time_base_ms = now_ms;
+        iot_os_timer_count_ms(time_timer, CAPS_UTIL_TIME_RANGE_MS);
+    }
+    iot_os_mutex_unlock(&time_mutex);
+
+    return now_ms;
+}
+
+int caps_util_double_to_milli(double value, int64_t *milli)
+{
+    double scaled = value * 1000;
+
+    if (!milli)
+        return -1;
+    /* also false for NaN */
+    if (!(scaled > (double)INT64_MIN && scaled < (double)INT64_MAX))
+        return -1;
+
+    *milli = (int64_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    return 0;
+}
+
+double caps_util_milli_to_double(int64_t milli)
+{
+    return milli / 1000.0;
+}
+
+void caps_util_milli_to_val(int64_t milli, iot_cap_val_t *value)
+{
+    if (!value)
+        return;
+
+    /* iot_cap_val_t integer is an int */
+    if (milli % 1000 == 0 && milli / 1000 >= INT_MIN && milli / 1000 <= INT_MAX) {
+        value->type = IOT_CAP_VAL_TYPE_INTEGER;
+        value->integer = (int)(milli / 1000);
+    } else {
+        value->type = IOT_CAP_VAL_TYPE_NUMBER;
+        value->number = caps_util_milli_to_double(milli);
+    }
+}
+
+int caps_util_copy_string(char *buf, unsigned int size, const char *value)
+{
+    unsigned int len;
+
+    if (!value) {
+        printf("value is NULL\n");
+        return -1;
+    }
+    len = strlen(value);
+    if (len >= size) {
+        printf("value is too long : %u >= %u\n", len, size);
+        return -1;
+    }
+    memcpy(buf, value, len + 1);
+    return 0;
+}
@@ -0,0 +1,76 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_UTIL_H_
+#define _CAPS_UTIL_H_
+
+#include <stdint.h>
+
+#include "st_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ISO-8601 time attributes up to "2020-01-01T12:00:00.000+09:00" and the terminator */
+#ifndef CAPS_UTIL_TIME_STRING_SIZE
+#define CAPS_UTIL_TIME_STRING_SIZE 30
+#endif
+
+#ifndef CAPS_UTIL_TIME_RANGE_MS
+#define CAPS_UTIL_TIME_RANGE_MS (24 * 60 * 60 * 1000U)
+#endif
+
+/**
+ * Milliseconds elapsed since the first call.
+ *
+ * Built on iot_os_timer so it works on every supported OS. It has to be called
+ * at least once every CAPS_UTIL_TIME_RANGE_MS / 2 to keep counting.
+ */
+unsigned int caps_util_get_time_ms(void);
+
+/**
+ * Fixed-point values in 1/1000 of the unit.
+ *
+ * Number attributes keep their value as int64_t milli-units, so get/set_X_milli()
+ * and the send path don't need floating point. Attributes without a maximum, like
+ * energy or gasMeter, may count well beyond the +-2147483.647 of int32_t.
+ * CAPS_UTIL_MILLI() is meant for constants, which the compiler folds.
+ */
+#define CAPS_UTIL_MILLI(value) ((int64_t)((value) * 1000.0))
+
+/* Returns -1 if value doesn't fit in int64_t milli-units */
+int caps_util_double_to_milli(double value, int64_t *milli);
+double caps_util_milli_to_double(int64_t milli);
+
+/* Whole values are sent as IOT_CAP_VAL_TYPE_INTEGER, others as IOT_CAP_VAL_TYPE_NUMBER */
+void caps_util_milli_to_val(int64_t milli, iot_cap_val_t *value);
+
+/**
+ * Free-form string attributes which are updated often, like completion times, are kept in
+ * fixed-size buffers of the wrapper instead of strdup() copies, so updates don't touch the heap.
+ * value is copied in place. A NULL value or one that doesn't fit is rejected with -1,
+ * and buf keeps its old value.
+ */
+int caps_util_copy_string(char *buf, unsigned int size, const char *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_UTIL_H_ */
@@ -27,10 +27,12 @@ typedef struct caps_valve_data {
     void *usr_data;
     void *cmd_data;
 
-    char *valve_value;
+    int valve_idx;
 
     const char *(*get_valve_value)(struct caps_valve_data *caps_data);
     void (*set_valve_value)(struct caps_valve_data *caps_data, const char *value);
+    int (*get_valve_idx)(struct caps_valve_data *caps_data);
+    void (*set_valve_idx)(struct caps_valve_data *caps_data, int idx);
     int (*attr_valve_str2idx)(const char *value);
     void (*attr_valve_send)(struct caps_valve_data *caps_data);
 
@@ -41,6 +43,7 @@ typedef struct caps_valve_data {
 } caps_valve_data_t;
 
 caps_valve_data_t *caps_valve_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_valve_deinitialize(caps_valve_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
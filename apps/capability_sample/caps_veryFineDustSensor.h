@@ -40,6 +40,7 @@ typedef struct caps_veryFineDustSensor_data {
 } caps_veryFineDustSensor_data_t;
 
 caps_veryFineDustSensor_data_t *caps_veryFineDustSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_veryFineDustSensor_deinitialize(caps_veryFineDustSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
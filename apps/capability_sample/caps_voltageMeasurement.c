@@ -22,6 +22,30 @@
 
 #include "st_dev.h"
 #include "caps_voltageMeasurement.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+
+static int64_t caps_voltageMeasurement_get_voltage_milli(caps_voltageMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return CAPS_UTIL_MILLI(caps_helper_voltageMeasurement.attr_voltage.min) - 1;
+    }
+    return caps_data->voltage_milli;
+}
+
+static void caps_voltageMeasurement_set_voltage_milli(caps_voltageMeasurement_data_t *caps_data, int64_t milli)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (milli < CAPS_UTIL_MILLI(caps_helper_voltageMeasurement.attr_voltage.min)) {
+        printf("%lld is out of range for voltage\n", (long long)milli);
+        return;
+    }
+    caps_data->voltage_milli = milli;
+}
 
 static double caps_voltageMeasurement_get_voltage_value(caps_voltageMeasurement_data_t *caps_data)
 {
@@ -29,16 +53,22 @@ static double caps_voltageMeasurement_get_voltage_value(caps_voltageMeasurement_
         printf("caps_data is NULL\n");
         return caps_helper_voltageMeasurement.attr_voltage.min - 1;
     }
-    return caps_data->voltage_value;
+    return caps_util_milli_to_double(caps_data->voltage_milli);
 }
 
 static void caps_voltageMeasurement_set_voltage_value(caps_voltageMeasurement_data_t *caps_data, double value)
 {
+    int64_t milli;
+
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    caps_data->voltage_value = value;
+    if (caps_util_double_to_milli(value, &milli) < 0) {
+        printf("value is out of range for voltage\n");
+        return;
+    }
+    caps_voltageMeasurement_set_voltage_milli(caps_data, milli);
 }
 
 static const char *caps_voltageMeasurement_get_voltage_unit(caps_voltageMeasurement_data_t *caps_data)
@@ -68,9 +98,9 @@ static void caps_voltageMeasurement_attr_voltage_send(caps_voltageMeasurement_da
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_MILLI(caps_data->handle,
             (char *)caps_helper_voltageMeasurement.attr_voltage.name,
-            caps_data->voltage_value,
+            caps_data->voltage_milli,
             caps_data->voltage_unit,
             NULL,
             sequence_no);
@@ -85,9 +115,12 @@ static void caps_voltageMeasurement_attr_voltage_send(caps_voltageMeasurement_da
 static void caps_voltageMeasurement_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_voltageMeasurement_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_voltageMeasurement_attr_voltage_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_voltageMeasurement_data_t *caps_voltageMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -107,12 +140,14 @@ caps_voltageMeasurement_data_t *caps_voltageMeasurement_initialize(IOT_CTX *ctx,
 
     caps_data->get_voltage_value = caps_voltageMeasurement_get_voltage_value;
     caps_data->set_voltage_value = caps_voltageMeasurement_set_voltage_value;
+    caps_data->get_voltage_milli = caps_voltageMeasurement_get_voltage_milli;
+    caps_data->set_voltage_milli = caps_voltageMeasurement_set_voltage_milli;
     caps_data->get_voltage_unit = caps_voltageMeasurement_get_voltage_unit;
     caps_data->set_voltage_unit = caps_voltageMeasurement_set_voltage_unit;
     caps_data->attr_voltage_send = caps_voltageMeasurement_attr_voltage_send;
-    caps_data->voltage_value = 0;
+    caps_data->voltage_milli = CAPS_UTIL_MILLI(0);
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_voltageMeasurement.id, caps_voltageMeasurement_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_voltageMeasurement.id, caps_voltageMeasurement_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init voltageMeasurement handle\n");
@@ -120,3 +155,16 @@ caps_voltageMeasurement_data_t *caps_voltageMeasurement_initialize(IOT_CTX *ctx,
 
     return caps_data;
 }
+
+void caps_voltageMeasurement_deinitialize(caps_voltageMeasurement_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "caps/iot_caps_helper_voltageMeasurement.h"
 
 #ifdef __cplusplus
@@ -27,11 +29,13 @@ typedef struct caps_voltageMeasurement_data {
     void *usr_data;
     void *cmd_data;
 
-    double voltage_value;
+    int64_t voltage_milli;
     char *voltage_unit;
 
     double (*get_voltage_value)(struct caps_voltageMeasurement_data *caps_data);
     void (*set_voltage_value)(struct caps_voltageMeasurement_data *caps_data, double value);
+    int64_t (*get_voltage_milli)(struct caps_voltageMeasurement_data *caps_data);
+    void (*set_voltage_milli)(struct caps_voltageMeasurement_data *caps_data, int64_t milli);
     const char *(*get_voltage_unit)(struct caps_voltageMeasurement_data *caps_data);
     void (*set_voltage_unit)(struct caps_voltageMeasurement_data *caps_data, const char *unit);
     void (*attr_voltage_send)(struct caps_voltageMeasurement_data *caps_data);
@@ -40,6 +44,7 @@ typedef struct caps_voltageMeasurement_data {
 } caps_voltageMeasurement_data_t;
 
 caps_voltageMeasurement_data_t *caps_voltageMeasurement_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_voltageMeasurement_deinitialize(caps_voltageMeasurement_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
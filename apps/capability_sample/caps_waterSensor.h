@@ -27,10 +27,12 @@ typedef struct caps_waterSensor_data {
     void *usr_data;
     void *cmd_data;
 
-    char *water_value;
+    int water_idx;
 
     const char *(*get_water_value)(struct caps_waterSensor_data *caps_data);
     void (*set_water_value)(struct caps_waterSensor_data *caps_data, const char *value);
+    int (*get_water_idx)(struct caps_waterSensor_data *caps_data);
+    void (*set_water_idx)(struct caps_waterSensor_data *caps_data, int idx);
     int (*attr_water_str2idx)(const char *value);
     void (*attr_water_send)(struct caps_waterSensor_data *caps_data);
 
@@ -38,6 +40,7 @@ typedef struct caps_waterSensor_data {
 } caps_waterSensor_data_t;
 
 caps_waterSensor_data_t *caps_waterSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_waterSensor_deinitialize(caps_waterSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
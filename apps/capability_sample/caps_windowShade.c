@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_windowShade.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_windowShade_attr_windowShade_str2idx(const char *value)
 {
@@ -41,19 +43,52 @@ static const char *caps_windowShade_get_windowShade_value(caps_windowShade_data_
         printf("caps_data is NULL\n");
         return NULL;
     }
-    return caps_data->windowShade_value;
+    if (caps_data->windowShade_idx < 0) {
+        return NULL;
+    }
+    return caps_helper_windowShade.attr_windowShade.values[caps_data->windowShade_idx];
 }
 
 static void caps_windowShade_set_windowShade_value(caps_windowShade_data_t *caps_data, const char *value)
+{
+    int index;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (!value) {
+        printf("value is NULL\n");
+        return;
+    }
+    index = caps_windowShade_attr_windowShade_str2idx(value);
+    if (index < 0) {
+        printf("%s is not supported value for windowShade\n", value);
+        return;
+    }
+    caps_data->windowShade_idx = index;
+}
+
+static int caps_windowShade_get_windowShade_idx(caps_windowShade_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return -1;
+    }
+    return caps_data->windowShade_idx;
+}
+
+static void caps_windowShade_set_windowShade_idx(caps_windowShade_data_t *caps_data, int idx)
 {
     if (!caps_data) {
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->windowShade_value) {
-        free(caps_data->windowShade_value);
+    if (idx < 0 || idx >= CAP_ENUM_WINDOWSHADE_WINDOWSHADE_VALUE_MAX) {
+        printf("%d is not supported index for windowShade\n", idx);
+        return;
     }
-    caps_data->windowShade_value = strdup(value);
+    caps_data->windowShade_idx = idx;
 }
 
 static void caps_windowShade_attr_windowShade_send(caps_windowShade_data_t *caps_data)
@@ -64,14 +99,14 @@ static void caps_windowShade_attr_windowShade_send(caps_windowShade_data_t *caps
         printf("fail to get handle\n");
         return;
     }
-    if (!caps_data->windowShade_value) {
+    if (caps_data->windowShade_idx < 0) {
         printf("value is NULL\n");
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRING(caps_data->handle,
+    CAPS_SEND_ATTR_STRING(caps_data->handle,
             (char *)caps_helper_windowShade.attr_windowShade.name,
-            caps_data->windowShade_value,
+            (char *)caps_helper_windowShade.attr_windowShade.values[caps_data->windowShade_idx],
             NULL,
             NULL,
             sequence_no);
@@ -100,7 +135,7 @@ static void caps_windowShade_set_supportedWindowShadeCommands_value(caps_windowS
         printf("caps_data is NULL\n");
         return;
     }
-    if (caps_data->supportedWindowShadeCommands_value) {
+    if (caps_data->supportedWindowShadeCommands_value && !caps_data->supportedWindowShadeCommands_borrowed) {
         for (i = 0; i < caps_data->supportedWindowShadeCommands_arraySize; i++) {
             free(caps_data->supportedWindowShadeCommands_value[i]);
         }
@@ -117,6 +152,27 @@ static void caps_windowShade_set_supportedWindowShadeCommands_value(caps_windowS
     }
 
     caps_data->supportedWindowShadeCommands_arraySize = arraySize;
+    caps_data->supportedWindowShadeCommands_borrowed = 0;
+}
+
+static void caps_windowShade_set_supportedWindowShadeCommands_value_borrowed(caps_windowShade_data_t *caps_data, const char * const *value, int arraySize)
+{
+    int i;
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+    if (caps_data->supportedWindowShadeCommands_value && !caps_data->supportedWindowShadeCommands_borrowed) {
+        for (i = 0; i < caps_data->supportedWindowShadeCommands_arraySize; i++) {
+            free(caps_data->supportedWindowShadeCommands_value[i]);
+        }
+        free(caps_data->supportedWindowShadeCommands_value);
+    }
+
+    /* value is kept as is, it has to outlive caps_data or the next set */
+    caps_data->supportedWindowShadeCommands_value = (char **)value;
+    caps_data->supportedWindowShadeCommands_arraySize = arraySize;
+    caps_data->supportedWindowShadeCommands_borrowed = 1;
 }
 
 static void caps_windowShade_attr_supportedWindowShadeCommands_send(caps_windowShade_data_t *caps_data)
@@ -132,7 +188,7 @@ static void caps_windowShade_attr_supportedWindowShadeCommands_send(caps_windowS
         return;
     }
 
-    ST_CAP_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
+    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,
             (char *)caps_helper_windowShade.attr_supportedWindowShadeCommands.name,
             caps_data->supportedWindowShadeCommands_value,
             caps_data->supportedWindowShadeCommands_arraySize,
@@ -150,11 +206,11 @@ static void caps_windowShade_attr_supportedWindowShadeCommands_send(caps_windowS
 static void caps_windowShade_cmd_close_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_windowShade_data_t *caps_data = (caps_windowShade_data_t *)usr_data;
-    const char* value = caps_helper_windowShade.attr_windowShade.values[CAP_ENUM_WINDOWSHADE_WINDOWSHADE_VALUE_CLOSED];
+    int index = CAP_ENUM_WINDOWSHADE_WINDOWSHADE_VALUE_CLOSED;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_windowShade_set_windowShade_value(caps_data, value);
+    caps_windowShade_set_windowShade_idx(caps_data, index);
     if (caps_data && caps_data->cmd_close_usr_cb)
         caps_data->cmd_close_usr_cb(caps_data);
     caps_windowShade_attr_windowShade_send(caps_data);
@@ -173,11 +229,11 @@ static void caps_windowShade_cmd_pause_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_da
 static void caps_windowShade_cmd_open_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
 {
     caps_windowShade_data_t *caps_data = (caps_windowShade_data_t *)usr_data;
-    const char* value = caps_helper_windowShade.attr_windowShade.values[CAP_ENUM_WINDOWSHADE_WINDOWSHADE_VALUE_OPEN];
+    int index = CAP_ENUM_WINDOWSHADE_WINDOWSHADE_VALUE_OPEN;
 
     printf("called [%s] func with num_args:%u\n", __func__, cmd_data->num_args);
 
-    caps_windowShade_set_windowShade_value(caps_data, value);
+    caps_windowShade_set_windowShade_idx(caps_data, index);
     if (caps_data && caps_data->cmd_open_usr_cb)
         caps_data->cmd_open_usr_cb(caps_data);
     caps_windowShade_attr_windowShade_send(caps_data);
@@ -186,10 +242,13 @@ static void caps_windowShade_cmd_open_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_dat
 static void caps_windowShade_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_windowShade_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_windowShade_attr_windowShade_send(caps_data);
     caps_windowShade_attr_supportedWindowShadeCommands_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_windowShade_data_t *caps_windowShade_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -210,24 +269,28 @@ caps_windowShade_data_t *caps_windowShade_initialize(IOT_CTX *ctx, const char *c
 
     caps_data->get_windowShade_value = caps_windowShade_get_windowShade_value;
     caps_data->set_windowShade_value = caps_windowShade_set_windowShade_value;
+    caps_data->get_windowShade_idx = caps_windowShade_get_windowShade_idx;
+    caps_data->set_windowShade_idx = caps_windowShade_set_windowShade_idx;
     caps_data->attr_windowShade_str2idx = caps_windowShade_attr_windowShade_str2idx;
     caps_data->attr_windowShade_send = caps_windowShade_attr_windowShade_send;
     caps_data->get_supportedWindowShadeCommands_value = caps_windowShade_get_supportedWindowShadeCommands_value;
     caps_data->set_supportedWindowShadeCommands_value = caps_windowShade_set_supportedWindowShadeCommands_value;
+    caps_data->set_supportedWindowShadeCommands_value_borrowed = caps_windowShade_set_supportedWindowShadeCommands_value_borrowed;
     caps_data->attr_supportedWindowShadeCommands_send = caps_windowShade_attr_supportedWindowShadeCommands_send;
+    caps_data->windowShade_idx = -1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_windowShade.id, caps_windowShade_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_windowShade.id, caps_windowShade_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_close.name, caps_windowShade_cmd_close_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_close.name, caps_windowShade_cmd_close_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for close of windowShade\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_pause.name, caps_windowShade_cmd_pause_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_pause.name, caps_windowShade_cmd_pause_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for pause of windowShade\n");
     }
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_open.name, caps_windowShade_cmd_open_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_windowShade.cmd_open.name, caps_windowShade_cmd_open_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for open of windowShade\n");
     }
@@ -237,3 +300,25 @@ caps_windowShade_data_t *caps_windowShade_initialize(IOT_CTX *ctx, const char *c
 
     return caps_data;
 }
+
+void caps_windowShade_deinitialize(caps_windowShade_data_t *caps_data)
+{
+    int i;
+
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    if (caps_data->supportedWindowShadeCommands_value && !caps_data->supportedWindowShadeCommands_borrowed) {
+        for (i = 0; i < caps_data->supportedWindowShadeCommands_arraySize; i++) {
+            free(caps_data->supportedWindowShadeCommands_value[i]);
+        }
+        free(caps_data->supportedWindowShadeCommands_value);
+    }
+    free(caps_data);
+}
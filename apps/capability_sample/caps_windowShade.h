@@ -28,16 +28,20 @@ typedef struct caps_windowShade_data {
     void *usr_data;
     void *cmd_data;
 
-    char *windowShade_value;
+    int windowShade_idx;
     char **supportedWindowShadeCommands_value;
     int supportedWindowShadeCommands_arraySize;
+    int supportedWindowShadeCommands_borrowed;
 
     const char *(*get_windowShade_value)(struct caps_windowShade_data *caps_data);
     void (*set_windowShade_value)(struct caps_windowShade_data *caps_data, const char *value);
+    int (*get_windowShade_idx)(struct caps_windowShade_data *caps_data);
+    void (*set_windowShade_idx)(struct caps_windowShade_data *caps_data, int idx);
     int (*attr_windowShade_str2idx)(const char *value);
     void (*attr_windowShade_send)(struct caps_windowShade_data *caps_data);
     const char **(*get_supportedWindowShadeCommands_value)(struct caps_windowShade_data *caps_data);
     void (*set_supportedWindowShadeCommands_value)(struct caps_windowShade_data *caps_data, const char **value, int arraySize);
+    void (*set_supportedWindowShadeCommands_value_borrowed)(struct caps_windowShade_data *caps_data, const char * const *value, int arraySize);
     void (*attr_supportedWindowShadeCommands_send)(struct caps_windowShade_data *caps_data);
 
     void (*init_usr_cb)(struct caps_windowShade_data *caps_data);
@@ -48,6 +52,7 @@ typedef struct caps_windowShade_data {
 } caps_windowShade_data_t;
 
 caps_windowShade_data_t *caps_windowShade_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_windowShade_deinitialize(caps_windowShade_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,173 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "caps_json_writer.h"
+
+/*
+ * Numbers written by caps_json_writer and by snprintf("%.15g"), on a corpus of sensor
+ * readings kept as double with their decimals and as float. Prints ns and output bytes
+ * per value, the table of README section 9.
+ */
+
+#define VALUES 80000
+#define ROUNDS 5
+
+struct sensor {
+    const char *name;
+    double min;
+    double max;
+    int decimals;
+};
+
+static const struct sensor sensors[] = {
+    { "temperature", -20, 45, 1 },
+    { "humidity", 0, 100, 1 },
+    { "power", 0, 3000, 1 },
+    { "voltage", 210, 250, 1 },
+    { "energy", 0, 99999, 3 },
+    { "lux", 0, 10000, 0 },
+    { "acceleration", -2, 2, 3 },
+    { "pressure", 950, 1050, 2 },
+};
+
+#define SENSOR_NUM (int)(sizeof(sensors) / sizeof(sensors[0]))
+
+static double decimal_values[VALUES];
+static float float_values[VALUES];
+static volatile unsigned int sink;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void make_corpus(void)
+{
+    static const double scale[] = { 1, 10, 100, 1000 };
+    unsigned int seed = 1;
+    const struct sensor *sensor;
+    long long low;
+    long long steps;
+    int i;
+
+    /* one division of whole steps, so a value is the double nearest to its decimal text */
+    for (i = 0; i < VALUES; i++) {
+        sensor = &sensors[i % SENSOR_NUM];
+        seed = seed * 1103515245 + 12345;
+        low = (long long)(sensor->min * scale[sensor->decimals]);
+        steps = (long long)((sensor->max - sensor->min) * scale[sensor->decimals]);
+        decimal_values[i] = (double)(low + (seed >> 8) % (steps + 1)) / scale[sensor->decimals];
+        float_values[i] = (float)decimal_values[i];
+    }
+}
+
+static unsigned int write_number(char *buf, double value)
+{
+    caps_json_writer_t writer;
+
+    caps_json_writer_init(&writer, buf, 32);
+    caps_json_writer_number(&writer, value);
+    return caps_json_writer_finish(&writer) ? writer.len : 0;
+}
+
+static unsigned int write_float(char *buf, float value)
+{
+    caps_json_writer_t writer;
+
+    caps_json_writer_init(&writer, buf, 32);
+    caps_json_writer_float(&writer, value);
+    return caps_json_writer_finish(&writer) ? writer.len : 0;
+}
+
+static unsigned int print_number(char *buf, double value)
+{
+    return snprintf(buf, 32, "%.15g", value);
+}
+
+/* best ns/value of ROUNDS and bytes/value */
+static void run(const char *label, int use_float, unsigned int (*number)(char *, double),
+        unsigned int (*single)(char *, float))
+{
+    char buf[32];
+    uint64_t best = UINT64_MAX;
+    uint64_t start;
+    uint64_t elapsed;
+    unsigned long bytes = 0;
+    int round;
+    int i;
+
+    for (round = 0; round < ROUNDS; round++) {
+        bytes = 0;
+        start = now_ns();
+        for (i = 0; i < VALUES; i++) {
+            if (use_float)
+                bytes += single ? single(buf, float_values[i]) : number(buf, float_values[i]);
+            else
+                bytes += number(buf, decimal_values[i]);
+            sink += buf[0];
+        }
+        elapsed = now_ns() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    printf("  %-46s : %6.1f ns %6.2f bytes\n", label, (double)best / VALUES, (double)bytes / VALUES);
+}
+
+/* the writer output reads back as the same value */
+static int check_round_trip(void)
+{
+    char buf[32];
+    int bad = 0;
+    int i;
+
+    for (i = 0; i < VALUES; i++) {
+        if (!write_number(buf, decimal_values[i]) || strtod(buf, NULL) != decimal_values[i])
+            bad++;
+        if (!write_float(buf, float_values[i]) || (float)strtod(buf, NULL) != float_values[i])
+            bad++;
+    }
+    return bad;
+}
+
+int main(void)
+{
+    int bad;
+
+    make_corpus();
+    bad = check_round_trip();
+    if (bad) {
+        printf("%d values don't read back\n", bad);
+        return 1;
+    }
+
+    printf("%d sensor readings, per value, best of %d\n", VALUES, ROUNDS);
+    run("snprintf(\"%.15g\") of decimal values", 0, print_number, NULL);
+    run("caps_json_writer_number() of decimal values", 0, write_number, NULL);
+    run("snprintf(\"%.15g\") of float readings", 1, print_number, NULL);
+    run("caps_json_writer_float() of float readings", 1, NULL, write_float);
+    return 0;
+}
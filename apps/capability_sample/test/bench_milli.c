@@ -0,0 +1,160 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "st_dev.h"
+#include "caps_engine.h"
+#include "caps_sender.h"
+#include "caps_util.h"
+#include "host_stub.h"
+
+/*
+ * Set and send cycles of a number attribute, kept in int64_t milli-units by caps_engine
+ * and, for comparison, in a double slot as caps_engine did before.
+ */
+
+#define CYCLES 200000
+#define ROUNDS 5
+
+typedef struct meter_state {
+    int64_t power_value;
+    const char *power_unit;
+} meter_state_t;
+
+static const char * const power_units[] = { "W" };
+
+static const caps_engine_attr_desc_t meter_attrs[] = {
+    {
+        .name = "power",
+        .type = CAPS_ENGINE_ATTR_NUMBER,
+        .flags = CAPS_ENGINE_ATTR_FLAG_MIN,
+        .unit_num = 1,
+        .offset = offsetof(meter_state_t, power_value),
+        .unit_offset = offsetof(meter_state_t, power_unit),
+        .units = power_units,
+        .min = CAPS_UTIL_MILLI(0),
+    },
+};
+
+static const caps_engine_desc_t meter_desc = {
+    .id = "powerMeter",
+    .attrs = meter_attrs,
+    .attr_num = 1,
+    .state_size = sizeof(meter_state_t),
+};
+
+static int ctx;
+static double double_slot;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* set and send of caps_engine before the milli-units, with the same checks and log */
+static void double_set_send(caps_engine_data_t *caps_data, double value)
+{
+    const caps_engine_attr_desc_t *attr_desc = &caps_data->desc->attrs[0];
+    caps_attr_t caps_attr;
+    int sequence_no;
+
+    if ((attr_desc->flags & CAPS_ENGINE_ATTR_FLAG_MIN) && value < attr_desc->min / 1000.0)
+        return;
+    double_slot = value;
+
+    memset(&caps_attr, 0, sizeof(caps_attr));
+    caps_attr.handle = caps_data->handle;
+    caps_attr.name = attr_desc->name;
+    caps_attr.value.type = IOT_CAP_VAL_TYPE_NUMBER;
+    caps_attr.value.number = double_slot;
+    caps_attr.unit = caps_engine_get_unit(caps_data, 0);
+    sequence_no = caps_sender_send_attrs(&caps_attr, 1);
+    if (sequence_no < 0)
+        printf("fail to send %s value\n", attr_desc->name);
+    else
+        printf("Sequence number return : %d\n", sequence_no);
+}
+
+int main(void)
+{
+    caps_engine_data_t *meter;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t milli_ns;
+    uint64_t number_ns;
+    uint64_t double_ns;
+    FILE *out = stdout;
+    int round;
+    int i;
+
+    meter = caps_engine_initialize(&ctx, "main", &meter_desc, NULL, NULL);
+    if (!meter || !meter->handle)
+        return 1;
+    caps_engine_set_unit(meter, 0, power_units[0]);
+
+    /* the engine logs every send */
+    stdout = fopen("/dev/null", "w");
+
+    /* readings of 0.1 W steps, so most of them are not whole, best of ROUNDS */
+    milli_ns = number_ns = double_ns = UINT64_MAX;
+    for (round = 0; round < ROUNDS; round++) {
+        start = now_ns();
+        for (i = 0; i < CYCLES; i++) {
+            caps_engine_set_milli(meter, 0, (int64_t)i * 100);
+            caps_engine_attr_send(meter, 0);
+        }
+        elapsed = now_ns() - start;
+        if (elapsed < milli_ns)
+            milli_ns = elapsed;
+
+        start = now_ns();
+        for (i = 0; i < CYCLES; i++) {
+            caps_engine_set_number(meter, 0, i * 0.1);
+            caps_engine_attr_send(meter, 0);
+        }
+        elapsed = now_ns() - start;
+        if (elapsed < number_ns)
+            number_ns = elapsed;
+
+        start = now_ns();
+        for (i = 0; i < CYCLES; i++) {
+            double_set_send(meter, i * 0.1);
+        }
+        elapsed = now_ns() - start;
+        if (elapsed < double_ns)
+            double_ns = elapsed;
+    }
+
+    fclose(stdout);
+    stdout = out;
+
+    printf("set+send of %d readings, ns/cycle, best of %d\n", CYCLES, ROUNDS);
+    printf("  caps_engine_set_milli   : %.1f\n", (double)milli_ns / CYCLES);
+    printf("  caps_engine_set_number  : %.1f\n", (double)number_ns / CYCLES);
+    printf("  double slot             : %.1f\n", (double)double_ns / CYCLES);
+
+    caps_engine_deinitialize(meter);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_payload_cache.h"
+#include "host_stub.h"
+
+/*
+ * Refreshes of unchanged attributes, the events built for them and the time per send,
+ * with the attributes not registered in caps_payload_cache and then registered.
+ */
+
+#define ATTRS 20
+#define REFRESHES 1000
+#define ROUNDS 5
+
+static IOT_CAP_HANDLE *handle;
+static char names[ATTRS][16];
+static caps_attr_t attrs[ATTRS];
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* levels with a unit, numbers and strings, like a light and its sensors */
+static void make_attrs(void)
+{
+    int i;
+
+    for (i = 0; i < ATTRS; i++) {
+        snprintf(names[i], sizeof(names[i]), "attr%d", i);
+        attrs[i].handle = handle;
+        attrs[i].name = names[i];
+        if (i % 4 == 3) {
+            attrs[i].value.type = IOT_CAP_VAL_TYPE_STRING;
+            attrs[i].value.string = (i % 8 == 3) ? "on" : "off";
+        } else if (i % 4 == 2) {
+            attrs[i].value.type = IOT_CAP_VAL_TYPE_NUMBER;
+            attrs[i].value.number = 21.5 + i;
+            attrs[i].unit = "C";
+        } else {
+            attrs[i].value.type = IOT_CAP_VAL_TYPE_INTEGER;
+            attrs[i].value.integer = i * 5;
+            attrs[i].unit = "%";
+        }
+    }
+}
+
+/* best ns per send of ROUNDS and events built in the first round */
+static void run(const char *label)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t start;
+    uint64_t elapsed;
+    int created = 0;
+    int round;
+    int i;
+    int j;
+
+    for (round = 0; round < ROUNDS; round++) {
+        if (round == 0)
+            created = host_created_events();
+        start = now_ns();
+        for (i = 0; i < REFRESHES; i++) {
+            for (j = 0; j < ATTRS; j++) {
+                if (caps_sender_send_attrs(&attrs[j], 1) < 0)
+                    printf("fail to send %s\n", names[j]);
+            }
+        }
+        elapsed = now_ns() - start;
+        if (round == 0)
+            created = host_created_events() - created;
+        if (elapsed < best)
+            best = elapsed;
+        host_reset_sent();
+    }
+    printf("  %-14s : %6.1f ns/send, %6d events built\n", label, (double)best / (REFRESHES * ATTRS), created);
+}
+
+int main(void)
+{
+    static int ctx;
+    caps_payload_cache_stats_t stats;
+    int i;
+
+    handle = st_cap_handle_init(&ctx, "main", "bench", NULL, NULL);
+    if (caps_sender_add_handle(handle, "main", "bench"))
+        return 1;
+    make_attrs();
+
+    printf("%d refreshes of %d unchanged attributes, best of %d\n", REFRESHES, ATTRS, ROUNDS);
+    run("not registered");
+
+    for (i = 0; i < ATTRS; i++) {
+        if (caps_payload_cache_register(handle, names[i])) {
+            printf("fail to register %s\n", names[i]);
+            return 1;
+        }
+    }
+    caps_payload_cache_reset_stats();
+    run("registered");
+
+    caps_payload_cache_get_stats(&stats);
+    printf("  hit %u, built %u, busy %u\n", stats.hit_count, stats.build_count, stats.busy_count);
+    return 0;
+}
@@ -0,0 +1,464 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* iot_os_util on pthreads, and an iot-core which records what is sent */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "host_stub.h"
+
+#define HOST_MAX_HANDLES 64
+#define HOST_MAX_CMDS 8
+
+struct host_queue {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int length;
+    int item_size;
+    int head;
+    int count;
+    char *buf;
+};
+
+struct host_handle {
+    const char *component;
+    const char *capability;
+    st_cap_init_cb init_cb;
+    void *init_usr_data;
+    int cmd_num;
+    const char *cmd_type[HOST_MAX_CMDS];
+    st_cap_cmd_cb cmd_cb[HOST_MAX_CMDS];
+    void *cmd_usr_data[HOST_MAX_CMDS];
+};
+
+int host_failures;
+
+static pthread_mutex_t host_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct host_handle host_handle[HOST_MAX_HANDLES];
+static int host_handle_num;
+static host_event_t host_sent[HOST_SENT_SIZE];
+static int host_sent_num;
+static int host_message_num;
+static int host_sequence_no;
+static int host_live;
+static int host_created;
+static int host_send_fail;
+
+static uint64_t _now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int iot_os_thread_create(void *thread_function, const char *name, int stack_size,
+        void *data, int priority, iot_os_thread *thread_handle)
+{
+    pthread_t *thread = malloc(sizeof(*thread));
+
+    if (!thread || pthread_create(thread, NULL, (void *(*)(void *))thread_function, data)) {
+        free(thread);
+        return IOT_OS_FALSE;
+    }
+    pthread_detach(*thread);
+    if (thread_handle) {
+        *thread_handle = thread;
+    }
+    return IOT_OS_TRUE;
+}
+
+void iot_os_thread_delete(iot_os_thread thread_handle)
+{
+    if (!thread_handle) {
+        pthread_exit(NULL);
+    }
+}
+
+void iot_os_thread_yield(void)
+{
+    sched_yield();
+}
+
+int iot_os_thread_get_current_handle(iot_os_thread *thread_handle)
+{
+    *thread_handle = (iot_os_thread)pthread_self();
+    return IOT_OS_TRUE;
+}
+
+iot_os_queue *iot_os_queue_create(int queue_length, int item_size)
+{
+    struct host_queue *queue = calloc(1, sizeof(*queue));
+
+    if (!queue) {
+        return NULL;
+    }
+    queue->buf = malloc(queue_length * item_size);
+    if (!queue->buf) {
+        free(queue);
+        return NULL;
+    }
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+    queue->length = queue_length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+int iot_os_queue_reset(iot_os_queue *queue_handle)
+{
+    struct host_queue *queue = queue_handle;
+
+    pthread_mutex_lock(&queue->mutex);
+    queue->count = 0;
+    pthread_mutex_unlock(&queue->mutex);
+    return IOT_OS_TRUE;
+}
+
+void iot_os_queue_delete(iot_os_queue *queue_handle)
+{
+    struct host_queue *queue = queue_handle;
+
+    if (queue) {
+        pthread_mutex_destroy(&queue->mutex);
+        pthread_cond_destroy(&queue->cond);
+        free(queue->buf);
+        free(queue);
+    }
+}
+
+int iot_os_queue_send(iot_os_queue *queue_handle, void *data, unsigned int wait_time_ms)
+{
+    struct host_queue *queue = queue_handle;
+
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->count == queue->length) {
+        pthread_mutex_unlock(&queue->mutex);
+        return IOT_OS_FALSE;
+    }
+    memcpy(queue->buf + ((queue->head + queue->count) % queue->length) * queue->item_size,
+            data, queue->item_size);
+    queue->count++;
+    pthread_cond_signal(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return IOT_OS_TRUE;
+}
+
+int iot_os_queue_receive(iot_os_queue *queue_handle, void *data, unsigned int wait_time_ms)
+{
+    struct host_queue *queue = queue_handle;
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += wait_time_ms / 1000;
+    deadline.tv_nsec += (wait_time_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&queue->mutex);
+    while (!queue->count) {
+        if (wait_time_ms == IOT_OS_MAX_DELAY) {
+            pthread_cond_wait(&queue->cond, &queue->mutex);
+        } else if (!wait_time_ms || pthread_cond_timedwait(&queue->cond, &queue->mutex, &deadline)) {
+            pthread_mutex_unlock(&queue->mutex);
+            return IOT_OS_FALSE;
+        }
+    }
+    memcpy(data, queue->buf + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_mutex_unlock(&queue->mutex);
+    return IOT_OS_TRUE;
+}
+
+int iot_os_mutex_init(iot_os_mutex *mutex)
+{
+    pthread_mutex_t *m = malloc(sizeof(*m));
+
+    if (!m) {
+        return IOT_OS_FALSE;
+    }
+    pthread_mutex_init(m, NULL);
+    mutex->sem = m;
+    return IOT_OS_TRUE;
+}
+
+int iot_os_mutex_lock(iot_os_mutex *mutex)
+{
+    pthread_mutex_lock(mutex->sem);
+    return IOT_OS_TRUE;
+}
+
+int iot_os_mutex_unlock(iot_os_mutex *mutex)
+{
+    pthread_mutex_unlock(mutex->sem);
+    return IOT_OS_TRUE;
+}
+
+void iot_os_mutex_destroy(iot_os_mutex *mutex)
+{
+    if (mutex->sem) {
+        pthread_mutex_destroy(mutex->sem);
+        free(mutex->sem);
+        mutex->sem = NULL;
+    }
+}
+
+void iot_os_delay(unsigned int delay_ms)
+{
+    usleep(delay_ms * 1000);
+}
+
+void iot_os_timer_count_ms(iot_os_timer timer, unsigned int timeout_ms)
+{
+    *(uint64_t *)timer = _now_ms() + timeout_ms;
+}
+
+unsigned int iot_os_timer_left_ms(iot_os_timer timer)
+{
+    uint64_t now = _now_ms();
+    uint64_t deadline = *(uint64_t *)timer;
+
+    return deadline > now ? (unsigned int)(deadline - now) : 0;
+}
+
+char iot_os_timer_isexpired(iot_os_timer timer)
+{
+    return iot_os_timer_left_ms(timer) == 0;
+}
+
+int iot_os_timer_init(iot_os_timer *timer)
+{
+    *timer = calloc(1, sizeof(uint64_t));
+    return *timer ? IOT_OS_TRUE : IOT_OS_FALSE;
+}
+
+void iot_os_timer_destroy(iot_os_timer *timer)
+{
+    free(*timer);
+    *timer = NULL;
+}
+
+IOT_CAP_HANDLE *st_cap_handle_init(IOT_CTX *iot_ctx, const char *component, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data)
+{
+    struct host_handle *handle;
+
+    pthread_mutex_lock(&host_mutex);
+    if (host_handle_num >= HOST_MAX_HANDLES) {
+        pthread_mutex_unlock(&host_mutex);
+        return NULL;
+    }
+    handle = &host_handle[host_handle_num++];
+    handle->component = component;
+    handle->capability = capability;
+    handle->init_cb = init_cb;
+    handle->init_usr_data = init_usr_data;
+    pthread_mutex_unlock(&host_mutex);
+
+    return handle;
+}
+
+int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data)
+{
+    struct host_handle *handle = cap_handle;
+
+    if (handle->cmd_num >= HOST_MAX_CMDS) {
+        return -1;
+    }
+    handle->cmd_type[handle->cmd_num] = cmd_type;
+    handle->cmd_cb[handle->cmd_num] = cmd_cb;
+    handle->cmd_usr_data[handle->cmd_num] = usr_data;
+    handle->cmd_num++;
+    return 0;
+}
+
+IOT_EVENT *st_cap_create_attr(IOT_CAP_HANDLE *cap_handle, const char *attribute, iot_cap_val_t *value,
+        const char *unit, const char *data)
+{
+    host_event_t *event = calloc(1, sizeof(*event));
+
+    if (!event) {
+        return NULL;
+    }
+    event->handle = cap_handle;
+    snprintf(event->name, sizeof(event->name), "%s", attribute);
+    event->value = *value;
+    if (value->type == IOT_CAP_VAL_TYPE_STRING || value->type == IOT_CAP_VAL_TYPE_JSON_OBJECT) {
+        snprintf(event->text, sizeof(event->text), "%s", value->string);
+        event->value.string = event->text;
+    } else if (value->type == IOT_CAP_VAL_TYPE_STR_ARRAY) {
+        event->value.strings = NULL;
+    }
+
+    pthread_mutex_lock(&host_mutex);
+    host_live++;
+    host_created++;
+    pthread_mutex_unlock(&host_mutex);
+    return event;
+}
+
+void st_cap_free_attr(IOT_EVENT *event)
+{
+    if (!event) {
+        return;
+    }
+    pthread_mutex_lock(&host_mutex);
+    host_live--;
+    pthread_mutex_unlock(&host_mutex);
+    free(event);
+}
+
+int st_cap_send_attr(IOT_EVENT *event[], uint8_t evt_num)
+{
+    host_event_t *sent;
+    int sequence_no;
+    int i;
+
+    pthread_mutex_lock(&host_mutex);
+    if (host_send_fail) {
+        pthread_mutex_unlock(&host_mutex);
+        return -1;
+    }
+    sequence_no = ++host_sequence_no;
+    host_message_num++;
+    for (i = 0; i < evt_num; i++) {
+        if (host_sent_num < HOST_SENT_SIZE) {
+            sent = &host_sent[host_sent_num++];
+            *sent = *(host_event_t *)event[i];
+            if (sent->value.type == IOT_CAP_VAL_TYPE_STRING || sent->value.type == IOT_CAP_VAL_TYPE_JSON_OBJECT) {
+                sent->value.string = sent->text;
+            }
+            sent->sequence_no = sequence_no;
+        }
+    }
+    pthread_mutex_unlock(&host_mutex);
+    return sequence_no;
+}
+
+int host_sent_messages(void)
+{
+    return host_message_num;
+}
+
+int host_sent_events(void)
+{
+    return host_sent_num;
+}
+
+const host_event_t *host_sent_event(int index)
+{
+    if (index < 0 || index >= host_sent_num) {
+        return NULL;
+    }
+    return &host_sent[index];
+}
+
+const host_event_t *host_last_sent(IOT_CAP_HANDLE *handle, const char *name)
+{
+    int i;
+
+    for (i = host_sent_num - 1; i >= 0; i--) {
+        if (host_sent[i].handle == handle && !strcmp(host_sent[i].name, name)) {
+            return &host_sent[i];
+        }
+    }
+    return NULL;
+}
+
+void host_reset_sent(void)
+{
+    pthread_mutex_lock(&host_mutex);
+    host_sent_num = 0;
+    host_message_num = 0;
+    pthread_mutex_unlock(&host_mutex);
+}
+
+int host_live_events(void)
+{
+    return host_live;
+}
+
+int host_created_events(void)
+{
+    return host_created;
+}
+
+void host_set_send_fail(int fail)
+{
+    host_send_fail = fail;
+}
+
+void host_run_init_cb(void)
+{
+    int i;
+
+    for (i = 0; i < host_handle_num; i++) {
+        if (host_handle[i].init_cb) {
+            host_handle[i].init_cb(&host_handle[i], host_handle[i].init_usr_data);
+        }
+    }
+}
+
+int host_fire_cmd(IOT_CAP_HANDLE *cap_handle, const char *cmd_type, iot_cap_cmd_data_t *cmd_data)
+{
+    struct host_handle *handle = cap_handle;
+    int i;
+
+    for (i = 0; i < handle->cmd_num; i++) {
+        if (!strcmp(handle->cmd_type[i], cmd_type)) {
+            handle->cmd_cb[i](cap_handle, cmd_data, handle->cmd_usr_data[i]);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/* Heap of the FreeRTOS port which cJSON of iot-core allocates from */
+static int host_json_allocs;
+
+void *pvPortMalloc(size_t size)
+{
+    __atomic_add_fetch(&host_json_allocs, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+void *pvPortRealloc(void *pv, size_t size)
+{
+    __atomic_add_fetch(&host_json_allocs, 1, __ATOMIC_RELAXED);
+    return realloc(pv, size);
+}
+
+void vPortFree(void *pv)
+{
+    free(pv);
+}
+
+int host_json_alloc_count(void)
+{
+    return __atomic_load_n(&host_json_allocs, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,71 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _HOST_STUB_H_
+#define _HOST_STUB_H_
+
+#include <stdio.h>
+
+#include "st_dev.h"
+
+/* Events kept of the attributes given to st_cap_send_attr() */
+#define HOST_SENT_SIZE 1024
+
+typedef struct host_event {
+    IOT_CAP_HANDLE *handle;
+    char name[32];
+    iot_cap_val_t value;        /* string and json_object point to text */
+    char text[64];
+    int sequence_no;
+} host_event_t;
+
+/* st_cap_send_attr() calls and events so far, and the events in sending order */
+int host_sent_messages(void);
+int host_sent_events(void);
+const host_event_t *host_sent_event(int index);
+/* Last event sent of an attribute, or NULL */
+const host_event_t *host_last_sent(IOT_CAP_HANDLE *handle, const char *name);
+void host_reset_sent(void);
+
+/* Events created and not yet freed */
+int host_live_events(void);
+/* st_cap_create_attr() calls so far, one allocation here and more in iot-core, which copies the strings */
+int host_created_events(void);
+
+/* Make the next st_cap_send_attr() calls fail */
+void host_set_send_fail(int fail);
+
+/* Run the init callback of every handle, like iot-core does on connection */
+void host_run_init_cb(void);
+/* Deliver a command to the callback registered for it, returns -1 if none */
+int host_fire_cmd(IOT_CAP_HANDLE *handle, const char *cmd_type, iot_cap_cmd_data_t *cmd_data);
+
+/* Allocations made by cJSON so far */
+int host_json_alloc_count(void);
+
+extern int host_failures;
+
+#define HOST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            host_failures++; \
+        } \
+    } while (0)
+
+#endif /* _HOST_STUB_H_ */
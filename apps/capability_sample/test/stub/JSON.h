@@ -0,0 +1,50 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host copy of iot-core's JSON.h. cJSON itself is taken by the Makefile from
+ * the copy of the emw3166 port in patches/.
+ */
+
+#ifndef _JSON_H_
+#define _JSON_H_
+
+#include <stdlib.h>
+
+#include "cJSON.h"
+
+#define JSON_H cJSON
+
+#define JSON_PARSE cJSON_Parse
+#define JSON_PRINT cJSON_PrintUnformatted
+#define JSON_DELETE cJSON_Delete
+#define JSON_FREE free
+#define JSON_DUPLICATE cJSON_Duplicate
+#define JSON_CREATE_OBJECT cJSON_CreateObject
+#define JSON_CREATE_ARRAY cJSON_CreateArray
+#define JSON_CREATE_NUMBER cJSON_CreateNumber
+#define JSON_CREATE_STRING cJSON_CreateString
+#define JSON_ADD_ITEM_TO_ARRAY cJSON_AddItemToArray
+#define JSON_ADD_ITEM_TO_OBJECT cJSON_AddItemToObject
+#define JSON_GET_OBJECT_ITEM cJSON_GetObjectItem
+#define JSON_GET_ARRAY_SIZE cJSON_GetArraySize
+#define JSON_GET_ARRAY_ITEM cJSON_GetArrayItem
+#define JSON_IS_NUMBER cJSON_IsNumber
+#define JSON_IS_STRING cJSON_IsString
+
+#endif /* _JSON_H_ */
@@ -0,0 +1,103 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host copy of iot-core's iot_caps_helper_button.h */
+#ifndef _IOT_CAPS_HELPER_BUTTON_
+#define _IOT_CAPS_HELPER_BUTTON_
+
+#include "iot_caps_helper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CAP_ENUM_BUTTON_SUPPORTEDBUTTONVALUES_VALUE_ALPHA,
+    CAP_ENUM_BUTTON_SUPPORTEDBUTTONVALUES_VALUE_BETA,
+    CAP_ENUM_BUTTON_SUPPORTEDBUTTONVALUES_VALUE_GAMMA,
+    CAP_ENUM_BUTTON_SUPPORTEDBUTTONVALUES_VALUE_MAX
+};
+
+enum {
+    CAP_ENUM_BUTTON_BUTTON_VALUE_ALPHA,
+    CAP_ENUM_BUTTON_BUTTON_VALUE_BETA,
+    CAP_ENUM_BUTTON_BUTTON_VALUE_GAMMA,
+    CAP_ENUM_BUTTON_BUTTON_VALUE_MAX
+};
+
+const static struct iot_caps_button {
+    const char *id;
+    const struct button_attr_supportedButtonValues {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_BUTTON_SUPPORTEDBUTTONVALUES_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_supportedButtonValues;
+    const struct button_attr_button {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_BUTTON_BUTTON_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_button;
+    const struct button_attr_numberOfButtons {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const int min;
+        const int max;
+    } attr_numberOfButtons;
+} caps_helper_button = {
+    .id = "button",
+    .attr_supportedButtonValues = {
+        .name = "supportedButtonValues",
+        .property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_button = {
+        .name = "button",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_numberOfButtons = {
+        .name = "numberOfButtons",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_INTEGER,
+        .min = 0,
+        .max = 100,
+    },
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IOT_CAPS_HELPER_BUTTON_ */
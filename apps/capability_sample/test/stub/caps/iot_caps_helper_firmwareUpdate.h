@@ -0,0 +1,133 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host copy of iot-core's iot_caps_helper_firmwareUpdate.h */
+#ifndef _IOT_CAPS_HELPER_FIRMWAREUPDATE_
+#define _IOT_CAPS_HELPER_FIRMWAREUPDATE_
+
+#include "iot_caps_helper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_ALPHA,
+    CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_BETA,
+    CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_GAMMA,
+    CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_MAX
+};
+
+enum {
+    CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_ALPHA,
+    CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_BETA,
+    CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_GAMMA,
+    CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_MAX
+};
+
+const static struct iot_caps_firmwareUpdate {
+    const char *id;
+    const struct firmwareUpdate_attr_lastUpdateStatus {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_FIRMWAREUPDATE_LASTUPDATESTATUS_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_lastUpdateStatus;
+    const struct firmwareUpdate_attr_state {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_FIRMWAREUPDATE_STATE_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_state;
+    const struct firmwareUpdate_attr_currentVersion {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_currentVersion;
+    const struct firmwareUpdate_attr_lastUpdateTime {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_lastUpdateTime;
+    const struct firmwareUpdate_attr_availableVersion {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_availableVersion;
+    const struct firmwareUpdate_attr_lastUpdateStatusReason {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_lastUpdateStatusReason;
+    const struct firmwareUpdate_cmd_checkForFirmwareUpdate { const char* name; } cmd_checkForFirmwareUpdate;
+    const struct firmwareUpdate_cmd_updateFirmware { const char* name; } cmd_updateFirmware;
+} caps_helper_firmwareUpdate = {
+    .id = "firmwareUpdate",
+    .attr_lastUpdateStatus = {
+        .name = "lastUpdateStatus",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_state = {
+        .name = "state",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_currentVersion = {
+        .name = "currentVersion",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .attr_lastUpdateTime = {
+        .name = "lastUpdateTime",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .attr_availableVersion = {
+        .name = "availableVersion",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .attr_lastUpdateStatusReason = {
+        .name = "lastUpdateStatusReason",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .cmd_checkForFirmwareUpdate = { .name = "checkForFirmwareUpdate" },
+    .cmd_updateFirmware = { .name = "updateFirmware" },
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IOT_CAPS_HELPER_FIRMWAREUPDATE_ */
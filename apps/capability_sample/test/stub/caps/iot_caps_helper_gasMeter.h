@@ -0,0 +1,139 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host copy of iot-core's iot_caps_helper_gasMeter.h */
+#ifndef _IOT_CAPS_HELPER_GASMETER_
+#define _IOT_CAPS_HELPER_GASMETER_
+
+#include "iot_caps_helper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CAP_ENUM_GASMETER_GASMETER_UNIT_U1,
+    CAP_ENUM_GASMETER_GASMETER_UNIT_U2,
+    CAP_ENUM_GASMETER_GASMETER_UNIT_MAX
+};
+
+enum {
+    CAP_ENUM_GASMETER_GASMETERVOLUME_UNIT_U1,
+    CAP_ENUM_GASMETER_GASMETERVOLUME_UNIT_U2,
+    CAP_ENUM_GASMETER_GASMETERVOLUME_UNIT_MAX
+};
+
+const static struct iot_caps_gasMeter {
+    const char *id;
+    const struct gasMeter_attr_gasMeterTime {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_gasMeterTime;
+    const struct gasMeter_attr_gasMeter {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *units[CAP_ENUM_GASMETER_GASMETER_UNIT_MAX];
+        const char *unit_u1;
+        const char *unit_u2;
+        const double min;
+        const double max;
+    } attr_gasMeter;
+    const struct gasMeter_attr_gasMeterCalorific {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const double min;
+        const double max;
+    } attr_gasMeterCalorific;
+    const struct gasMeter_attr_gasMeterVolume {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *units[CAP_ENUM_GASMETER_GASMETERVOLUME_UNIT_MAX];
+        const char *unit_u1;
+        const char *unit_u2;
+        const double min;
+        const double max;
+    } attr_gasMeterVolume;
+    const struct gasMeter_attr_gasMeterPrecision {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_gasMeterPrecision;
+    const struct gasMeter_attr_gasMeterConversion {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const double min;
+        const double max;
+    } attr_gasMeterConversion;
+} caps_helper_gasMeter = {
+    .id = "gasMeter",
+    .attr_gasMeterTime = {
+        .name = "gasMeterTime",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .attr_gasMeter = {
+        .name = "gasMeter",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_NUMBER,
+        .units = {"u1", "u2"},
+        .unit_u1 = "u1",
+        .unit_u2 = "u2",
+        .min = 0,
+        .max = 100,
+    },
+    .attr_gasMeterCalorific = {
+        .name = "gasMeterCalorific",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_NUMBER,
+        .min = 0,
+        .max = 100,
+    },
+    .attr_gasMeterVolume = {
+        .name = "gasMeterVolume",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_NUMBER,
+        .units = {"u1", "u2"},
+        .unit_u1 = "u1",
+        .unit_u2 = "u2",
+        .min = 0,
+        .max = 100,
+    },
+    .attr_gasMeterPrecision = {
+        .name = "gasMeterPrecision",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_OBJECT,
+    },
+    .attr_gasMeterConversion = {
+        .name = "gasMeterConversion",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_NUMBER,
+        .min = 0,
+        .max = 100,
+    },
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IOT_CAPS_HELPER_GASMETER_ */
@@ -0,0 +1,170 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host copy of iot-core's iot_caps_helper_ovenOperatingState.h */
+#ifndef _IOT_CAPS_HELPER_OVENOPERATINGSTATE_
+#define _IOT_CAPS_HELPER_OVENOPERATINGSTATE_
+
+#include "iot_caps_helper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_ALPHA,
+    CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_BETA,
+    CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_GAMMA,
+    CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_MAX
+};
+
+enum {
+    CAP_ENUM_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES_VALUE_ALPHA,
+    CAP_ENUM_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES_VALUE_BETA,
+    CAP_ENUM_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES_VALUE_GAMMA,
+    CAP_ENUM_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES_VALUE_MAX
+};
+
+enum {
+    CAP_ENUM_OVENOPERATINGSTATE_PROGRESS_UNIT_U1,
+    CAP_ENUM_OVENOPERATINGSTATE_PROGRESS_UNIT_U2,
+    CAP_ENUM_OVENOPERATINGSTATE_PROGRESS_UNIT_MAX
+};
+
+enum {
+    CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_ALPHA,
+    CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_BETA,
+    CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_GAMMA,
+    CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_MAX
+};
+
+const static struct iot_caps_ovenOperatingState {
+    const char *id;
+    const struct ovenOperatingState_attr_ovenJobState {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_OVENOPERATINGSTATE_OVENJOBSTATE_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_ovenJobState;
+    const struct ovenOperatingState_attr_completionTime {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+    } attr_completionTime;
+    const struct ovenOperatingState_attr_supportedMachineStates {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_OVENOPERATINGSTATE_SUPPORTEDMACHINESTATES_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_supportedMachineStates;
+    const struct ovenOperatingState_attr_progress {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *units[CAP_ENUM_OVENOPERATINGSTATE_PROGRESS_UNIT_MAX];
+        const char *unit_u1;
+        const char *unit_u2;
+        const int min;
+        const int max;
+    } attr_progress;
+    const struct ovenOperatingState_attr_operationTime {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const int min;
+        const int max;
+    } attr_operationTime;
+    const struct ovenOperatingState_attr_machineState {
+        const char *name;
+        const unsigned char property;
+        const unsigned char valueType;
+        const char *values[CAP_ENUM_OVENOPERATINGSTATE_MACHINESTATE_VALUE_MAX];
+        const char *value_alpha;
+        const char *value_beta;
+        const char *value_gamma;
+    } attr_machineState;
+    const struct ovenOperatingState_cmd_start { const char* name; } cmd_start;
+    const struct ovenOperatingState_cmd_stop { const char* name; } cmd_stop;
+    const struct ovenOperatingState_cmd_setMachineState { const char* name; } cmd_setMachineState;
+} caps_helper_ovenOperatingState = {
+    .id = "ovenOperatingState",
+    .attr_ovenJobState = {
+        .name = "ovenJobState",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_completionTime = {
+        .name = "completionTime",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+    },
+    .attr_supportedMachineStates = {
+        .name = "supportedMachineStates",
+        .property = ATTR_SET_VALUE_REQUIRED | ATTR_SET_VALUE_ARRAY,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .attr_progress = {
+        .name = "progress",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_INTEGER,
+        .units = {"u1", "u2"},
+        .unit_u1 = "u1",
+        .unit_u2 = "u2",
+        .min = 0,
+        .max = 100,
+    },
+    .attr_operationTime = {
+        .name = "operationTime",
+        .property = ATTR_SET_VALUE_MIN | ATTR_SET_VALUE_MAX | ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_INTEGER,
+        .min = 0,
+        .max = 100,
+    },
+    .attr_machineState = {
+        .name = "machineState",
+        .property = ATTR_SET_VALUE_REQUIRED,
+        .valueType = VALUE_TYPE_STRING,
+        .values = {"alpha", "beta", "gamma"},
+        .value_alpha = "alpha",
+        .value_beta = "beta",
+        .value_gamma = "gamma",
+    },
+    .cmd_start = { .name = "start" },
+    .cmd_stop = { .name = "stop" },
+    .cmd_setMachineState = { .name = "setMachineState" },
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IOT_CAPS_HELPER_OVENOPERATINGSTATE_ */
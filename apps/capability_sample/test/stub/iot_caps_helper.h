@@ -0,0 +1,31 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host copy of iot-core's iot_caps_helper.h */
+#ifndef _IOT_CAPS_HELPER_
+#define _IOT_CAPS_HELPER_
+#define VALUE_TYPE_INTEGER 1
+#define VALUE_TYPE_NUMBER 2
+#define VALUE_TYPE_STRING 3
+#define VALUE_TYPE_OBJECT 4
+#define VALUE_TYPE_BOOLEAN 5
+#define ATTR_SET_VALUE_MIN (1 << 0)
+#define ATTR_SET_VALUE_MAX (1 << 1)
+#define ATTR_SET_VALUE_REQUIRED (1 << 2)
+#define ATTR_SET_VALUE_ARRAY (1 << 3)
+#endif
@@ -0,0 +1,62 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host stub of iot-core's iot_os_util.h, implemented with pthreads by host_stub.c */
+
+#ifndef _IOT_OS_UTIL_H_
+#define _IOT_OS_UTIL_H_
+
+#include <stdbool.h>
+
+typedef void *iot_os_thread;
+typedef struct {
+    void *sem;
+} iot_os_mutex;
+typedef void iot_os_queue;
+typedef void *iot_os_timer;
+
+#define IOT_OS_TRUE 1
+#define IOT_OS_FALSE 0
+#define IOT_OS_MAX_DELAY 0xFFFFFFFF
+
+int iot_os_thread_create(void *thread_function, const char *name, int stack_size,
+        void *data, int priority, iot_os_thread *thread_handle);
+void iot_os_thread_delete(iot_os_thread thread_handle);
+void iot_os_thread_yield(void);
+int iot_os_thread_get_current_handle(iot_os_thread *thread_handle);
+
+iot_os_queue *iot_os_queue_create(int queue_length, int item_size);
+int iot_os_queue_reset(iot_os_queue *queue_handle);
+void iot_os_queue_delete(iot_os_queue *queue_handle);
+int iot_os_queue_send(iot_os_queue *queue_handle, void *data, unsigned int wait_time_ms);
+int iot_os_queue_receive(iot_os_queue *queue_handle, void *data, unsigned int wait_time_ms);
+
+int iot_os_mutex_init(iot_os_mutex *mutex);
+int iot_os_mutex_lock(iot_os_mutex *mutex);
+int iot_os_mutex_unlock(iot_os_mutex *mutex);
+void iot_os_mutex_destroy(iot_os_mutex *mutex);
+
+void iot_os_delay(unsigned int delay_ms);
+
+void iot_os_timer_count_ms(iot_os_timer timer, unsigned int timeout_ms);
+unsigned int iot_os_timer_left_ms(iot_os_timer timer);
+char iot_os_timer_isexpired(iot_os_timer timer);
+int iot_os_timer_init(iot_os_timer *timer);
+void iot_os_timer_destroy(iot_os_timer *timer);
+
+#endif /* _IOT_OS_UTIL_H_ */
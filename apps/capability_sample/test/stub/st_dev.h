@@ -0,0 +1,74 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host stub of iot-core's st_dev.h, only what the caps modules use */
+
+#ifndef _ST_DEV_H_
+#define _ST_DEV_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef void IOT_CTX;
+typedef void IOT_CAP_HANDLE;
+typedef void IOT_EVENT;
+
+#define MAX_CMD_ARG (5)
+
+typedef enum iot_cap_val_type {
+    IOT_CAP_VAL_TYPE_UNKNOWN = -1,
+    IOT_CAP_VAL_TYPE_INTEGER,
+    IOT_CAP_VAL_TYPE_NUMBER,
+    IOT_CAP_VAL_TYPE_INT_OR_NUM,
+    IOT_CAP_VAL_TYPE_STRING,
+    IOT_CAP_VAL_TYPE_STR_ARRAY,
+    IOT_CAP_VAL_TYPE_JSON_OBJECT,
+    IOT_CAP_VAL_TYPE_BOOLEAN,
+} iot_cap_val_type_t;
+
+typedef struct {
+    iot_cap_val_type_t type;
+    uint8_t str_num;
+    union {
+        int integer;
+        double number;
+        char *string;
+        char **strings;
+        char *json_object;
+        bool boolean;
+    };
+} iot_cap_val_t;
+
+typedef struct {
+    uint8_t num_args;
+    iot_cap_val_t cmd_data[MAX_CMD_ARG];
+} iot_cap_cmd_data_t;
+
+typedef void (*st_cap_init_cb)(IOT_CAP_HANDLE *cap_handle, void *init_usr_data);
+typedef void (*st_cap_cmd_cb)(IOT_CAP_HANDLE *cap_handle, iot_cap_cmd_data_t *cmd_data, void *usr_data);
+
+IOT_CAP_HANDLE *st_cap_handle_init(IOT_CTX *iot_ctx, const char *component, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data);
+int st_cap_cmd_set_cb(IOT_CAP_HANDLE *cap_handle, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data);
+IOT_EVENT *st_cap_create_attr(IOT_CAP_HANDLE *cap_handle, const char *attribute, iot_cap_val_t *value,
+        const char *unit, const char *data);
+void st_cap_free_attr(IOT_EVENT *event);
+int st_cap_send_attr(IOT_EVENT *event[], uint8_t evt_num);
+
+#endif /* _ST_DEV_H_ */
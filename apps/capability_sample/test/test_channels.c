@@ -0,0 +1,112 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_switch.h"
+#include "caps_switchLevel.h"
+#include "host_stub.h"
+
+/* a 16-channel dimmer has twice as many handles as CAPS_SENDER_MAX_HANDLES keeps */
+#define CHANNELS 16
+
+static int ctx;
+static const char *components[CHANNELS];
+static char component_names[CHANNELS][16];
+static int level_ch = -1;
+
+static void _level_cb(caps_switchLevel_n_data_t *caps_data, int ch)
+{
+    level_ch = ch;
+}
+
+static void test_dimmer(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    caps_switch_n_data_t *sw;
+    caps_switchLevel_n_data_t *level;
+    int ch;
+
+    sw = caps_switch_initialize_n(&ctx, components, CHANNELS, NULL, NULL);
+    level = caps_switchLevel_initialize_n(&ctx, components, CHANNELS, NULL, NULL);
+    HOST_CHECK(sw && level);
+    if (!sw || !level)
+        return;
+
+    for (ch = 0; ch < CHANNELS; ch++) {
+        HOST_CHECK(sw->handle[ch] && level->handle[ch] && sw->handle[ch] != level->handle[ch]);
+        HOST_CHECK(caps_sender_find_handle(components[ch], "switchLevel") == level->handle[ch]);
+    }
+
+    /* a command reaches the channel of its handle */
+    level->cmd_setLevel_usr_cb = _level_cb;
+    cmd_data.num_args = 1;
+    cmd_data.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    cmd_data.cmd_data[0].integer = 40;
+    HOST_CHECK(host_fire_cmd(level->handle[CHANNELS - 1], "setLevel", &cmd_data) == 0);
+    HOST_CHECK(level_ch == CHANNELS - 1);
+    HOST_CHECK(level->get_level_value(level, CHANNELS - 1) == 40);
+
+    host_reset_sent();
+    level->attr_level_send_all(level);
+    HOST_CHECK(host_sent_messages() == 1 && host_sent_events() == CHANNELS);
+
+    caps_switch_deinitialize_n(sw);
+    caps_switchLevel_deinitialize_n(level);
+}
+
+/* every channel is attached or none */
+static void test_all_or_nothing(void)
+{
+    caps_switch_data_t *single;
+    caps_switch_n_data_t *sw;
+
+    single = caps_switch_initialize(&ctx, components[CHANNELS / 2], NULL, NULL);
+    HOST_CHECK(single != NULL);
+    HOST_CHECK(caps_switch_initialize_n(&ctx, components, CHANNELS, NULL, NULL) == NULL);
+
+    /* the channels before the one in use were left detached */
+    caps_switch_deinitialize(single);
+    single = caps_switch_initialize(&ctx, components[0], NULL, NULL);
+    HOST_CHECK(single != NULL);
+    caps_switch_deinitialize(single);
+
+    sw = caps_switch_initialize_n(&ctx, components, CHANNELS, NULL, NULL);
+    HOST_CHECK(sw != NULL);
+    caps_switch_deinitialize_n(sw);
+}
+
+int main(void)
+{
+    int ch;
+
+    for (ch = 0; ch < CHANNELS; ch++) {
+        snprintf(component_names[ch], sizeof(component_names[ch]), "ch%d", ch);
+        components[ch] = component_names[ch];
+    }
+
+    test_dimmer();
+    test_all_or_nothing();
+    HOST_CHECK(host_live_events() == 0);
+
+    printf("test_channels: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_cmd.h"
+#include "caps_switch.h"
+#include "caps_switchLevel.h"
+#include "caps_colorControl.h"
+#include "host_stub.h"
+
+#define WINDOW_MS 50
+#define QUEUE_DEPTH 16
+
+static int ctx;
+static caps_switch_data_t *sw;
+static caps_switchLevel_data_t *level;
+static caps_colorControl_data_t *color;
+
+static volatile int batch_num;
+static int batch_size[4];
+static char batch_cmd[CAPS_CMD_BATCH_MAX][16];
+static IOT_CAP_HANDLE *batch_handle[CAPS_CMD_BATCH_MAX];
+static uint64_t batch_us;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void _batch_cb(caps_cmd_batch_item_t *items, int item_num, void *usr_data)
+{
+    int i;
+
+    if (batch_num < 4)
+        batch_size[batch_num] = item_num;
+    if (batch_num == 0) {
+        for (i = 0; i < item_num; i++) {
+            snprintf(batch_cmd[i], sizeof(batch_cmd[i]), "%s", items[i].cmd_type);
+            batch_handle[i] = items[i].handle;
+        }
+    }
+    batch_num++;
+    batch_us = now_us();
+}
+
+static int wait_batches(int num)
+{
+    int ms;
+
+    for (ms = 0; ms < 2000; ms++) {
+        if (batch_num >= num)
+            return 1;
+        iot_os_delay(1);
+    }
+    return 0;
+}
+
+static void reset(void)
+{
+    batch_num = 0;
+    memset(batch_size, 0, sizeof(batch_size));
+    caps_cmd_reset_stats();
+    host_reset_sent();
+}
+
+/* a scene sets switch, level and hue in one message */
+static void test_scene(void)
+{
+    iot_cap_cmd_data_t on = { 0 };
+    iot_cap_cmd_data_t set_level = { 0 };
+    iot_cap_cmd_data_t set_hue = { 0 };
+    caps_cmd_stats_t stats;
+
+    reset();
+    set_level.num_args = 1;
+    set_level.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    set_level.cmd_data[0].integer = 70;
+    set_hue.num_args = 1;
+    set_hue.cmd_data[0].type = IOT_CAP_VAL_TYPE_NUMBER;
+    set_hue.cmd_data[0].number = 33;
+
+    HOST_CHECK(host_fire_cmd(sw->handle, "on", &on) == 0);
+    HOST_CHECK(host_fire_cmd(level->handle, "setLevel", &set_level) == 0);
+    HOST_CHECK(host_fire_cmd(color->handle, "setHue", &set_hue) == 0);
+    HOST_CHECK(wait_batches(1));
+    iot_os_delay(WINDOW_MS);
+
+    HOST_CHECK(batch_num == 1 && batch_size[0] == 3);
+    HOST_CHECK(!strcmp(batch_cmd[0], "on") && batch_handle[0] == sw->handle);
+    HOST_CHECK(!strcmp(batch_cmd[1], "setLevel") && batch_handle[1] == level->handle);
+    HOST_CHECK(!strcmp(batch_cmd[2], "setHue") && batch_handle[2] == color->handle);
+
+    /* the wrappers updated their attributes before batch_cb, and the events went out together */
+    HOST_CHECK(level->get_level_value(level) == 70);
+    HOST_CHECK(color->get_hue_value(color) == 33);
+    HOST_CHECK(host_sent_messages() == 1 && host_sent_events() == 3);
+
+    caps_cmd_get_stats(&stats);
+    HOST_CHECK(stats.batch_count == 1 && stats.max_batch_size == 3 && stats.executed_count == 3);
+}
+
+/* a lone command is a batch of one, handed over after the window */
+static void test_single(void)
+{
+    iot_cap_cmd_data_t set_level = { 0 };
+    caps_cmd_stats_t stats;
+    uint64_t start;
+
+    reset();
+    set_level.num_args = 1;
+    set_level.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    set_level.cmd_data[0].integer = 20;
+
+    start = now_us();
+    HOST_CHECK(host_fire_cmd(level->handle, "setLevel", &set_level) == 0);
+    HOST_CHECK(wait_batches(1));
+    printf("single command reached batch_cb after %u us\n", (unsigned int)(batch_us - start));
+    HOST_CHECK(batch_us - start >= WINDOW_MS * 1000);
+
+    iot_os_delay(WINDOW_MS);
+    HOST_CHECK(batch_num == 1 && batch_size[0] == 1);
+    HOST_CHECK(level->get_level_value(level) == 20);
+    HOST_CHECK(host_sent_messages() == 1 && host_sent_events() == 1);
+
+    caps_cmd_get_stats(&stats);
+    HOST_CHECK(stats.batch_count == 1 && stats.max_batch_size == 1);
+}
+
+/* commands beyond CAPS_CMD_BATCH_MAX go to the next batch */
+static void test_batch_max(void)
+{
+    iot_cap_cmd_data_t set_level = { 0 };
+    int i;
+
+    reset();
+    set_level.num_args = 1;
+    set_level.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    for (i = 0; i < CAPS_CMD_BATCH_MAX + 2; i++) {
+        set_level.cmd_data[0].integer = i;
+        HOST_CHECK(host_fire_cmd(level->handle, "setLevel", &set_level) == 0);
+    }
+    HOST_CHECK(wait_batches(2));
+    iot_os_delay(WINDOW_MS);
+
+    HOST_CHECK(batch_num == 2);
+    HOST_CHECK(batch_size[0] == CAPS_CMD_BATCH_MAX && batch_size[1] == 2);
+    HOST_CHECK(level->get_level_value(level) == CAPS_CMD_BATCH_MAX + 1);
+}
+
+int main(void)
+{
+    sw = caps_switch_initialize(&ctx, "main", NULL, NULL);
+    level = caps_switchLevel_initialize(&ctx, "main", NULL, NULL);
+    color = caps_colorControl_initialize(&ctx, "main", NULL, NULL);
+    HOST_CHECK(sw && level && color);
+    if (!sw || !level || !color)
+        return 1;
+
+    HOST_CHECK(caps_cmd_set_batch_cb(_batch_cb, WINDOW_MS, NULL) == 0);
+    HOST_CHECK(caps_cmd_executor_start(QUEUE_DEPTH, CAPS_CMD_TASK_PRIORITY) == 0);
+
+    test_scene();
+    test_single();
+    test_batch_max();
+
+    printf("test_cmd_batch: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_cmd.h"
+#include "caps_switch.h"
+#include "caps_switchLevel.h"
+#include "caps_colorControl.h"
+#include "host_stub.h"
+
+#define COMMANDS 100
+
+static int ctx;
+static caps_switch_data_t *sw;
+static caps_switchLevel_data_t *level;
+static caps_colorControl_data_t *color;
+
+static volatile int hold;
+static volatile int holding;
+static int level_actuated;
+static int level_last = -1;
+static int hue_actuated;
+static double hue_last = -1;
+
+/* keeps the executor busy, so the commands behind it wait in the queue */
+static void _hold_cb(caps_switch_data_t *caps_data)
+{
+    holding = 1;
+    while (hold)
+        iot_os_delay(1);
+    holding = 0;
+}
+
+static void _level_cb(caps_switchLevel_data_t *caps_data)
+{
+    level_actuated++;
+    level_last = caps_data->get_level_value(caps_data);
+}
+
+static void _hue_cb(caps_colorControl_data_t *caps_data)
+{
+    hue_actuated++;
+    hue_last = caps_data->get_hue_value(caps_data);
+}
+
+static int wait_executed(unsigned int count)
+{
+    caps_cmd_stats_t stats;
+    int ms;
+
+    for (ms = 0; ms < 2000; ms++) {
+        caps_cmd_get_stats(&stats);
+        if (stats.executed_count >= count)
+            return 1;
+        iot_os_delay(1);
+    }
+    return 0;
+}
+
+static void block_executor(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    int ms;
+
+    hold = 1;
+    HOST_CHECK(host_fire_cmd(sw->handle, "on", &cmd_data) == 0);
+    for (ms = 0; ms < 2000 && !holding; ms++)
+        iot_os_delay(1);
+    HOST_CHECK(holding);
+}
+
+static int count_sent(IOT_CAP_HANDLE *handle, const char *name)
+{
+    const host_event_t *event;
+    int count = 0;
+    int i;
+
+    for (i = 0; (event = host_sent_event(i)) != NULL; i++) {
+        if (event->handle == handle && !strcmp(event->name, name))
+            count++;
+    }
+    return count;
+}
+
+/* a slider drag of COMMANDS setLevel while the executor is busy */
+static void test_set_level(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    caps_cmd_stats_t stats;
+    const host_event_t *event;
+    int i;
+
+    caps_cmd_reset_stats();
+    block_executor();
+    host_reset_sent();
+
+    cmd_data.num_args = 1;
+    cmd_data.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    for (i = 1; i <= COMMANDS; i++) {
+        cmd_data.cmd_data[0].integer = i;
+        HOST_CHECK(host_fire_cmd(level->handle, "setLevel", &cmd_data) == 0);
+    }
+
+    hold = 0;
+    HOST_CHECK(wait_executed(2));
+    iot_os_delay(20);
+
+    caps_cmd_get_stats(&stats);
+    HOST_CHECK(stats.collapsed_count == COMMANDS - 1);
+    HOST_CHECK(stats.executed_count == 2);
+    HOST_CHECK(level_actuated == 1 && level_last == COMMANDS);
+    HOST_CHECK(count_sent(level->handle, "level") == 1);
+    event = host_last_sent(level->handle, "level");
+    HOST_CHECK(event && event->value.type == IOT_CAP_VAL_TYPE_NUMBER && event->value.number == COMMANDS);
+}
+
+static void test_set_hue(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    caps_cmd_stats_t stats;
+    const host_event_t *event;
+    int i;
+
+    caps_cmd_reset_stats();
+    block_executor();
+    host_reset_sent();
+
+    cmd_data.num_args = 1;
+    cmd_data.cmd_data[0].type = IOT_CAP_VAL_TYPE_NUMBER;
+    for (i = 1; i <= COMMANDS; i++) {
+        cmd_data.cmd_data[0].number = i * 0.5;
+        HOST_CHECK(host_fire_cmd(color->handle, "setHue", &cmd_data) == 0);
+    }
+
+    hold = 0;
+    HOST_CHECK(wait_executed(2));
+    iot_os_delay(20);
+
+    caps_cmd_get_stats(&stats);
+    HOST_CHECK(stats.collapsed_count == COMMANDS - 1);
+    HOST_CHECK(hue_actuated == 1 && hue_last == COMMANDS * 0.5);
+    HOST_CHECK(count_sent(color->handle, "hue") == 1);
+    event = host_last_sent(color->handle, "hue");
+    HOST_CHECK(event && event->value.type == IOT_CAP_VAL_TYPE_INTEGER && event->value.integer == COMMANDS / 2);
+}
+
+/* commands which don't collapse all run */
+static void test_no_collapse(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    caps_cmd_stats_t stats;
+    int i;
+
+    caps_cmd_reset_stats();
+    block_executor();
+    hold = 0;
+    HOST_CHECK(wait_executed(1));
+    caps_cmd_reset_stats();
+
+    for (i = 0; i < 4; i++)
+        HOST_CHECK(host_fire_cmd(sw->handle, i & 1 ? "on" : "off", &cmd_data) == 0);
+    HOST_CHECK(wait_executed(4));
+
+    caps_cmd_get_stats(&stats);
+    HOST_CHECK(stats.collapsed_count == 0 && stats.dropped_count == 0);
+}
+
+int main(void)
+{
+    sw = caps_switch_initialize(&ctx, "main", NULL, NULL);
+    level = caps_switchLevel_initialize(&ctx, "main", NULL, NULL);
+    color = caps_colorControl_initialize(&ctx, "main", NULL, NULL);
+    HOST_CHECK(sw && level && color);
+    if (!sw || !level || !color)
+        return 1;
+
+    sw->cmd_on_usr_cb = _hold_cb;
+    level->cmd_setLevel_usr_cb = _level_cb;
+    color->cmd_setHue_usr_cb = _hue_cb;
+
+    HOST_CHECK(caps_cmd_set_collapse(level->handle, "setLevel", 1) == 0);
+    HOST_CHECK(caps_cmd_set_collapse(color->handle, "setHue", 1) == 0);
+    HOST_CHECK(caps_cmd_executor_start(CAPS_CMD_QUEUE_DEPTH, CAPS_CMD_TASK_PRIORITY) == 0);
+
+    test_set_level();
+    test_set_hue();
+    test_no_collapse();
+
+    printf("test_cmd_collapse: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
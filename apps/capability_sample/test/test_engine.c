@@ -0,0 +1,310 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "st_dev.h"
+#include "caps_engine.h"
+#include "caps_util.h"
+#include "host_stub.h"
+
+/* a dimmer described the way caps_generator.py --engine does */
+enum {
+    DIMMER_ATTR_SWITCH,
+    DIMMER_ATTR_LEVEL,
+    DIMMER_ATTR_POWER,
+    DIMMER_ATTR_LABEL,
+    DIMMER_ATTR_MODES,
+    DIMMER_ATTR_NUM,
+};
+
+enum {
+    DIMMER_CMD_ON,
+    DIMMER_CMD_OFF,
+    DIMMER_CMD_SET_SWITCH,
+    DIMMER_CMD_SET_LEVEL,
+    DIMMER_CMD_SET_POWER,
+    DIMMER_CMD_SET_LABEL,
+    DIMMER_CMD_IDENTIFY,
+    DIMMER_CMD_NUM,
+};
+
+typedef struct dimmer_state {
+    int switch_value;
+    int level_value;
+    const char *level_unit;
+    int64_t power_value;
+    const char *power_unit;
+    char *label_value;
+    caps_engine_array_t modes_value;
+} dimmer_state_t;
+
+static const char * const switch_values[] = { "on", "off" };
+static const char * const level_units[] = { "%" };
+static const char * const power_units[] = { "W", "kW" };
+
+static const caps_engine_attr_desc_t dimmer_attrs[] = {
+    [DIMMER_ATTR_SWITCH] = {
+        .name = "switch",
+        .type = CAPS_ENGINE_ATTR_ENUM,
+        .value_num = 2,
+        .offset = offsetof(dimmer_state_t, switch_value),
+        .values = switch_values,
+    },
+    [DIMMER_ATTR_LEVEL] = {
+        .name = "level",
+        .type = CAPS_ENGINE_ATTR_INTEGER,
+        .flags = CAPS_ENGINE_ATTR_FLAG_MIN | CAPS_ENGINE_ATTR_FLAG_MAX,
+        .unit_num = 1,
+        .offset = offsetof(dimmer_state_t, level_value),
+        .unit_offset = offsetof(dimmer_state_t, level_unit),
+        .units = level_units,
+        .min = CAPS_UTIL_MILLI(0),
+        .max = CAPS_UTIL_MILLI(100),
+    },
+    [DIMMER_ATTR_POWER] = {
+        .name = "power",
+        .type = CAPS_ENGINE_ATTR_NUMBER,
+        .flags = CAPS_ENGINE_ATTR_FLAG_MIN,
+        .unit_num = 2,
+        .offset = offsetof(dimmer_state_t, power_value),
+        .unit_offset = offsetof(dimmer_state_t, power_unit),
+        .units = power_units,
+        .min = CAPS_UTIL_MILLI(0),
+    },
+    [DIMMER_ATTR_LABEL] = {
+        .name = "label",
+        .type = CAPS_ENGINE_ATTR_STRING,
+        .offset = offsetof(dimmer_state_t, label_value),
+    },
+    [DIMMER_ATTR_MODES] = {
+        .name = "modes",
+        .type = CAPS_ENGINE_ATTR_ARRAY,
+        .offset = offsetof(dimmer_state_t, modes_value),
+    },
+};
+
+static const caps_engine_cmd_desc_t dimmer_cmds[] = {
+    [DIMMER_CMD_ON] = { .name = "on", .attr = DIMMER_ATTR_SWITCH, .value_idx = 0 },
+    [DIMMER_CMD_OFF] = { .name = "off", .attr = DIMMER_ATTR_SWITCH, .value_idx = 1 },
+    [DIMMER_CMD_SET_SWITCH] = { .name = "setSwitch", .attr = DIMMER_ATTR_SWITCH, .value_idx = CAPS_ENGINE_ARG_VALUE },
+    [DIMMER_CMD_SET_LEVEL] = { .name = "setLevel", .attr = DIMMER_ATTR_LEVEL, .value_idx = CAPS_ENGINE_ARG_VALUE },
+    [DIMMER_CMD_SET_POWER] = { .name = "setPower", .attr = DIMMER_ATTR_POWER, .value_idx = CAPS_ENGINE_ARG_VALUE },
+    [DIMMER_CMD_SET_LABEL] = { .name = "setLabel", .attr = DIMMER_ATTR_LABEL, .value_idx = CAPS_ENGINE_ARG_VALUE },
+    [DIMMER_CMD_IDENTIFY] = { .name = "identify", .attr = CAPS_ENGINE_NO_ATTR },
+};
+
+static const caps_engine_desc_t dimmer_desc = {
+    .id = "dimmer",
+    .attrs = dimmer_attrs,
+    .cmds = dimmer_cmds,
+    .attr_num = DIMMER_ATTR_NUM,
+    .cmd_num = DIMMER_CMD_NUM,
+    .state_size = sizeof(dimmer_state_t),
+};
+
+static int ctx;
+static int init_count;
+static int last_cmd = -1;
+static int cmd_count;
+
+static void _init_cb(caps_engine_data_t *caps_data)
+{
+    init_count++;
+}
+
+static void _cmd_cb(caps_engine_data_t *caps_data, int cmd)
+{
+    last_cmd = cmd;
+    cmd_count++;
+}
+
+/* number attributes are sent as integers when they are whole */
+static double sent_number(caps_engine_data_t *caps_data, const char *name)
+{
+    const host_event_t *event = host_last_sent(caps_data->handle, name);
+
+    if (!event)
+        return -1;
+    if (event->value.type == IOT_CAP_VAL_TYPE_INTEGER)
+        return event->value.integer;
+    if (event->value.type == IOT_CAP_VAL_TYPE_NUMBER)
+        return event->value.number;
+    return -1;
+}
+
+static const char *sent_string(caps_engine_data_t *caps_data, const char *name)
+{
+    const host_event_t *event = host_last_sent(caps_data->handle, name);
+
+    return event && event->value.type == IOT_CAP_VAL_TYPE_STRING ? event->value.string : NULL;
+}
+
+static iot_cap_cmd_data_t *number_arg(iot_cap_cmd_data_t *cmd_data, double value)
+{
+    memset(cmd_data, 0, sizeof(*cmd_data));
+    cmd_data->num_args = 1;
+    cmd_data->cmd_data[0].type = IOT_CAP_VAL_TYPE_NUMBER;
+    cmd_data->cmd_data[0].number = value;
+    return cmd_data;
+}
+
+static iot_cap_cmd_data_t *string_arg(iot_cap_cmd_data_t *cmd_data, const char *value)
+{
+    memset(cmd_data, 0, sizeof(*cmd_data));
+    cmd_data->num_args = 1;
+    cmd_data->cmd_data[0].type = IOT_CAP_VAL_TYPE_STRING;
+    cmd_data->cmd_data[0].string = (char *)value;
+    return cmd_data;
+}
+
+static void test_init(caps_engine_data_t *dimmer)
+{
+    static const char *modes[] = { "normal", "night" };
+    const char **array;
+    int size;
+
+    /* the switch has no value yet, so it is not sent */
+    HOST_CHECK(caps_engine_get_idx(dimmer, DIMMER_ATTR_SWITCH) == -1);
+    HOST_CHECK(caps_engine_get_string(dimmer, DIMMER_ATTR_SWITCH) == NULL);
+
+    caps_engine_set_int(dimmer, DIMMER_ATTR_LEVEL, 30);
+    caps_engine_set_unit(dimmer, DIMMER_ATTR_LEVEL, level_units[0]);
+    caps_engine_set_number(dimmer, DIMMER_ATTR_POWER, 7.5);
+    caps_engine_set_unit(dimmer, DIMMER_ATTR_POWER, power_units[0]);
+    caps_engine_set_string(dimmer, DIMMER_ATTR_LABEL, "hall");
+    caps_engine_set_array(dimmer, DIMMER_ATTR_MODES, modes, 2);
+
+    array = caps_engine_get_array(dimmer, DIMMER_ATTR_MODES, &size);
+    HOST_CHECK(size == 2 && array && array[0] != modes[0] && !strcmp(array[1], "night"));
+
+    host_reset_sent();
+    host_run_init_cb();
+    HOST_CHECK(init_count == 1);
+    HOST_CHECK(host_sent_events() == DIMMER_ATTR_NUM - 1);
+    HOST_CHECK(host_last_sent(dimmer->handle, "switch") == NULL);
+    HOST_CHECK(sent_number(dimmer, "level") == 30);
+    HOST_CHECK(sent_number(dimmer, "power") == 7.5);
+    HOST_CHECK(sent_string(dimmer, "label") && !strcmp(sent_string(dimmer, "label"), "hall"));
+    HOST_CHECK(host_last_sent(dimmer->handle, "modes") != NULL);
+}
+
+static void test_cmd(caps_engine_data_t *dimmer)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+
+    host_reset_sent();
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "on", &cmd_data) == 0);
+    HOST_CHECK(last_cmd == DIMMER_CMD_ON);
+    HOST_CHECK(caps_engine_get_idx(dimmer, DIMMER_ATTR_SWITCH) == 0);
+    HOST_CHECK(sent_string(dimmer, "switch") && !strcmp(sent_string(dimmer, "switch"), "on"));
+
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setSwitch", string_arg(&cmd_data, "off")) == 0);
+    HOST_CHECK(!strcmp(caps_engine_get_string(dimmer, DIMMER_ATTR_SWITCH), "off"));
+    HOST_CHECK(!strcmp(sent_string(dimmer, "switch"), "off"));
+
+    /* a value the capability doesn't have is neither set nor sent */
+    host_reset_sent();
+    cmd_count = 0;
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setSwitch", string_arg(&cmd_data, "dim")) == 0);
+    HOST_CHECK(caps_engine_get_idx(dimmer, DIMMER_ATTR_SWITCH) == 1);
+    HOST_CHECK(host_sent_events() == 0 && cmd_count == 0);
+
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setLevel", number_arg(&cmd_data, 40)) == 0);
+    HOST_CHECK(caps_engine_get_int(dimmer, DIMMER_ATTR_LEVEL) == 40);
+    HOST_CHECK(sent_number(dimmer, "level") == 40);
+
+    /* out of range, the level stays and is reported again */
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setLevel", number_arg(&cmd_data, 150)) == 0);
+    HOST_CHECK(caps_engine_get_int(dimmer, DIMMER_ATTR_LEVEL) == 40);
+    HOST_CHECK(sent_number(dimmer, "level") == 40);
+
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setPower", number_arg(&cmd_data, 12.25)) == 0);
+    HOST_CHECK(caps_engine_get_milli(dimmer, DIMMER_ATTR_POWER) == 12250);
+    HOST_CHECK(sent_number(dimmer, "power") == 12.25);
+    HOST_CHECK(host_last_sent(dimmer->handle, "power")->value.type == IOT_CAP_VAL_TYPE_NUMBER);
+
+    /* integer arguments and whole values don't go through double */
+    cmd_data.cmd_data[0].type = IOT_CAP_VAL_TYPE_INTEGER;
+    cmd_data.cmd_data[0].integer = 3000000;
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setPower", &cmd_data) == 0);
+    HOST_CHECK(caps_engine_get_milli(dimmer, DIMMER_ATTR_POWER) == 3000000000LL);
+    HOST_CHECK(host_last_sent(dimmer->handle, "power")->value.type == IOT_CAP_VAL_TYPE_INTEGER);
+    HOST_CHECK(host_last_sent(dimmer->handle, "power")->value.integer == 3000000);
+    caps_engine_set_milli(dimmer, DIMMER_ATTR_POWER, 12250);
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setPower", number_arg(&cmd_data, -1)) == 0);
+    HOST_CHECK(caps_engine_get_number(dimmer, DIMMER_ATTR_POWER) == 12.25);
+
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setLabel", string_arg(&cmd_data, "porch")) == 0);
+    HOST_CHECK(!strcmp(caps_engine_get_string(dimmer, DIMMER_ATTR_LABEL), "porch"));
+    HOST_CHECK(!strcmp(sent_string(dimmer, "label"), "porch"));
+
+    /* a command without attribute only reaches cmd_usr_cb */
+    host_reset_sent();
+    memset(&cmd_data, 0, sizeof(cmd_data));
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "identify", &cmd_data) == 0);
+    HOST_CHECK(last_cmd == DIMMER_CMD_IDENTIFY && dimmer->cmd_data == &cmd_data);
+    HOST_CHECK(host_sent_events() == 0);
+
+    /* an argument is required */
+    HOST_CHECK(host_fire_cmd(dimmer->handle, "setLevel", &cmd_data) == 0);
+    HOST_CHECK(host_sent_events() == 0);
+}
+
+static void test_type(caps_engine_data_t *dimmer)
+{
+    /* accessors of another type don't touch the state */
+    HOST_CHECK(caps_engine_get_string(dimmer, DIMMER_ATTR_LEVEL) == NULL);
+    HOST_CHECK(caps_engine_get_idx(dimmer, DIMMER_ATTR_LABEL) == -1);
+    HOST_CHECK(caps_engine_get_array(dimmer, DIMMER_ATTR_SWITCH, NULL) == NULL);
+    caps_engine_set_idx(dimmer, DIMMER_ATTR_SWITCH, 2);
+    caps_engine_set_string(dimmer, DIMMER_ATTR_LEVEL, "50");
+    caps_engine_set_int(dimmer, DIMMER_ATTR_LABEL, 1);
+    caps_engine_set_unit(dimmer, DIMMER_ATTR_LABEL, "m");
+    HOST_CHECK(caps_engine_get_idx(dimmer, DIMMER_ATTR_SWITCH) == 1);
+    HOST_CHECK(caps_engine_get_int(dimmer, DIMMER_ATTR_LEVEL) == 40);
+    HOST_CHECK(caps_engine_get_milli(dimmer, DIMMER_ATTR_LEVEL) == 40000);
+    HOST_CHECK(caps_engine_get_unit(dimmer, DIMMER_ATTR_LABEL) == NULL);
+    caps_engine_set_milli(dimmer, DIMMER_ATTR_LEVEL, 100001);
+    HOST_CHECK(caps_engine_get_int(dimmer, DIMMER_ATTR_LEVEL) == 40);
+    HOST_CHECK(caps_engine_get_int(dimmer, DIMMER_ATTR_NUM) == -1);
+    HOST_CHECK(caps_engine_get_int(NULL, DIMMER_ATTR_LEVEL) == -1);
+}
+
+int main(void)
+{
+    caps_engine_data_t *dimmer;
+
+    dimmer = caps_engine_initialize(&ctx, "main", &dimmer_desc, _init_cb, NULL);
+    HOST_CHECK(dimmer && dimmer->handle);
+    if (!dimmer)
+        return 1;
+    dimmer->cmd_usr_cb = _cmd_cb;
+
+    test_init(dimmer);
+    test_cmd(dimmer);
+    test_type(dimmer);
+
+    caps_engine_deinitialize(dimmer);
+    HOST_CHECK(host_live_events() == 0);
+
+    printf("test_engine: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
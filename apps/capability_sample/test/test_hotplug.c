@@ -0,0 +1,126 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_cmd.h"
+#include "caps_sender.h"
+#include "caps_switch.h"
+#include "caps_button.h"
+#include "caps_firmwareUpdate.h"
+#include "host_stub.h"
+
+/* from sanitizer/allocator_interface.h, which not every gcc installs */
+size_t __sanitizer_get_current_allocated_bytes(void);
+
+#define CYCLES 5000
+/* Allocations settle once the handles and their command entries exist */
+#define WARMUP 100
+
+static int ctx;
+static volatile int on_count;
+
+static void _on_cb(caps_switch_data_t *caps_data)
+{
+    on_count++;
+}
+
+/* The executor runs the command in its task, wait for the callback */
+static void _wait_on_count(int count)
+{
+    int i;
+
+    for (i = 0; i < 1000000 && on_count < count; i++)
+        iot_os_thread_yield();
+}
+
+static void _fire_on(void)
+{
+    iot_cap_cmd_data_t cmd_data = { 0 };
+    IOT_CAP_HANDLE *handle = caps_sender_find_handle("main", "switch");
+
+    HOST_CHECK(handle && host_fire_cmd(handle, "on", &cmd_data) == 0);
+}
+
+/* Attach and detach the wrappers, commands of a detached wrapper are ignored */
+static void test_cycles(int executor)
+{
+    static const char *button_values[] = { "pushed", "held" };
+    caps_switch_data_t *sw;
+    caps_button_data_t *button;
+    caps_firmwareUpdate_data_t *firmware;
+    size_t base = 0;
+    int i;
+
+    on_count = 0;
+    for (i = 0; i < CYCLES; i++) {
+        sw = caps_switch_initialize(&ctx, "main", NULL, NULL);
+        button = caps_button_initialize(&ctx, "main", NULL, NULL);
+        firmware = caps_firmwareUpdate_initialize(&ctx, "main", NULL, NULL);
+        HOST_CHECK(sw && button && firmware);
+        if (!sw || !button || !firmware)
+            return;
+
+        sw->cmd_on_usr_cb = _on_cb;
+        button->set_supportedButtonValues_value(button, button_values, 2);
+        firmware->set_currentVersion_value(firmware, "1.0.0");
+        host_run_init_cb();
+        _fire_on();
+        if (executor)
+            _wait_on_count(i + 1);
+
+        /* waits for a command which is still queued or running */
+        caps_switch_deinitialize(sw);
+        caps_button_deinitialize(button);
+        caps_firmwareUpdate_deinitialize(firmware);
+
+        host_run_init_cb();
+        _fire_on();
+
+        if (i == WARMUP) {
+            /* the executor frees the job right after the callback */
+            iot_os_delay(10);
+            base = __sanitizer_get_current_allocated_bytes();
+        }
+    }
+    iot_os_delay(10);
+
+    if (base != __sanitizer_get_current_allocated_bytes())
+        printf("heap grew by %ld bytes\n", (long)(__sanitizer_get_current_allocated_bytes() - base));
+    HOST_CHECK(base == __sanitizer_get_current_allocated_bytes());
+    HOST_CHECK(on_count == CYCLES);
+    HOST_CHECK(host_live_events() == 0);
+}
+
+int main(void)
+{
+    test_cycles(0);
+    HOST_CHECK(caps_cmd_executor_start(CAPS_CMD_QUEUE_DEPTH, CAPS_CMD_TASK_PRIORITY) == 0);
+    test_cycles(1);
+
+    /* the handles are kept and reused */
+    HOST_CHECK(caps_sender_find_handle("main", "switch") != NULL);
+    HOST_CHECK(caps_sender_find_handle("main", "button") != NULL);
+    HOST_CHECK(caps_sender_find_handle("main", "firmwareUpdate") != NULL);
+
+    printf("test_hotplug: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
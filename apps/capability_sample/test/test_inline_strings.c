@@ -0,0 +1,141 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "st_dev.h"
+#include "caps_ovenOperatingState.h"
+#include "caps_gasMeter.h"
+#include "caps_imageCapture.h"
+#include "host_stub.h"
+
+size_t __sanitizer_get_current_allocated_bytes(void);
+
+static void test_time_values(void)
+{
+    caps_ovenOperatingState_data_t *oven;
+    const char *value;
+
+    oven = caps_ovenOperatingState_initialize(NULL, "main", NULL, NULL);
+    HOST_CHECK(oven != NULL);
+    if (!oven)
+        return;
+
+    HOST_CHECK(oven->get_completionTime_value(oven) == NULL);
+    HOST_CHECK(oven->set_completionTime_value(oven, "2020-01-01T12:00:00.000Z") == 0);
+    /* the longest ISO-8601 form, with a UTC offset */
+    HOST_CHECK(oven->set_completionTime_value(oven, "2020-01-01T00:00:00.000+09:00") == 0);
+    value = oven->get_completionTime_value(oven);
+    HOST_CHECK(value && !strcmp(value, "2020-01-01T00:00:00.000+09:00"));
+
+    /* too long and NULL are rejected and the old value is kept */
+    HOST_CHECK(oven->set_completionTime_value(oven, "2020-01-01T00:00:00.000000+09:00") < 0);
+    HOST_CHECK(oven->set_completionTime_value(oven, NULL) < 0);
+    value = oven->get_completionTime_value(oven);
+    HOST_CHECK(value && !strcmp(value, "2020-01-01T00:00:00.000+09:00"));
+
+    caps_ovenOperatingState_deinitialize(oven);
+}
+
+static void test_image_value(void)
+{
+    caps_imageCapture_data_t *camera;
+    char url[512];
+    const char *value;
+    size_t heap;
+
+    camera = caps_imageCapture_initialize(NULL, "main", NULL, NULL);
+    HOST_CHECK(camera != NULL);
+    if (!camera)
+        return;
+
+    heap = __sanitizer_get_current_allocated_bytes();
+    HOST_CHECK(camera->set_image_value(camera, "https://example.com/a.jpg") == 0);
+    HOST_CHECK(__sanitizer_get_current_allocated_bytes() == heap);
+
+    /* a URL longer than the inline buffer goes to the heap instead of being dropped */
+    memset(url, 'a', sizeof(url) - 1);
+    url[sizeof(url) - 1] = '\0';
+    memcpy(url, "https://", 8);
+    HOST_CHECK(camera->set_image_value(camera, url) == 0);
+    value = camera->get_image_value(camera);
+    HOST_CHECK(value && !strcmp(value, url));
+    HOST_CHECK(__sanitizer_get_current_allocated_bytes() > heap);
+
+    HOST_CHECK(camera->set_image_value(camera, "https://example.com/b.jpg") == 0);
+    value = camera->get_image_value(camera);
+    HOST_CHECK(value && !strcmp(value, "https://example.com/b.jpg"));
+    HOST_CHECK(__sanitizer_get_current_allocated_bytes() == heap);
+
+    HOST_CHECK(camera->set_image_value(camera, url) == 0);
+    /* deinitialize frees the long value, checked by LeakSanitizer */
+    caps_imageCapture_deinitialize(camera);
+}
+
+/* Updates of the time attributes of an oven and a gas meter must not touch the heap */
+static void test_soak(void)
+{
+    caps_ovenOperatingState_data_t *oven;
+    caps_gasMeter_data_t *gas;
+    const char *oven_time;
+    const char *gas_time;
+    char time[32];
+    size_t heap;
+    unsigned int i;
+    int err = 0;
+
+    oven = caps_ovenOperatingState_initialize(NULL, "main", NULL, NULL);
+    gas = caps_gasMeter_initialize(NULL, "main", NULL, NULL);
+    HOST_CHECK(oven && gas);
+    if (!oven || !gas)
+        goto out;
+
+    oven->set_completionTime_value(oven, "2020-01-01T00:00:00.000Z");
+    gas->set_gasMeterTime_value(gas, "2020-01-01T00:00:00.000Z");
+    oven_time = oven->get_completionTime_value(oven);
+    gas_time = gas->get_gasMeterTime_value(gas);
+    heap = __sanitizer_get_current_allocated_bytes();
+
+    for (i = 0; i < 1000000; i++) {
+        snprintf(time, sizeof(time), "2020-01-%02uT%02u:%02u:%02u.%03u+09:00",
+                1 + i / 86400 % 28, i / 3600 % 24, i / 60 % 60, i % 60, i % 1000);
+        err |= oven->set_completionTime_value(oven, time);
+        err |= gas->set_gasMeterTime_value(gas, time);
+    }
+    HOST_CHECK(err == 0);
+    HOST_CHECK(__sanitizer_get_current_allocated_bytes() == heap);
+    /* the values are still the buffers inside the caps data */
+    HOST_CHECK(oven->get_completionTime_value(oven) == oven_time);
+    HOST_CHECK(gas->get_gasMeterTime_value(gas) == gas_time);
+    HOST_CHECK(!strcmp(oven_time, time) && !strcmp(gas_time, time));
+
+out:
+    caps_ovenOperatingState_deinitialize(oven);
+    caps_gasMeter_deinitialize(gas);
+}
+
+int main(void)
+{
+    test_time_values();
+    test_image_value();
+    test_soak();
+
+    printf("test_inline_strings: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,330 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "caps_json_parser.h"
+#include "host_stub.h"
+
+#define TOKENS 64
+#define FUZZ_ROUNDS 200000
+
+static const char *valid[] = {
+    "{\"hue\":10.5,\"saturation\":20}",
+    "{\"x\":{\"hue\":1,\"a\":[1,2,{\"hue\":3}]},\"hue\":7, \"saturation\" : -3e1}",
+    "{\"s\":\"a\\n\\u00e9\\\"\"}",
+    "[1,2,3]",
+    "[]",
+    "{}",
+    "[[],{},\"\"]",
+    "\"x\"",
+    "true",
+    " { \"a\" : [ null , false ] } ",
+};
+
+static const char *invalid[] = {
+    "{\"a\":1,}",
+    "[1,]",
+    "{,\"a\":1}",
+    "[,1]",
+    "[1 2]",
+    "{\"a\":1 \"b\":2}",
+    "{\"a\"}",
+    "{\"a\",\"b\":1}",
+    "{\"a\":}",
+    "{\"a\" 1}",
+    "{\"a\"::1}",
+    "{1:2}",
+    "{\"a\":1}{",
+    "1 2",
+    "[1}",
+    "{\"a\":[}",
+    "[\"a\":1]",
+    ",",
+    ":",
+};
+
+static const char *partial[] = {
+    "",
+    "{\"a\":1",
+    "[1,",
+    "{\"a\":",
+    "\"abc",
+};
+
+static int _parse(const char *js, caps_json_token_t *tokens)
+{
+    return caps_json_parse(js, strlen(js), tokens, TOKENS);
+}
+
+static void test_valid(void)
+{
+    caps_json_token_t tokens[TOKENS];
+    unsigned int i;
+
+    for (i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+        if (_parse(valid[i], tokens) <= 0)
+            printf("rejected %s\n", valid[i]);
+        HOST_CHECK(_parse(valid[i], tokens) > 0);
+    }
+    for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        if (_parse(invalid[i], tokens) != CAPS_JSON_ERROR_INVAL)
+            printf("accepted %s\n", invalid[i]);
+        HOST_CHECK(_parse(invalid[i], tokens) == CAPS_JSON_ERROR_INVAL);
+    }
+    for (i = 0; i < sizeof(partial) / sizeof(partial[0]); i++)
+        HOST_CHECK(_parse(partial[i], tokens) == CAPS_JSON_ERROR_PART);
+    HOST_CHECK(caps_json_parse(valid[1], strlen(valid[1]), tokens, 4) == CAPS_JSON_ERROR_NOMEM);
+}
+
+static void test_getters(void)
+{
+    const char *js = valid[1];
+    caps_json_token_t tokens[TOKENS];
+    char buf[8];
+    double number;
+    int value;
+    int num;
+    int i;
+
+    num = _parse(js, tokens);
+    HOST_CHECK(num == 16);
+    HOST_CHECK(tokens[0].size == 3);
+
+    /* only members of the root, not the nested hue */
+    i = caps_json_find(js, tokens, num, 0, "hue");
+    HOST_CHECK(i > 0 && caps_json_get_int(js, &tokens[i], &value) == 0 && value == 7);
+    i = caps_json_find(js, tokens, num, 0, "saturation");
+    HOST_CHECK(i > 0 && caps_json_get_number(js, &tokens[i], &number) == 0 && number == -30);
+    HOST_CHECK(caps_json_find(js, tokens, num, 0, "a") < 0);
+    HOST_CHECK(caps_json_next(tokens, num, 2) == 12);
+
+    js = valid[2];
+    num = _parse(js, tokens);
+    i = caps_json_find(js, tokens, num, 0, "s");
+    HOST_CHECK(i > 0 && caps_json_get_string(js, &tokens[i], buf, sizeof(buf)) == 0);
+    HOST_CHECK(!strcmp(buf, "a\n\xc3\xa9\""));
+    HOST_CHECK(caps_json_get_string(js, &tokens[i], buf, 4) < 0);
+
+    js = valid[9];
+    num = _parse(js, tokens);
+    HOST_CHECK(num == 5);
+    HOST_CHECK(caps_json_get_bool(js, &tokens[4], &value) == 0 && value == 0);
+    HOST_CHECK(caps_json_get_bool(js, &tokens[3], &value) < 0);
+}
+
+static void test_milli(void)
+{
+    static const struct {
+        const char *js;
+        int64_t milli;
+    } cases[] = {
+        { "[23.5]", 23500 },
+        { "[-0.0015]", -2 },
+        { "[0.12345]", 123 },
+        { "[1e3]", 1000000 },
+        { "[5000000.123]", 5000000123LL },
+        { "[-2147484]", -2147484000LL },
+        { "[922337203685477.5]", 922337203685477500LL },
+    };
+    caps_json_token_t tokens[TOKENS];
+    int64_t milli;
+    unsigned int i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        HOST_CHECK(_parse(cases[i].js, tokens) == 2);
+        HOST_CHECK(caps_json_get_milli(cases[i].js, &tokens[1], &milli) == 0 && milli == cases[i].milli);
+    }
+    HOST_CHECK(_parse("[9223372036854775807, 1e300, 1.]", tokens) == 4);
+    for (i = 1; i < 4; i++)
+        HOST_CHECK(caps_json_get_milli("[9223372036854775807, 1e300, 1.]", &tokens[i], &milli) < 0);
+}
+
+/*
+ * Recursive descent reference of the same grammar. Like the tokenizer it
+ * takes any run of printable characters up to a delimiter as a primitive.
+ */
+static int _ref_value(const char **p);
+
+static void _ref_space(const char **p)
+{
+    while (**p == ' ' || **p == '\t' || **p == '\r' || **p == '\n')
+        (*p)++;
+}
+
+static int _ref_string(const char **p)
+{
+    const char *hex = "0123456789abcdefABCDEF";
+    int i;
+
+    for ((*p)++; **p != '"'; (*p)++) {
+        if (!**p || (unsigned char)**p < 32)
+            return 0;
+        if (**p != '\\')
+            continue;
+        (*p)++;
+        if (**p == 'u') {
+            for (i = 0; i < 4; i++) {
+                (*p)++;
+                if (!**p || !strchr(hex, **p))
+                    return 0;
+            }
+        } else if (!**p || !strchr("\"/\\bfrnt", **p)) {
+            return 0;
+        }
+    }
+    (*p)++;
+    return 1;
+}
+
+static int _ref_container(const char **p, char close)
+{
+    (*p)++;
+    _ref_space(p);
+    if (**p == close) {
+        (*p)++;
+        return 1;
+    }
+    for (;;) {
+        if (close == '}') {
+            if (**p != '"' || !_ref_string(p))
+                return 0;
+            _ref_space(p);
+            if (**p != ':')
+                return 0;
+            (*p)++;
+            _ref_space(p);
+        }
+        if (!_ref_value(p))
+            return 0;
+        _ref_space(p);
+        if (**p == close) {
+            (*p)++;
+            return 1;
+        }
+        if (**p != ',')
+            return 0;
+        (*p)++;
+        _ref_space(p);
+    }
+}
+
+static int _ref_value(const char **p)
+{
+    const char *start = *p;
+
+    switch (**p) {
+    case '{':
+        return _ref_container(p, '}');
+    case '[':
+        return _ref_container(p, ']');
+    case '"':
+        return _ref_string(p);
+    }
+    for (; **p && !strchr(",]}: \t\r\n", **p); (*p)++) {
+        if ((unsigned char)**p < 32 || (unsigned char)**p >= 127)
+            return 0;
+    }
+    return *p != start;
+}
+
+static int _ref_valid(const char *js)
+{
+    _ref_space(&js);
+    if (!_ref_value(&js))
+        return 0;
+    _ref_space(&js);
+    return *js == '\0';
+}
+
+/* Every token lies in the text and its parent comes before it */
+static int _tokens_sane(const char *js, const caps_json_token_t *tokens, int num)
+{
+    int len = strlen(js);
+    int i;
+
+    for (i = 0; i < num; i++) {
+        if (tokens[i].start < 0 || tokens[i].start > tokens[i].end || tokens[i].end > len)
+            return 0;
+        if (tokens[i].parent >= i)
+            return 0;
+    }
+    return 1;
+}
+
+/* Random edits of the valid documents, compared with the reference */
+static void test_fuzz(void)
+{
+    static const char alphabet[] = "{}[]:,\" \\u0a1-.etnl";
+    caps_json_token_t tokens[TOKENS];
+    char js[128];
+    int mismatch = 0;
+    int round;
+    int len;
+    int num;
+    int i;
+
+    srand(1);
+    for (round = 0; round < FUZZ_ROUNDS; round++) {
+        strcpy(js, valid[rand() % (sizeof(valid) / sizeof(valid[0]))]);
+        len = strlen(js);
+        for (i = rand() % 3 + 1; i > 0 && len > 0; i--) {
+            int pos = rand() % len;
+
+            switch (rand() % 3) {
+            case 0:     /* replace */
+                js[pos] = alphabet[rand() % (sizeof(alphabet) - 1)];
+                break;
+            case 1:     /* delete */
+                memmove(js + pos, js + pos + 1, len - pos);
+                len--;
+                break;
+            default:    /* insert */
+                if (len + 1 >= (int)sizeof(js))
+                    break;
+                memmove(js + pos + 1, js + pos, len - pos + 1);
+                js[pos] = alphabet[rand() % (sizeof(alphabet) - 1)];
+                len++;
+                break;
+            }
+        }
+
+        num = caps_json_parse(js, len, tokens, TOKENS);
+        if ((num > 0) != _ref_valid(js)) {
+            if (mismatch++ < 5)
+                printf("%s: %d\n", js, num);
+            continue;
+        }
+        if (num > 0 && !_tokens_sane(js, tokens, num))
+            mismatch++;
+    }
+    HOST_CHECK(mismatch == 0);
+}
+
+int main(void)
+{
+    test_valid();
+    test_getters();
+    test_milli();
+    test_fuzz();
+
+    printf("test_json_parser: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "JSON.h"
+#include "caps_json_writer.h"
+#include "host_stub.h"
+
+/* from sanitizer/allocator_interface.h, which not every gcc installs */
+int __sanitizer_install_malloc_and_free_hooks(void (*malloc_hook)(const volatile void *, size_t),
+        void (*free_hook)(const volatile void *));
+
+static int malloc_count;
+
+static void count_malloc(const volatile void *ptr, size_t size)
+{
+    malloc_count++;
+}
+
+static void count_free(const volatile void *ptr)
+{
+}
+
+static void test_escape(void)
+{
+    char buf[128];
+    caps_json_writer_t writer;
+    const char *json;
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_string(&writer, "a\"b\\c\nd\te\x01\x1f/\xc3\xa9");
+    json = caps_json_writer_finish(&writer);
+    HOST_CHECK(json && !strcmp(json, "\"a\\\"b\\\\c\\nd\\te\\u0001\\u001f/\xc3\xa9\""));
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_begin_object(&writer);
+    caps_json_writer_key(&writer, "k\"ey");
+    caps_json_writer_string(&writer, "\b\f\r");
+    caps_json_writer_key(&writer, "none");
+    caps_json_writer_string(&writer, NULL);
+    caps_json_writer_end_object(&writer);
+    json = caps_json_writer_finish(&writer);
+    HOST_CHECK(json && !strcmp(json, "{\"k\\\"ey\":\"\\b\\f\\r\",\"none\":null}"));
+}
+
+static void test_nesting(void)
+{
+    char buf[128];
+    caps_json_writer_t writer;
+    const char *json;
+    JSON_H *root;
+    int i;
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_begin_object(&writer);
+    caps_json_writer_key(&writer, "a");
+    caps_json_writer_begin_array(&writer);
+    caps_json_writer_begin_object(&writer);
+    caps_json_writer_end_object(&writer);
+    caps_json_writer_begin_array(&writer);
+    caps_json_writer_end_array(&writer);
+    caps_json_writer_bool(&writer, 1);
+    caps_json_writer_bool(&writer, 0);
+    caps_json_writer_end_array(&writer);
+    caps_json_writer_key(&writer, "b");
+    caps_json_writer_begin_object(&writer);
+    caps_json_writer_key(&writer, "c");
+    caps_json_writer_null(&writer);
+    caps_json_writer_end_object(&writer);
+    caps_json_writer_end_object(&writer);
+    json = caps_json_writer_finish(&writer);
+    HOST_CHECK(json && !strcmp(json, "{\"a\":[{},[],true,false],\"b\":{\"c\":null}}"));
+
+    root = JSON_PARSE(json);
+    HOST_CHECK(root && JSON_GET_ARRAY_SIZE(JSON_GET_OBJECT_ITEM(root, "a")) == 4);
+    JSON_DELETE(root);
+
+    /* unbalanced nesting, a key outside an object and a key without a value */
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_begin_array(&writer);
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_end_object(&writer);
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_key(&writer, "a");
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_begin_object(&writer);
+    caps_json_writer_key(&writer, "a");
+    caps_json_writer_end_object(&writer);
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+
+    /* too deep */
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    for (i = 0; i < CAPS_JSON_WRITER_MAX_DEPTH; i++)
+        caps_json_writer_begin_array(&writer);
+    for (i = 0; i < CAPS_JSON_WRITER_MAX_DEPTH; i++)
+        caps_json_writer_end_array(&writer);
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+
+    /* the buffer keeps a byte for the terminator */
+    caps_json_writer_init(&writer, buf, 8);
+    caps_json_writer_string(&writer, "12345");
+    HOST_CHECK(caps_json_writer_finish(&writer) && strlen(buf) == 7);
+    caps_json_writer_init(&writer, buf, 8);
+    caps_json_writer_string(&writer, "123456");
+    HOST_CHECK(caps_json_writer_finish(&writer) == NULL);
+}
+
+static void check_number(double value, int is_float, const char *expected)
+{
+    char buf[64];
+    caps_json_writer_t writer;
+    const char *json;
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    if (is_float)
+        caps_json_writer_float(&writer, (float)value);
+    else
+        caps_json_writer_number(&writer, value);
+    json = caps_json_writer_finish(&writer);
+    if (!json || strcmp(json, expected)) {
+        printf("%.17g is written as %s, not %s\n", value, json ? json : "(error)", expected);
+        host_failures++;
+    }
+}
+
+static void test_number(void)
+{
+    char buf[64];
+    caps_json_writer_t writer;
+    const char *json;
+    double value;
+    double back;
+    int i;
+
+    caps_json_writer_init(&writer, buf, sizeof(buf));
+    caps_json_writer_begin_array(&writer);
+    caps_json_writer_int(&writer, 0);
+    caps_json_writer_int(&writer, -2147483647 - 1);
+    caps_json_writer_int(&writer, 2147483647);
+    caps_json_writer_end_array(&writer);
+    json = caps_json_writer_finish(&writer);
+    HOST_CHECK(json && !strcmp(json, "[0,-2147483648,2147483647]"));
+
+    check_number(0, 0, "0");
+    check_number(-0.5, 0, "-0.5");
+    check_number(23.4, 0, "23.4");
+    check_number(0.1 + 0.2, 0, "0.30000000000000004");
+    check_number(1e-7, 0, "0.0000001");
+    check_number(1.5e-12, 0, "1.5e-12");
+    check_number(4294967296.0, 0, "4294967296");
+    check_number(1e300, 0, "1e+300");
+    check_number(23.4, 1, "23.4");
+    check_number(-40.25, 1, "-40.25");
+    check_number(0.0 / 0.0, 0, "null");
+    check_number(1.0 / 0.0, 0, "null");
+
+    /* every number reads back as the same double */
+    value = 0.001;
+    for (i = 0; i < 2000; i++) {
+        caps_json_writer_init(&writer, buf, sizeof(buf));
+        caps_json_writer_number(&writer, value);
+        json = caps_json_writer_finish(&writer);
+        back = json ? strtod(json, NULL) : -1;
+        if (back != value) {
+            printf("%.17g is written as %s\n", value, json ? json : "(error)");
+            host_failures++;
+            break;
+        }
+        value = value * -1.37 + 0.013;
+    }
+}
+
+/* threeAxis value built by the writer and as a cJSON tree, like the wrapper did before */
+static void test_alloc(void)
+{
+    const int samples = 1000;
+    char buf[40];
+    caps_json_writer_t writer;
+    JSON_H *array;
+    char *text;
+    int cjson_allocs;
+    int writer_allocs;
+    int i;
+    int j;
+
+    malloc_count = 0;
+    __sanitizer_install_malloc_and_free_hooks(count_malloc, count_free);
+    for (i = 0; i < samples; i++) {
+        caps_json_writer_init(&writer, buf, sizeof(buf));
+        caps_json_writer_begin_array(&writer);
+        for (j = 0; j < 3; j++)
+            caps_json_writer_int(&writer, i * 3 + j - 1000);
+        caps_json_writer_end_array(&writer);
+        HOST_CHECK(caps_json_writer_finish(&writer));
+    }
+    writer_allocs = malloc_count;
+
+    malloc_count = 0;
+    for (i = 0; i < samples; i++) {
+        array = JSON_CREATE_ARRAY();
+        for (j = 0; j < 3; j++)
+            JSON_ADD_ITEM_TO_ARRAY(array, JSON_CREATE_NUMBER(i * 3 + j - 1000));
+        text = JSON_PRINT(array);
+        HOST_CHECK(text && !strcmp(text, buf) == (i == samples - 1));
+        JSON_FREE(text);
+        JSON_DELETE(array);
+    }
+    cjson_allocs = malloc_count;
+    __sanitizer_install_malloc_and_free_hooks(NULL, NULL);
+
+    printf("threeAxis x %d : %d allocations with caps_json_writer, %d with a cJSON tree\n",
+            samples, writer_allocs, cjson_allocs);
+    HOST_CHECK(writer_allocs == 0);
+    HOST_CHECK(cjson_allocs >= samples * 5);
+}
+
+int main(void)
+{
+    test_escape();
+    test_nesting();
+    test_number();
+    test_alloc();
+
+    printf("test_json_writer: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
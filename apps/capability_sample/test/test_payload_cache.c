@@ -0,0 +1,166 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "caps_payload_cache.h"
+#include "host_stub.h"
+
+#define COLLISION_SEARCH (1 << 18)
+
+struct hashed {
+    unsigned int hash;
+    int value;
+};
+
+static IOT_CAP_HANDLE *handle;
+
+static int _compare(const void *a, const void *b)
+{
+    const struct hashed *x = a, *y = b;
+
+    return x->hash < y->hash ? -1 : x->hash > y->hash;
+}
+
+static int send_level(int level)
+{
+    int sequence_no;
+
+    CAPS_SEND_ATTR_MILLI(handle, "level", level * 1000, "%", NULL, sequence_no);
+    return sequence_no;
+}
+
+static int last_level(void)
+{
+    const host_event_t *event = host_last_sent(handle, "level");
+
+    return event ? event->value.integer : -1;
+}
+
+/* Two levels of the same hash, found by the birthday bound */
+static int _find_collision(int *a, int *b)
+{
+    struct hashed *hashed = malloc(COLLISION_SEARCH * sizeof(*hashed));
+    caps_attr_t attr = { 0 };
+    int found = 0;
+    int i;
+
+    attr.value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    attr.unit = "%";
+    for (i = 0; i < COLLISION_SEARCH; i++) {
+        attr.value.integer = i * 7919;
+        hashed[i].hash = caps_send_cache_hash(&attr);
+        hashed[i].value = attr.value.integer;
+    }
+    qsort(hashed, COLLISION_SEARCH, sizeof(*hashed), _compare);
+    for (i = 1; i < COLLISION_SEARCH; i++) {
+        if (hashed[i].hash == hashed[i - 1].hash) {
+            *a = hashed[i - 1].value;
+            *b = hashed[i].value;
+            found = 1;
+            break;
+        }
+    }
+    free(hashed);
+    return found;
+}
+
+static void test_reuse(void)
+{
+    caps_payload_cache_stats_t stats;
+
+    caps_payload_cache_reset_stats();
+    HOST_CHECK(send_level(10) > 0);
+    HOST_CHECK(send_level(10) > 0);
+    HOST_CHECK(send_level(20) > 0);
+    HOST_CHECK(last_level() == 20);
+    caps_payload_cache_get_stats(&stats);
+    HOST_CHECK(stats.build_count == 2);
+    HOST_CHECK(stats.hit_count == 1);
+}
+
+static int send_raw_level(int value)
+{
+    caps_attr_t attr = { 0 };
+
+    attr.handle = handle;
+    attr.name = "level";
+    attr.unit = "%";
+    attr.value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    attr.value.integer = value;
+    return caps_sender_send_attrs(&attr, 1);
+}
+
+static void test_collision(void)
+{
+    int a, b;
+
+    HOST_CHECK(_find_collision(&a, &b));
+    HOST_CHECK(send_raw_level(a) > 0);
+    HOST_CHECK(last_level() == a);
+    /* same hash, the kept event of a must not go out */
+    HOST_CHECK(send_raw_level(b) > 0);
+    HOST_CHECK(last_level() == b);
+}
+
+/* a value which doesn't fit in caps_send_cache_value_t is never reused */
+static void test_long_value(void)
+{
+    caps_payload_cache_stats_t stats;
+    caps_attr_t attr = { 0 };
+    char value[64];
+
+    HOST_CHECK(caps_payload_cache_register(handle, "text") == 0);
+    memset(value, 'a', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+    attr.handle = handle;
+    attr.name = "text";
+    attr.value.type = IOT_CAP_VAL_TYPE_STRING;
+    attr.value.string = value;
+
+    caps_payload_cache_reset_stats();
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+    caps_payload_cache_get_stats(&stats);
+    HOST_CHECK(stats.hit_count == 0);
+    HOST_CHECK(stats.build_count == 2);
+}
+
+int main(void)
+{
+    static int ctx;
+
+    handle = st_cap_handle_init(&ctx, "main", "switchLevel", NULL, NULL);
+    HOST_CHECK(caps_sender_add_handle(handle, "main", "switchLevel") == 0);
+    HOST_CHECK(caps_payload_cache_register(handle, "level") == 0);
+
+    test_reuse();
+    test_collision();
+    test_long_value();
+
+    caps_payload_cache_invalidate(NULL);
+    HOST_CHECK(host_live_events() == 0);
+
+    printf("test_payload_cache: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_smokeDetector.h"
+#include "caps_dustSensor.h"
+#include "host_stub.h"
+
+#define FLOOD_TASKS 3
+#define COALESCE_WINDOW_MS 200
+
+static caps_smokeDetector_data_t *smoke;
+static caps_dustSensor_data_t *dust;
+static volatile int flood_stop;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Other tasks send dust levels every 50 us into the coalescing window */
+static void *flood_task(void *arg)
+{
+    int value = 0;
+
+    while (!flood_stop) {
+        dust->set_dustLevel_value(dust, value++ % 500);
+        dust->attr_dustLevel_send(dust);
+        usleep(50);
+    }
+    return NULL;
+}
+
+static int compare_us(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+/*
+ * Sets and sends smoke num times and returns the p99 time in us until
+ * st_cap_send_attr() got it.
+ */
+static uint64_t smoke_p99_us(int num)
+{
+    const host_event_t *event;
+    const char *value;
+    uint64_t *latency;
+    uint64_t start;
+    uint64_t p99;
+    int i;
+
+    latency = calloc(num, sizeof(uint64_t));
+    if (!latency)
+        return UINT64_MAX;
+
+    for (i = 0; i < num; i++) {
+        usleep(3000 + rand() % 2000);
+        value = caps_helper_smokeDetector.attr_smoke.values[i & 1];
+        host_reset_sent();
+
+        start = now_us();
+        smoke->set_smoke_value(smoke, value);
+        smoke->attr_smoke_send(smoke);
+        for (;;) {
+            event = host_last_sent(smoke->handle, "smoke");
+            if (event && !strcmp(event->value.string, value))
+                break;
+            if (now_us() - start > 2000000) {
+                HOST_CHECK(!"smoke was not sent");
+                break;
+            }
+            iot_os_thread_yield();
+        }
+        latency[i] = now_us() - start;
+    }
+
+    qsort(latency, num, sizeof(uint64_t), compare_us);
+    p99 = latency[num * 99 / 100];
+    free(latency);
+    return p99;
+}
+
+static void test_critical_lane(void)
+{
+    static int ctx;
+    pthread_t flood[FLOOD_TASKS];
+    caps_sender_stats_t stats;
+    uint64_t critical_p99;
+    uint64_t normal_p99;
+    int i;
+
+    smoke = caps_smokeDetector_initialize(&ctx, "main", NULL, NULL);
+    dust = caps_dustSensor_initialize(&ctx, "main", NULL, NULL);
+    HOST_CHECK(smoke && smoke->handle && dust && dust->handle);
+    if (!smoke || !smoke->handle || !dust || !dust->handle)
+        return;
+    HOST_CHECK(caps_sender_get_priority(smoke->handle, "smoke") == CAPS_SEND_PRIORITY_CRITICAL);
+
+    HOST_CHECK(caps_sender_set_coalesce_window(COALESCE_WINDOW_MS) == 0);
+    caps_sender_reset_stats();
+    for (i = 0; i < FLOOD_TASKS; i++)
+        pthread_create(&flood[i], NULL, flood_task, NULL);
+
+    critical_p99 = smoke_p99_us(200);
+    caps_sender_get_stats(&stats);
+    HOST_CHECK(stats.critical_count == 200);
+
+    caps_sender_set_priority(smoke->handle, "smoke", CAPS_SEND_PRIORITY_NORMAL);
+    normal_p99 = smoke_p99_us(20);
+
+    flood_stop = 1;
+    for (i = 0; i < FLOOD_TASKS; i++)
+        pthread_join(flood[i], NULL);
+    HOST_CHECK(caps_sender_set_coalesce_window(0) == 0);
+
+    printf("smoke p99 with a %d ms coalescing window: critical %llu us, normal %llu us\n",
+            COALESCE_WINDOW_MS, (unsigned long long)critical_p99, (unsigned long long)normal_p99);
+    /* a critical attribute never waits for the window, a normal one does */
+    HOST_CHECK(critical_p99 < COALESCE_WINDOW_MS * 1000 / 10);
+    HOST_CHECK(normal_p99 > critical_p99);
+
+    caps_smokeDetector_deinitialize(smoke);
+    caps_dustSensor_deinitialize(dust);
+}
+
+int main(void)
+{
+    test_critical_lane();
+
+    printf("test_priority: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
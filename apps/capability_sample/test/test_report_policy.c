@@ -0,0 +1,175 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "caps_report_policy.h"
+#include "host_stub.h"
+
+static IOT_CAP_HANDLE *handle;
+
+static int send_level(const char *name, int value)
+{
+    caps_attr_t attr = { 0 };
+
+    attr.handle = handle;
+    attr.name = name;
+    attr.value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    attr.value.integer = value;
+    return caps_sender_send_attrs(&attr, 1);
+}
+
+static int last_level(const char *name)
+{
+    const host_event_t *event = host_last_sent(handle, name);
+
+    return event ? event->value.integer : -1;
+}
+
+/* A change below 5 is dropped and a bigger one goes out right away */
+static void test_deadband(void)
+{
+    caps_report_policy_t policy = { 0 };
+    caps_report_policy_stats_t stats;
+
+    policy.change = 5;
+    HOST_CHECK(caps_report_policy_set(handle, "deadband", &policy) == 0);
+
+    host_reset_sent();
+    HOST_CHECK(send_level("deadband", 100) > 0);
+    HOST_CHECK(send_level("deadband", 104) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_level("deadband", 96) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_level("deadband", 105) > 0);
+    HOST_CHECK(host_sent_events() == 2);
+    HOST_CHECK(last_level("deadband") == 105);
+
+    /* the reportable change is relative to the last reported value */
+    policy.change = 10;
+    policy.change_percent = 1;
+    HOST_CHECK(caps_report_policy_set(handle, "deadband", &policy) == 0);
+    HOST_CHECK(send_level("deadband", 114) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_level("deadband", 116) > 0);
+
+    caps_report_policy_get_stats(&stats);
+    HOST_CHECK(stats.dropped_count == 3);
+    HOST_CHECK(caps_report_policy_set(handle, "deadband", NULL) == 0);
+}
+
+/* Changes within min_interval_ms are held and the latest one is reported once it has passed */
+static void test_min_interval(void)
+{
+    caps_report_policy_t policy = { 0 };
+    caps_report_policy_stats_t before;
+    caps_report_policy_stats_t after;
+
+    policy.min_interval_ms = 200;
+    HOST_CHECK(caps_report_policy_set(handle, "held", &policy) == 0);
+    caps_report_policy_get_stats(&before);
+
+    host_reset_sent();
+    HOST_CHECK(send_level("held", 1) > 0);
+    HOST_CHECK(send_level("held", 2) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_level("held", 3) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(host_sent_events() == 1);
+
+    iot_os_delay(100);
+    HOST_CHECK(host_sent_events() == 1);
+    iot_os_delay(200);
+    HOST_CHECK(host_sent_events() == 2);
+    HOST_CHECK(last_level("held") == 3);
+
+    caps_report_policy_get_stats(&after);
+    HOST_CHECK(after.held_count - before.held_count == 2);
+    HOST_CHECK(after.deferred_count - before.deferred_count == 1);
+
+    /* a held change which goes back to the reported value is not reported */
+    iot_os_delay(250);
+    HOST_CHECK(send_level("held", 4) > 0);
+    HOST_CHECK(send_level("held", 5) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_level("held", 4) == CAPS_SEND_SUPPRESSED);
+    iot_os_delay(300);
+    HOST_CHECK(host_sent_events() == 3);
+    HOST_CHECK(caps_report_policy_set(handle, "held", NULL) == 0);
+}
+
+/* Without reports the value goes out again after max_interval_ms, and the send cache keeps it */
+static void test_heartbeat(void)
+{
+    caps_report_policy_t policy = { 0 };
+    caps_report_policy_stats_t before;
+    caps_report_policy_stats_t after;
+
+    policy.max_interval_ms = 150;
+    HOST_CHECK(caps_send_cache_register(handle, "heartbeat") == 0);
+    HOST_CHECK(caps_report_policy_set(handle, "heartbeat", &policy) == 0);
+    caps_report_policy_get_stats(&before);
+
+    host_reset_sent();
+    HOST_CHECK(send_level("heartbeat", 20) > 0);
+    iot_os_delay(100);
+    HOST_CHECK(host_sent_events() == 1);
+    iot_os_delay(150);
+    HOST_CHECK(host_sent_events() == 2);
+    HOST_CHECK(last_level("heartbeat") == 20);
+
+    caps_report_policy_get_stats(&after);
+    HOST_CHECK(after.heartbeat_count - before.heartbeat_count >= 1);
+
+    /* the heartbeat didn't make the send cache forget the value */
+    HOST_CHECK(caps_report_policy_set(handle, "heartbeat", NULL) == 0);
+    HOST_CHECK(send_level("heartbeat", 20) == CAPS_SEND_SUPPRESSED);
+}
+
+static void test_load_json(void)
+{
+    const char *json = "{\"reportPolicy\": ["
+            "{\"component\": \"main\", \"capability\": \"test\", \"attribute\": \"json\", "
+            "\"minInterval\": 10, \"maxInterval\": 600, \"change\": \"5%\"},"
+            "{\"component\": \"main\", \"capability\": \"unknown\", \"attribute\": \"json\"},"
+            "{\"component\": \"main\", \"capability\": \"test\"}]}";
+
+    HOST_CHECK(caps_report_policy_load_json(json) == 1);
+    HOST_CHECK(caps_report_policy_load_json("{\"reportPolicy\": ") < 0);
+    HOST_CHECK(caps_report_policy_load_json("{}") < 0);
+
+    host_reset_sent();
+    HOST_CHECK(send_level("json", 100) > 0);
+    HOST_CHECK(send_level("json", 110) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(caps_report_policy_set_by_name("main", "test", "json", NULL) == 0);
+}
+
+int main(void)
+{
+    static int ctx;
+
+    handle = st_cap_handle_init(&ctx, "main", "test", NULL, NULL);
+    HOST_CHECK(caps_sender_add_handle(handle, "main", "test") == 0);
+
+    test_deadband();
+    test_min_interval();
+    test_heartbeat();
+    test_load_json();
+
+    printf("test_report_policy: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
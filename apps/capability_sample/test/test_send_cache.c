@@ -0,0 +1,189 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "host_stub.h"
+
+#define COLLISION_SEARCH (1 << 18)
+
+struct hashed {
+    unsigned int hash;
+    int index;
+};
+
+static IOT_CAP_HANDLE *handle;
+
+static int _compare(const void *a, const void *b)
+{
+    const struct hashed *x = a, *y = b;
+
+    return x->hash < y->hash ? -1 : x->hash > y->hash;
+}
+
+/* spread the values, short decimal strings and small integers rarely collide */
+static void _string_of(int index, char *buf, size_t size)
+{
+    snprintf(buf, size, "%08x", (unsigned int)index * 2654435761U);
+}
+
+static void _fill_attr(caps_attr_t *attr, const char *name, int index, char *buf, size_t size)
+{
+    memset(attr, 0, sizeof(*attr));
+    attr->handle = handle;
+    attr->name = name;
+    if (buf) {
+        _string_of(index, buf, size);
+        attr->value.type = IOT_CAP_VAL_TYPE_STRING;
+        attr->value.string = buf;
+    } else {
+        attr->value.type = IOT_CAP_VAL_TYPE_INTEGER;
+        attr->value.integer = index * 7919;
+    }
+}
+
+/* Two values of the same hash, found by the birthday bound */
+static int _find_collision(int string, int *a, int *b)
+{
+    struct hashed *hashed = malloc(COLLISION_SEARCH * sizeof(*hashed));
+    caps_attr_t attr;
+    char buf[16];
+    int found = 0;
+    int i;
+
+    for (i = 0; i < COLLISION_SEARCH; i++) {
+        _fill_attr(&attr, "x", i, string ? buf : NULL, sizeof(buf));
+        hashed[i].hash = caps_send_cache_hash(&attr);
+        hashed[i].index = i;
+    }
+    qsort(hashed, COLLISION_SEARCH, sizeof(*hashed), _compare);
+    for (i = 1; i < COLLISION_SEARCH; i++) {
+        if (hashed[i].hash == hashed[i - 1].hash) {
+            *a = hashed[i - 1].index;
+            *b = hashed[i].index;
+            found = 1;
+            break;
+        }
+    }
+    free(hashed);
+    return found;
+}
+
+static void test_collision(const char *name, int string)
+{
+    caps_attr_t attr;
+    char buf[16];
+    int a, b;
+
+    HOST_CHECK(_find_collision(string, &a, &b));
+    HOST_CHECK(caps_send_cache_register(handle, name) == 0);
+
+    _fill_attr(&attr, name, a, string ? buf : NULL, sizeof(buf));
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) == CAPS_SEND_SUPPRESSED);
+
+    /* same hash, different value */
+    _fill_attr(&attr, name, b, string ? buf : NULL, sizeof(buf));
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) == CAPS_SEND_SUPPRESSED);
+}
+
+static void test_value(void)
+{
+    caps_send_cache_value_t x, y;
+    caps_attr_t attr = { 0 };
+    char long_a[64], long_b[64];
+
+    attr.value.type = IOT_CAP_VAL_TYPE_NUMBER;
+    attr.value.number = 1.5;
+    attr.unit = "C";
+    caps_send_cache_value_set(&x, &attr);
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(caps_send_cache_value_equal(&x, &y));
+    attr.unit = "F";
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(!caps_send_cache_value_equal(&x, &y));
+
+    memset(long_a, 'a', sizeof(long_a) - 1);
+    long_a[sizeof(long_a) - 1] = '\0';
+    memcpy(long_b, long_a, sizeof(long_b));
+    long_b[3] = 'b';
+    attr.value.type = IOT_CAP_VAL_TYPE_STRING;
+    attr.value.string = long_a;
+    caps_send_cache_value_set(&x, &attr);
+    HOST_CHECK(x.len > CAPS_SEND_CACHE_VALUE_SIZE);
+    attr.value.string = long_b;
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(!caps_send_cache_value_equal(&x, &y));
+    /* a long value is never taken for an earlier one, not even for itself */
+    attr.value.string = long_a;
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(!caps_send_cache_value_equal(&x, &y));
+
+    /* an ISO-8601 time with a UTC offset is compared in full */
+    attr.value.string = "2020-01-01T00:00:00.000+09:00";
+    attr.unit = NULL;
+    caps_send_cache_value_set(&x, &attr);
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(x.len <= CAPS_SEND_CACHE_VALUE_SIZE);
+    HOST_CHECK(caps_send_cache_value_equal(&x, &y));
+    attr.value.string = "2020-01-01T00:00:00.000+10:00";
+    caps_send_cache_value_set(&y, &attr);
+    HOST_CHECK(!caps_send_cache_value_equal(&x, &y));
+}
+
+/* a send nobody checked, e.g. with CAPS_SEND_FLAG_NO_FILTER, leaves nothing to compare with */
+static void test_unchecked_send(void)
+{
+    caps_attr_t attr;
+
+    HOST_CHECK(caps_send_cache_register(handle, "level") == 0);
+    _fill_attr(&attr, "level", 1, NULL, 0);
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) == CAPS_SEND_SUPPRESSED);
+    attr.value.integer = 2;
+    HOST_CHECK(caps_sender_send_attrs_flags(&attr, 1, CAPS_SEND_FLAG_NO_FILTER) > 0);
+    HOST_CHECK(caps_sender_send_attrs_flags(&attr, 1, CAPS_SEND_FLAG_NO_FILTER) > 0);
+    /* the unchecked sends still keep the sent value */
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) == CAPS_SEND_SUPPRESSED);
+    attr.value.integer = 3;
+    HOST_CHECK(caps_sender_send_attrs(&attr, 1) > 0);
+}
+
+int main(void)
+{
+    static int ctx;
+
+    handle = st_cap_handle_init(&ctx, "main", "test", NULL, NULL);
+    HOST_CHECK(caps_sender_add_handle(handle, "main", "test") == 0);
+
+    test_collision("integer", 0);
+    test_collision("string", 1);
+    test_value();
+    test_unchecked_send();
+
+    HOST_CHECK(host_live_events() == 0);
+
+    printf("test_send_cache: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
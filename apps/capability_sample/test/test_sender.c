@@ -0,0 +1,180 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "host_stub.h"
+
+static IOT_CAP_HANDLE *dust_handle;
+static IOT_CAP_HANDLE *switch_handle;
+
+static int send_dust(int value)
+{
+    int sequence_no;
+
+    CAPS_SEND_ATTR_MILLI(dust_handle, "dustLevel", value * 1000, "μg/m^3", NULL, sequence_no);
+    return sequence_no;
+}
+
+static int last_dust(void)
+{
+    const host_event_t *event = host_last_sent(dust_handle, "dustLevel");
+
+    return event ? event->value.integer : -1;
+}
+
+static void switch_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    int sequence_no;
+
+    caps_sender_init_cb_begin(handle);
+    CAPS_SEND_ATTR_STRING(handle, "switch", "on", NULL, NULL, sequence_no);
+    /* another task changes the dust level back and forth meanwhile */
+    send_dust(20);
+    send_dust(10);
+    (void)sequence_no;
+    caps_sender_init_cb_end(handle);
+}
+
+static void dust_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    caps_sender_init_cb_begin(handle);
+    caps_sender_init_cb_end(handle);
+}
+
+static void test_direct(void)
+{
+    host_reset_sent();
+    HOST_CHECK(send_dust(10) > 0);
+    HOST_CHECK(send_dust(10) == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(send_dust(20) > 0);
+    HOST_CHECK(send_dust(10) > 0);
+    HOST_CHECK(host_sent_events() == 3);
+    HOST_CHECK(last_dust() == 10);
+}
+
+/* A sent, then B and A again before the held events go out: nothing is sent */
+static void test_batch(void)
+{
+    host_reset_sent();
+    caps_sender_batch_begin();
+    send_dust(20);
+    send_dust(10);
+    HOST_CHECK(caps_sender_batch_end() == CAPS_SEND_SUPPRESSED);
+    HOST_CHECK(host_sent_messages() == 0);
+
+    caps_sender_batch_begin();
+    send_dust(20);
+    send_dust(30);
+    HOST_CHECK(caps_sender_batch_end() > 0);
+    HOST_CHECK(host_sent_events() == 1);
+    HOST_CHECK(last_dust() == 30);
+
+    send_dust(10);
+}
+
+static void test_coalesce(void)
+{
+    caps_sender_stats_t stats;
+
+    host_reset_sent();
+    caps_sender_reset_stats();
+    HOST_CHECK(caps_sender_set_coalesce_window(50) == 0);
+
+    send_dust(20);
+    send_dust(10);
+    iot_os_delay(150);
+    HOST_CHECK(host_sent_messages() == 0);
+
+    send_dust(20);
+    send_dust(30);
+    iot_os_delay(150);
+    HOST_CHECK(host_sent_messages() == 1);
+    HOST_CHECK(host_sent_events() == 1);
+    HOST_CHECK(last_dust() == 30);
+
+    caps_sender_get_stats(&stats);
+    HOST_CHECK(stats.flush_count == 1);
+    HOST_CHECK(stats.replaced_count == 2);
+
+    HOST_CHECK(caps_sender_set_coalesce_window(0) == 0);
+    send_dust(10);
+}
+
+/* dustLevel goes to 20 and back to 10 while the init publish of the switch is open */
+static void test_init_publish(void)
+{
+    const host_event_t *event;
+    int i;
+
+    host_reset_sent();
+    caps_sender_set_init_publish(1);
+    host_run_init_cb();
+    caps_sender_set_init_publish(0);
+
+    HOST_CHECK(host_sent_messages() == 1);
+    for (i = 0; i < host_sent_events(); i++) {
+        event = host_sent_event(i);
+        HOST_CHECK(event->handle != dust_handle);
+    }
+    HOST_CHECK(host_last_sent(switch_handle, "switch") != NULL);
+}
+
+/* a handle added without a wrapper has no init callback the publish could wait for */
+static void test_init_publish_added_handle(void)
+{
+    static int ctx;
+    IOT_CAP_HANDLE *added;
+
+    added = st_cap_handle_init(&ctx, "extra", "temperatureMeasurement", NULL, NULL);
+    HOST_CHECK(added && caps_sender_add_handle(added, "extra", "temperatureMeasurement") == 0);
+
+    host_reset_sent();
+    caps_sender_set_init_publish(1);
+    host_run_init_cb();
+    /* closed by the last wrapped handle, not left open until caps_sender_flush() */
+    HOST_CHECK(host_sent_messages() == 1);
+    HOST_CHECK(host_last_sent(switch_handle, "switch") != NULL);
+    caps_sender_set_init_publish(0);
+}
+
+int main(void)
+{
+    static int ctx;
+
+    switch_handle = caps_sender_handle_init(&ctx, "main", "switch", switch_init_cb, NULL);
+    dust_handle = caps_sender_handle_init(&ctx, "monitor", "dustSensor", dust_init_cb, NULL);
+    HOST_CHECK(switch_handle && dust_handle);
+    HOST_CHECK(caps_send_cache_register(dust_handle, "dustLevel") == 0);
+
+    test_direct();
+    test_batch();
+    test_coalesce();
+    test_init_publish();
+    test_init_publish_added_handle();
+
+    HOST_CHECK(host_live_events() == 0);
+
+    printf("test_sender: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
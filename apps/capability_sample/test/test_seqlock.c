@@ -0,0 +1,121 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "iot_os_util.h"
+#include "caps_seqlock.h"
+#include "host_stub.h"
+
+#define WRITERS 4
+#define READERS 4
+#define UPDATES 200000
+
+/* An app state block, every word is written with the same value */
+typedef struct app_state {
+    int iot_status;
+    int stat_lv;
+    int noti_led_mode;
+    int monitor_enable;
+    int monitor_period_ms;
+    int spare[3];
+} app_state_t;
+
+static caps_seqlock_t state_lock;
+static app_state_t state;
+static volatile int writers_done;
+static unsigned long torn_reads;
+static unsigned long total_reads;
+
+static void *writer_task(void *arg)
+{
+    int value;
+    int i;
+
+    for (i = 0; i < UPDATES; i++) {
+        caps_seqlock_write_begin(&state_lock);
+        value = state.iot_status + 1;
+        state.iot_status = value;
+        state.stat_lv = value;
+        state.noti_led_mode = value;
+        state.monitor_enable = value;
+        /* let the readers run in the middle of a write now and then, also on a single core */
+        if (!(i % 1024))
+            iot_os_thread_yield();
+        state.monitor_period_ms = value;
+        state.spare[0] = state.spare[1] = state.spare[2] = value;
+        caps_seqlock_write_end(&state_lock);
+    }
+    return NULL;
+}
+
+static void *reader_task(void *arg)
+{
+    app_state_t snapshot;
+    unsigned long torn = 0;
+    unsigned long reads = 0;
+
+    while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+        caps_seqlock_read(&state_lock, &snapshot, &state, sizeof(snapshot));
+        reads++;
+        if (snapshot.stat_lv != snapshot.iot_status || snapshot.noti_led_mode != snapshot.iot_status ||
+                snapshot.monitor_enable != snapshot.iot_status ||
+                snapshot.monitor_period_ms != snapshot.iot_status || snapshot.spare[2] != snapshot.iot_status) {
+            torn++;
+        }
+    }
+    __atomic_add_fetch(&torn_reads, torn, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&total_reads, reads, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+static void test_concurrent(void)
+{
+    pthread_t writers[WRITERS];
+    pthread_t readers[READERS];
+    int i;
+
+    HOST_CHECK(caps_seqlock_init(&state_lock) == 0);
+
+    for (i = 0; i < READERS; i++)
+        pthread_create(&readers[i], NULL, reader_task, NULL);
+    for (i = 0; i < WRITERS; i++)
+        pthread_create(&writers[i], NULL, writer_task, NULL);
+    for (i = 0; i < WRITERS; i++)
+        pthread_join(writers[i], NULL);
+    __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < READERS; i++)
+        pthread_join(readers[i], NULL);
+
+    printf("%d updates, %lu reads, %lu torn\n", WRITERS * UPDATES, total_reads, torn_reads);
+    /* the writers are serialized, so no update is lost */
+    HOST_CHECK(state.iot_status == WRITERS * UPDATES);
+    HOST_CHECK(torn_reads == 0);
+    HOST_CHECK(total_reads > 0);
+
+    iot_os_mutex_destroy(&state_lock.writer);
+}
+
+int main(void)
+{
+    test_concurrent();
+
+    printf("test_seqlock: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
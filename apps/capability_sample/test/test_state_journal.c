@@ -0,0 +1,264 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_state_journal.h"
+#include "host_stub.h"
+
+/*
+ * caps_state_journal_init() runs once per process, so every case runs in a child
+ * with the storage shared with the parent, which keeps the blob between cases.
+ */
+struct storage {
+    unsigned char buf[4096];
+    int size;
+    int write_fail;
+    int write_count;
+};
+
+static struct storage *storage;
+static IOT_CAP_HANDLE *handle;
+
+static int storage_read(void *buf, unsigned int size, void *usr_data)
+{
+    if (storage->size < 0)
+        return -1;
+    if ((unsigned int)storage->size < size)
+        size = storage->size;
+    memcpy(buf, storage->buf, size);
+    return size;
+}
+
+static int storage_write(const void *buf, unsigned int size, void *usr_data)
+{
+    if (storage->write_fail || size > sizeof(storage->buf))
+        return -1;
+    memcpy(storage->buf, buf, size);
+    storage->size = size;
+    storage->write_count++;
+    return 0;
+}
+
+static void start(void)
+{
+    static int ctx;
+    caps_state_journal_storage_t journal_storage = { 0 };
+
+    handle = st_cap_handle_init(&ctx, "main", "test", NULL, NULL);
+    HOST_CHECK(caps_sender_add_handle(handle, "main", "test") == 0);
+
+    journal_storage.read = storage_read;
+    journal_storage.write = storage_write;
+    HOST_CHECK(caps_state_journal_init(&journal_storage) == 0);
+    HOST_CHECK(caps_state_journal_register("main", "test", "level") == 0);
+    HOST_CHECK(caps_state_journal_register("main", "test", "mode") == 0);
+}
+
+static int send_level(const char *name, int value)
+{
+    caps_attr_t attr = { 0 };
+
+    attr.handle = handle;
+    attr.name = name;
+    attr.value.type = IOT_CAP_VAL_TYPE_INTEGER;
+    attr.value.integer = value;
+    return caps_sender_send_attrs(&attr, 1);
+}
+
+static int send_mode(const char *mode)
+{
+    caps_attr_t attr = { 0 };
+
+    attr.handle = handle;
+    attr.name = "mode";
+    attr.value.type = IOT_CAP_VAL_TYPE_STRING;
+    attr.value.string = (char *)mode;
+    return caps_sender_send_attrs(&attr, 1);
+}
+
+static double get_level(const char *name)
+{
+    double value;
+
+    if (caps_state_journal_get_number("main", "test", name, &value))
+        return -1;
+    return value;
+}
+
+static void run(const char *name, void (*test)(void))
+{
+    pid_t pid;
+    int status;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        test();
+        fflush(stdout);
+        _exit(host_failures ? 1 : 0);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        printf("%s failed\n", name);
+        host_failures++;
+    }
+}
+
+/* One write after the commit delay for all changes made within it */
+static void test_write(void)
+{
+    caps_state_journal_stats_t stats;
+
+    start();
+    HOST_CHECK(send_level("level", 10) > 0);
+    HOST_CHECK(send_level("level", 20) > 0);
+    HOST_CHECK(send_mode("night") > 0);
+    HOST_CHECK(get_level("level") == 20);
+    HOST_CHECK(storage->write_count == 0);
+
+    iot_os_delay(CAPS_STATE_JOURNAL_COMMIT_DELAY_MS * 4);
+    HOST_CHECK(storage->write_count == 1);
+
+    caps_state_journal_get_stats(&stats);
+    HOST_CHECK(stats.record_count == 3);
+    HOST_CHECK(stats.coalesced_count == 2);
+    HOST_CHECK(stats.write_count == 1);
+
+    /* held by the write interval, flush writes it at once */
+    HOST_CHECK(send_level("level", 30) > 0);
+    iot_os_delay(CAPS_STATE_JOURNAL_COMMIT_DELAY_MS * 4);
+    HOST_CHECK(storage->write_count == 1);
+    HOST_CHECK(caps_state_journal_flush() == 0);
+    HOST_CHECK(storage->write_count == 2);
+}
+
+/* The values written by test_write() are back after a reboot */
+static void test_restore(void)
+{
+    caps_state_journal_stats_t stats;
+    char mode[16];
+
+    start();
+    caps_state_journal_get_stats(&stats);
+    HOST_CHECK(stats.restored_count == 2);
+    HOST_CHECK(get_level("level") == 30);
+    HOST_CHECK(caps_state_journal_get_string("main", "test", "mode", mode, sizeof(mode)) == 0);
+    HOST_CHECK(!strcmp(mode, "night"));
+    HOST_CHECK(caps_state_journal_get_string("main", "test", "mode", mode, 5) == -1);
+    HOST_CHECK(get_level("unknown") == -1);
+
+    /* the same values again don't make a write */
+    HOST_CHECK(send_level("level", 30) > 0);
+    HOST_CHECK(caps_state_journal_flush() == 0);
+    HOST_CHECK(storage->write_count == 0);
+}
+
+static void test_invalid(void)
+{
+    caps_state_journal_stats_t stats;
+
+    start();
+    caps_state_journal_get_stats(&stats);
+    HOST_CHECK(stats.restored_count == 0);
+    HOST_CHECK(get_level("level") == -1);
+}
+
+/* A failed write is retried on the next tick, without waiting for the write interval */
+static void test_write_fail(void)
+{
+    caps_state_journal_stats_t stats;
+
+    start();
+    storage->write_fail = 1;
+    HOST_CHECK(send_level("level", 40) > 0);
+    iot_os_delay(CAPS_STATE_JOURNAL_COMMIT_DELAY_MS * 4);
+    caps_state_journal_get_stats(&stats);
+    HOST_CHECK(stats.fail_count >= 1);
+    HOST_CHECK(storage->write_count == 0);
+
+    storage->write_fail = 0;
+    iot_os_delay(CAPS_STATE_JOURNAL_TICK_MS * 10);
+    caps_state_journal_get_stats(&stats);
+    HOST_CHECK(stats.write_count == 1);
+    HOST_CHECK(storage->write_count == 1);
+    HOST_CHECK(CAPS_STATE_JOURNAL_TICK_MS * 10 < CAPS_STATE_JOURNAL_MIN_WRITE_INTERVAL_MS);
+}
+
+/* "lTBpKrkC" and "lIuHDHTm" have the same hash in main/test */
+static void test_same_hash(void)
+{
+    start();
+    HOST_CHECK(caps_state_journal_register("main", "test", "lTBpKrkC") == 0);
+    HOST_CHECK(send_level("lTBpKrkC", 1) > 0);
+    HOST_CHECK(get_level("lIuHDHTm") == -1);
+
+    HOST_CHECK(caps_state_journal_register("main", "test", "lIuHDHTm") == 0);
+    HOST_CHECK(send_level("lIuHDHTm", 2) > 0);
+    HOST_CHECK(get_level("lTBpKrkC") == 1);
+    HOST_CHECK(get_level("lIuHDHTm") == 2);
+
+    HOST_CHECK(caps_state_journal_register("main", "test",
+            "anAttributeNameTooLongForTheStateJournalNameSize") == -1);
+}
+
+int main(void)
+{
+    unsigned char blob[sizeof(storage->buf)];
+    int size;
+
+    storage = mmap(NULL, sizeof(*storage), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (storage == MAP_FAILED) {
+        printf("test_state_journal: no shared memory\n");
+        return 1;
+    }
+    storage->size = -1;
+
+    run("write", test_write);
+    HOST_CHECK(storage->size > 0);
+    memcpy(blob, storage->buf, storage->size);
+    size = storage->size;
+
+    storage->write_count = 0;
+    run("restore", test_restore);
+
+    /* a flipped bit in a record, a cut blob and another version are ignored */
+    storage->buf[size - 1] ^= 0x01;
+    run("flipped bit", test_invalid);
+    memcpy(storage->buf, blob, size);
+    storage->size = size - 1;
+    run("cut blob", test_invalid);
+    storage->size = size;
+    storage->buf[4]++;
+    run("version", test_invalid);
+
+    storage->size = -1;
+    storage->write_count = 0;
+    run("write fail", test_write_fail);
+    run("same hash", test_same_hash);
+
+    printf("test_state_journal: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "caps_util.h"
+#include "host_stub.h"
+
+static void test_milli(void)
+{
+    iot_cap_val_t value;
+    int64_t milli;
+
+    HOST_CHECK(caps_util_double_to_milli(23.5, &milli) == 0 && milli == 23500);
+    HOST_CHECK(caps_util_double_to_milli(-0.0015, &milli) == 0 && milli == -2);
+    /* a kWh counter beyond int32_t milli-units */
+    HOST_CHECK(caps_util_double_to_milli(5000000.25, &milli) == 0 && milli == 5000000250LL);
+    HOST_CHECK(caps_util_milli_to_double(milli) == 5000000.25);
+    HOST_CHECK(caps_util_double_to_milli(1e300, &milli) < 0);
+    HOST_CHECK(caps_util_double_to_milli(0.0 / 0.0, &milli) < 0);
+    HOST_CHECK(CAPS_UTIL_MILLI(3000000) == 3000000000LL);
+
+    caps_util_milli_to_val(23000, &value);
+    HOST_CHECK(value.type == IOT_CAP_VAL_TYPE_INTEGER && value.integer == 23);
+    caps_util_milli_to_val(-23500, &value);
+    HOST_CHECK(value.type == IOT_CAP_VAL_TYPE_NUMBER && value.number == -23.5);
+    /* whole, but not an int */
+    caps_util_milli_to_val(5000000000000LL, &value);
+    HOST_CHECK(value.type == IOT_CAP_VAL_TYPE_NUMBER && value.number == 5000000000.0);
+}
+
+int main(void)
+{
+    test_milli();
+
+    printf("test_util: %s\n", host_failures ? "FAIL" : "ok");
+    return host_failures ? 1 : 0;
+}
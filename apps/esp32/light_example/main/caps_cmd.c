@@ -0,0 +1,594 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_cmd.h"
+#include "caps_util.h"
+#include "caps_sender.h"
+
+/* registered to iot-core for good, cmd_cb is NULL while the wrapper is detached */
+struct caps_cmd_entry {
+    IOT_CAP_HANDLE *handle;
+    const char *cmd_type;
+    st_cap_cmd_cb cmd_cb;
+    void *usr_data;
+    int collapse;
+    struct caps_cmd_job *pending;   /* latest command waiting in the queue, if collapse */
+    struct caps_cmd_entry *next;
+};
+
+/* a received command, copied with its strings right after it */
+struct caps_cmd_job {
+    struct caps_cmd_entry *entry;
+    IOT_CAP_HANDLE *handle;
+    unsigned int queued_ms;
+    iot_cap_cmd_data_t cmd_data;
+};
+
+/* queued item, job is NULL for a collapsing command which keeps it in entry->pending */
+struct caps_cmd_item {
+    struct caps_cmd_entry *entry;
+    struct caps_cmd_job *job;
+};
+
+static struct caps_cmd_entry *cmd_entries;
+static iot_os_mutex cmd_mutex;
+static int cmd_mutex_ready;
+static struct caps_cmd_entry *cmd_running;
+static iot_os_queue *cmd_queue;
+static iot_os_thread cmd_thread;
+static unsigned int cmd_queued_num;
+static caps_cmd_batch_cb cmd_batch_cb;
+static unsigned int cmd_batch_window_ms;
+static void *cmd_batch_usr_data;
+static caps_cmd_stats_t cmd_stats;
+
+static int _cmd_lock_init(void)
+{
+    if (!cmd_mutex_ready) {
+        if (iot_os_mutex_init(&cmd_mutex) != IOT_OS_TRUE) {
+            printf("fail to init command mutex\n");
+            return -1;
+        }
+        cmd_mutex_ready = 1;
+    }
+    return 0;
+}
+
+/* cmd_mutex must be held */
+static struct caps_cmd_entry *_find_entry(IOT_CAP_HANDLE *handle, const char *cmd_type)
+{
+    struct caps_cmd_entry *entry;
+
+    for (entry = cmd_entries; entry; entry = entry->next) {
+        if (entry->handle == handle && !strcmp(entry->cmd_type, cmd_type)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Returns -1 if the wrapper of entry has been detached */
+static int _call_cmd(struct caps_cmd_entry *entry, IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data)
+{
+    st_cap_cmd_cb cmd_cb;
+    void *usr_data;
+
+    iot_os_mutex_lock(&cmd_mutex);
+    cmd_cb = entry->cmd_cb;
+    usr_data = entry->usr_data;
+    if (cmd_cb) {
+        cmd_running = entry;
+    }
+    iot_os_mutex_unlock(&cmd_mutex);
+
+    if (!cmd_cb) {
+        return -1;
+    }
+    cmd_cb(handle, cmd_data, usr_data);
+
+    iot_os_mutex_lock(&cmd_mutex);
+    cmd_running = NULL;
+    iot_os_mutex_unlock(&cmd_mutex);
+    return 0;
+}
+
+static size_t _arg_size(const iot_cap_val_t *arg)
+{
+    size_t size = 0;
+    int i;
+
+    switch (arg->type) {
+    case IOT_CAP_VAL_TYPE_STRING:
+        if (arg->string)
+            size = strlen(arg->string) + 1;
+        break;
+    case IOT_CAP_VAL_TYPE_JSON_OBJECT:
+        if (arg->json_object)
+            size = strlen(arg->json_object) + 1;
+        break;
+    case IOT_CAP_VAL_TYPE_STR_ARRAY:
+        if (!arg->strings)
+            break;
+        size = sizeof(char *) * arg->str_num;
+        for (i = 0; i < arg->str_num; i++) {
+            if (arg->strings[i])
+                size += strlen(arg->strings[i]) + 1;
+        }
+        break;
+    default:
+        break;
+    }
+    return size;
+}
+
+static char *_copy_string(char **pool, const char *string)
+{
+    char *copy = *pool;
+    size_t len;
+
+    if (!string)
+        return NULL;
+    len = strlen(string) + 1;
+    memcpy(copy, string, len);
+    *pool += len;
+    return copy;
+}
+
+static struct caps_cmd_job *_job_create(struct caps_cmd_entry *entry, IOT_CAP_HANDLE *handle,
+        iot_cap_cmd_data_t *cmd_data)
+{
+    struct caps_cmd_job *job;
+    iot_cap_val_t *arg;
+    size_t size = sizeof(struct caps_cmd_job);
+    char **strings;
+    char *pool;
+    int num_args = cmd_data->num_args;
+    int i;
+    int j;
+
+    if (num_args > MAX_CMD_ARG)
+        num_args = MAX_CMD_ARG;
+    for (i = 0; i < num_args; i++) {
+        size += _arg_size(&cmd_data->cmd_data[i]);
+    }
+
+    job = malloc(size);
+    if (!job) {
+        printf("fail to malloc for caps_cmd_job\n");
+        return NULL;
+    }
+    job->entry = entry;
+    job->handle = handle;
+    memcpy(&job->cmd_data, cmd_data, sizeof(iot_cap_cmd_data_t));
+    job->cmd_data.num_args = num_args;
+
+    /* string arrays first to keep the pointers aligned */
+    pool = (char *)(job + 1);
+    for (i = 0; i < num_args; i++) {
+        arg = &job->cmd_data.cmd_data[i];
+        if (arg->type == IOT_CAP_VAL_TYPE_STR_ARRAY && arg->strings) {
+            strings = (char **)pool;
+            pool += sizeof(char *) * arg->str_num;
+            memcpy(strings, arg->strings, sizeof(char *) * arg->str_num);
+            arg->strings = strings;
+        }
+    }
+    for (i = 0; i < num_args; i++) {
+        arg = &job->cmd_data.cmd_data[i];
+        if (arg->type == IOT_CAP_VAL_TYPE_STRING) {
+            arg->string = _copy_string(&pool, arg->string);
+        } else if (arg->type == IOT_CAP_VAL_TYPE_JSON_OBJECT) {
+            arg->json_object = _copy_string(&pool, arg->json_object);
+        } else if (arg->type == IOT_CAP_VAL_TYPE_STR_ARRAY && arg->strings) {
+            for (j = 0; j < arg->str_num; j++) {
+                arg->strings[j] = _copy_string(&pool, arg->strings[j]);
+            }
+        }
+    }
+    return job;
+}
+
+static struct caps_cmd_job *_take_job(struct caps_cmd_item *item)
+{
+    struct caps_cmd_job *job = item->job;
+
+    if (!job) {
+        /* a collapsing command is queued once, take its latest arguments */
+        iot_os_mutex_lock(&cmd_mutex);
+        job = item->entry->pending;
+        item->entry->pending = NULL;
+        iot_os_mutex_unlock(&cmd_mutex);
+    }
+    return job;
+}
+
+/* Returns -1 if the command was dropped as its wrapper has been detached */
+static int _run_job(struct caps_cmd_job *job)
+{
+    unsigned int start_ms;
+    unsigned int wait_ms;
+    unsigned int exec_ms;
+
+    start_ms = caps_util_get_time_ms();
+    if (_call_cmd(job->entry, job->handle, &job->cmd_data)) {
+        iot_os_mutex_lock(&cmd_mutex);
+        cmd_queued_num--;
+        cmd_stats.dropped_count++;
+        iot_os_mutex_unlock(&cmd_mutex);
+        return -1;
+    }
+    exec_ms = caps_util_get_time_ms() - start_ms;
+    wait_ms = start_ms - job->queued_ms;
+
+    iot_os_mutex_lock(&cmd_mutex);
+    cmd_queued_num--;
+    cmd_stats.executed_count++;
+    cmd_stats.total_wait_ms += wait_ms;
+    if (wait_ms > cmd_stats.max_wait_ms)
+        cmd_stats.max_wait_ms = wait_ms;
+    cmd_stats.total_exec_ms += exec_ms;
+    if (exec_ms > cmd_stats.max_exec_ms)
+        cmd_stats.max_exec_ms = exec_ms;
+    iot_os_mutex_unlock(&cmd_mutex);
+    return 0;
+}
+
+static void _run_batch(struct caps_cmd_job *first)
+{
+    struct caps_cmd_job *jobs[CAPS_CMD_BATCH_MAX];
+    caps_cmd_batch_item_t items[CAPS_CMD_BATCH_MAX];
+    struct caps_cmd_item item;
+    int job_num = 0;
+    int item_num = 0;
+    int i;
+
+    /* commands of a message come back to back, give the rest time to arrive */
+    iot_os_delay(cmd_batch_window_ms);
+
+    jobs[job_num++] = first;
+    while (job_num < CAPS_CMD_BATCH_MAX &&
+            iot_os_queue_receive(cmd_queue, &item, 0) == IOT_OS_TRUE) {
+        jobs[job_num] = _take_job(&item);
+        if (jobs[job_num])
+            job_num++;
+    }
+
+    caps_sender_batch_begin();
+    for (i = 0; i < job_num; i++) {
+        if (_run_job(jobs[i]))
+            continue;
+        items[item_num].handle = jobs[i]->handle;
+        items[item_num].cmd_type = jobs[i]->entry->cmd_type;
+        items[item_num].cmd_data = &jobs[i]->cmd_data;
+        item_num++;
+    }
+    if (item_num > 0)
+        cmd_batch_cb(items, item_num, cmd_batch_usr_data);
+    caps_sender_batch_end();
+
+    iot_os_mutex_lock(&cmd_mutex);
+    cmd_stats.batch_count++;
+    if ((unsigned int)item_num > cmd_stats.max_batch_size)
+        cmd_stats.max_batch_size = item_num;
+    iot_os_mutex_unlock(&cmd_mutex);
+
+    for (i = 0; i < job_num; i++) {
+        free(jobs[i]);
+    }
+}
+
+static void _cmd_task(void *arg)
+{
+    struct caps_cmd_item item;
+    struct caps_cmd_job *job;
+
+    for (;;) {
+        if (iot_os_queue_receive(cmd_queue, &item, IOT_OS_MAX_DELAY) != IOT_OS_TRUE) {
+            continue;
+        }
+
+        job = _take_job(&item);
+        if (!job) {
+            continue;
+        }
+        if (cmd_batch_cb) {
+            _run_batch(job);
+        } else {
+            _run_job(job);
+            free(job);
+        }
+    }
+}
+
+static void _cmd_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)
+{
+    struct caps_cmd_entry *entry = usr_data;
+    struct caps_cmd_item item;
+    struct caps_cmd_job *job;
+
+    if (!cmd_thread) {
+        _call_cmd(entry, handle, cmd_data);
+        return;
+    }
+
+    job = _job_create(entry, handle, cmd_data);
+    if (!job) {
+        iot_os_mutex_lock(&cmd_mutex);
+        cmd_stats.dropped_count++;
+        iot_os_mutex_unlock(&cmd_mutex);
+        return;
+    }
+    job->queued_ms = caps_util_get_time_ms();
+
+    /* counted before sending, the task may take it right away */
+    iot_os_mutex_lock(&cmd_mutex);
+    if (!entry->cmd_cb) {
+        /* no wrapper attached to the handle */
+        cmd_stats.dropped_count++;
+        iot_os_mutex_unlock(&cmd_mutex);
+        free(job);
+        return;
+    }
+    if (entry->collapse && entry->pending) {
+        /* the queued one is not started yet, only the latest arguments run */
+        free(entry->pending);
+        entry->pending = job;
+        cmd_stats.collapsed_count++;
+        iot_os_mutex_unlock(&cmd_mutex);
+        return;
+    }
+    if (entry->collapse)
+        entry->pending = job;
+    cmd_queued_num++;
+    iot_os_mutex_unlock(&cmd_mutex);
+
+    item.entry = entry;
+    item.job = entry->collapse ? NULL : job;
+    if (iot_os_queue_send(cmd_queue, &item, 0) != IOT_OS_TRUE) {
+        printf("command queue is full, command is dropped\n");
+        iot_os_mutex_lock(&cmd_mutex);
+        if (entry->collapse) {
+            job = entry->pending;
+            entry->pending = NULL;
+        }
+        cmd_queued_num--;
+        cmd_stats.dropped_count++;
+        iot_os_mutex_unlock(&cmd_mutex);
+        free(job);
+        return;
+    }
+
+    iot_os_mutex_lock(&cmd_mutex);
+    cmd_stats.queued_count++;
+    if (cmd_queued_num > cmd_stats.max_queued)
+        cmd_stats.max_queued = cmd_queued_num;
+    iot_os_mutex_unlock(&cmd_mutex);
+}
+
+int caps_cmd_set_cb_n(IOT_CAP_HANDLE **handles, int num, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data)
+{
+    struct caps_cmd_entry *block = NULL;
+    struct caps_cmd_entry *entry;
+    int new_num = 0;
+    int used = 0;
+    int err = 0;
+    int i;
+
+    if (!handles || num <= 0 || !cmd_type || !cmd_cb) {
+        printf("invalid parameter\n");
+        return -1;
+    }
+    for (i = 0; i < num; i++) {
+        if (!handles[i]) {
+            printf("invalid parameter\n");
+            return -1;
+        }
+    }
+    if (_cmd_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&cmd_mutex);
+    for (i = 0; i < num; i++) {
+        if (!_find_entry(handles[i], cmd_type)) {
+            new_num++;
+        }
+    }
+    if (new_num > 0) {
+        block = calloc(new_num, sizeof(struct caps_cmd_entry));
+        if (!block) {
+            iot_os_mutex_unlock(&cmd_mutex);
+            printf("fail to malloc for %d caps_cmd_entry\n", new_num);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < num; i++) {
+        entry = _find_entry(handles[i], cmd_type);
+        if (entry) {
+            /* a wrapper attached again to a kept handle */
+            entry->cmd_cb = cmd_cb;
+            entry->usr_data = usr_data;
+            continue;
+        }
+
+        entry = &block[used];
+        entry->handle = handles[i];
+        entry->cmd_type = cmd_type;
+        entry->cmd_cb = cmd_cb;
+        entry->usr_data = usr_data;
+
+        err = st_cap_cmd_set_cb(handles[i], cmd_type, _cmd_cb, entry);
+        if (err) {
+            break;
+        }
+        /* iot-core keeps entry as its usr_data, so the block is never freed once used */
+        used++;
+        entry->next = cmd_entries;
+        cmd_entries = entry;
+    }
+    if (block && used == 0) {
+        free(block);
+    }
+    iot_os_mutex_unlock(&cmd_mutex);
+    return err;
+}
+
+int caps_cmd_set_cb(IOT_CAP_HANDLE *handle, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data)
+{
+    return caps_cmd_set_cb_n(&handle, 1, cmd_type, cmd_cb, usr_data);
+}
+
+void caps_cmd_unset_cb(IOT_CAP_HANDLE *handle)
+{
+    struct caps_cmd_entry *entry;
+    struct caps_cmd_job *job;
+
+    if (!handle || !cmd_mutex_ready) {
+        return;
+    }
+
+    iot_os_mutex_lock(&cmd_mutex);
+    for (entry = cmd_entries; entry; entry = entry->next) {
+        if (entry->handle != handle) {
+            continue;
+        }
+        entry->cmd_cb = NULL;
+        entry->usr_data = NULL;
+        job = entry->pending;
+        if (job) {
+            /* its queue item finds nothing to run */
+            entry->pending = NULL;
+            cmd_queued_num--;
+            cmd_stats.dropped_count++;
+            free(job);
+        }
+    }
+    /* a command of the handle may still be using the wrapper */
+    while (cmd_running && cmd_running->handle == handle) {
+        iot_os_mutex_unlock(&cmd_mutex);
+        iot_os_delay(1);
+        iot_os_mutex_lock(&cmd_mutex);
+    }
+    iot_os_mutex_unlock(&cmd_mutex);
+}
+
+int caps_cmd_set_collapse(IOT_CAP_HANDLE *handle, const char *cmd_type, int enable)
+{
+    struct caps_cmd_entry *entry;
+
+    if (!cmd_type) {
+        printf("cmd_type is NULL\n");
+        return -1;
+    }
+    if (cmd_thread) {
+        printf("collapse has to be set before the executor starts\n");
+        return -1;
+    }
+
+    entry = _find_entry(handle, cmd_type);
+    if (!entry) {
+        printf("%s is not registered\n", cmd_type);
+        return -1;
+    }
+    entry->collapse = enable;
+    return 0;
+}
+
+int caps_cmd_set_batch_cb(caps_cmd_batch_cb batch_cb, unsigned int window_ms, void *usr_data)
+{
+    if (cmd_thread) {
+        printf("batch has to be set before the executor starts\n");
+        return -1;
+    }
+
+    cmd_batch_cb = batch_cb;
+    cmd_batch_window_ms = window_ms;
+    cmd_batch_usr_data = usr_data;
+    return 0;
+}
+
+int caps_cmd_executor_start(unsigned int depth, int priority)
+{
+    if (cmd_thread) {
+        printf("command executor is already running\n");
+        return -1;
+    }
+    if (!depth) {
+        printf("invalid queue depth\n");
+        return -1;
+    }
+
+    if (_cmd_lock_init()) {
+        return -1;
+    }
+    cmd_queue = iot_os_queue_create(depth, sizeof(struct caps_cmd_item));
+    if (!cmd_queue) {
+        printf("fail to create command queue\n");
+        return -1;
+    }
+    /* start the clock before the first command */
+    caps_util_get_time_ms();
+    if (iot_os_thread_create(_cmd_task, "caps_cmd", CAPS_CMD_TASK_STACK_SIZE,
+            NULL, priority, &cmd_thread) != IOT_OS_TRUE) {
+        printf("fail to create command task\n");
+        iot_os_queue_delete(cmd_queue);
+        cmd_queue = NULL;
+        cmd_thread = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+int caps_cmd_executor_is_running(void)
+{
+    return cmd_thread != NULL;
+}
+
+void caps_cmd_get_stats(caps_cmd_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+
+    if (cmd_mutex_ready) {
+        iot_os_mutex_lock(&cmd_mutex);
+        *stats = cmd_stats;
+        iot_os_mutex_unlock(&cmd_mutex);
+    } else {
+        *stats = cmd_stats;
+    }
+}
+
+void caps_cmd_reset_stats(void)
+{
+    if (cmd_mutex_ready) {
+        iot_os_mutex_lock(&cmd_mutex);
+        memset(&cmd_stats, 0, sizeof(cmd_stats));
+        iot_os_mutex_unlock(&cmd_mutex);
+    } else {
+        memset(&cmd_stats, 0, sizeof(cmd_stats));
+    }
+}
@@ -0,0 +1,132 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_CMD_H_
+#define _CAPS_CMD_H_
+
+#include "st_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Default number of commands which can wait for the executor */
+#ifndef CAPS_CMD_QUEUE_DEPTH
+#define CAPS_CMD_QUEUE_DEPTH 8
+#endif
+
+/* Most commands handed to the batch callback at once */
+#ifndef CAPS_CMD_BATCH_MAX
+#define CAPS_CMD_BATCH_MAX 8
+#endif
+
+#ifndef CAPS_CMD_TASK_STACK_SIZE
+#define CAPS_CMD_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CAPS_CMD_TASK_PRIORITY
+#define CAPS_CMD_TASK_PRIORITY 10
+#endif
+
+typedef struct caps_cmd_stats {
+    unsigned int queued_count;
+    unsigned int dropped_count;     /* the queue was full */
+    unsigned int collapsed_count;   /* replaced by a newer one before running */
+    unsigned int executed_count;
+    unsigned int max_queued;        /* most commands waiting at once */
+    unsigned int total_wait_ms;     /* time from receipt to the start of execution */
+    unsigned int max_wait_ms;
+    unsigned int total_exec_ms;     /* time spent in the command callbacks */
+    unsigned int max_exec_ms;
+    unsigned int batch_count;
+    unsigned int max_batch_size;
+} caps_cmd_stats_t;
+
+typedef struct caps_cmd_batch_item {
+    IOT_CAP_HANDLE *handle;
+    const char *cmd_type;
+    iot_cap_cmd_data_t *cmd_data;
+} caps_cmd_batch_item_t;
+
+typedef void (*caps_cmd_batch_cb)(caps_cmd_batch_item_t *items, int item_num, void *usr_data);
+
+/**
+ * Called by caps_{CAPABILITY}_initialize instead of st_cap_cmd_set_cb().
+ *
+ * Without the executor, cmd_cb runs in the iot-core callback context as before.
+ */
+int caps_cmd_set_cb(IOT_CAP_HANDLE *handle, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data);
+/* Same for the handles of num channels, their entries are allocated at once */
+int caps_cmd_set_cb_n(IOT_CAP_HANDLE **handles, int num, const char *cmd_type, st_cap_cmd_cb cmd_cb, void *usr_data);
+
+/**
+ * Called by caps_{CAPABILITY}_deinitialize.
+ *
+ * iot-core can't drop a command callback, so the commands of handle stay
+ * registered and are ignored until caps_cmd_set_cb() is called again for them.
+ * Queued commands of handle are dropped, and a running one is waited for, so
+ * don't call it from a command callback of handle.
+ */
+void caps_cmd_unset_cb(IOT_CAP_HANDLE *handle);
+
+/**
+ * Command executor.
+ *
+ * Once started, received commands are copied into a queue of depth entries and
+ * cmd_cb, including the cmd_*_usr_cb of the app, runs in a caps_cmd task of the given
+ * priority, so slow actuation doesn't block the iot-core task. Commands run one at a
+ * time in the order received. A command arriving while the queue is full is dropped.
+ * The executor can't be stopped once started.
+ */
+int caps_cmd_executor_start(unsigned int depth, int priority);
+int caps_cmd_executor_is_running(void);
+
+/**
+ * Latest-wins collapsing, for slider-like commands such as setLevel or setHue.
+ *
+ * While a command of a collapsing cmd_type is waiting in the executor queue,
+ * a newer one replaces its arguments instead of being queued, so only the last
+ * value is actuated and sent back. Commands like volumeUp must not collapse.
+ * It has to be set before caps_cmd_executor_start() and only applies with it.
+ */
+int caps_cmd_set_collapse(IOT_CAP_HANDLE *handle, const char *cmd_type, int enable);
+
+/**
+ * Batch delivery, for commands which come together like on, setLevel and
+ * setColorTemperature of a scene.
+ *
+ * The executor waits window_ms after a command for the rest of the message and
+ * takes every queued command, up to CAPS_CMD_BATCH_MAX. The command callbacks of
+ * the wrappers update the attributes, then batch_cb gets all commands at once to
+ * actuate the final state a single time, and the changed attributes are sent in
+ * one message. Leave cmd_*_usr_cb unset for commands handled by batch_cb.
+ * The executor can't tell a lone command from the first one of a message, so
+ * every command, even a single one, starts window_ms after it is taken from the
+ * queue. Keep window_ms small, 20 ms covers the commands of one message.
+ * It has to be set before caps_cmd_executor_start() and only applies with it.
+ */
+int caps_cmd_set_batch_cb(caps_cmd_batch_cb batch_cb, unsigned int window_ms, void *usr_data);
+
+void caps_cmd_get_stats(caps_cmd_stats_t *stats);
+void caps_cmd_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_CMD_H_ */
@@ -22,6 +22,8 @@
 
 #include "st_dev.h"
 #include "caps_colorTemperature.h"
+#include "caps_sender.h"
+#include "caps_cmd.h"
 
 static int caps_colorTemperature_get_colorTemperature_value(caps_colorTemperature_data_t *caps_data)
 {
@@ -68,7 +70,7 @@ static void caps_colorTemperature_attr_colorTemperature_send(caps_colorTemperatu
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_colorTemperature.attr_colorTemperature.name,
             caps_data->colorTemperature_value,
             caps_data->colorTemperature_unit,
@@ -100,9 +102,12 @@ static void caps_colorTemperature_cmd_setColorTemperature_cb(IOT_CAP_HANDLE *han
 static void caps_colorTemperature_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_colorTemperature_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_colorTemperature_attr_colorTemperature_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_colorTemperature_data_t *caps_colorTemperature_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -128,10 +133,10 @@ caps_colorTemperature_data_t *caps_colorTemperature_initialize(IOT_CTX *ctx, con
     caps_data->attr_colorTemperature_send = caps_colorTemperature_attr_colorTemperature_send;
     caps_data->colorTemperature_value = 1;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_colorTemperature.id, caps_colorTemperature_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_colorTemperature.id, caps_colorTemperature_init_cb, caps_data);
     }
     if (caps_data->handle) {
-        err = st_cap_cmd_set_cb(caps_data->handle, caps_helper_colorTemperature.cmd_setColorTemperature.name, caps_colorTemperature_cmd_setColorTemperature_cb, caps_data);
+        err = caps_cmd_set_cb(caps_data->handle, caps_helper_colorTemperature.cmd_setColorTemperature.name, caps_colorTemperature_cmd_setColorTemperature_cb, caps_data);
         if (err) {
             printf("fail to set cmd_cb for setColorTemperature of colorTemperature\n");
     }
@@ -141,3 +146,17 @@ caps_colorTemperature_data_t *caps_colorTemperature_initialize(IOT_CTX *ctx, con
 
     return caps_data;
 }
+
+void caps_colorTemperature_deinitialize(caps_colorTemperature_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_cmd_unset_cb(caps_data->handle);
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -42,6 +42,7 @@ typedef struct caps_colorTemperature_data {
 } caps_colorTemperature_data_t;
 
 caps_colorTemperature_data_t *caps_colorTemperature_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_colorTemperature_deinitialize(caps_colorTemperature_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 
 #include "st_dev.h"
 #include "caps_dustSensor.h"
+#include "caps_sender.h"
 
 static int caps_dustSensor_get_fineDustLevel_value(caps_dustSensor_data_t *caps_data)
 {
@@ -68,7 +69,7 @@ static void caps_dustSensor_attr_fineDustLevel_send(caps_dustSensor_data_t *caps
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_dustSensor.attr_fineDustLevel.name,
             caps_data->fineDustLevel_value,
             caps_data->fineDustLevel_unit,
@@ -127,7 +128,7 @@ static void caps_dustSensor_attr_dustLevel_send(caps_dustSensor_data_t *caps_dat
         return;
     }
 
-    ST_CAP_SEND_ATTR_NUMBER(caps_data->handle,
+    CAPS_SEND_ATTR_NUMBER(caps_data->handle,
             (char *)caps_helper_dustSensor.attr_dustLevel.name,
             caps_data->dustLevel_value,
             caps_data->dustLevel_unit,
@@ -144,10 +145,13 @@ static void caps_dustSensor_attr_dustLevel_send(caps_dustSensor_data_t *caps_dat
 static void caps_dustSensor_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
 {
     caps_dustSensor_data_t *caps_data = usr_data;
+
+    caps_sender_init_cb_begin(handle);
     if (caps_data && caps_data->init_usr_cb)
         caps_data->init_usr_cb(caps_data);
     caps_dustSensor_attr_fineDustLevel_send(caps_data);
     caps_dustSensor_attr_dustLevel_send(caps_data);
+    caps_sender_init_cb_end(handle);
 }
 
 caps_dustSensor_data_t *caps_dustSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)
@@ -178,7 +182,7 @@ caps_dustSensor_data_t *caps_dustSensor_initialize(IOT_CTX *ctx, const char *com
     caps_data->fineDustLevel_value = 0;
     caps_data->dustLevel_value = 0;
     if (ctx) {
-        caps_data->handle = st_cap_handle_init(ctx, component, caps_helper_dustSensor.id, caps_dustSensor_init_cb, caps_data);
+        caps_data->handle = caps_sender_handle_init(ctx, component, caps_helper_dustSensor.id, caps_dustSensor_init_cb, caps_data);
     }
     if (!caps_data->handle) {
         printf("fail to init dustSensor handle\n");
@@ -186,3 +190,16 @@ caps_dustSensor_data_t *caps_dustSensor_initialize(IOT_CTX *ctx, const char *com
 
     return caps_data;
 }
+
+void caps_dustSensor_deinitialize(caps_dustSensor_data_t *caps_data)
+{
+    if (!caps_data) {
+        printf("caps_data is NULL\n");
+        return;
+    }
+
+    if (caps_data->handle) {
+        caps_sender_handle_detach(caps_data->handle);
+    }
+    free(caps_data);
+}
@@ -47,6 +47,7 @@ typedef struct caps_dustSensor_data {
 } caps_dustSensor_data_t;
 
 caps_dustSensor_data_t *caps_dustSensor_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_dustSensor_deinitialize(caps_dustSensor_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,219 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_payload_cache.h"
+#include "caps_send_cache.h"
+
+/* caps_sender only builds events through the cache when built with the flag */
+#ifndef CAPS_SENDER_USE_PAYLOAD_CACHE
+#error "caps_payload_cache needs CAPS_SENDER_USE_PAYLOAD_CACHE defined for the whole build"
+#endif
+
+struct caps_payload_cache_entry {
+    IOT_CAP_HANDLE *handle;
+    const char *attribute;
+    IOT_EVENT *cap_evt;
+    caps_send_cache_value_t value;  /* of cap_evt */
+    int in_use;                 /* cap_evt is queued or being sent */
+    int stale;                  /* free cap_evt when it comes back */
+};
+
+static struct caps_payload_cache_entry payload_entry[CAPS_PAYLOAD_CACHE_SIZE];
+static int payload_entry_num;
+static caps_payload_cache_stats_t payload_stats;
+static iot_os_mutex payload_mutex;
+
+static struct caps_payload_cache_entry *_find_entry(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    int i;
+
+    /* wrappers pass caps_helper_X.attr_Y.name, so the pointer usually matches */
+    for (i = 0; i < payload_entry_num; i++) {
+        if (payload_entry[i].handle == handle && payload_entry[i].attribute == attribute)
+            return &payload_entry[i];
+    }
+    for (i = 0; i < payload_entry_num; i++) {
+        if (payload_entry[i].handle == handle && !strcmp(payload_entry[i].attribute, attribute))
+            return &payload_entry[i];
+    }
+    return NULL;
+}
+
+int caps_payload_cache_register(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    struct caps_payload_cache_entry *entry;
+
+    if (!handle || !attribute) {
+        printf("invalid handle or attribute\n");
+        return -1;
+    }
+
+    if (payload_entry_num == 0) {
+        if (iot_os_mutex_init(&payload_mutex) != IOT_OS_TRUE) {
+            printf("fail to init payload cache mutex\n");
+            return -1;
+        }
+    }
+
+    iot_os_mutex_lock(&payload_mutex);
+    if (_find_entry(handle, attribute)) {
+        iot_os_mutex_unlock(&payload_mutex);
+        return 0;
+    }
+    if (payload_entry_num >= CAPS_PAYLOAD_CACHE_SIZE) {
+        iot_os_mutex_unlock(&payload_mutex);
+        printf("payload cache is full for %s\n", attribute);
+        return -1;
+    }
+    entry = &payload_entry[payload_entry_num];
+    memset(entry, 0, sizeof(*entry));
+    entry->handle = handle;
+    entry->attribute = attribute;
+    payload_entry_num++;
+    iot_os_mutex_unlock(&payload_mutex);
+
+    return 0;
+}
+
+void caps_payload_cache_invalidate(IOT_CAP_HANDLE *handle)
+{
+    struct caps_payload_cache_entry *entry;
+    int i;
+
+    if (payload_entry_num == 0)
+        return;
+
+    iot_os_mutex_lock(&payload_mutex);
+    for (i = 0; i < payload_entry_num; i++) {
+        entry = &payload_entry[i];
+        if ((handle && entry->handle != handle) || !entry->cap_evt)
+            continue;
+        if (entry->in_use) {
+            entry->stale = 1;
+        } else {
+            st_cap_free_attr(entry->cap_evt);
+            entry->cap_evt = NULL;
+        }
+    }
+    iot_os_mutex_unlock(&payload_mutex);
+}
+
+void caps_payload_cache_get_stats(caps_payload_cache_stats_t *stats)
+{
+    if (!stats)
+        return;
+    if (payload_entry_num == 0) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    iot_os_mutex_lock(&payload_mutex);
+    *stats = payload_stats;
+    iot_os_mutex_unlock(&payload_mutex);
+}
+
+void caps_payload_cache_reset_stats(void)
+{
+    if (payload_entry_num == 0)
+        return;
+    iot_os_mutex_lock(&payload_mutex);
+    memset(&payload_stats, 0, sizeof(payload_stats));
+    iot_os_mutex_unlock(&payload_mutex);
+}
+
+IOT_EVENT *caps_payload_cache_get(const caps_attr_t *attr)
+{
+    struct caps_payload_cache_entry *entry;
+    IOT_EVENT *cap_evt = NULL;
+    caps_send_cache_value_t value;
+
+    if (payload_entry_num == 0)
+        return NULL;
+
+    iot_os_mutex_lock(&payload_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (!entry) {
+        iot_os_mutex_unlock(&payload_mutex);
+        return NULL;
+    }
+    if (entry->in_use) {
+        payload_stats.busy_count++;
+        iot_os_mutex_unlock(&payload_mutex);
+        return NULL;
+    }
+
+    /* a long value is never equal, it may differ beyond the kept bytes */
+    caps_send_cache_value_set(&value, attr);
+    if (entry->cap_evt && caps_send_cache_value_equal(&entry->value, &value)) {
+        payload_stats.hit_count++;
+    } else {
+        if (entry->cap_evt)
+            st_cap_free_attr(entry->cap_evt);
+        /* the event keeps its own copy of the value */
+        entry->cap_evt = st_cap_create_attr(attr->handle, attr->name,
+                (iot_cap_val_t *)&attr->value, attr->unit, attr->data);
+        entry->value = value;
+        if (!entry->cap_evt) {
+            iot_os_mutex_unlock(&payload_mutex);
+            return NULL;
+        }
+        payload_stats.build_count++;
+    }
+    entry->in_use = 1;
+    cap_evt = entry->cap_evt;
+    iot_os_mutex_unlock(&payload_mutex);
+
+    return cap_evt;
+}
+
+void caps_payload_cache_free_events(IOT_EVENT **cap_evt, int evt_num)
+{
+    struct caps_payload_cache_entry *entry;
+    int i, j;
+
+    if (payload_entry_num == 0) {
+        for (i = 0; i < evt_num; i++)
+            st_cap_free_attr(cap_evt[i]);
+        return;
+    }
+
+    iot_os_mutex_lock(&payload_mutex);
+    for (i = 0; i < evt_num; i++) {
+        for (j = 0; j < payload_entry_num; j++) {
+            if (payload_entry[j].cap_evt == cap_evt[i] && payload_entry[j].in_use)
+                break;
+        }
+        if (j == payload_entry_num) {
+            st_cap_free_attr(cap_evt[i]);
+            continue;
+        }
+
+        entry = &payload_entry[j];
+        entry->in_use = 0;
+        if (entry->stale) {
+            st_cap_free_attr(entry->cap_evt);
+            entry->cap_evt = NULL;
+            entry->stale = 0;
+        }
+    }
+    iot_os_mutex_unlock(&payload_mutex);
+}
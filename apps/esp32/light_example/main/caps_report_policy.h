@@ -0,0 +1,120 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_REPORT_POLICY_H_
+#define _CAPS_REPORT_POLICY_H_
+
+#include "st_dev.h"
+#include "caps_sender.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of attributes which can have a reporting policy */
+#ifndef CAPS_REPORT_POLICY_SIZE
+#define CAPS_REPORT_POLICY_SIZE 16
+#endif
+
+/* Longest attribute name, with its terminator, set by name or loaded from JSON */
+#ifndef CAPS_REPORT_POLICY_NAME_SIZE
+#define CAPS_REPORT_POLICY_NAME_SIZE 32
+#endif
+
+/* How often held values and heartbeats are checked */
+#ifndef CAPS_REPORT_POLICY_TICK_MS
+#define CAPS_REPORT_POLICY_TICK_MS 1000
+#endif
+
+#ifndef CAPS_REPORT_POLICY_TASK_STACK_SIZE
+#define CAPS_REPORT_POLICY_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CAPS_REPORT_POLICY_TASK_PRIORITY
+#define CAPS_REPORT_POLICY_TASK_PRIORITY 10
+#endif
+
+typedef struct caps_report_policy {
+    unsigned int min_interval_ms;   /* 0 : no lower limit between reports */
+    unsigned int max_interval_ms;   /* 0 : no heartbeat */
+    double change;                  /* reportable change, 0 reports any change */
+    int change_percent;             /* change is a percent of the last reported value */
+} caps_report_policy_t;
+
+typedef struct caps_report_policy_stats {
+    unsigned int dropped_count;     /* sends below the reportable change */
+    unsigned int held_count;        /* sends held back by the minimum interval */
+    unsigned int deferred_count;    /* held values reported after the minimum interval */
+    unsigned int heartbeat_count;   /* reports sent for the maximum interval */
+} caps_report_policy_stats_t;
+
+/**
+ * Zigbee style reporting configuration for numeric attributes.
+ *
+ * A new value is reported when it differs from the last reported value by
+ * at least the reportable change and min_interval_ms has passed since the
+ * last report. A reportable change which comes too early is held and
+ * reported, with the latest value, once min_interval_ms has passed. The
+ * current value is reported again after max_interval_ms without reports.
+ *
+ * Passing NULL policy removes the policy of the attribute.
+ * attribute must stay valid while the policy is set, e.g. caps_helper_X.attr_Y.name.
+ */
+int caps_report_policy_set(IOT_CAP_HANDLE *handle, const char *attribute, const caps_report_policy_t *policy);
+
+/*
+ * Same as caps_report_policy_set, but looks the handle up by component and capability id.
+ * The policy keeps its own copy of attribute, e.g. a name read from a CLI or JSON.
+ */
+int caps_report_policy_set_by_name(const char *component, const char *capability,
+        const char *attribute, const caps_report_policy_t *policy);
+
+/**
+ * Load policies from JSON.
+ *
+ * {"reportPolicy": [{"component": "main", "capability": "dustSensor", "attribute": "dustLevel",
+ *   "minInterval": 10, "maxInterval": 600, "change": 5}]}
+ *
+ * Intervals are in seconds. "change" can also be a percent string like "5%".
+ * Returns the number of policies applied, or -1.
+ */
+int caps_report_policy_load_json(const char *json_str);
+
+/* Print every policy with printf */
+void caps_report_policy_dump(void);
+
+void caps_report_policy_get_stats(caps_report_policy_stats_t *stats);
+
+/*
+ * Called once by caps_sender when its first handle is set up, so the lock
+ * exists before a policy can be set from any task.
+ */
+int caps_report_policy_init(void);
+
+/* Forget the last reported values of a handle, or of every handle if handle is NULL */
+void caps_report_policy_invalidate(IOT_CAP_HANDLE *handle);
+
+/* Used by caps_sender. Returns 1 if attr must not be sent now. */
+int caps_report_policy_check(const caps_attr_t *attr);
+void caps_report_policy_update(const caps_attr_t *attr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_REPORT_POLICY_H_ */
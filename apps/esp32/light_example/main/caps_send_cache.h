@@ -0,0 +1,90 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_SEND_CACHE_H_
+#define _CAPS_SEND_CACHE_H_
+
+#include "st_dev.h"
+#include "caps_sender.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of attributes which can be registered to the last-sent cache */
+#ifndef CAPS_SEND_CACHE_SIZE
+#define CAPS_SEND_CACHE_SIZE 16
+#endif
+
+/*
+ * Bytes of the value, unit and data kept per attribute to confirm a hash match.
+ * Fits an ISO-8601 time with a UTC offset. Longer values are never suppressed.
+ */
+#ifndef CAPS_SEND_CACHE_VALUE_SIZE
+#define CAPS_SEND_CACHE_VALUE_SIZE 40
+#endif
+
+typedef struct caps_send_cache_value {
+    unsigned int hash;
+    unsigned int len;
+    unsigned char data[CAPS_SEND_CACHE_VALUE_SIZE];
+} caps_send_cache_value_t;
+
+/**
+ * Last-sent cache for capability attributes.
+ *
+ * Attributes are opt-in. Once an attribute is registered, a send whose value,
+ * unit and data are the same as the last successful send of that attribute is
+ * dropped by caps_sender_send_attrs(). The hash of the sent value is only a
+ * first test: a match is confirmed by comparing the value itself. A value
+ * longer than CAPS_SEND_CACHE_VALUE_SIZE with its unit and data can't be
+ * compared in full, so it is always sent.
+ *
+ * attribute must stay valid while registered, e.g. caps_helper_X.attr_Y.name.
+ */
+int caps_send_cache_register(IOT_CAP_HANDLE *handle, const char *attribute);
+
+/* Forget last-sent values of a handle, or of every handle if handle is NULL */
+void caps_send_cache_invalidate(IOT_CAP_HANDLE *handle);
+
+unsigned int caps_send_cache_get_suppressed(void);
+void caps_send_cache_reset_suppressed(void);
+int caps_send_cache_get_registered(void);
+
+/* Hash of the value, unit and data of attr */
+unsigned int caps_send_cache_hash(const caps_attr_t *attr);
+
+/* Comparable copy of the value, unit and data of attr, also used by caps_payload_cache */
+void caps_send_cache_value_set(caps_send_cache_value_t *value, const caps_attr_t *attr);
+int caps_send_cache_value_equal(const caps_send_cache_value_t *a, const caps_send_cache_value_t *b);
+
+/*
+ * Used by caps_sender. check returns 1 if attr equals the last sent value,
+ * update takes the hash given by check once the value has been sent.
+ * expect is check for a send which must not be dropped, e.g. a heartbeat,
+ * so the cache still knows the value once it has been sent.
+ */
+int caps_send_cache_check(const caps_attr_t *attr, unsigned int *hash);
+void caps_send_cache_expect(const caps_attr_t *attr, unsigned int *hash);
+void caps_send_cache_update(const caps_attr_t *attr, unsigned int hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_SEND_CACHE_H_ */
@@ -0,0 +1,1001 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#ifdef CAPS_SENDER_USE_PAYLOAD_CACHE
+#include "caps_payload_cache.h"
+#endif
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+#include "caps_report_policy.h"
+#endif
+#ifdef CAPS_SENDER_USE_STATE_JOURNAL
+#include "caps_state_journal.h"
+#endif
+
+/* upper bound of the latency measurement, far above any sane window */
+#define CAPS_SENDER_LATENCY_RANGE_MS (60 * 60 * 1000)
+
+struct caps_sender_pending {
+    IOT_EVENT *cap_evt[CAPS_SENDER_MAX_EVENTS];
+    caps_attr_t attr[CAPS_SENDER_MAX_EVENTS];
+    unsigned int hash[CAPS_SENDER_MAX_EVENTS];
+    int evt_num;
+};
+
+struct caps_sender_handle {
+    IOT_CAP_HANDLE *handle;
+    const char *component;
+    const char *capability;
+    struct caps_sender_handle *next;        /* in the order created */
+    int init_done;
+    int added;                  /* by caps_sender_add_handle(), its init callback isn't waited for */
+    st_cap_init_cb init_cb;     /* NULL while the wrapper is detached */
+    void *init_usr_data;
+};
+
+struct caps_sender_critical {
+    IOT_CAP_HANDLE *handle;
+    const char *attribute;
+    int priority;
+};
+
+static iot_os_mutex sender_mutex;
+static int sender_mutex_ready;
+
+/* kept apart from sender_mutex, which is held while held attributes are flushed */
+static iot_os_mutex critical_mutex;
+static struct caps_sender_critical critical_attr[CAPS_SENDER_MAX_CRITICAL];
+static int critical_num;
+static unsigned int critical_count;
+
+/* handles are kept for good, the ones beyond the pool come from the heap */
+static struct caps_sender_handle sender_handle_pool[CAPS_SENDER_MAX_HANDLES];
+static int sender_pool_used;
+static struct caps_sender_handle *sender_handles;
+static struct caps_sender_handle **sender_handles_tail = &sender_handles;
+static int sender_handle_num;
+static struct caps_sender_handle *sender_init_running;
+
+static int init_publish_enable;
+static int init_publish_open;
+static struct caps_sender_pending init_pending;
+
+static int batch_open;
+static struct caps_sender_pending batch_pending;
+
+static unsigned int coalesce_window_ms;
+static struct caps_sender_pending coalesce_pending;
+static iot_os_queue *coalesce_queue;
+static iot_os_thread coalesce_thread;
+static iot_os_timer coalesce_timer;
+static caps_sender_stats_t coalesce_stats;
+
+static int _sender_lock_init(void)
+{
+    if (!sender_mutex_ready) {
+        if (iot_os_mutex_init(&sender_mutex) != IOT_OS_TRUE) {
+            printf("fail to init sender mutex\n");
+            return -1;
+        }
+        if (iot_os_mutex_init(&critical_mutex) != IOT_OS_TRUE) {
+            printf("fail to init critical mutex\n");
+            iot_os_mutex_destroy(&sender_mutex);
+            return -1;
+        }
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+        if (caps_report_policy_init()) {
+            iot_os_mutex_destroy(&critical_mutex);
+            iot_os_mutex_destroy(&sender_mutex);
+            return -1;
+        }
+#endif
+        sender_mutex_ready = 1;
+    }
+    return 0;
+}
+
+/* the event keeps its own copy of the value, so attr may go away */
+static IOT_EVENT *_create_event(const caps_attr_t *attr)
+{
+#ifdef CAPS_SENDER_USE_PAYLOAD_CACHE
+    IOT_EVENT *cap_evt;
+
+    cap_evt = caps_payload_cache_get(attr);
+    if (cap_evt)
+        return cap_evt;
+#endif
+    return st_cap_create_attr(attr->handle, attr->name,
+            (iot_cap_val_t *)&attr->value, attr->unit, attr->data);
+}
+
+static void _free_events(IOT_EVENT **cap_evt, int evt_num)
+{
+#ifdef CAPS_SENDER_USE_PAYLOAD_CACHE
+    caps_payload_cache_free_events(cap_evt, evt_num);
+#else
+    int i;
+
+    for (i = 0; i < evt_num; i++) {
+        st_cap_free_attr(cap_evt[i]);
+    }
+#endif
+}
+
+static int _send_events(IOT_EVENT **cap_evt, caps_attr_t *attrs, unsigned int *hash, int evt_num)
+{
+    int sequence_no;
+    int i;
+
+    sequence_no = st_cap_send_attr(cap_evt, evt_num);
+    if (sequence_no >= 0) {
+        for (i = 0; i < evt_num; i++) {
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+            caps_report_policy_update(&attrs[i]);
+#endif
+            caps_send_cache_update(&attrs[i], hash[i]);
+        }
+    }
+
+    _free_events(cap_evt, evt_num);
+    return sequence_no;
+}
+
+/* sender_mutex must be held */
+static int _flush_pending(struct caps_sender_pending *pending)
+{
+    int sequence_no = CAPS_SEND_SUPPRESSED;
+
+    if (pending->evt_num > 0) {
+        sequence_no = _send_events(pending->cap_evt, pending->attr,
+                pending->hash, pending->evt_num);
+        if (sequence_no < 0)
+            printf("fail to send %d pending attributes\n", pending->evt_num);
+        pending->evt_num = 0;
+    }
+    return sequence_no;
+}
+
+/* sender_mutex must be held */
+static void _flush_coalesce_pending(void)
+{
+    unsigned int latency_ms;
+
+    if (coalesce_pending.evt_num == 0) {
+        return;
+    }
+
+    latency_ms = CAPS_SENDER_LATENCY_RANGE_MS - iot_os_timer_left_ms(coalesce_timer);
+    coalesce_stats.flush_count++;
+    coalesce_stats.event_count += coalesce_pending.evt_num;
+    if (coalesce_pending.evt_num > coalesce_stats.max_flush_size) {
+        coalesce_stats.max_flush_size = coalesce_pending.evt_num;
+    }
+    coalesce_stats.total_latency_ms += latency_ms;
+    if (latency_ms > coalesce_stats.max_latency_ms) {
+        coalesce_stats.max_latency_ms = latency_ms;
+    }
+
+    _flush_pending(&coalesce_pending);
+}
+
+/* Returns 1 if attr has to be dropped */
+static int _filter_attr(const caps_attr_t *attr, int flags, unsigned int *hash)
+{
+    *hash = 0;
+    if (flags & CAPS_SEND_FLAG_NO_FILTER) {
+        caps_send_cache_expect(attr, hash);
+        return 0;
+    }
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+    if (caps_report_policy_check(attr)) {
+        return 1;
+    }
+#endif
+    return caps_send_cache_check(attr, hash);
+}
+
+/* sender_mutex must be held */
+static int _find_pending(struct caps_sender_pending *pending, const caps_attr_t *attr)
+{
+    int j;
+
+    for (j = 0; j < pending->evt_num; j++) {
+        if (pending->attr[j].handle == attr->handle &&
+                !strcmp(pending->attr[j].name, attr->name)) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+/* sender_mutex must be held */
+static void _drop_pending(struct caps_sender_pending *pending, int j)
+{
+    _free_events(&pending->cap_evt[j], 1);
+    pending->evt_num--;
+    memmove(&pending->cap_evt[j], &pending->cap_evt[j + 1],
+            (pending->evt_num - j) * sizeof(pending->cap_evt[0]));
+    memmove(&pending->attr[j], &pending->attr[j + 1],
+            (pending->evt_num - j) * sizeof(pending->attr[0]));
+    memmove(&pending->hash[j], &pending->hash[j + 1],
+            (pending->evt_num - j) * sizeof(pending->hash[0]));
+}
+
+/* sender_mutex must be held */
+static int _queue_pending(struct caps_sender_pending *pending, caps_attr_t *attrs, int attr_num,
+        int flags, const char *critical)
+{
+    IOT_EVENT *cap_evt;
+    unsigned int hash;
+    int i, j;
+
+    for (i = 0; i < attr_num; i++) {
+        if (critical[i]) {
+            continue;
+        }
+
+        /* an attribute sent twice before the flush only goes out with its last value */
+        j = _find_pending(pending, &attrs[i]);
+        if (_filter_attr(&attrs[i], flags, &hash)) {
+            /*
+             * The filters compare with the last value sent, not with the
+             * pending one. Back to the sent value, the pending one is stale.
+             */
+            if (j >= 0) {
+                _drop_pending(pending, j);
+                if (pending == &coalesce_pending) {
+                    coalesce_stats.replaced_count++;
+                }
+            }
+            continue;
+        }
+
+        cap_evt = _create_event(&attrs[i]);
+        if (!cap_evt) {
+            printf("fail to create cap_evt for %s\n", attrs[i].name);
+            return -1;
+        }
+
+        if (j >= 0) {
+            _free_events(&pending->cap_evt[j], 1);
+            if (pending == &coalesce_pending) {
+                coalesce_stats.replaced_count++;
+            }
+        } else {
+            if (pending->evt_num >= CAPS_SENDER_MAX_EVENTS) {
+                if (pending == &coalesce_pending) {
+                    _flush_coalesce_pending();
+                } else {
+                    _flush_pending(pending);
+                }
+            }
+            j = pending->evt_num++;
+        }
+        /* only handle, name and numeric values of the copy are used after this */
+        pending->cap_evt[j] = cap_evt;
+        pending->attr[j] = attrs[i];
+        pending->hash[j] = hash;
+    }
+    return CAPS_SEND_QUEUED;
+}
+
+/* sender_mutex must be held */
+static void _close_init_publish(void)
+{
+    struct caps_sender_handle *h;
+    int sequence_no;
+
+    if (init_pending.evt_num > 0) {
+        int evt_num = init_pending.evt_num;
+
+        sequence_no = _flush_pending(&init_pending);
+        if (sequence_no >= 0)
+            printf("init attributes(%d) sent. sequence number : %d\n", evt_num, sequence_no);
+    }
+    for (h = sender_handles; h; h = h->next) {
+        h->init_done = 0;
+    }
+    init_publish_open = 0;
+}
+
+static struct caps_sender_handle *_find_handle(IOT_CAP_HANDLE *handle)
+{
+    struct caps_sender_handle *h;
+
+    for (h = sender_handles; h; h = h->next) {
+        if (h->handle == handle) {
+            return h;
+        }
+    }
+    return NULL;
+}
+
+/* sender_mutex must be held, num handles in one piece */
+static struct caps_sender_handle *_alloc_handles(int num)
+{
+    struct caps_sender_handle *h;
+
+    if (sender_pool_used + num <= CAPS_SENDER_MAX_HANDLES) {
+        h = &sender_handle_pool[sender_pool_used];
+        sender_pool_used += num;
+        return h;
+    }
+    h = calloc(num, sizeof(struct caps_sender_handle));
+    if (!h) {
+        printf("fail to malloc for %d caps_sender handles\n", num);
+    }
+    return h;
+}
+
+/* sender_mutex must be held */
+static void _add_handle(struct caps_sender_handle *h)
+{
+    *sender_handles_tail = h;
+    sender_handles_tail = &h->next;
+    sender_handle_num++;
+}
+
+static struct caps_sender_handle *_find_handle_by_name(const char *component, const char *capability)
+{
+    struct caps_sender_handle *h;
+
+    for (h = sender_handles; h; h = h->next) {
+        if (h->component && !strcmp(h->component, component) &&
+                h->capability && !strcmp(h->capability, capability)) {
+            return h;
+        }
+    }
+    return NULL;
+}
+
+static void _handle_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)
+{
+    struct caps_sender_handle *h = usr_data;
+    st_cap_init_cb init_cb;
+    void *init_usr_data;
+
+    iot_os_mutex_lock(&sender_mutex);
+    init_cb = h->init_cb;
+    init_usr_data = h->init_usr_data;
+    if (init_cb) {
+        sender_init_running = h;
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+
+    if (!init_cb) {
+        /* detached, nothing to report but the init publish still waits for it */
+        caps_sender_init_cb_begin(handle);
+        caps_sender_init_cb_end(handle);
+        return;
+    }
+
+    init_cb(handle, init_usr_data);
+
+    iot_os_mutex_lock(&sender_mutex);
+    sender_init_running = NULL;
+    iot_os_mutex_unlock(&sender_mutex);
+}
+
+int caps_sender_handle_init_n(IOT_CTX *ctx, const char **components, int num, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data, IOT_CAP_HANDLE **handles)
+{
+    struct caps_sender_handle *block = NULL;
+    struct caps_sender_handle *h;
+    int new_num = 0;
+    int ch;
+
+    if (!ctx || !components || num <= 0 || !capability || !init_cb || !handles) {
+        printf("invalid parameter\n");
+        return -1;
+    }
+    if (_sender_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    for (ch = 0; ch < num; ch++) {
+        h = _find_handle_by_name(components[ch], capability);
+        if (h && h->init_cb) {
+            iot_os_mutex_unlock(&sender_mutex);
+            printf("%s of %s is already initialized\n", capability, components[ch]);
+            return -1;
+        }
+        if (!h) {
+            new_num++;
+        }
+    }
+    if (new_num > 0) {
+        block = _alloc_handles(new_num);
+        if (!block) {
+            iot_os_mutex_unlock(&sender_mutex);
+            return -1;
+        }
+    }
+
+    for (ch = 0; ch < num; ch++) {
+        h = _find_handle_by_name(components[ch], capability);
+        if (!h) {
+            /* iot-core keeps the handle and h as its usr_data, so h is never freed */
+            h = block++;
+            h->handle = st_cap_handle_init(ctx, components[ch], capability, _handle_init_cb, h);
+            if (!h->handle) {
+                printf("fail to init %s handle of %s\n", capability, components[ch]);
+                break;
+            }
+            h->component = components[ch];
+            h->capability = capability;
+            _add_handle(h);
+        }
+        /* attached again, iot-core keeps the handle created the first time */
+        h->init_cb = init_cb;
+        h->init_usr_data = init_usr_data;
+        handles[ch] = h->handle;
+    }
+    if (ch < num) {
+        /* all or nothing, the handles created so far stay for the next try */
+        while (--ch >= 0) {
+            h = _find_handle(handles[ch]);
+            h->init_cb = NULL;
+            h->init_usr_data = NULL;
+            handles[ch] = NULL;
+        }
+        iot_os_mutex_unlock(&sender_mutex);
+        return -1;
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+
+    return 0;
+}
+
+IOT_CAP_HANDLE *caps_sender_handle_init(IOT_CTX *ctx, const char *component, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data)
+{
+    IOT_CAP_HANDLE *handle;
+
+    if (caps_sender_handle_init_n(ctx, &component, 1, capability, init_cb, init_usr_data, &handle)) {
+        return NULL;
+    }
+    return handle;
+}
+
+void caps_sender_handle_detach(IOT_CAP_HANDLE *handle)
+{
+    struct caps_sender_handle *h;
+
+    if (!handle || !sender_mutex_ready) {
+        return;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    h = _find_handle(handle);
+    if (!h) {
+        iot_os_mutex_unlock(&sender_mutex);
+        return;
+    }
+    h->init_cb = NULL;
+    h->init_usr_data = NULL;
+    /* the init callback may still be using the wrapper which is going away */
+    while (sender_init_running == h) {
+        iot_os_mutex_unlock(&sender_mutex);
+        iot_os_delay(1);
+        iot_os_mutex_lock(&sender_mutex);
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+
+    /* the next wrapper attached to the handle reports its state from scratch */
+    caps_send_cache_invalidate(handle);
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+    caps_report_policy_invalidate(handle);
+#endif
+#ifdef CAPS_SENDER_USE_PAYLOAD_CACHE
+    caps_payload_cache_invalidate(handle);
+#endif
+}
+
+int caps_sender_add_handle(IOT_CAP_HANDLE *handle, const char *component, const char *capability)
+{
+    struct caps_sender_handle *h;
+
+    if (!handle) {
+        return -1;
+    }
+    if (_sender_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    if (_find_handle(handle)) {
+        iot_os_mutex_unlock(&sender_mutex);
+        return 0;
+    }
+    h = _alloc_handles(1);
+    if (!h) {
+        iot_os_mutex_unlock(&sender_mutex);
+        return -1;
+    }
+    h->handle = handle;
+    h->component = component;
+    h->capability = capability;
+    h->added = 1;
+    _add_handle(h);
+    iot_os_mutex_unlock(&sender_mutex);
+
+    return 0;
+}
+
+IOT_CAP_HANDLE *caps_sender_find_handle(const char *component, const char *capability)
+{
+    struct caps_sender_handle *h;
+    IOT_CAP_HANDLE *handle = NULL;
+
+    if (!component || !capability || !sender_mutex_ready) {
+        return NULL;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    h = _find_handle_by_name(component, capability);
+    if (h) {
+        handle = h->handle;
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+
+    return handle;
+}
+
+void caps_sender_set_init_publish(int enable)
+{
+    if (sender_mutex_ready) {
+        iot_os_mutex_lock(&sender_mutex);
+        if (!enable && init_publish_open) {
+            _close_init_publish();
+        }
+        init_publish_enable = enable;
+        iot_os_mutex_unlock(&sender_mutex);
+    } else {
+        init_publish_enable = enable;
+    }
+}
+
+int caps_sender_get_init_publish(void)
+{
+    return init_publish_enable;
+}
+
+void caps_sender_init_cb_begin(IOT_CAP_HANDLE *handle)
+{
+    struct caps_sender_handle *h;
+
+    caps_send_cache_invalidate(handle);
+#ifdef CAPS_SENDER_USE_REPORT_POLICY
+    caps_report_policy_invalidate(handle);
+#endif
+
+    if (!init_publish_enable || sender_handle_num == 0) {
+        return;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    h = _find_handle(handle);
+    if (h) {
+        if (h->init_done) {
+            /* init callbacks started over before the previous round finished */
+            _close_init_publish();
+        }
+        init_publish_open = 1;
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+}
+
+void caps_sender_init_cb_end(IOT_CAP_HANDLE *handle)
+{
+    struct caps_sender_handle *h;
+
+    if (!init_publish_open) {
+        return;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    h = _find_handle(handle);
+    if (h) {
+        h->init_done = 1;
+    }
+    for (h = sender_handles; h; h = h->next) {
+        if (!h->init_done && !h->added) {
+            break;
+        }
+    }
+    if (!h) {
+        _close_init_publish();
+    }
+    iot_os_mutex_unlock(&sender_mutex);
+}
+
+void caps_sender_flush(void)
+{
+    if (!sender_mutex_ready) {
+        return;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    if (init_publish_open) {
+        _close_init_publish();
+    }
+    _flush_pending(&batch_pending);
+    _flush_coalesce_pending();
+    iot_os_mutex_unlock(&sender_mutex);
+}
+
+void caps_sender_batch_begin(void)
+{
+    if (_sender_lock_init()) {
+        return;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    batch_open = 1;
+    iot_os_mutex_unlock(&sender_mutex);
+}
+
+int caps_sender_batch_end(void)
+{
+    int sequence_no;
+
+    if (!batch_open) {
+        return CAPS_SEND_SUPPRESSED;
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    batch_open = 0;
+    sequence_no = _flush_pending(&batch_pending);
+    iot_os_mutex_unlock(&sender_mutex);
+
+    return sequence_no;
+}
+
+static void _coalesce_task(void *arg)
+{
+    int msg;
+
+    for (;;) {
+        if (iot_os_queue_receive(coalesce_queue, &msg, IOT_OS_MAX_DELAY) != IOT_OS_TRUE) {
+            continue;
+        }
+
+        /* the window starts with the first event queued after the last flush */
+        iot_os_delay(coalesce_window_ms);
+
+        iot_os_mutex_lock(&sender_mutex);
+        _flush_coalesce_pending();
+        iot_os_mutex_unlock(&sender_mutex);
+    }
+}
+
+int caps_sender_set_coalesce_window(unsigned int window_ms)
+{
+    if (_sender_lock_init()) {
+        return -1;
+    }
+
+    if (window_ms && !coalesce_thread) {
+        if (iot_os_timer_init(&coalesce_timer) != IOT_OS_TRUE) {
+            printf("fail to init coalesce timer\n");
+            return -1;
+        }
+        coalesce_queue = iot_os_queue_create(1, sizeof(int));
+        if (!coalesce_queue) {
+            printf("fail to create coalesce queue\n");
+            iot_os_timer_destroy(&coalesce_timer);
+            return -1;
+        }
+        if (iot_os_thread_create(_coalesce_task, "caps_coalesce", CAPS_SENDER_TASK_STACK_SIZE,
+                NULL, CAPS_SENDER_TASK_PRIORITY, &coalesce_thread) != IOT_OS_TRUE) {
+            printf("fail to create coalesce task\n");
+            iot_os_queue_delete(coalesce_queue);
+            coalesce_queue = NULL;
+            iot_os_timer_destroy(&coalesce_timer);
+            return -1;
+        }
+    }
+
+    iot_os_mutex_lock(&sender_mutex);
+    if (!window_ms) {
+        _flush_coalesce_pending();
+    }
+    coalesce_window_ms = window_ms;
+    iot_os_mutex_unlock(&sender_mutex);
+
+    return 0;
+}
+
+unsigned int caps_sender_get_coalesce_window(void)
+{
+    return coalesce_window_ms;
+}
+
+void caps_sender_get_stats(caps_sender_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+
+    if (sender_mutex_ready) {
+        iot_os_mutex_lock(&sender_mutex);
+        *stats = coalesce_stats;
+        iot_os_mutex_unlock(&sender_mutex);
+        iot_os_mutex_lock(&critical_mutex);
+        stats->critical_count = critical_count;
+        iot_os_mutex_unlock(&critical_mutex);
+    } else {
+        *stats = coalesce_stats;
+    }
+}
+
+void caps_sender_reset_stats(void)
+{
+    if (sender_mutex_ready) {
+        iot_os_mutex_lock(&sender_mutex);
+        memset(&coalesce_stats, 0, sizeof(coalesce_stats));
+        iot_os_mutex_unlock(&sender_mutex);
+        iot_os_mutex_lock(&critical_mutex);
+        critical_count = 0;
+        iot_os_mutex_unlock(&critical_mutex);
+    } else {
+        memset(&coalesce_stats, 0, sizeof(coalesce_stats));
+    }
+}
+
+/* critical_mutex must be held */
+static struct caps_sender_critical *_find_critical(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    int i;
+
+    /* attribute is normally the same caps_helper string, compare the pointers first */
+    for (i = 0; i < critical_num; i++) {
+        if (critical_attr[i].handle == handle && critical_attr[i].attribute == attribute) {
+            return &critical_attr[i];
+        }
+    }
+    for (i = 0; i < critical_num; i++) {
+        if (critical_attr[i].handle == handle && !strcmp(critical_attr[i].attribute, attribute)) {
+            return &critical_attr[i];
+        }
+    }
+    return NULL;
+}
+
+int caps_sender_set_priority(IOT_CAP_HANDLE *handle, const char *attribute, int priority)
+{
+    struct caps_sender_critical *entry;
+
+    if (!handle || !attribute) {
+        printf("invalid handle or attribute\n");
+        return -1;
+    }
+    if (priority != CAPS_SEND_PRIORITY_NORMAL && priority != CAPS_SEND_PRIORITY_CRITICAL) {
+        printf("invalid priority : %d\n", priority);
+        return -1;
+    }
+    if (_sender_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&critical_mutex);
+    entry = _find_critical(handle, attribute);
+    if (!entry) {
+        if (priority == CAPS_SEND_PRIORITY_NORMAL) {
+            iot_os_mutex_unlock(&critical_mutex);
+            return 0;
+        }
+        if (critical_num >= CAPS_SENDER_MAX_CRITICAL) {
+            iot_os_mutex_unlock(&critical_mutex);
+            printf("too many critical attributes for %s\n", attribute);
+            return -1;
+        }
+        entry = &critical_attr[critical_num++];
+        entry->handle = handle;
+        entry->attribute = attribute;
+    }
+    /* the slot is kept when the attribute goes back to normal */
+    entry->priority = priority;
+    iot_os_mutex_unlock(&critical_mutex);
+
+#ifdef CAPS_SENDER_USE_PAYLOAD_CACHE
+    if (priority == CAPS_SEND_PRIORITY_CRITICAL) {
+        /* a full payload cache only costs the allocations of each send */
+        caps_payload_cache_register(handle, attribute);
+    }
+#endif
+    return 0;
+}
+
+int caps_sender_get_priority(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    struct caps_sender_critical *entry;
+    int priority = CAPS_SEND_PRIORITY_NORMAL;
+
+    if (!handle || !attribute || !critical_num) {
+        return CAPS_SEND_PRIORITY_NORMAL;
+    }
+
+    iot_os_mutex_lock(&critical_mutex);
+    entry = _find_critical(handle, attribute);
+    if (entry) {
+        priority = entry->priority;
+    }
+    iot_os_mutex_unlock(&critical_mutex);
+
+    return priority;
+}
+
+/*
+ * Send the critical attributes of attrs right away and mark them in critical.
+ * Returns the number of critical attributes, and their sequence number or a
+ * negative value in *sequence_no.
+ */
+static int _send_critical(caps_attr_t *attrs, int attr_num, char *critical, int *sequence_no)
+{
+    IOT_EVENT *cap_evt[CAPS_SENDER_MAX_EVENTS];
+    caps_attr_t sent_attr[CAPS_SENDER_MAX_EVENTS];
+    unsigned int hash[CAPS_SENDER_MAX_EVENTS];
+    struct caps_sender_critical *entry;
+    int critical_attr_num = 0;
+    int evt_num = 0;
+    int i;
+
+    iot_os_mutex_lock(&critical_mutex);
+    for (i = 0; i < attr_num; i++) {
+        entry = _find_critical(attrs[i].handle, attrs[i].name);
+        critical[i] = (entry && entry->priority == CAPS_SEND_PRIORITY_CRITICAL);
+        critical_attr_num += critical[i];
+    }
+    iot_os_mutex_unlock(&critical_mutex);
+
+    for (i = 0; i < attr_num; i++) {
+        if (!critical[i]) {
+            continue;
+        }
+
+        cap_evt[evt_num] = _create_event(&attrs[i]);
+        if (!cap_evt[evt_num]) {
+            printf("fail to create cap_evt for %s\n", attrs[i].name);
+            _free_events(cap_evt, evt_num);
+            *sequence_no = -1;
+            return critical_attr_num;
+        }
+        sent_attr[evt_num] = attrs[i];
+        hash[evt_num] = caps_send_cache_hash(&attrs[i]);
+        evt_num++;
+    }
+
+    if (evt_num > 0) {
+        *sequence_no = _send_events(cap_evt, sent_attr, hash, evt_num);
+        if (*sequence_no >= 0) {
+            iot_os_mutex_lock(&critical_mutex);
+            critical_count += evt_num;
+            iot_os_mutex_unlock(&critical_mutex);
+        }
+    }
+    return critical_attr_num;
+}
+
+/* a failed critical send is reported even if the rest went out */
+static int _sequence_no(int critical_attr_num, int critical_seq, int sequence_no)
+{
+    if (critical_attr_num && (critical_seq < 0 || sequence_no == CAPS_SEND_SUPPRESSED)) {
+        return critical_seq;
+    }
+    return sequence_no;
+}
+
+int caps_sender_send_attrs(caps_attr_t *attrs, int attr_num)
+{
+    return caps_sender_send_attrs_flags(attrs, attr_num, 0);
+}
+
+int caps_sender_send_attrs_flags(caps_attr_t *attrs, int attr_num, int flags)
+{
+    IOT_EVENT *cap_evt[CAPS_SENDER_MAX_EVENTS];
+    caps_attr_t sent_attr[CAPS_SENDER_MAX_EVENTS];
+    unsigned int hash[CAPS_SENDER_MAX_EVENTS];
+    char critical[CAPS_SENDER_MAX_EVENTS] = { 0 };
+    int critical_attr_num = 0;
+    int critical_seq = CAPS_SEND_SUPPRESSED;
+    int evt_num = 0;
+    int sequence_no;
+    int msg = 0;
+    int i;
+
+    if (!attrs || attr_num <= 0) {
+        printf("attrs is NULL\n");
+        return -1;
+    }
+    if (attr_num > CAPS_SENDER_MAX_EVENTS) {
+        printf("too many attrs : %d\n", attr_num);
+        return -1;
+    }
+
+#ifdef CAPS_SENDER_USE_STATE_JOURNAL
+    /* the journal keeps what the app set, whether or not it is sent now */
+    for (i = 0; i < attr_num; i++) {
+        caps_state_journal_record(&attrs[i]);
+    }
+#endif
+
+    /* critical attributes go first and never wait for sender_mutex */
+    if (critical_num) {
+        critical_attr_num = _send_critical(attrs, attr_num, critical, &critical_seq);
+        if (critical_attr_num == attr_num) {
+            return critical_seq;
+        }
+    }
+
+    if (init_publish_open || batch_open || coalesce_window_ms) {
+        iot_os_mutex_lock(&sender_mutex);
+        if (init_publish_open) {
+            sequence_no = _queue_pending(&init_pending, attrs, attr_num, flags, critical);
+            iot_os_mutex_unlock(&sender_mutex);
+            return _sequence_no(critical_attr_num, critical_seq, sequence_no);
+        }
+        if (batch_open) {
+            sequence_no = _queue_pending(&batch_pending, attrs, attr_num, flags, critical);
+            iot_os_mutex_unlock(&sender_mutex);
+            return _sequence_no(critical_attr_num, critical_seq, sequence_no);
+        }
+        if (coalesce_window_ms) {
+            int was_empty = (coalesce_pending.evt_num == 0);
+
+            sequence_no = _queue_pending(&coalesce_pending, attrs, attr_num, flags, critical);
+            if (was_empty && coalesce_pending.evt_num > 0) {
+                iot_os_timer_count_ms(coalesce_timer, CAPS_SENDER_LATENCY_RANGE_MS);
+                iot_os_queue_send(coalesce_queue, &msg, 0);
+            }
+            iot_os_mutex_unlock(&sender_mutex);
+            return _sequence_no(critical_attr_num, critical_seq, sequence_no);
+        }
+        iot_os_mutex_unlock(&sender_mutex);
+    }
+
+    for (i = 0; i < attr_num; i++) {
+        if (critical[i] || _filter_attr(&attrs[i], flags, &hash[evt_num])) {
+            continue;
+        }
+
+        cap_evt[evt_num] = _create_event(&attrs[i]);
+        if (!cap_evt[evt_num]) {
+            printf("fail to create cap_evt for %s\n", attrs[i].name);
+            _free_events(cap_evt, evt_num);
+            return -1;
+        }
+        sent_attr[evt_num] = attrs[i];
+        evt_num++;
+    }
+
+    if (evt_num == 0) {
+        sequence_no = CAPS_SEND_SUPPRESSED;
+    } else {
+        sequence_no = _send_events(cap_evt, sent_attr, hash, evt_num);
+    }
+    return _sequence_no(critical_attr_num, critical_seq, sequence_no);
+}
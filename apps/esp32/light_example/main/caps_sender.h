@@ -0,0 +1,254 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_SENDER_H_
+#define _CAPS_SENDER_H_
+
+#include "st_dev.h"
+#include "caps_util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Optional stages of the send path. Each one needs its module in the build,
+ * and the flag has to be defined for the whole app, e.g. in CMakeLists.txt:
+ *   CAPS_SENDER_USE_REPORT_POLICY   caps_report_policy.c
+ *   CAPS_SENDER_USE_PAYLOAD_CACHE   caps_payload_cache.c
+ *   CAPS_SENDER_USE_STATE_JOURNAL   caps_state_journal.c
+ * caps_send_cache is always part of caps_sender.
+ */
+
+/* Maximum number of attributes which can go out in a single st_cap_send_attr() */
+#ifndef CAPS_SENDER_MAX_EVENTS
+#define CAPS_SENDER_MAX_EVENTS 16
+#endif
+
+/* Capability handles kept in static memory, more are allocated from the heap */
+#ifndef CAPS_SENDER_MAX_HANDLES
+#define CAPS_SENDER_MAX_HANDLES 16
+#endif
+
+/* Maximum number of attributes which can be put in the priority lane */
+#ifndef CAPS_SENDER_MAX_CRITICAL
+#define CAPS_SENDER_MAX_CRITICAL 8
+#endif
+
+#ifndef CAPS_SENDER_TASK_STACK_SIZE
+#define CAPS_SENDER_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CAPS_SENDER_TASK_PRIORITY
+#define CAPS_SENDER_TASK_PRIORITY 10
+#endif
+
+/* Skip caps_report_policy and caps_send_cache, e.g. for heartbeats. caps_send_cache still keeps the sent value. */
+#define CAPS_SEND_FLAG_NO_FILTER (1 << 0)
+
+/* Priority class of an attribute, see caps_sender_set_priority() */
+#define CAPS_SEND_PRIORITY_NORMAL (0)
+#define CAPS_SEND_PRIORITY_CRITICAL (1)
+
+/* Returned instead of a sequence number when every attribute was filtered out */
+#define CAPS_SEND_SUPPRESSED (0)
+/* Returned instead of a sequence number when attributes are held for a later publish */
+#define CAPS_SEND_QUEUED (0)
+
+typedef struct caps_sender_stats {
+    unsigned int flush_count;       /* coalesced messages sent */
+    unsigned int event_count;       /* events sent by coalesced messages */
+    unsigned int replaced_count;    /* events overwritten by a newer value in the window */
+    unsigned int max_flush_size;
+    unsigned int total_latency_ms;  /* sum of the delay added to the oldest event of each flush */
+    unsigned int max_latency_ms;
+    unsigned int critical_count;    /* events sent through the priority lane */
+} caps_sender_stats_t;
+
+typedef struct caps_attr {
+    IOT_CAP_HANDLE *handle;
+    const char *name;
+    iot_cap_val_t value;
+    const char *unit;
+    const char *data;
+} caps_attr_t;
+
+/**
+ * Send attributes through the common capability send path.
+ *
+ * Every attr_*_send() of the capability wrappers ends up here, so filtering
+ * (caps_report_policy, caps_send_cache) and recording (caps_state_journal) are
+ * applied in one place, as far as they are built in. Attributes may belong to
+ * different handles and are published as a single multi-event message.
+ *
+ * Returns the sequence number, CAPS_SEND_SUPPRESSED if nothing had to be
+ * sent, or a negative value on failure.
+ */
+int caps_sender_send_attrs(caps_attr_t *attrs, int attr_num);
+int caps_sender_send_attrs_flags(caps_attr_t *attrs, int attr_num, int flags);
+
+/**
+ * Called by caps_{CAPABILITY}_initialize instead of st_cap_handle_init().
+ *
+ * iot-core has no way to delete a handle, so the handle of a component and
+ * capability is created once and kept. init_cb runs through caps_sender, and
+ * caps_sender_handle_detach() unbinds it when the wrapper is deinitialized.
+ * Initializing the same component and capability again attaches the new wrapper
+ * to the kept handle. component and capability must stay valid, e.g. a string
+ * literal and caps_helper_X.id.
+ */
+IOT_CAP_HANDLE *caps_sender_handle_init(IOT_CTX *ctx, const char *component, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data);
+/*
+ * Same for the capability of num components, e.g. the channels of a multi-gang relay.
+ * The new handles are allocated at once, and either all of them are set in handles
+ * or -1 is returned and none is attached.
+ */
+int caps_sender_handle_init_n(IOT_CTX *ctx, const char **components, int num, const char *capability,
+        st_cap_init_cb init_cb, void *init_usr_data, IOT_CAP_HANDLE **handles);
+/* Waits for a running init_cb, don't call it from the init_cb of the handle */
+void caps_sender_handle_detach(IOT_CAP_HANDLE *handle);
+
+/*
+ * For handles created with st_cap_handle_init() directly, they can't be detached.
+ * The init publish doesn't wait for their init callback. One which calls
+ * caps_sender_init_cb_begin/end has its sends collected while the publish is open.
+ */
+int caps_sender_add_handle(IOT_CAP_HANDLE *handle, const char *component, const char *capability);
+IOT_CAP_HANDLE *caps_sender_find_handle(const char *component, const char *capability);
+
+/**
+ * Init publish mode.
+ *
+ * When enabled, attributes sent from the init callbacks of all handles are
+ * collected and published as one multi-event message once the last handle
+ * has finished its init callback, instead of one message per attribute.
+ */
+void caps_sender_set_init_publish(int enable);
+int caps_sender_get_init_publish(void);
+
+/* Wrap the body of every caps_{CAPABILITY}_init_cb */
+void caps_sender_init_cb_begin(IOT_CAP_HANDLE *handle);
+void caps_sender_init_cb_end(IOT_CAP_HANDLE *handle);
+
+/**
+ * Send coalescing.
+ *
+ * With a non-zero window, attributes are held for window_ms from the first
+ * attribute queued after the previous flush. Only the latest value of each
+ * attribute is kept, and everything is published as one multi-event message
+ * from a caps_sender task. 0 disables coalescing and flushes what is held.
+ */
+int caps_sender_set_coalesce_window(unsigned int window_ms);
+unsigned int caps_sender_get_coalesce_window(void);
+
+/**
+ * Priority lane.
+ *
+ * A CAPS_SEND_PRIORITY_CRITICAL attribute, e.g. smoke or a water leak, is sent
+ * from the calling task as soon as it is sent by the wrapper. It skips init
+ * publish, batch and coalescing, so it goes out ahead of everything held there,
+ * and caps_report_policy and caps_send_cache never drop or defer it. With
+ * CAPS_SENDER_USE_PAYLOAD_CACHE its event is kept by caps_payload_cache, so
+ * sending the same value again doesn't allocate. attribute must stay valid,
+ * e.g. caps_helper_X.attr_Y.name.
+ */
+int caps_sender_set_priority(IOT_CAP_HANDLE *handle, const char *attribute, int priority);
+int caps_sender_get_priority(IOT_CAP_HANDLE *handle, const char *attribute);
+
+void caps_sender_get_stats(caps_sender_stats_t *stats);
+void caps_sender_reset_stats(void);
+
+/**
+ * Batch send.
+ *
+ * Attributes sent between begin and end, from any task, are published as one
+ * multi-event message by caps_sender_batch_end(). Used by caps_cmd to echo a
+ * batch of commands at once.
+ */
+void caps_sender_batch_begin(void);
+int caps_sender_batch_end(void);
+
+/* Publish whatever has been collected so far */
+void caps_sender_flush(void);
+
+#define CAPS_SEND_ATTR_STRING(cap_handle, attribute, value_string, unit_str, data_str, output_seq_num) \
+{ \
+    caps_attr_t caps_attr; \
+    caps_attr.handle = cap_handle; \
+    caps_attr.name = attribute; \
+    caps_attr.value.type = IOT_CAP_VAL_TYPE_STRING; \
+    caps_attr.value.string = value_string; \
+    caps_attr.unit = unit_str; \
+    caps_attr.data = data_str; \
+    output_seq_num = caps_sender_send_attrs(&caps_attr, 1); \
+}
+
+#define CAPS_SEND_ATTR_NUMBER(cap_handle, attribute, value_number, unit_str, data_str, output_seq_num) \
+{ \
+    caps_attr_t caps_attr; \
+    caps_attr.handle = cap_handle; \
+    caps_attr.name = attribute; \
+    caps_attr.value.type = IOT_CAP_VAL_TYPE_NUMBER; \
+    caps_attr.value.number = value_number; \
+    caps_attr.unit = unit_str; \
+    caps_attr.data = data_str; \
+    output_seq_num = caps_sender_send_attrs(&caps_attr, 1); \
+}
+
+#define CAPS_SEND_ATTR_MILLI(cap_handle, attribute, value_milli, unit_str, data_str, output_seq_num) \
+{ \
+    caps_attr_t caps_attr; \
+    caps_attr.handle = cap_handle; \
+    caps_attr.name = attribute; \
+    caps_util_milli_to_val(value_milli, &caps_attr.value); \
+    caps_attr.unit = unit_str; \
+    caps_attr.data = data_str; \
+    output_seq_num = caps_sender_send_attrs(&caps_attr, 1); \
+}
+
+#define CAPS_SEND_ATTR_STRINGS_ARRAY(cap_handle, attribute, value_string_array, array_num, unit_str, data_str, output_seq_num) \
+{ \
+    caps_attr_t caps_attr; \
+    caps_attr.handle = cap_handle; \
+    caps_attr.name = attribute; \
+    caps_attr.value.type = IOT_CAP_VAL_TYPE_STR_ARRAY; \
+    caps_attr.value.strings = value_string_array; \
+    caps_attr.value.str_num = array_num; \
+    caps_attr.unit = unit_str; \
+    caps_attr.data = data_str; \
+    output_seq_num = caps_sender_send_attrs(&caps_attr, 1); \
+}
+
+#define CAPS_SEND_ATTR_JSON_OBJECT(cap_handle, attribute, value_json_str, unit_str, data_str, output_seq_num) \
+{ \
+    caps_attr_t caps_attr; \
+    caps_attr.handle = cap_handle; \
+    caps_attr.name = attribute; \
+    caps_attr.value.type = IOT_CAP_VAL_TYPE_JSON_OBJECT; \
+    caps_attr.value.json_object = value_json_str; \
+    caps_attr.unit = unit_str; \
+    caps_attr.data = data_str; \
+    output_seq_num = caps_sender_send_attrs(&caps_attr, 1); \
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_SENDER_H_ */
@@ -0,0 +1,518 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "st_dev.h"
+#include "iot_os_util.h"
+#include "caps_sender.h"
+#include "caps_state_journal.h"
+#include "caps_util.h"
+
+/* caps_sender only records attributes when built with the flag */
+#ifndef CAPS_SENDER_USE_STATE_JOURNAL
+#error "caps_state_journal needs CAPS_SENDER_USE_STATE_JOURNAL defined for the whole build"
+#endif
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+#define STATE_JOURNAL_MAGIC 0x4a534143U     /* "CASJ" */
+#define STATE_JOURNAL_VERSION 2
+
+enum {
+    STATE_JOURNAL_NONE,
+    STATE_JOURNAL_NUMBER,
+    STATE_JOURNAL_STRING,
+};
+
+struct caps_state_journal_record {
+    unsigned int key;               /* hash of name */
+    unsigned char type;
+    unsigned char reserved[3];
+    char name[CAPS_STATE_JOURNAL_NAME_SIZE];    /* component/capability/attribute */
+    union {
+        double number;
+        char string[CAPS_STATE_JOURNAL_STRING_SIZE];
+    } value;
+};
+
+/* Layout in the storage, only count records are written */
+struct caps_state_journal_blob {
+    unsigned int magic;
+    unsigned short version;
+    unsigned short count;
+    unsigned int hash;              /* hash of the records */
+    struct caps_state_journal_record record[CAPS_STATE_JOURNAL_SIZE];
+};
+
+struct caps_state_journal_entry {
+    IOT_CAP_HANDLE *handle;
+    const char *attribute;
+    unsigned int key;
+    char name[CAPS_STATE_JOURNAL_NAME_SIZE];
+};
+
+static struct caps_state_journal_entry journal_entry[CAPS_STATE_JOURNAL_SIZE];
+static int journal_entry_num;
+/* restored and recorded values, records of unregistered attributes are kept until the space is needed */
+static struct caps_state_journal_record journal_record[CAPS_STATE_JOURNAL_SIZE];
+static int journal_record_num;
+static struct caps_state_journal_blob journal_blob;
+
+static caps_state_journal_storage_t journal_storage;
+static caps_state_journal_stats_t journal_stats;
+static unsigned int journal_stats_ms;
+static int journal_dirty;
+static unsigned int journal_dirty_ms;
+static unsigned int journal_write_ms;
+static int journal_written;
+static int journal_retry;
+static unsigned int journal_stored_hash;
+static int journal_stored;
+
+static iot_os_mutex journal_mutex;
+static iot_os_mutex journal_write_mutex;
+static int journal_mutex_ready;
+static iot_os_thread journal_thread;
+
+static int _journal_lock_init(void)
+{
+    if (!journal_mutex_ready) {
+        if (iot_os_mutex_init(&journal_mutex) != IOT_OS_TRUE) {
+            printf("fail to init journal mutex\n");
+            return -1;
+        }
+        if (iot_os_mutex_init(&journal_write_mutex) != IOT_OS_TRUE) {
+            printf("fail to init journal write mutex\n");
+            iot_os_mutex_destroy(&journal_mutex);
+            return -1;
+        }
+        journal_mutex_ready = 1;
+    }
+    return 0;
+}
+
+static unsigned int _hash_bytes(unsigned int hash, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+
+    while (len--) {
+        hash ^= *p++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/* Returns -1 if the name doesn't fit in CAPS_STATE_JOURNAL_NAME_SIZE */
+static int _journal_name(char *name, const char *component, const char *capability, const char *attribute)
+{
+    int len;
+
+    len = snprintf(name, CAPS_STATE_JOURNAL_NAME_SIZE, "%s/%s/%s", component, capability, attribute);
+    if (len < 0 || len >= CAPS_STATE_JOURNAL_NAME_SIZE)
+        return -1;
+    return 0;
+}
+
+static unsigned int _journal_key(const char *name)
+{
+    return _hash_bytes(FNV_OFFSET_BASIS, name, strlen(name));
+}
+
+static struct caps_state_journal_entry *_find_entry(IOT_CAP_HANDLE *handle, const char *attribute)
+{
+    int i;
+
+    for (i = 0; i < journal_entry_num; i++) {
+        if (journal_entry[i].handle == handle &&
+                (journal_entry[i].attribute == attribute || !strcmp(journal_entry[i].attribute, attribute)))
+            return &journal_entry[i];
+    }
+    return NULL;
+}
+
+/* the key only narrows the search, two names may have the same hash */
+static struct caps_state_journal_record *_find_record(unsigned int key, const char *name)
+{
+    int i;
+
+    for (i = 0; i < journal_record_num; i++) {
+        if (journal_record[i].key == key && !strcmp(journal_record[i].name, name))
+            return &journal_record[i];
+    }
+    return NULL;
+}
+
+static int _is_registered(const struct caps_state_journal_record *record)
+{
+    int i;
+
+    for (i = 0; i < journal_entry_num; i++) {
+        if (journal_entry[i].key == record->key && !strcmp(journal_entry[i].name, record->name))
+            return 1;
+    }
+    return 0;
+}
+
+static struct caps_state_journal_record *_alloc_record(void)
+{
+    int i;
+
+    if (journal_record_num < CAPS_STATE_JOURNAL_SIZE)
+        return &journal_record[journal_record_num++];
+
+    /* reuse a restored record which nobody registered */
+    for (i = 0; i < journal_record_num; i++) {
+        if (!_is_registered(&journal_record[i]))
+            return &journal_record[i];
+    }
+    return NULL;
+}
+
+static int _journal_commit(void)
+{
+    unsigned int hash;
+    unsigned int size;
+    int err = 0;
+
+    iot_os_mutex_lock(&journal_write_mutex);
+    iot_os_mutex_lock(&journal_mutex);
+    if (!journal_dirty) {
+        iot_os_mutex_unlock(&journal_mutex);
+        iot_os_mutex_unlock(&journal_write_mutex);
+        return 0;
+    }
+    journal_blob.magic = STATE_JOURNAL_MAGIC;
+    journal_blob.version = STATE_JOURNAL_VERSION;
+    journal_blob.count = journal_record_num;
+    memcpy(journal_blob.record, journal_record, journal_record_num * sizeof(journal_record[0]));
+    size = journal_record_num * sizeof(journal_record[0]);
+    hash = _hash_bytes(FNV_OFFSET_BASIS, journal_blob.record, size);
+    journal_blob.hash = hash;
+    journal_dirty = 0;
+    journal_write_ms = caps_util_get_time_ms();
+    journal_written = 1;
+    iot_os_mutex_unlock(&journal_mutex);
+
+    /* changed and changed back within the commit delay */
+    if (journal_stored && hash == journal_stored_hash) {
+        iot_os_mutex_lock(&journal_mutex);
+        journal_stats.skipped_count++;
+        iot_os_mutex_unlock(&journal_mutex);
+        iot_os_mutex_unlock(&journal_write_mutex);
+        return 0;
+    }
+
+    err = journal_storage.write(&journal_blob, offsetof(struct caps_state_journal_blob, record) + size,
+            journal_storage.usr_data);
+
+    iot_os_mutex_lock(&journal_mutex);
+    if (err) {
+        printf("fail to write state journal : %d\n", err);
+        journal_stats.fail_count++;
+        /* retried on the next tick, a failed write doesn't count for the interval */
+        journal_dirty = 1;
+        journal_retry = 1;
+    } else {
+        journal_stats.write_count++;
+        journal_stored_hash = hash;
+        journal_stored = 1;
+        journal_retry = 0;
+    }
+    iot_os_mutex_unlock(&journal_mutex);
+    iot_os_mutex_unlock(&journal_write_mutex);
+
+    return err ? -1 : 0;
+}
+
+static void _state_journal_task(void *arg)
+{
+    unsigned int now_ms;
+    int due;
+
+    for (;;) {
+        iot_os_delay(CAPS_STATE_JOURNAL_TICK_MS);
+
+        iot_os_mutex_lock(&journal_mutex);
+        now_ms = caps_util_get_time_ms();
+        due = journal_dirty && (journal_retry ||
+                ((now_ms - journal_dirty_ms >= CAPS_STATE_JOURNAL_COMMIT_DELAY_MS) &&
+                (!journal_written || now_ms - journal_write_ms >= CAPS_STATE_JOURNAL_MIN_WRITE_INTERVAL_MS)));
+        iot_os_mutex_unlock(&journal_mutex);
+
+        if (due)
+            _journal_commit();
+    }
+}
+
+static void _journal_restore(void)
+{
+    int size;
+    int i;
+
+    size = journal_storage.read(&journal_blob, sizeof(journal_blob), journal_storage.usr_data);
+    if (size < (int)offsetof(struct caps_state_journal_blob, record))
+        return;
+
+    if (journal_blob.magic != STATE_JOURNAL_MAGIC || journal_blob.version != STATE_JOURNAL_VERSION ||
+            journal_blob.count > CAPS_STATE_JOURNAL_SIZE ||
+            size < (int)(offsetof(struct caps_state_journal_blob, record) +
+                    journal_blob.count * sizeof(journal_blob.record[0])) ||
+            journal_blob.hash != _hash_bytes(FNV_OFFSET_BASIS, journal_blob.record,
+                    journal_blob.count * sizeof(journal_blob.record[0]))) {
+        printf("state journal is invalid, ignored\n");
+        return;
+    }
+
+    memcpy(journal_record, journal_blob.record, journal_blob.count * sizeof(journal_blob.record[0]));
+    journal_record_num = journal_blob.count;
+    for (i = 0; i < journal_record_num; i++)
+        journal_record[i].name[CAPS_STATE_JOURNAL_NAME_SIZE - 1] = '\0';
+    journal_stored_hash = journal_blob.hash;
+    journal_stored = 1;
+    journal_stats.restored_count = journal_record_num;
+}
+
+int caps_state_journal_init(const caps_state_journal_storage_t *storage)
+{
+    if (!storage || !storage->read || !storage->write) {
+        printf("invalid journal storage\n");
+        return -1;
+    }
+    if (journal_thread) {
+        printf("state journal is already initialized\n");
+        return -1;
+    }
+    if (_journal_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&journal_mutex);
+    journal_storage = *storage;
+    _journal_restore();
+    journal_stats_ms = caps_util_get_time_ms();
+    iot_os_mutex_unlock(&journal_mutex);
+
+    if (iot_os_thread_create(_state_journal_task, "caps_journal", CAPS_STATE_JOURNAL_TASK_STACK_SIZE,
+            NULL, CAPS_STATE_JOURNAL_TASK_PRIORITY, &journal_thread) != IOT_OS_TRUE) {
+        printf("fail to create state journal task\n");
+        return -1;
+    }
+    return 0;
+}
+
+int caps_state_journal_register(const char *component, const char *capability, const char *attribute)
+{
+    struct caps_state_journal_entry *entry;
+    IOT_CAP_HANDLE *handle;
+    char name[CAPS_STATE_JOURNAL_NAME_SIZE];
+
+    if (!component || !capability || !attribute) {
+        printf("invalid component, capability or attribute\n");
+        return -1;
+    }
+    if (_journal_name(name, component, capability, attribute)) {
+        printf("%s/%s/%s is too long for the state journal\n", component, capability, attribute);
+        return -1;
+    }
+    handle = caps_sender_find_handle(component, capability);
+    if (!handle) {
+        printf("no handle for %s/%s\n", component, capability);
+        return -1;
+    }
+    if (_journal_lock_init()) {
+        return -1;
+    }
+
+    iot_os_mutex_lock(&journal_mutex);
+    if (_find_entry(handle, attribute)) {
+        iot_os_mutex_unlock(&journal_mutex);
+        return 0;
+    }
+    if (journal_entry_num >= CAPS_STATE_JOURNAL_SIZE) {
+        iot_os_mutex_unlock(&journal_mutex);
+        printf("state journal is full for %s\n", attribute);
+        return -1;
+    }
+    entry = &journal_entry[journal_entry_num++];
+    entry->handle = handle;
+    entry->attribute = attribute;
+    strcpy(entry->name, name);
+    entry->key = _journal_key(name);
+    iot_os_mutex_unlock(&journal_mutex);
+
+    return 0;
+}
+
+int caps_state_journal_get_number(const char *component, const char *capability, const char *attribute, double *value)
+{
+    struct caps_state_journal_record *record;
+    char name[CAPS_STATE_JOURNAL_NAME_SIZE];
+    int ret = -1;
+
+    if (!component || !capability || !attribute || !value || !journal_mutex_ready)
+        return -1;
+    if (_journal_name(name, component, capability, attribute))
+        return -1;
+
+    iot_os_mutex_lock(&journal_mutex);
+    record = _find_record(_journal_key(name), name);
+    if (record && record->type == STATE_JOURNAL_NUMBER) {
+        *value = record->value.number;
+        ret = 0;
+    }
+    iot_os_mutex_unlock(&journal_mutex);
+
+    return ret;
+}
+
+int caps_state_journal_get_string(const char *component, const char *capability, const char *attribute,
+        char *buf, unsigned int size)
+{
+    struct caps_state_journal_record *record;
+    char name[CAPS_STATE_JOURNAL_NAME_SIZE];
+    int ret = -1;
+
+    if (!component || !capability || !attribute || !buf || !size || !journal_mutex_ready)
+        return -1;
+    if (_journal_name(name, component, capability, attribute))
+        return -1;
+
+    iot_os_mutex_lock(&journal_mutex);
+    record = _find_record(_journal_key(name), name);
+    if (record && record->type == STATE_JOURNAL_STRING && strlen(record->value.string) < size) {
+        strcpy(buf, record->value.string);
+        ret = 0;
+    }
+    iot_os_mutex_unlock(&journal_mutex);
+
+    return ret;
+}
+
+int caps_state_journal_flush(void)
+{
+    if (!journal_thread)
+        return -1;
+    return _journal_commit();
+}
+
+void caps_state_journal_get_stats(caps_state_journal_stats_t *stats)
+{
+    unsigned int elapsed_ms;
+
+    if (!stats)
+        return;
+    if (!journal_mutex_ready) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    iot_os_mutex_lock(&journal_mutex);
+    *stats = journal_stats;
+    elapsed_ms = caps_util_get_time_ms() - journal_stats_ms;
+    iot_os_mutex_unlock(&journal_mutex);
+
+    if (elapsed_ms)
+        stats->writes_per_hour = (unsigned int)((unsigned long long)stats->write_count * 3600000 / elapsed_ms);
+}
+
+void caps_state_journal_reset_stats(void)
+{
+    unsigned int restored_count;
+
+    if (!journal_mutex_ready)
+        return;
+
+    iot_os_mutex_lock(&journal_mutex);
+    restored_count = journal_stats.restored_count;
+    memset(&journal_stats, 0, sizeof(journal_stats));
+    journal_stats.restored_count = restored_count;
+    journal_stats_ms = caps_util_get_time_ms();
+    iot_os_mutex_unlock(&journal_mutex);
+}
+
+void caps_state_journal_record(const caps_attr_t *attr)
+{
+    struct caps_state_journal_entry *entry;
+    struct caps_state_journal_record *record;
+    struct caps_state_journal_record value;
+
+    /* not started, journal_entry_num is only read with journal_mutex */
+    if (!journal_mutex_ready)
+        return;
+
+    memset(&value, 0, sizeof(value));
+    switch (attr->value.type) {
+    case IOT_CAP_VAL_TYPE_INTEGER:
+        value.type = STATE_JOURNAL_NUMBER;
+        value.value.number = attr->value.integer;
+        break;
+    case IOT_CAP_VAL_TYPE_NUMBER:
+    case IOT_CAP_VAL_TYPE_INT_OR_NUM:
+        value.type = STATE_JOURNAL_NUMBER;
+        value.value.number = attr->value.number;
+        break;
+    case IOT_CAP_VAL_TYPE_BOOLEAN:
+        value.type = STATE_JOURNAL_NUMBER;
+        value.value.number = attr->value.boolean;
+        break;
+    case IOT_CAP_VAL_TYPE_STRING:
+        if (!attr->value.string || strlen(attr->value.string) >= CAPS_STATE_JOURNAL_STRING_SIZE)
+            return;
+        value.type = STATE_JOURNAL_STRING;
+        strcpy(value.value.string, attr->value.string);
+        break;
+    default:
+        return;
+    }
+
+    iot_os_mutex_lock(&journal_mutex);
+    entry = _find_entry(attr->handle, attr->name);
+    if (!entry) {
+        iot_os_mutex_unlock(&journal_mutex);
+        return;
+    }
+    value.key = entry->key;
+    strcpy(value.name, entry->name);
+
+    record = _find_record(entry->key, entry->name);
+    if (!record) {
+        record = _alloc_record();
+        if (!record) {
+            iot_os_mutex_unlock(&journal_mutex);
+            printf("no journal record for %s\n", attr->name);
+            return;
+        }
+    } else if (!memcmp(record, &value, sizeof(value))) {
+        iot_os_mutex_unlock(&journal_mutex);
+        return;
+    }
+    *record = value;
+
+    journal_stats.record_count++;
+    if (journal_dirty) {
+        journal_stats.coalesced_count++;
+    } else {
+        journal_dirty = 1;
+        journal_dirty_ms = caps_util_get_time_ms();
+    }
+    iot_os_mutex_unlock(&journal_mutex);
+}
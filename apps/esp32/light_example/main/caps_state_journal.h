@@ -0,0 +1,127 @@
+/* ***************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef _CAPS_STATE_JOURNAL_H_
+#define _CAPS_STATE_JOURNAL_H_
+
+#include "st_dev.h"
+#include "caps_sender.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of attributes which can be kept in the journal */
+#ifndef CAPS_STATE_JOURNAL_SIZE
+#define CAPS_STATE_JOURNAL_SIZE 16
+#endif
+
+/* Longest string value kept, including the terminator. Longer values are not recorded. */
+#ifndef CAPS_STATE_JOURNAL_STRING_SIZE
+#define CAPS_STATE_JOURNAL_STRING_SIZE 32
+#endif
+
+/* Longest component/capability/attribute name kept with a value, including the terminator */
+#ifndef CAPS_STATE_JOURNAL_NAME_SIZE
+#define CAPS_STATE_JOURNAL_NAME_SIZE 48
+#endif
+
+/* Changes made within this time after the first change are written together */
+#ifndef CAPS_STATE_JOURNAL_COMMIT_DELAY_MS
+#define CAPS_STATE_JOURNAL_COMMIT_DELAY_MS 5000
+#endif
+
+/* At most one write per interval, whatever the rate of changes */
+#ifndef CAPS_STATE_JOURNAL_MIN_WRITE_INTERVAL_MS
+#define CAPS_STATE_JOURNAL_MIN_WRITE_INTERVAL_MS 60000
+#endif
+
+#ifndef CAPS_STATE_JOURNAL_TICK_MS
+#define CAPS_STATE_JOURNAL_TICK_MS 1000
+#endif
+
+#ifndef CAPS_STATE_JOURNAL_TASK_STACK_SIZE
+#define CAPS_STATE_JOURNAL_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CAPS_STATE_JOURNAL_TASK_PRIORITY
+#define CAPS_STATE_JOURNAL_TASK_PRIORITY 5
+#endif
+
+typedef struct caps_state_journal_storage {
+    /* Read the last written journal into buf. Returns the size read, or -1 if there is none. */
+    int (*read)(void *buf, unsigned int size, void *usr_data);
+    /* Replace the stored journal with buf. Returns 0 on success. */
+    int (*write)(const void *buf, unsigned int size, void *usr_data);
+    void *usr_data;
+} caps_state_journal_storage_t;
+
+typedef struct caps_state_journal_stats {
+    unsigned int record_count;      /* changed values given to the journal */
+    unsigned int coalesced_count;   /* changes merged into a write which was already pending */
+    unsigned int write_count;       /* writes to the storage */
+    unsigned int skipped_count;     /* pending writes dropped as the stored journal was the same */
+    unsigned int fail_count;        /* failed writes, retried on the next tick without waiting for the interval */
+    unsigned int restored_count;    /* values found in the storage at boot */
+    unsigned int writes_per_hour;   /* write_count over the time since init or reset */
+} caps_state_journal_stats_t;
+
+/**
+ * Persisted journal of the last known attribute values.
+ *
+ * Registered attributes are recorded by caps_sender_send_attrs() whenever the app
+ * sends them, and written through the storage callbacks. Writes are coalesced: the
+ * whole journal is written once CAPS_STATE_JOURNAL_COMMIT_DELAY_MS has passed after
+ * the first change, and not more than once per CAPS_STATE_JOURNAL_MIN_WRITE_INTERVAL_MS.
+ * A journal that is the same as the stored one is not written.
+ *
+ * At boot, call caps_state_journal_init() once the storage is ready, register the
+ * attributes after initializing the capabilities, and restore the values with
+ * caps_state_journal_get_*() before st_conn_start(), so outputs can be driven
+ * without waiting for the server.
+ *
+ * Integer, number and boolean values are kept as numbers, strings up to
+ * CAPS_STATE_JOURNAL_STRING_SIZE. Units, data, arrays and objects are not kept.
+ */
+int caps_state_journal_init(const caps_state_journal_storage_t *storage);
+
+/**
+ * component, capability and attribute must stay valid, e.g. "main", caps_helper_X.id and caps_helper_X.attr_Y.name.
+ * Values are kept with "component/capability/attribute", which has to fit in CAPS_STATE_JOURNAL_NAME_SIZE.
+ */
+int caps_state_journal_register(const char *component, const char *capability, const char *attribute);
+
+/* Return 0 and the restored or last recorded value, or -1 if the journal has none */
+int caps_state_journal_get_number(const char *component, const char *capability, const char *attribute, double *value);
+int caps_state_journal_get_string(const char *component, const char *capability, const char *attribute,
+        char *buf, unsigned int size);
+
+/* Write a pending change now, e.g. before a reboot */
+int caps_state_journal_flush(void);
+
+void caps_state_journal_get_stats(caps_state_journal_stats_t *stats);
+void caps_state_journal_reset_stats(void);
+
+/* Used by caps_sender */
+void caps_state_journal_record(const caps_attr_t *attr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CAPS_STATE_JOURNAL_H_ */
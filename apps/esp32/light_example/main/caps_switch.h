@@ -27,10 +27,12 @@ typedef struct caps_switch_data {
     void *usr_data;
     void *cmd_data;
 
-    char *switch_value;
+    int switch_idx;
 
     const char *(*get_switch_value)(struct caps_switch_data *caps_data);
     void (*set_switch_value)(struct caps_switch_data *caps_data, const char *value);
+    int (*get_switch_idx)(struct caps_switch_data *caps_data);
+    void (*set_switch_idx)(struct caps_switch_data *caps_data, int idx);
     int (*attr_switch_str2idx)(const char *value);
     void (*attr_switch_send)(struct caps_switch_data *caps_data);
 
@@ -41,6 +43,35 @@ typedef struct caps_switch_data {
 } caps_switch_data_t;
 
 caps_switch_data_t *caps_switch_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_switch_deinitialize(caps_switch_data_t *caps_data);
+
+/*
+ * Channels of a multi-gang device, e.g. components "switch1".."switch8".
+ * All channels share one allocation and one set of functions, ch is the index
+ * into the components given to caps_switch_initialize_n().
+ */
+typedef struct caps_switch_n_data {
+    IOT_CAP_HANDLE **handle;
+    void *usr_data;
+    int num;
+
+    signed char *switch_idx;
+
+    const char *(*get_switch_value)(struct caps_switch_n_data *caps_data, int ch);
+    void (*set_switch_value)(struct caps_switch_n_data *caps_data, int ch, const char *value);
+    int (*get_switch_idx)(struct caps_switch_n_data *caps_data, int ch);
+    void (*set_switch_idx)(struct caps_switch_n_data *caps_data, int ch, int idx);
+    void (*attr_switch_send)(struct caps_switch_n_data *caps_data, int ch);
+    void (*attr_switch_send_all)(struct caps_switch_n_data *caps_data);
+
+    void (*init_usr_cb)(struct caps_switch_n_data *caps_data, int ch);
+
+    void (*cmd_on_usr_cb)(struct caps_switch_n_data *caps_data, int ch);
+    void (*cmd_off_usr_cb)(struct caps_switch_n_data *caps_data, int ch);
+} caps_switch_n_data_t;
+
+caps_switch_n_data_t *caps_switch_initialize_n(IOT_CTX *ctx, const char **components, int num, void *init_usr_cb, void *usr_data);
+void caps_switch_deinitialize_n(caps_switch_n_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,35 @@ typedef struct caps_switchLevel_data {
 } caps_switchLevel_data_t;
 
 caps_switchLevel_data_t *caps_switchLevel_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);
+void caps_switchLevel_deinitialize(caps_switchLevel_data_t *caps_data);
+
+/*
+ * Channels of a multi-channel dimmer, e.g. components "channel1".."channel16".
+ * All channels share one allocation, one set of functions and the unit, ch is
+ * the index into the components given to caps_switchLevel_initialize_n().
+ */
+typedef struct caps_switchLevel_n_data {
+    IOT_CAP_HANDLE **handle;
+    void *usr_data;
+    int num;
+
+    unsigned char *level_value;
+    char *level_unit;
+
+    int (*get_level_value)(struct caps_switchLevel_n_data *caps_data, int ch);
+    void (*set_level_value)(struct caps_switchLevel_n_data *caps_data, int ch, int value);
+    const char *(*get_level_unit)(struct caps_switchLevel_n_data *caps_data);
+    void (*set_level_unit)(struct caps_switchLevel_n_data *caps_data, const char *unit);
+    void (*attr_level_send)(struct caps_switchLevel_n_data *caps_data, int ch);
+    void (*attr_level_send_all)(struct caps_switchLevel_n_data *caps_data);
+
+    void (*init_usr_cb)(struct caps_switchLevel_n_data *caps_data, int ch);
+
+    void (*cmd_setLevel_usr_cb)(struct caps_switchLevel_n_data *caps_data, int ch);
+} caps_switchLevel_n_data_t;
+
+caps_switchLevel_n_data_t *caps_switchLevel_initialize_n(IOT_CTX *ctx, const char **components, int num, void *init_usr_cb, void *usr_data);
+void caps_switchLevel_deinitialize_n(caps_switchLevel_n_data_t *caps_data);
 #ifdef __cplusplus
 }
 #endif
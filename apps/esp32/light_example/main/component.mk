@@ -3,4 +3,6 @@
 #
 # (Uses default behaviour of compiling all source files in directory, adding 'include' to include path.)
 
-COMPONENT_EMBED_TXTFILES := onboarding_config.json device_info.json
\ No newline at end of file
+COMPONENT_EMBED_TXTFILES := onboarding_config.json device_info.json report_policy.json
+
+CFLAGS += -DCAPS_SENDER_USE_REPORT_POLICY -DCAPS_SENDER_USE_PAYLOAD_CACHE -DCAPS_SENDER_USE_STATE_JOURNAL
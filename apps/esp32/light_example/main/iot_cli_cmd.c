@@ -24,6 +24,12 @@
 #include "device_control.h"
 
 #include "st_dev.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "caps_payload_cache.h"
+#include "caps_report_policy.h"
+#include "caps_state_journal.h"
+#include "caps_cmd.h"
 
 extern IOT_CTX *ctx;
 
@@ -89,33 +95,196 @@ static void _cli_cmd_butten_event(char *string)
     button_event(ctx, type, count);
 }
 
-extern int monitor_enable;
+extern void app_set_monitor_enable(int enable);
 static void _cli_cmd_monitor_enable(char *string)
 {
     char buf[MAX_UART_LINE_SIZE];
+    int monitor_enable;
 
     if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
         monitor_enable = strtol(buf, NULL, 10);
+        app_set_monitor_enable(monitor_enable);
         printf("change monitor mode to %d\n", monitor_enable);
     }
 }
 
-extern int monitor_period_ms;
+extern void app_set_monitor_period(int period_ms);
 static void _cli_cmd_monitor_period(char *string)
 {
     char buf[MAX_UART_LINE_SIZE];
+    int monitor_period_ms;
 
     if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
         monitor_period_ms = strtol(buf, NULL, 10);
+        app_set_monitor_period(monitor_period_ms);
         printf("change monitor period to %d ms\n", monitor_period_ms);
     }
 }
 
+static void _cli_cmd_send_cache(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        if (strncmp(buf, "reset", 5) == 0) {
+            caps_send_cache_reset_suppressed();
+        } else if (strncmp(buf, "invalidate", 10) == 0) {
+            caps_send_cache_invalidate(NULL);
+        }
+    }
+
+    printf("send cache : registered %d, suppressed %u\n",
+            caps_send_cache_get_registered(), caps_send_cache_get_suppressed());
+}
+
+#if defined(CAPS_SENDER_USE_PAYLOAD_CACHE)
+static void _cli_cmd_payload_cache(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+    caps_payload_cache_stats_t stats;
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        if (strncmp(buf, "reset", 5) == 0) {
+            caps_payload_cache_reset_stats();
+        } else if (strncmp(buf, "invalidate", 10) == 0) {
+            caps_payload_cache_invalidate(NULL);
+        }
+    }
+
+    caps_payload_cache_get_stats(&stats);
+    printf("payload cache : hit %u, built %u, busy %u\n", stats.hit_count, stats.build_count, stats.busy_count);
+}
+#endif
+
+static void _cli_cmd_init_publish(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        caps_sender_set_init_publish(strtol(buf, NULL, 10));
+    }
+    printf("init publish : %d\n", caps_sender_get_init_publish());
+}
+
+static void _cli_cmd_coalesce(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+    caps_sender_stats_t stats;
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        if (strncmp(buf, "reset", 5) == 0) {
+            caps_sender_reset_stats();
+        } else {
+            caps_sender_set_coalesce_window(strtol(buf, NULL, 10));
+        }
+    }
+
+    caps_sender_get_stats(&stats);
+    printf("coalesce window : %u ms\n", caps_sender_get_coalesce_window());
+    printf("flush : %u, events : %u, replaced : %u, max size : %u\n",
+            stats.flush_count, stats.event_count, stats.replaced_count, stats.max_flush_size);
+    if (stats.flush_count) {
+        printf("latency avg : %u ms, max : %u ms\n",
+                stats.total_latency_ms / stats.flush_count, stats.max_latency_ms);
+    }
+}
+
+static void _cli_cmd_cmd_stats(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+    caps_cmd_stats_t stats;
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        if (strncmp(buf, "reset", 5) == 0) {
+            caps_cmd_reset_stats();
+        }
+    }
+
+    caps_cmd_get_stats(&stats);
+    printf("command executor : %s\n", caps_cmd_executor_is_running() ? "running" : "off");
+    printf("queued : %u, collapsed : %u, dropped : %u, executed : %u, max queued : %u\n",
+            stats.queued_count, stats.collapsed_count, stats.dropped_count, stats.executed_count, stats.max_queued);
+    if (stats.executed_count) {
+        printf("wait avg : %u ms, max : %u ms\n",
+                stats.total_wait_ms / stats.executed_count, stats.max_wait_ms);
+        printf("exec avg : %u ms, max : %u ms\n",
+                stats.total_exec_ms / stats.executed_count, stats.max_exec_ms);
+    }
+    printf("batch : %u, max size : %u\n", stats.batch_count, stats.max_batch_size);
+}
+
+static void _cli_cmd_journal(char *string)
+{
+    char buf[MAX_UART_LINE_SIZE];
+    caps_state_journal_stats_t stats;
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 1) >= 0) {
+        if (strncmp(buf, "reset", 5) == 0) {
+            caps_state_journal_reset_stats();
+        } else if (strncmp(buf, "flush", 5) == 0) {
+            caps_state_journal_flush();
+        }
+    }
+
+    caps_state_journal_get_stats(&stats);
+    printf("restored : %u, recorded : %u, coalesced : %u\n",
+            stats.restored_count, stats.record_count, stats.coalesced_count);
+    printf("writes : %u (%u per hour), skipped : %u, failed : %u\n",
+            stats.write_count, stats.writes_per_hour, stats.skipped_count, stats.fail_count);
+}
+
+#if defined(CAPS_SENDER_USE_REPORT_POLICY)
+static void _cli_cmd_report_policy(char *string)
+{
+    char component[32];
+    char capability[32];
+    char attribute[32];
+    char buf[16];
+    char *end;
+    caps_report_policy_t policy = {0};
+
+    if (_cli_copy_nth_arg(component, string, sizeof(component), 1) < 0) {
+        caps_report_policy_dump();
+        return;
+    }
+    if (_cli_copy_nth_arg(capability, string, sizeof(capability), 2) < 0 ||
+            _cli_copy_nth_arg(attribute, string, sizeof(attribute), 3) < 0) {
+        printf("usage : report_policy {component} {capability} {attribute} [min_s] [max_s] [change[%%]]\n");
+        return;
+    }
+
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 4) >= 0)
+        policy.min_interval_ms = strtoul(buf, NULL, 10) * 1000;
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 5) >= 0)
+        policy.max_interval_ms = strtoul(buf, NULL, 10) * 1000;
+    if (_cli_copy_nth_arg(buf, string, sizeof(buf), 6) >= 0) {
+        policy.change = strtod(buf, &end);
+        policy.change_percent = (*end == '%');
+    }
+
+    /* the policy keeps its own copy of the attribute name */
+    if (caps_report_policy_set_by_name(component, capability, attribute, &policy) < 0)
+        return;
+    caps_report_policy_dump();
+}
+#endif
+
 static struct cli_command cmd_list[] = {
     {"cleanup", "clean-up data with reboot option", _cli_cmd_cleanup},
     {"button", "button {count} {type} : ex) button 5 / button 1 long", _cli_cmd_butten_event},
     {"monitor_enable", "monitor_enable {0|1}", _cli_cmd_monitor_enable},
     {"monitor_period", "monitor_period {period_ms}", _cli_cmd_monitor_period},
+    {"send_cache", "send_cache [reset|invalidate] : show suppressed send count", _cli_cmd_send_cache},
+#if defined(CAPS_SENDER_USE_PAYLOAD_CACHE)
+    {"payload_cache", "payload_cache [reset|invalidate] : show reused events", _cli_cmd_payload_cache},
+#endif
+    {"init_publish", "init_publish {0|1} : send init attributes in one message", _cli_cmd_init_publish},
+    {"coalesce", "coalesce [{window_ms}|reset] : show or set send coalescing window", _cli_cmd_coalesce},
+#if defined(CAPS_SENDER_USE_REPORT_POLICY)
+    {"report_policy", "report_policy [{component} {capability} {attribute} {min_s} {max_s} {change[%]}]", _cli_cmd_report_policy},
+#endif
+    {"cmd_stats", "cmd_stats [reset] : show command executor latency", _cli_cmd_cmd_stats},
+    {"journal", "journal [flush|reset] : show state journal writes", _cli_cmd_journal},
 };
 
 void register_iot_cli_cmd(void) {
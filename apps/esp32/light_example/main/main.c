@@ -25,6 +25,7 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "nvs.h"
 
 #include "iot_uart_cli.h"
 #include "iot_cli_cmd.h"
@@ -34,6 +35,13 @@
 #include "caps_colorTemperature.h"
 #include "caps_activityLightingMode.h"
 #include "caps_dustSensor.h"
+#include "caps_sender.h"
+#include "caps_send_cache.h"
+#include "caps_payload_cache.h"
+#include "caps_report_policy.h"
+#include "caps_cmd.h"
+#include "caps_state_journal.h"
+#include "caps_seqlock.h"
 
 // onboarding_config_start is null-terminated string
 extern const uint8_t onboarding_config_start[]    asm("_binary_onboarding_config_json_start");
@@ -43,14 +51,60 @@ extern const uint8_t onboarding_config_end[]    asm("_binary_onboarding_config_j
 extern const uint8_t device_info_start[]    asm("_binary_device_info_json_start");
 extern const uint8_t device_info_end[]        asm("_binary_device_info_json_end");
 
-static iot_status_t g_iot_status = IOT_STATUS_IDLE;
-static iot_stat_lv_t g_iot_stat_lv;
 
 IOT_CTX* ctx = NULL;
 
 //#define SET_PIN_NUMBER_CONFRIM
 
-static int noti_led_mode = LED_ANIMATION_MODE_IDLE;
+// publish the state of all capabilities in one message when connected
+//#define USE_INIT_PUBLISH
+
+// hold attribute sends for this time and publish them in one message
+//#define SEND_COALESCE_WINDOW_MS 100
+
+// run command callbacks in a caps_cmd task instead of the iot-core task
+//#define USE_CMD_EXECUTOR
+#define CMD_BATCH_WINDOW_MS 20
+
+// restore the last switch, level, color temperature and lighting mode at boot
+//#define USE_STATE_JOURNAL
+#define STATE_JOURNAL_NVS_NAMESPACE "caps_journal"
+#define STATE_JOURNAL_NVS_KEY "state"
+
+// apply the reporting policies of report_policy.json, also set USE_REPORT_POLICY in CMakeLists.txt
+//#define USE_REPORT_POLICY
+
+// reuse the events of the light attributes, also set USE_PAYLOAD_CACHE in CMakeLists.txt
+//#define USE_PAYLOAD_CACHE
+
+#if defined(USE_REPORT_POLICY)
+#if !defined(CAPS_SENDER_USE_REPORT_POLICY)
+#error "USE_REPORT_POLICY needs USE_REPORT_POLICY set in main/CMakeLists.txt"
+#endif
+extern const uint8_t report_policy_start[]    asm("_binary_report_policy_json_start");
+extern const uint8_t report_policy_end[]    asm("_binary_report_policy_json_end");
+#endif
+
+#if defined(USE_PAYLOAD_CACHE) && !defined(CAPS_SENDER_USE_PAYLOAD_CACHE)
+#error "USE_PAYLOAD_CACHE needs USE_PAYLOAD_CACHE set in main/CMakeLists.txt"
+#endif
+
+/* shared by the iot-core, app and CLI tasks, read it with app_state_get() */
+struct app_state {
+    iot_status_t iot_status;
+    iot_stat_lv_t iot_stat_lv;
+    int noti_led_mode;
+    int monitor_enable;
+    int monitor_period_ms;
+};
+
+static struct app_state app_state = {
+    .iot_status = IOT_STATUS_IDLE,
+    .noti_led_mode = LED_ANIMATION_MODE_IDLE,
+    .monitor_enable = false,
+    .monitor_period_ms = 30000,
+};
+static caps_seqlock_t app_state_lock;
 
 static caps_switch_data_t *cap_switch_data;
 static caps_switchLevel_data_t *cap_switchLevel_data;
@@ -58,21 +112,44 @@ static caps_colorTemperature_data_t *cap_colorTemp_data;
 static caps_activityLightingMode_data_t *cap_lightMode_data;
 static caps_dustSensor_data_t *cap_dustSensor_data;
 
-int monitor_enable = false;
-int monitor_period_ms = 30000;
+static void app_state_get(struct app_state *state)
+{
+    caps_seqlock_read(&app_state_lock, state, &app_state, sizeof(app_state));
+}
+
+static void set_noti_led_mode(int noti_led_mode)
+{
+    caps_seqlock_write_begin(&app_state_lock);
+    app_state.noti_led_mode = noti_led_mode;
+    caps_seqlock_write_end(&app_state_lock);
+}
+
+void app_set_monitor_enable(int enable)
+{
+    caps_seqlock_write_begin(&app_state_lock);
+    app_state.monitor_enable = enable;
+    caps_seqlock_write_end(&app_state_lock);
+}
+
+void app_set_monitor_period(int period_ms)
+{
+    caps_seqlock_write_begin(&app_state_lock);
+    app_state.monitor_period_ms = period_ms;
+    caps_seqlock_write_end(&app_state_lock);
+}
 
 static int get_switch_state(void)
 {
-    const char* switch_value = cap_switch_data->get_switch_value(cap_switch_data);
+    int switch_idx = cap_switch_data->get_switch_idx(cap_switch_data);
     int switch_state = SWITCH_OFF;
 
-    if (!switch_value) {
+    if (switch_idx < 0) {
         return -1;
     }
 
-    if (!strcmp(switch_value, caps_helper_switch.attr_switch.value_on)) {
+    if (switch_idx == CAP_ENUM_SWITCH_SWITCH_VALUE_ON) {
         switch_state = SWITCH_ON;
-    } else if (!strcmp(switch_value, caps_helper_switch.attr_switch.value_off)) {
+    } else if (switch_idx == CAP_ENUM_SWITCH_SWITCH_VALUE_OFF) {
         switch_state = SWITCH_OFF;
     }
     return switch_state;
@@ -124,16 +201,128 @@ static void cap_lightMode_cmd_cb(struct caps_activityLightingMode_data *caps_dat
     cap_colorTemp_data->attr_colorTemperature_send(cap_colorTemp_data);
 }
 
+#if defined(USE_CMD_EXECUTOR)
+static void cap_batch_cmd_cb(caps_cmd_batch_item_t *items, int item_num, void *usr_data)
+{
+    int level_changed = false;
+    int colorTemp_changed = false;
+    int i;
+
+    /* attributes are already updated, drive the LED once for the final state */
+    for (i = 0; i < item_num; i++) {
+        if (cap_switchLevel_data && items[i].handle == cap_switchLevel_data->handle) {
+            level_changed = true;
+        } else if (cap_colorTemp_data && items[i].handle == cap_colorTemp_data->handle) {
+            colorTemp_changed = true;
+        }
+    }
+
+    if (colorTemp_changed)
+        update_color_info(cap_colorTemp_data->get_colorTemperature_value(cap_colorTemp_data));
+    if (level_changed)
+        change_switch_level(cap_switchLevel_data->get_level_value(cap_switchLevel_data));
+    change_switch_state(get_switch_state());
+}
+#endif
+
+#if defined(USE_STATE_JOURNAL)
+static int state_journal_read(void *buf, unsigned int size, void *usr_data)
+{
+    nvs_handle nvs;
+    size_t len = size;
+    esp_err_t err;
+
+    if (nvs_open(STATE_JOURNAL_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK)
+        return -1;
+    err = nvs_get_blob(nvs, STATE_JOURNAL_NVS_KEY, buf, &len);
+    nvs_close(nvs);
+
+    return (err == ESP_OK) ? (int)len : -1;
+}
+
+static int state_journal_write(const void *buf, unsigned int size, void *usr_data)
+{
+    nvs_handle nvs;
+    esp_err_t err;
+
+    /* NVS appends the blob to its log pages, which spreads the wear over the partition */
+    err = nvs_open(STATE_JOURNAL_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK)
+        return err;
+    err = nvs_set_blob(nvs, STATE_JOURNAL_NVS_KEY, buf, size);
+    if (err == ESP_OK)
+        err = nvs_commit(nvs);
+    nvs_close(nvs);
+
+    return err;
+}
+
+static void state_journal_restore(void)
+{
+    const caps_state_journal_storage_t storage = {
+        .read = state_journal_read,
+        .write = state_journal_write,
+    };
+    char value[CAPS_STATE_JOURNAL_STRING_SIZE];
+    double number;
+
+    /* NVS is initialized by st_conn_init() */
+    if (caps_state_journal_init(&storage)) {
+        printf("fail to init state journal\n");
+        return;
+    }
+
+    if (cap_switch_data) {
+        caps_state_journal_register("main", caps_helper_switch.id, caps_helper_switch.attr_switch.name);
+        if (!caps_state_journal_get_string("main", caps_helper_switch.id, caps_helper_switch.attr_switch.name,
+                value, sizeof(value)))
+            cap_switch_data->set_switch_value(cap_switch_data, value);
+    }
+    if (cap_switchLevel_data) {
+        caps_state_journal_register("main", caps_helper_switchLevel.id, caps_helper_switchLevel.attr_level.name);
+        if (!caps_state_journal_get_number("main", caps_helper_switchLevel.id, caps_helper_switchLevel.attr_level.name,
+                &number))
+            cap_switchLevel_data->set_level_value(cap_switchLevel_data, (int)number);
+    }
+    if (cap_colorTemp_data) {
+        caps_state_journal_register("main", caps_helper_colorTemperature.id,
+                caps_helper_colorTemperature.attr_colorTemperature.name);
+        if (!caps_state_journal_get_number("main", caps_helper_colorTemperature.id,
+                caps_helper_colorTemperature.attr_colorTemperature.name, &number))
+            cap_colorTemp_data->set_colorTemperature_value(cap_colorTemp_data, (int)number);
+    }
+    if (cap_lightMode_data) {
+        caps_state_journal_register("main", caps_helper_activityLightingMode.id,
+                caps_helper_activityLightingMode.attr_lightingMode.name);
+        if (!caps_state_journal_get_string("main", caps_helper_activityLightingMode.id,
+                caps_helper_activityLightingMode.attr_lightingMode.name, value, sizeof(value)))
+            cap_lightMode_data->set_lightingMode_value(cap_lightMode_data, value);
+    }
+}
+#endif
+
 static void capability_init()
 {
+#if defined(USE_INIT_PUBLISH)
+    caps_sender_set_init_publish(true);
+#endif
+#if defined(SEND_COALESCE_WINDOW_MS)
+    caps_sender_set_coalesce_window(SEND_COALESCE_WINDOW_MS);
+#endif
+
     cap_switch_data = caps_switch_initialize(ctx, "main", NULL, NULL);
     if (cap_switch_data) {
-        const char *switch_init_value = caps_helper_switch.attr_switch.value_on;
+        int switch_init_idx = CAP_ENUM_SWITCH_SWITCH_VALUE_ON;
 
         cap_switch_data->cmd_on_usr_cb = cap_switch_cmd_cb;
         cap_switch_data->cmd_off_usr_cb = cap_switch_cmd_cb;
 
-        cap_switch_data->set_switch_value(cap_switch_data, switch_init_value);
+        cap_switch_data->set_switch_idx(cap_switch_data, switch_init_idx);
+
+#if defined(USE_PAYLOAD_CACHE)
+        /* resent unchanged on every refresh and reconnect */
+        caps_payload_cache_register(cap_switch_data->handle, caps_helper_switch.attr_switch.name);
+#endif
     }
 
     cap_switchLevel_data = caps_switchLevel_initialize(ctx, "main", NULL, NULL);
@@ -144,6 +333,10 @@ static void capability_init()
 
         cap_switchLevel_data->set_level_value(cap_switchLevel_data, switch_init_level);
         cap_switchLevel_data->set_level_unit(cap_switchLevel_data, caps_helper_switchLevel.attr_level.unit_percent);
+
+#if defined(USE_PAYLOAD_CACHE)
+        caps_payload_cache_register(cap_switchLevel_data->handle, caps_helper_switchLevel.attr_level.name);
+#endif
     }
 
     cap_colorTemp_data = caps_colorTemperature_initialize(ctx, "main", NULL, NULL);
@@ -153,6 +346,11 @@ static void capability_init()
         cap_colorTemp_data->cmd_setColorTemperature_usr_cb = cap_colorTemp_cmd_cb;
 
         cap_colorTemp_data->set_colorTemperature_value(cap_colorTemp_data, colorTemp_init_value);
+
+        caps_send_cache_register(cap_colorTemp_data->handle, caps_helper_colorTemperature.attr_colorTemperature.name);
+#if defined(USE_PAYLOAD_CACHE)
+        caps_payload_cache_register(cap_colorTemp_data->handle, caps_helper_colorTemperature.attr_colorTemperature.name);
+#endif
     }
 
     cap_lightMode_data = caps_activityLightingMode_initialize(ctx, "main", NULL, NULL);
@@ -161,6 +359,10 @@ static void capability_init()
         cap_lightMode_data->set_lightingMode_value(cap_lightMode_data, init_lightMode);
 
         cap_lightMode_data->cmd_setLightingMode_usr_cb = cap_lightMode_cmd_cb;
+
+#if defined(USE_PAYLOAD_CACHE)
+        caps_payload_cache_register(cap_lightMode_data->handle, caps_helper_activityLightingMode.attr_lightingMode.name);
+#endif
     }
 
     cap_dustSensor_data = caps_dustSensor_initialize(ctx, "monitor", NULL, NULL);
@@ -170,25 +372,82 @@ static void capability_init()
 
         cap_dustSensor_data->set_dustLevel_unit(cap_dustSensor_data, caps_helper_dustSensor.attr_dustLevel.unit_ug_per_m3);
         cap_dustSensor_data->set_fineDustLevel_unit(cap_dustSensor_data, caps_helper_dustSensor.attr_fineDustLevel.unit_ug_per_m3);
+
+        caps_send_cache_register(cap_dustSensor_data->handle, caps_helper_dustSensor.attr_dustLevel.name);
+        caps_send_cache_register(cap_dustSensor_data->handle, caps_helper_dustSensor.attr_fineDustLevel.name);
+    }
+
+#if defined(USE_CMD_EXECUTOR)
+    /* only the last value of a slider drag is applied */
+    if (cap_switchLevel_data)
+        caps_cmd_set_collapse(cap_switchLevel_data->handle, caps_helper_switchLevel.cmd_setLevel.name, true);
+    if (cap_colorTemp_data)
+        caps_cmd_set_collapse(cap_colorTemp_data->handle, caps_helper_colorTemperature.cmd_setColorTemperature.name, true);
+
+    /* switch, level and color temperature of a scene are applied at once by cap_batch_cmd_cb */
+    if (cap_switch_data) {
+        cap_switch_data->cmd_on_usr_cb = NULL;
+        cap_switch_data->cmd_off_usr_cb = NULL;
+    }
+    if (cap_switchLevel_data)
+        cap_switchLevel_data->cmd_setLevel_usr_cb = NULL;
+    if (cap_colorTemp_data)
+        cap_colorTemp_data->cmd_setColorTemperature_usr_cb = NULL;
+    caps_cmd_set_batch_cb(cap_batch_cmd_cb, CMD_BATCH_WINDOW_MS, NULL);
+
+    caps_cmd_executor_start(CAPS_CMD_QUEUE_DEPTH, CAPS_CMD_TASK_PRIORITY);
+#endif
+
+#if defined(USE_STATE_JOURNAL)
+    state_journal_restore();
+#endif
+}
+
+#if defined(USE_REPORT_POLICY)
+static void report_policy_init(void)
+{
+    unsigned int report_policy_len = report_policy_end - report_policy_start;
+    char *report_policy;
+    int applied;
+
+    report_policy = malloc(report_policy_len + 1);
+    if (!report_policy) {
+        printf("failed to malloc for report policy\n");
+        return;
     }
+    memcpy(report_policy, report_policy_start, report_policy_len);
+    report_policy[report_policy_len] = '\0';
+
+    applied = caps_report_policy_load_json(report_policy);
+    printf("report policy applied : %d\n", applied);
+    free(report_policy);
 }
+#endif
 
 static void iot_status_cb(iot_status_t status,
                           iot_stat_lv_t stat_lv, void *usr_data)
 {
-    g_iot_status = status;
-    g_iot_stat_lv = stat_lv;
+    caps_seqlock_write_begin(&app_state_lock);
+    app_state.iot_status = status;
+    app_state.iot_stat_lv = stat_lv;
+    caps_seqlock_write_end(&app_state_lock);
 
-    printf("status: %d, stat: %d\n", g_iot_status, g_iot_stat_lv);
+    printf("status: %d, stat: %d\n", status, stat_lv);
 
     switch(status)
     {
         case IOT_STATUS_NEED_INTERACT:
-            noti_led_mode = LED_ANIMATION_MODE_FAST;
+            set_noti_led_mode(LED_ANIMATION_MODE_FAST);
             break;
         case IOT_STATUS_IDLE:
         case IOT_STATUS_CONNECTING:
-            noti_led_mode = LED_ANIMATION_MODE_IDLE;
+            if (stat_lv == IOT_STAT_LV_START) {
+                /* server side state is unknown until init_cb sends it again */
+                caps_send_cache_invalidate(NULL);
+            } else if (stat_lv == IOT_STAT_LV_DONE) {
+                caps_sender_flush();
+            }
+            set_noti_led_mode(LED_ANIMATION_MODE_IDLE);
             change_switch_state(get_switch_state());
             break;
         default:
@@ -251,29 +510,34 @@ static void iot_noti_cb(iot_noti_data_t *noti_data, void *noti_usr_data)
 
 void button_event(IOT_CAP_HANDLE *handle, int type, int count)
 {
+    struct app_state state;
+
+    app_state_get(&state);
     if (type == BUTTON_SHORT_PRESS) {
         printf("Button short press, count: %d\n", count);
         switch(count) {
             case 1:
-                if (g_iot_status == IOT_STATUS_NEED_INTERACT) {
+                if (state.iot_status == IOT_STATUS_NEED_INTERACT) {
                     st_conn_ownership_confirm(ctx, true);
-                    noti_led_mode = LED_ANIMATION_MODE_IDLE;
+                    set_noti_led_mode(LED_ANIMATION_MODE_IDLE);
                     change_switch_state(get_switch_state());
                 } else {
                     if (get_switch_state() == SWITCH_ON) {
                         change_switch_state(SWITCH_OFF);
-                        cap_switch_data->set_switch_value(cap_switch_data, caps_helper_switch.attr_switch.value_off);
+                        cap_switch_data->set_switch_idx(cap_switch_data, CAP_ENUM_SWITCH_SWITCH_VALUE_OFF);
                         cap_switch_data->attr_switch_send(cap_switch_data);
                     } else {
                         change_switch_state(SWITCH_ON);
-                        cap_switch_data->set_switch_value(cap_switch_data, caps_helper_switch.attr_switch.value_on);
+                        cap_switch_data->set_switch_idx(cap_switch_data, CAP_ENUM_SWITCH_SWITCH_VALUE_ON);
                         cap_switch_data->attr_switch_send(cap_switch_data);
                     }
                 }
                 break;
             case 2:
-                monitor_enable = !monitor_enable;
-                printf("change monitor mode to %d\n", monitor_enable);
+                caps_seqlock_write_begin(&app_state_lock);
+                state.monitor_enable = app_state.monitor_enable = !app_state.monitor_enable;
+                caps_seqlock_write_end(&app_state_lock);
+                printf("change monitor mode to %d\n", state.monitor_enable);
                 break;
             case 5:
                 /* clean-up provisioning & registered data with reboot option*/
@@ -284,7 +548,7 @@ void button_event(IOT_CAP_HANDLE *handle, int type, int count)
                 break;
         }
     } else if (type == BUTTON_LONG_PRESS) {
-        printf("Button long press, iot_status: %d\n", g_iot_status);
+        printf("Button long press, iot_status: %d\n", state.iot_status);
         led_blink(get_switch_state(), 100, 3);
         st_conn_cleanup(ctx, false);
         xTaskCreate(connection_start_task, "connection_task", 2048, NULL, 10, NULL);
@@ -300,22 +564,26 @@ static void app_main_task(void *arg)
 
     int dustLevel_value = 0;
     int fineDustLevel_value = 0;
+    struct app_state state;
     TimeOut_t monitor_timeout;
-    TickType_t monitor_period_tick = pdMS_TO_TICKS(monitor_period_ms);
+    TickType_t monitor_period_tick;
 
+    app_state_get(&state);
+    monitor_period_tick = pdMS_TO_TICKS(state.monitor_period_ms);
     vTaskSetTimeOutState(&monitor_timeout);
 
     for (;;) {
         if (get_button_event(&button_event_type, &button_event_count)) {
             button_event(handle, button_event_type, button_event_count);
         }
-        if (noti_led_mode != LED_ANIMATION_MODE_IDLE) {
-            change_led_mode(noti_led_mode);
+        app_state_get(&state);
+        if (state.noti_led_mode != LED_ANIMATION_MODE_IDLE) {
+            change_led_mode(state.noti_led_mode);
         }
 
-        if (monitor_enable && (xTaskCheckForTimeOut(&monitor_timeout, &monitor_period_tick) != pdFALSE)) {
+        if (state.monitor_enable && (xTaskCheckForTimeOut(&monitor_timeout, &monitor_period_tick) != pdFALSE)) {
             vTaskSetTimeOutState(&monitor_timeout);
-            monitor_period_tick = pdMS_TO_TICKS(monitor_period_ms);
+            monitor_period_tick = pdMS_TO_TICKS(state.monitor_period_ms);
             /* emulate sensor value for example */
             dustLevel_value = (dustLevel_value + 1) % 300;
             fineDustLevel_value = dustLevel_value;
@@ -360,6 +628,12 @@ void app_main(void)
 
     int iot_err;
 
+    // the status callback, CLI and app task share app_state
+    if (caps_seqlock_init(&app_state_lock)) {
+        printf("fail to init app state lock\n");
+        return;
+    }
+
     // create a iot context
     ctx = st_conn_init(onboarding_config, onboarding_config_len, device_info, device_info_len);
     if (ctx != NULL) {
@@ -372,8 +646,18 @@ void app_main(void)
 
     // create a handle to process capability and initialize capability info
     capability_init();
+#if defined(USE_REPORT_POLICY)
+    report_policy_init();
+#endif
 
     iot_gpio_init();
+    // drive the light with the initial or restored state before connecting
+    if (cap_colorTemp_data)
+        update_color_info(cap_colorTemp_data->get_colorTemperature_value(cap_colorTemp_data));
+    if (cap_switchLevel_data)
+        change_switch_level(cap_switchLevel_data->get_level_value(cap_switchLevel_data));
+    if (cap_switch_data)
+        change_switch_state(get_switch_state());
     register_iot_cli_cmd();
     uart_cli_main();
     xTaskCreate(app_main_task, "app_main_task", 4096, NULL, 10, NULL);
@@ -0,0 +1,1490 @@
+#!/usr/bin/env python3
+#-*- coding: utf-8 -*-
+
+# Generate capability wrappers(caps_{CAPABILITY}.h/.c) from the capability helper
+# headers(iot_caps_helper_{CAPABILITY}.h) of iot-core.
+#
+# Unlike the hand written files in apps/capability_sample, the generated wrappers
+# keep every get/set/send function pointer in a single 'const' ops table which is
+# placed in flash. Each instance only carries its handle, attribute values and
+# user callbacks, and can live in caller-provided or static storage.
+#
+# With --engine, only const descriptor tables and static inline typed facades are
+# generated, and apps/capability_sample/caps_engine.c does the work for every capability.
+#
+# With --cpp, a header-only C++17 binding(caps_{CAPABILITY}.hpp) is generated instead,
+# built on apps/capability_sample/caps_binding.hpp.
+#
+# usage)
+#   python3 caps_generator.py [-i HELPER_PATH] [-o OUTPUT_PATH] [-c switch,switchLevel]
+#   python3 caps_generator.py --engine [-i HELPER_PATH] [-o OUTPUT_PATH] [-c switch,switchLevel]
+#   python3 caps_generator.py --cpp [-i HELPER_PATH] [-o OUTPUT_PATH] [-c switch,switchLevel]
+#   python3 caps_generator.py --report [-o OUTPUT_PATH] [-s SAMPLE_PATH]
+
+import os
+import re
+import sys
+import glob
+import argparse
+
+tool_path = os.path.dirname(os.path.abspath(__file__))
+default_helper_path = os.path.join(tool_path, "../../iot-core/src/include/caps")
+default_sample_path = os.path.join(tool_path, "../../apps/capability_sample")
+default_output_path = os.path.join(tool_path, "../../output/capability_generated")
+
+license_header = """/* ***************************************************************************
+ *
+ * Copyright 2019-2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+"""
+
+ATTR_ENUM = "enum"
+ATTR_STRING = "string"
+ATTR_INTEGER = "integer"
+ATTR_NUMBER = "number"
+ATTR_ARRAY = "array"
+ATTR_OBJECT = "object"
+
+# Life-safety attributes which go through the priority lane of caps_sender
+CRITICAL_ATTRS = {
+    "smokeDetector": ["smoke"],
+    "carbonMonoxideDetector": ["carbonMonoxide"],
+    "waterSensor": ["water"],
+    "tamperAlert": ["tamper"],
+    "securitySystem": ["alarm"],
+    "temperatureAlarm": ["temperatureAlarm"],
+}
+
+
+class Attribute:
+    def __init__(self, name):
+        self.name = name
+        self.kind = ATTR_STRING
+        self.values = []
+        self.units = []
+        self.min = None
+        self.max = None
+
+
+class Capability:
+    def __init__(self, cap_id):
+        self.id = cap_id
+        self.attrs = []
+        self.cmds = []
+
+    def find_attr(self, name):
+        for attr in self.attrs:
+            if attr.name == name:
+                return attr
+        return None
+
+
+def parse_helper(path):
+    text = open(path).read()
+
+    match = re.search(r"\}\s*caps_helper_(\w+)\s*=", text)
+    if not match:
+        return None
+    cap = Capability(match.group(1))
+
+    # member declarations keep the order of the schema
+    for kind, name in re.findall(r"const struct \w+_(attr|cmd)_(\w+)\s*\{", text):
+        if kind == "cmd":
+            cap.cmds.append(name)
+        else:
+            cap.attrs.append(Attribute(name))
+
+    for attr in cap.attrs:
+        init = re.search(r"\.attr_%s\s*=\s*\{(.*?)\n\s*\},?\s*\n" % attr.name, text, re.S)
+        if not init:
+            continue
+        body = init.group(1)
+        value_type = re.search(r"\.valueType\s*=\s*(\w+)", body)
+        value_type = value_type.group(1) if value_type else ""
+        prop = re.search(r"\.property\s*=\s*([^,]+),", body)
+        prop = prop.group(1) if prop else ""
+        values = re.search(r"\.values\s*=\s*\{([^}]*)\}", body)
+        if values:
+            attr.values = re.findall(r'"([^"]*)"', values.group(1))
+        units = re.search(r"\.units\s*=\s*\{([^}]*)\}", body)
+        if units:
+            attr.units = re.findall(r'"([^"]*)"', units.group(1))
+        if "ATTR_SET_VALUE_MIN" in prop:
+            value = re.search(r"\.min\s*=\s*([-+0-9.eE]+)", body)
+            attr.min = value.group(1) if value else None
+        if "ATTR_SET_VALUE_MAX" in prop:
+            value = re.search(r"\.max\s*=\s*([-+0-9.eE]+)", body)
+            attr.max = value.group(1) if value else None
+
+        if "ARRAY" in prop or "ARRAY" in value_type:
+            attr.kind = ATTR_ARRAY
+        elif "INTEGER" in value_type:
+            attr.kind = ATTR_INTEGER
+        elif "NUMBER" in value_type:
+            attr.kind = ATTR_NUMBER
+        elif "OBJECT" in value_type:
+            attr.kind = ATTR_OBJECT
+        elif attr.values:
+            attr.kind = ATTR_ENUM
+        else:
+            attr.kind = ATTR_STRING
+    return cap
+
+
+def enum_name(cap, attr, value):
+    return "CAP_ENUM_%s_%s_VALUE_%s" % (cap.id.upper(), attr.name.upper(),
+            re.sub(r"[^A-Za-z0-9]", "_", value).upper())
+
+
+def enum_max(cap, attr):
+    return "CAP_ENUM_%s_%s_VALUE_MAX" % (cap.id.upper(), attr.name.upper())
+
+
+def helper(cap):
+    return "caps_helper_%s" % cap.id
+
+
+def critical_attrs(cap):
+    return [attr for attr in cap.attrs if attr.name in CRITICAL_ATTRS.get(cap.id, [])]
+
+
+def ops_members(cap):
+    t = "struct caps_%s_data" % cap.id
+    members = []
+    for attr in cap.attrs:
+        a = attr.name
+        if attr.kind in (ATTR_ENUM, ATTR_STRING):
+            members.append("const char *(*get_%s_value)(%s *caps_data);" % (a, t))
+            members.append("void (*set_%s_value)(%s *caps_data, const char *value);" % (a, t))
+            if attr.kind == ATTR_ENUM:
+                members.append("int (*get_%s_idx)(%s *caps_data);" % (a, t))
+                members.append("void (*set_%s_idx)(%s *caps_data, int idx);" % (a, t))
+                members.append("int (*attr_%s_str2idx)(const char *value);" % a)
+        elif attr.kind in (ATTR_INTEGER, ATTR_NUMBER):
+            c_type = "int" if attr.kind == ATTR_INTEGER else "double"
+            members.append("%s (*get_%s_value)(%s *caps_data);" % (c_type, a, t))
+            members.append("void (*set_%s_value)(%s *caps_data, %s value);" % (a, t, c_type))
+            if attr.kind == ATTR_NUMBER:
+                members.append("int64_t (*get_%s_milli)(%s *caps_data);" % (a, t))
+                members.append("void (*set_%s_milli)(%s *caps_data, int64_t milli);" % (a, t))
+            if attr.units:
+                members.append("const char *(*get_%s_unit)(%s *caps_data);" % (a, t))
+                members.append("void (*set_%s_unit)(%s *caps_data, const char *unit);" % (a, t))
+        elif attr.kind == ATTR_ARRAY:
+            members.append("const char **(*get_%s_value)(%s *caps_data);" % (a, t))
+            members.append("void (*set_%s_value)(%s *caps_data, const char **value, int arraySize);" % (a, t))
+            members.append("void (*set_%s_value_borrowed)(%s *caps_data, const char * const *value, int arraySize);" % (a, t))
+        elif attr.kind == ATTR_OBJECT:
+            members.append("const char *(*get_%s_value)(%s *caps_data);" % (a, t))
+            members.append("void (*set_%s_value)(%s *caps_data, const char *value);" % (a, t))
+        members.append("void (*attr_%s_send)(%s *caps_data);" % (a, t))
+    return members
+
+
+def state_members(cap):
+    members = []
+    for attr in cap.attrs:
+        a = attr.name
+        if attr.kind == ATTR_ENUM:
+            members.append("int %s_idx;" % a)
+        elif attr.kind == ATTR_STRING:
+            members.append("char *%s_value;" % a)
+        elif attr.kind == ATTR_INTEGER:
+            members.append("int %s_value;" % a)
+        elif attr.kind == ATTR_NUMBER:
+            members.append("int64_t %s_milli;" % a)
+        elif attr.kind == ATTR_ARRAY:
+            members.append("char **%s_value;" % a)
+            members.append("int %s_arraySize;" % a)
+            members.append("int %s_borrowed;" % a)
+        elif attr.kind == ATTR_OBJECT:
+            members.append("char *%s_value;" % a)
+        if attr.kind in (ATTR_INTEGER, ATTR_NUMBER) and attr.units:
+            members.append("char *%s_unit;" % a)
+    return members
+
+
+def gen_header(cap):
+    c = cap.id
+    t = "struct caps_%s_data" % c
+    out = [license_header]
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append('#include "caps/iot_caps_helper_%s.h"' % c)
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append('extern "C" {')
+    out.append("#endif")
+    out.append("")
+    out.append("#ifndef CAPS_%s_MAX_INSTANCES" % c.upper())
+    out.append("#define CAPS_%s_MAX_INSTANCES 1" % c.upper())
+    out.append("#endif")
+    out.append("")
+    out.append("struct caps_%s_data;" % c)
+    out.append("")
+    out.append("typedef struct caps_%s_ops {" % c)
+    for member in ops_members(cap):
+        out.append("    " + member)
+    if not cap.attrs:
+        out.append("    int reserved;")
+    out.append("} caps_%s_ops_t;" % c)
+    out.append("")
+    out.append("typedef struct caps_%s_data {" % c)
+    out.append("    IOT_CAP_HANDLE* handle;")
+    out.append("    void *usr_data;")
+    out.append("    void *cmd_data;")
+    out.append("    const caps_%s_ops_t *ops;" % c)
+    out.append("")
+    for member in state_members(cap):
+        out.append("    " + member)
+    if cap.attrs:
+        out.append("")
+    out.append("    void (*init_usr_cb)(%s *caps_data);" % t)
+    if cap.cmds:
+        out.append("")
+    for cmd in cap.cmds:
+        out.append("    void (*cmd_%s_usr_cb)(%s *caps_data);" % (cmd, t))
+    out.append("} caps_%s_data_t;" % c)
+    out.append("")
+    out.append("extern const caps_%s_ops_t caps_%s_ops;" % (c, c))
+    out.append("")
+    out.append("caps_%s_data_t *caps_%s_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data);" % (c, c))
+    out.append("caps_%s_data_t *caps_%s_initialize_static(IOT_CTX *ctx, const char *component, caps_%s_data_t *caps_data, void *init_usr_cb, void *usr_data);" % (c, c, c))
+    out.append("void caps_%s_deinitialize(caps_%s_data_t *caps_data);" % (c, c))
+    out.append("#ifdef __cplusplus")
+    out.append("}")
+    out.append("#endif")
+    out.append("")
+    return "\n".join(out)
+
+
+def gen_null_check(ret=""):
+    return ["    if (!caps_data) {",
+            '        printf("caps_data is NULL\\n");',
+            "        return%s;" % (" " + ret if ret else ""),
+            "    }"]
+
+
+def gen_send_check(attr, check_value):
+    out = ["    if (!caps_data || !caps_data->handle) {",
+           '        printf("fail to get handle\\n");',
+           "        return;",
+           "    }"]
+    if check_value:
+        out += ["    if (!caps_data->%s_value) {" % attr.name,
+                '        printf("value is NULL\\n");',
+                "        return;",
+                "    }"]
+    return out
+
+
+def gen_send_result(attr):
+    return ["    if (sequence_no < 0)",
+            '        printf("fail to send %s value\\n");' % attr.name,
+            "    else",
+            '        printf("Sequence number return : %d\\n", sequence_no);']
+
+
+def gen_attr(cap, attr):
+    c = cap.id
+    a = attr.name
+    d = "caps_%s_data_t" % c
+    name = "(char *)%s.attr_%s.name" % (helper(cap), a)
+    out = []
+
+    if attr.kind == ATTR_ENUM:
+        out.append("static int caps_%s_attr_%s_str2idx(const char *value)" % (c, a))
+        out.append("{")
+        out.append("    int index;")
+        out.append("")
+        out.append("    for (index = 0; index < %s; index++) {" % enum_max(cap, attr))
+        out.append("        if (!strcmp(value, %s.attr_%s.values[index])) {" % (helper(cap), a))
+        out.append("            return index;")
+        out.append("        }")
+        out.append("    }")
+        out.append("    return -1;")
+        out.append("}")
+        out.append("")
+
+    if attr.kind == ATTR_ENUM:
+        out.append("static const char *caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("NULL")
+        out.append("    if (caps_data->%s_idx < 0) {" % a)
+        out.append("        return NULL;")
+        out.append("    }")
+        out.append("    return %s.attr_%s.values[caps_data->%s_idx];" % (helper(cap), a, a))
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, const char *value)" % (c, a, d))
+        out.append("{")
+        out.append("    int index;")
+        out.append("")
+        out += gen_null_check()
+        out.append("    if (!value) {")
+        out.append('        printf("value is NULL\\n");')
+        out.append("        return;")
+        out.append("    }")
+        out.append("    index = caps_%s_attr_%s_str2idx(value);" % (c, a))
+        out.append("    if (index < 0) {")
+        out.append('        printf("%%s is not supported value for %s\\n", value);' % a)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    caps_data->%s_idx = index;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static int caps_%s_get_%s_idx(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("-1")
+        out.append("    return caps_data->%s_idx;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_idx(%s *caps_data, int idx)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check()
+        out.append("    if (idx < 0 || idx >= %s) {" % enum_max(cap, attr))
+        out.append('        printf("%%d is not supported index for %s\\n", idx);' % a)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    caps_data->%s_idx = idx;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_attr_%s_send(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out.append("    int sequence_no = -1;")
+        out.append("")
+        out += gen_send_check(attr, False)
+        out.append("    if (caps_data->%s_idx < 0) {" % a)
+        out.append('        printf("value is NULL\\n");')
+        out.append("        return;")
+        out.append("    }")
+        out.append("")
+        out.append("    CAPS_SEND_ATTR_STRING(caps_data->handle,")
+        out.append("            %s," % name)
+        out.append("            (char *)%s.attr_%s.values[caps_data->%s_idx]," % (helper(cap), a, a))
+        out.append("            NULL,")
+        out.append("            NULL,")
+        out.append("            sequence_no);")
+        out.append("")
+        out += gen_send_result(attr)
+        out.append("}")
+
+    elif attr.kind == ATTR_STRING:
+        out.append("static const char *caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("NULL")
+        out.append("    return caps_data->%s_value;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, const char *value)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check()
+        out.append("    if (caps_data->%s_value) {" % a)
+        out.append("        free(caps_data->%s_value);" % a)
+        out.append("    }")
+        out.append("    caps_data->%s_value = strdup(value);" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_attr_%s_send(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out.append("    int sequence_no = -1;")
+        out.append("")
+        out += gen_send_check(attr, True)
+        out.append("")
+        out.append("    CAPS_SEND_ATTR_STRING(caps_data->handle,")
+        out.append("            %s," % name)
+        out.append("            caps_data->%s_value," % a)
+        out.append("            NULL,")
+        out.append("            NULL,")
+        out.append("            sequence_no);")
+        out.append("")
+        out += gen_send_result(attr)
+        out.append("}")
+
+    elif attr.kind == ATTR_INTEGER:
+        out.append("static int caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("%s.attr_%s.min - 1" % (helper(cap), a))
+        out.append("    return caps_data->%s_value;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, int value)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check()
+        out.append("    caps_data->%s_value = value;" % a)
+        out.append("}")
+        out.append("")
+    elif attr.kind == ATTR_NUMBER:
+        # kept in milli-units, see CAPS_UTIL_MILLI()
+        out.append("static int64_t caps_%s_get_%s_milli(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("CAPS_UTIL_MILLI(%s.attr_%s.min) - 1" % (helper(cap), a))
+        out.append("    return caps_data->%s_milli;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_milli(%s *caps_data, int64_t milli)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check()
+        out.append("    if (milli < CAPS_UTIL_MILLI(%s.attr_%s.min)) {" % (helper(cap), a))
+        out.append('        printf("%%lld is out of range for %s\\n", (long long)milli);' % a)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    caps_data->%s_milli = milli;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static double caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("%s.attr_%s.min - 1" % (helper(cap), a))
+        out.append("    return caps_util_milli_to_double(caps_data->%s_milli);" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, double value)" % (c, a, d))
+        out.append("{")
+        out.append("    int64_t milli;")
+        out.append("")
+        out += gen_null_check()
+        out.append("    if (caps_util_double_to_milli(value, &milli) < 0) {")
+        out.append('        printf("value is out of range for %s\\n");' % a)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    caps_%s_set_%s_milli(caps_data, milli);" % (c, a))
+        out.append("}")
+        out.append("")
+    if attr.kind in (ATTR_INTEGER, ATTR_NUMBER):
+        if attr.units:
+            out.append("static const char *caps_%s_get_%s_unit(%s *caps_data)" % (c, a, d))
+            out.append("{")
+            out += gen_null_check("NULL")
+            out.append("    return caps_data->%s_unit;" % a)
+            out.append("}")
+            out.append("")
+            out.append("static void caps_%s_set_%s_unit(%s *caps_data, const char *unit)" % (c, a, d))
+            out.append("{")
+            out += gen_null_check()
+            out.append("    caps_data->%s_unit = (char *)unit;" % a)
+            out.append("}")
+            out.append("")
+        out.append("static void caps_%s_attr_%s_send(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out.append("    int sequence_no = -1;")
+        out.append("")
+        out += gen_send_check(attr, False)
+        out.append("")
+        if attr.kind == ATTR_NUMBER:
+            out.append("    CAPS_SEND_ATTR_MILLI(caps_data->handle,")
+            out.append("            %s," % name)
+            out.append("            caps_data->%s_milli," % a)
+        else:
+            out.append("    CAPS_SEND_ATTR_NUMBER(caps_data->handle,")
+            out.append("            %s," % name)
+            out.append("            caps_data->%s_value," % a)
+        out.append("            %s," % ("caps_data->%s_unit" % a if attr.units else "NULL"))
+        out.append("            NULL,")
+        out.append("            sequence_no);")
+        out.append("")
+        out += gen_send_result(attr)
+        out.append("}")
+
+    elif attr.kind == ATTR_ARRAY:
+        out.append("static const char **caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("NULL")
+        out.append("    return (const char **)caps_data->%s_value;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, const char **value, int arraySize)" % (c, a, d))
+        out.append("{")
+        out.append("    int i;")
+        out += gen_null_check()
+        out.append("    if (caps_data->%s_value && !caps_data->%s_borrowed) {" % (a, a))
+        out.append("        for (i = 0; i < caps_data->%s_arraySize; i++) {" % a)
+        out.append("            free(caps_data->%s_value[i]);" % a)
+        out.append("        }")
+        out.append("        free(caps_data->%s_value);" % a)
+        out.append("    }")
+        out.append("    caps_data->%s_value = malloc(sizeof(char *) * arraySize);" % a)
+        out.append("    if (!caps_data->%s_value) {" % a)
+        out.append('        printf("fail to malloc for %s_value\\n");' % a)
+        out.append("        caps_data->%s_arraySize = 0;" % a)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    for (i = 0; i < arraySize; i++) {")
+        out.append("        caps_data->%s_value[i] = strdup(value[i]);" % a)
+        out.append("    }")
+        out.append("")
+        out.append("    caps_data->%s_arraySize = arraySize;" % a)
+        out.append("    caps_data->%s_borrowed = 0;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value_borrowed(%s *caps_data, const char * const *value, int arraySize)" % (c, a, d))
+        out.append("{")
+        out.append("    int i;")
+        out += gen_null_check()
+        out.append("    if (caps_data->%s_value && !caps_data->%s_borrowed) {" % (a, a))
+        out.append("        for (i = 0; i < caps_data->%s_arraySize; i++) {" % a)
+        out.append("            free(caps_data->%s_value[i]);" % a)
+        out.append("        }")
+        out.append("        free(caps_data->%s_value);" % a)
+        out.append("    }")
+        out.append("")
+        out.append("    /* value is kept as is, it has to outlive caps_data or the next set */")
+        out.append("    caps_data->%s_value = (char **)value;" % a)
+        out.append("    caps_data->%s_arraySize = arraySize;" % a)
+        out.append("    caps_data->%s_borrowed = 1;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_attr_%s_send(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out.append("    int sequence_no = -1;")
+        out.append("")
+        out += gen_send_check(attr, True)
+        out.append("")
+        out.append("    CAPS_SEND_ATTR_STRINGS_ARRAY(caps_data->handle,")
+        out.append("            %s," % name)
+        out.append("            caps_data->%s_value," % a)
+        out.append("            caps_data->%s_arraySize," % a)
+        out.append("            NULL,")
+        out.append("            NULL,")
+        out.append("            sequence_no);")
+        out.append("")
+        out += gen_send_result(attr)
+        out.append("}")
+
+    elif attr.kind == ATTR_OBJECT:
+        # JSON text is kept as is, build it with caps_json_writer
+        out.append("static const char *caps_%s_get_%s_value(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check("NULL")
+        out.append("    return caps_data->%s_value;" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_set_%s_value(%s *caps_data, const char *value)" % (c, a, d))
+        out.append("{")
+        out += gen_null_check()
+        out.append("    if (caps_data->%s_value) {" % a)
+        out.append("        free(caps_data->%s_value);" % a)
+        out.append("    }")
+        out.append("    caps_data->%s_value = strdup(value);" % a)
+        out.append("}")
+        out.append("")
+        out.append("static void caps_%s_attr_%s_send(%s *caps_data)" % (c, a, d))
+        out.append("{")
+        out.append("    int sequence_no = -1;")
+        out.append("")
+        out += gen_send_check(attr, True)
+        out.append("")
+        out.append("    CAPS_SEND_ATTR_JSON_OBJECT(caps_data->handle,")
+        out.append("            %s," % name)
+        out.append("            caps_data->%s_value," % a)
+        out.append("            NULL,")
+        out.append("            NULL,")
+        out.append("            sequence_no);")
+        out.append("")
+        out += gen_send_result(attr)
+        out.append("}")
+
+    out.append("")
+    out.append("")
+    return out
+
+
+def command_target(cap, cmd):
+    # "setFoo" command updates "foo" attribute with its first argument
+    if cmd.startswith("set") and len(cmd) > 3:
+        attr = cap.find_attr(cmd[3].lower() + cmd[4:])
+        if attr and attr.kind in (ATTR_ENUM, ATTR_STRING, ATTR_INTEGER, ATTR_NUMBER):
+            return ("arg", attr, None)
+    # "on", "heat", "open"... command updates the attribute having same enum value
+    for attr in cap.attrs:
+        if attr.kind == ATTR_ENUM and cmd in attr.values:
+            return ("enum", attr, cmd)
+    return ("none", None, None)
+
+
+def gen_cmd(cap, cmd):
+    c = cap.id
+    d = "caps_%s_data_t" % c
+    kind, attr, value = command_target(cap, cmd)
+    out = []
+    out.append("static void caps_%s_cmd_%s_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)" % (c, cmd))
+    out.append("{")
+    out.append("    %s *caps_data = (%s *)usr_data;" % (d, d))
+
+    if kind == "enum":
+        out.append("    int index = %s;" % enum_name(cap, attr, value))
+        out.append("")
+        out.append('    printf("called [%s] func with num_args:%u\\n", __func__, cmd_data->num_args);')
+        out.append("")
+        out.append("    caps_%s_set_%s_idx(caps_data, index);" % (c, attr.name))
+    elif kind == "arg" and attr.kind == ATTR_ENUM:
+        out.append("    int index;")
+        out.append("")
+        out.append('    printf("called [%s] func with num_args:%u\\n", __func__, cmd_data->num_args);')
+        out.append("")
+        out.append("    index = caps_%s_attr_%s_str2idx(cmd_data->cmd_data[0].string);" % (c, attr.name))
+        out.append("    if (index < 0) {")
+        out.append('        printf("%%s is not supported value for %s\\n", cmd_data->cmd_data[0].string);' % cmd)
+        out.append("        return;")
+        out.append("    }")
+        out.append("    caps_%s_set_%s_idx(caps_data, index);" % (c, attr.name))
+    elif kind == "arg":
+        c_type, member = {ATTR_STRING: ("char *", "string"),
+                          ATTR_INTEGER: ("int ", "integer"),
+                          ATTR_NUMBER: ("double ", "number")}[attr.kind]
+        out.append("    %svalue;" % c_type)
+        out.append("")
+        out.append('    printf("called [%s] func with num_args:%u\\n", __func__, cmd_data->num_args);')
+        out.append("")
+        out.append("    value = cmd_data->cmd_data[0].%s;" % member)
+        out.append("")
+        out.append("    caps_%s_set_%s_value(caps_data, value);" % (c, attr.name))
+    else:
+        out.append("")
+        out.append('    printf("called [%s] func with num_args:%u\\n", __func__, cmd_data->num_args);')
+        out.append("    if (caps_data)")
+        out.append("        caps_data->cmd_data = cmd_data;")
+
+    out.append("    if (caps_data && caps_data->cmd_%s_usr_cb)" % cmd)
+    out.append("        caps_data->cmd_%s_usr_cb(caps_data);" % cmd)
+    if attr:
+        out.append("    caps_%s_attr_%s_send(caps_data);" % (c, attr.name))
+    out.append("}")
+    out.append("")
+    return out
+
+
+def gen_source(cap):
+    c = cap.id
+    d = "caps_%s_data_t" % c
+    out = [license_header]
+    out.append("#include <string.h>")
+    out.append("#include <stdio.h>")
+    out.append("#include <stdlib.h>")
+    out.append("")
+    out.append('#include "st_dev.h"')
+    out.append('#include "caps_%s.h"' % c)
+    out.append('#include "caps_sender.h"')
+    out.append('#include "caps_util.h"')
+    if cap.cmds:
+        out.append('#include "caps_cmd.h"')
+    out.append("")
+
+    for attr in cap.attrs:
+        out += gen_attr(cap, attr)
+    for cmd in cap.cmds:
+        out += gen_cmd(cap, cmd)
+
+    out.append("static void caps_%s_init_cb(IOT_CAP_HANDLE *handle, void *usr_data)" % c)
+    out.append("{")
+    out.append("    %s *caps_data = usr_data;" % d)
+    out.append("")
+    out.append("    caps_sender_init_cb_begin(handle);")
+    out.append("    if (caps_data && caps_data->init_usr_cb)")
+    out.append("        caps_data->init_usr_cb(caps_data);")
+    for attr in cap.attrs:
+        out.append("    caps_%s_attr_%s_send(caps_data);" % (c, attr.name))
+    out.append("    caps_sender_init_cb_end(handle);")
+    out.append("}")
+    out.append("")
+
+    out.append("const caps_%s_ops_t caps_%s_ops = {" % (c, c))
+    for attr in cap.attrs:
+        a = attr.name
+        if attr.kind == ATTR_ENUM:
+            members = ["get_%s_value", "set_%s_value", "get_%s_idx", "set_%s_idx", "attr_%s_str2idx"]
+        elif attr.kind in (ATTR_INTEGER, ATTR_NUMBER):
+            members = ["get_%s_value", "set_%s_value"]
+            if attr.kind == ATTR_NUMBER:
+                members += ["get_%s_milli", "set_%s_milli"]
+            if attr.units:
+                members += ["get_%s_unit", "set_%s_unit"]
+        elif attr.kind == ATTR_ARRAY:
+            members = ["get_%s_value", "set_%s_value", "set_%s_value_borrowed"]
+        else:
+            members = ["get_%s_value", "set_%s_value"]
+        members.append("attr_%s_send")
+        for member in members:
+            member = member % a
+            out.append("    .%s = caps_%s_%s," % (member, c, member))
+    out.append("};")
+    out.append("")
+
+    # a slot of the pool is free while its ops is NULL
+    out.append("static %s caps_%s_pool[CAPS_%s_MAX_INSTANCES];" % (d, c, c.upper()))
+    out.append("")
+
+    out.append("caps_%s_data_t *caps_%s_initialize_static(IOT_CTX *ctx, const char *component, %s *caps_data, void *init_usr_cb, void *usr_data)" % (c, c, d))
+    out.append("{")
+    if cap.cmds:
+        out.append("    int err;")
+        out.append("")
+    out.append("    if (!caps_data) {")
+    out.append('        printf("caps_data is NULL\\n");')
+    out.append("        return NULL;")
+    out.append("    }")
+    out.append("")
+    out.append("    memset(caps_data, 0, sizeof(%s));" % d)
+    out.append("")
+    out.append("    caps_data->init_usr_cb = init_usr_cb;")
+    out.append("    caps_data->usr_data = usr_data;")
+    out.append("    caps_data->ops = &caps_%s_ops;" % c)
+    for attr in cap.attrs:
+        if attr.kind == ATTR_ENUM:
+            out.append("    caps_data->%s_idx = -1;" % attr.name)
+    out.append("")
+    out.append("    if (ctx) {")
+    out.append("        caps_data->handle = caps_sender_handle_init(ctx, component, %s.id, caps_%s_init_cb, caps_data);" % (helper(cap), c))
+    out.append("    }")
+    if cap.cmds or critical_attrs(cap):
+        out.append("    if (caps_data->handle) {")
+        for attr in critical_attrs(cap):
+            out.append("        caps_sender_set_priority(caps_data->handle, %s.attr_%s.name, CAPS_SEND_PRIORITY_CRITICAL);" % (helper(cap), attr.name))
+        for cmd in cap.cmds:
+            out.append("        err = caps_cmd_set_cb(caps_data->handle, %s.cmd_%s.name, caps_%s_cmd_%s_cb, caps_data);" % (helper(cap), cmd, c, cmd))
+            out.append("        if (err) {")
+            out.append('            printf("fail to set cmd_cb for %s of %s\\n");' % (cmd, c))
+            out.append("        }")
+        out.append("    } else {")
+        out.append('        printf("fail to init %s handle\\n");' % c)
+        out.append("    }")
+    else:
+        out.append("    if (!caps_data->handle) {")
+        out.append('        printf("fail to init %s handle\\n");' % c)
+        out.append("    }")
+    out.append("")
+    out.append("    return caps_data;")
+    out.append("}")
+    out.append("")
+
+    out.append("caps_%s_data_t *caps_%s_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)" % (c, c))
+    out.append("{")
+    out.append("    int i;")
+    out.append("")
+    out.append("    for (i = 0; i < CAPS_%s_MAX_INSTANCES; i++) {" % c.upper())
+    out.append("        if (!caps_%s_pool[i].ops)" % c)
+    out.append("            return caps_%s_initialize_static(ctx, component, &caps_%s_pool[i], init_usr_cb, usr_data);" % (c, c))
+    out.append("    }")
+    out.append('    printf("no more static storage for caps_%s_data\\n");' % c)
+    out.append("    return NULL;")
+    out.append("}")
+    out.append("")
+
+    # storage is cleared rather than freed, it is a pool slot or the caller's
+    arrays = [attr for attr in cap.attrs if attr.kind == ATTR_ARRAY]
+    out.append("void caps_%s_deinitialize(%s *caps_data)" % (c, d))
+    out.append("{")
+    if arrays:
+        out.append("    int i;")
+        out.append("")
+    out += gen_null_check()
+    out.append("")
+    out.append("    if (caps_data->handle) {")
+    if cap.cmds:
+        out.append("        caps_cmd_unset_cb(caps_data->handle);")
+    out.append("        caps_sender_handle_detach(caps_data->handle);")
+    out.append("    }")
+    for attr in arrays:
+        a = attr.name
+        out.append("    if (caps_data->%s_value && !caps_data->%s_borrowed) {" % (a, a))
+        out.append("        for (i = 0; i < caps_data->%s_arraySize; i++) {" % a)
+        out.append("            free(caps_data->%s_value[i]);" % a)
+        out.append("        }")
+        out.append("        free(caps_data->%s_value);" % a)
+        out.append("    }")
+    for attr in cap.attrs:
+        if attr.kind in (ATTR_STRING, ATTR_OBJECT):
+            out.append("    free(caps_data->%s_value);" % attr.name)
+    out.append("    memset(caps_data, 0, sizeof(%s));" % d)
+    out.append("}")
+    return "\n".join(out) + "\n"
+
+
+# Table-driven variant(--engine). Each capability is only a const descriptor in
+# caps_{CAPABILITY}.c and a typed facade of static inline functions calling
+# caps_engine in caps_{CAPABILITY}.h, so the code is shared by every capability.
+
+engine_attr_type = {ATTR_ENUM: "CAPS_ENGINE_ATTR_ENUM",
+                    ATTR_STRING: "CAPS_ENGINE_ATTR_STRING",
+                    ATTR_INTEGER: "CAPS_ENGINE_ATTR_INTEGER",
+                    ATTR_NUMBER: "CAPS_ENGINE_ATTR_NUMBER",
+                    ATTR_ARRAY: "CAPS_ENGINE_ATTR_ARRAY",
+                    ATTR_OBJECT: "CAPS_ENGINE_ATTR_OBJECT"}
+
+
+def engine_attr_index(cap, attr):
+    return "CAPS_%s_ATTR_%s" % (cap.id.upper(), attr.name.upper())
+
+
+def engine_cmd_index(cap, cmd):
+    return "CAPS_%s_CMD_%s" % (cap.id.upper(), cmd.upper())
+
+
+def engine_unit_max(cap, attr):
+    return "CAP_ENUM_%s_%s_UNIT_MAX" % (cap.id.upper(), attr.name.upper())
+
+
+def engine_state_members(cap):
+    members = []
+    for attr in cap.attrs:
+        a = attr.name
+        if attr.kind == ATTR_ENUM:
+            members.append("int %s_idx;" % a)
+        elif attr.kind in (ATTR_STRING, ATTR_OBJECT):
+            members.append("char *%s_value;" % a)
+        elif attr.kind == ATTR_INTEGER:
+            members.append("int %s_value;" % a)
+        elif attr.kind == ATTR_NUMBER:
+            members.append("int64_t %s_value;" % a)
+        elif attr.kind == ATTR_ARRAY:
+            members.append("caps_engine_array_t %s_value;" % a)
+        if attr.kind in (ATTR_INTEGER, ATTR_NUMBER) and attr.units:
+            members.append("const char *%s_unit;" % a)
+    if not members:
+        members.append("int reserved;")
+    return members
+
+
+def gen_engine_facade(cap, attr):
+    c = cap.id
+    a = attr.name
+    idx = engine_attr_index(cap, attr)
+    d = "caps_%s_data_t" % c
+    out = []
+    if attr.kind in (ATTR_ENUM, ATTR_STRING, ATTR_OBJECT):
+        out.append("static inline const char *caps_%s_get_%s_value(%s *caps_data) { return caps_engine_get_string(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_value(%s *caps_data, const char *value) { caps_engine_set_string(caps_data, %s, value); }" % (c, a, d, idx))
+    if attr.kind == ATTR_ENUM:
+        out.append("static inline int caps_%s_get_%s_idx(%s *caps_data) { return caps_engine_get_idx(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_idx(%s *caps_data, int idx) { caps_engine_set_idx(caps_data, %s, idx); }" % (c, a, d, idx))
+    elif attr.kind == ATTR_INTEGER:
+        out.append("static inline int caps_%s_get_%s_value(%s *caps_data) { return caps_engine_get_int(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_value(%s *caps_data, int value) { caps_engine_set_int(caps_data, %s, value); }" % (c, a, d, idx))
+    elif attr.kind == ATTR_NUMBER:
+        out.append("static inline double caps_%s_get_%s_value(%s *caps_data) { return caps_engine_get_number(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_value(%s *caps_data, double value) { caps_engine_set_number(caps_data, %s, value); }" % (c, a, d, idx))
+        out.append("static inline int64_t caps_%s_get_%s_milli(%s *caps_data) { return caps_engine_get_milli(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_milli(%s *caps_data, int64_t milli) { caps_engine_set_milli(caps_data, %s, milli); }" % (c, a, d, idx))
+    elif attr.kind == ATTR_ARRAY:
+        out.append("static inline const char **caps_%s_get_%s_value(%s *caps_data, int *arraySize) { return caps_engine_get_array(caps_data, %s, arraySize); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_value(%s *caps_data, const char **value, int arraySize) { caps_engine_set_array(caps_data, %s, value, arraySize); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_value_borrowed(%s *caps_data, const char * const *value, int arraySize) { caps_engine_set_array_borrowed(caps_data, %s, value, arraySize); }" % (c, a, d, idx))
+    if attr.kind in (ATTR_INTEGER, ATTR_NUMBER) and attr.units:
+        out.append("static inline const char *caps_%s_get_%s_unit(%s *caps_data) { return caps_engine_get_unit(caps_data, %s); }" % (c, a, d, idx))
+        out.append("static inline void caps_%s_set_%s_unit(%s *caps_data, const char *unit) { caps_engine_set_unit(caps_data, %s, unit); }" % (c, a, d, idx))
+    out.append("static inline void caps_%s_attr_%s_send(%s *caps_data) { caps_engine_attr_send(caps_data, %s); }" % (c, a, d, idx))
+    return out
+
+
+def gen_engine_header(cap):
+    c = cap.id
+    out = [license_header]
+    out.append("#ifndef _CAPS_%s_H_" % c.upper())
+    out.append("#define _CAPS_%s_H_" % c.upper())
+    out.append("")
+    out.append('#include "caps/iot_caps_helper_%s.h"' % c)
+    out.append('#include "caps_engine.h"')
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append('extern "C" {')
+    out.append("#endif")
+    out.append("")
+    out.append("enum {")
+    for attr in cap.attrs:
+        out.append("    %s," % engine_attr_index(cap, attr))
+    out.append("    CAPS_%s_ATTR_MAX" % c.upper())
+    out.append("};")
+    out.append("")
+    out.append("enum {")
+    for cmd in cap.cmds:
+        out.append("    %s," % engine_cmd_index(cap, cmd))
+    out.append("    CAPS_%s_CMD_MAX" % c.upper())
+    out.append("};")
+    out.append("")
+    out.append("typedef struct caps_%s_state {" % c)
+    for member in engine_state_members(cap):
+        out.append("    " + member)
+    out.append("} caps_%s_state_t;" % c)
+    out.append("")
+    out.append("typedef caps_engine_data_t caps_%s_data_t;" % c)
+    out.append("")
+    out.append("extern const caps_engine_desc_t caps_%s_desc;" % c)
+    out.append("")
+    out.append("static inline caps_%s_data_t *caps_%s_initialize(IOT_CTX *ctx, const char *component, void *init_usr_cb, void *usr_data)" % (c, c))
+    out.append("{")
+    out.append("    return caps_engine_initialize(ctx, component, &caps_%s_desc, init_usr_cb, usr_data);" % c)
+    out.append("}")
+    out.append("")
+    out.append("static inline void caps_%s_deinitialize(caps_%s_data_t *caps_data)" % (c, c))
+    out.append("{")
+    out.append("    caps_engine_deinitialize(caps_data);")
+    out.append("}")
+    out.append("")
+    for attr in cap.attrs:
+        out += gen_engine_facade(cap, attr)
+        out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append("}")
+    out.append("#endif")
+    out.append("")
+    out.append("#endif /* _CAPS_%s_H_ */" % c.upper())
+    out.append("")
+    return "\n".join(out)
+
+
+def gen_engine_source(cap):
+    c = cap.id
+    out = [license_header]
+    out.append("#include <stddef.h>")
+    out.append("")
+    out.append('#include "st_dev.h"')
+    out.append('#include "caps_util.h"')
+    out.append('#include "caps_%s.h"' % c)
+    out.append("")
+    if cap.attrs:
+        out.append("static const caps_engine_attr_desc_t caps_%s_attrs[] = {" % c)
+        for attr in cap.attrs:
+            a = attr.name
+            flags = []
+            out.append("    [%s] = {" % engine_attr_index(cap, attr))
+            out.append('        .name = "%s",' % a)
+            out.append("        .type = %s," % engine_attr_type[attr.kind])
+            if attr.min is not None:
+                flags.append("CAPS_ENGINE_ATTR_FLAG_MIN")
+            if attr.max is not None:
+                flags.append("CAPS_ENGINE_ATTR_FLAG_MAX")
+            if attr in critical_attrs(cap):
+                flags.append("CAPS_ENGINE_ATTR_FLAG_CRITICAL")
+            if flags:
+                out.append("        .flags = %s," % " | ".join(flags))
+            member = "%s_idx" % a if attr.kind == ATTR_ENUM else "%s_value" % a
+            out.append("        .offset = offsetof(caps_%s_state_t, %s)," % (c, member))
+            if attr.kind == ATTR_ENUM:
+                out.append("        .value_num = %s," % enum_max(cap, attr))
+                out.append("        .values = %s.attr_%s.values," % (helper(cap), a))
+            if attr.kind in (ATTR_INTEGER, ATTR_NUMBER) and attr.units:
+                out.append("        .unit_num = %s," % engine_unit_max(cap, attr))
+                out.append("        .unit_offset = offsetof(caps_%s_state_t, %s_unit)," % (c, a))
+                out.append("        .units = %s.attr_%s.units," % (helper(cap), a))
+            if attr.min is not None:
+                out.append("        .min = CAPS_UTIL_MILLI(%s)," % attr.min)
+            if attr.max is not None:
+                out.append("        .max = CAPS_UTIL_MILLI(%s)," % attr.max)
+            out.append("    },")
+        out.append("};")
+        out.append("")
+    if cap.cmds:
+        out.append("static const caps_engine_cmd_desc_t caps_%s_cmds[] = {" % c)
+        for cmd in cap.cmds:
+            kind, attr, value = command_target(cap, cmd)
+            out.append("    [%s] = {" % engine_cmd_index(cap, cmd))
+            out.append('        .name = "%s",' % cmd)
+            out.append("        .attr = %s," % (engine_attr_index(cap, attr) if attr else "CAPS_ENGINE_NO_ATTR"))
+            out.append("        .value_idx = %s," % (enum_name(cap, attr, value) if kind == "enum" else "CAPS_ENGINE_ARG_VALUE"))
+            out.append("    },")
+        out.append("};")
+        out.append("")
+    out.append("const caps_engine_desc_t caps_%s_desc = {" % c)
+    out.append('    .id = "%s",' % c)
+    if cap.attrs:
+        out.append("    .attrs = caps_%s_attrs," % c)
+    if cap.cmds:
+        out.append("    .cmds = caps_%s_cmds," % c)
+    out.append("    .attr_num = CAPS_%s_ATTR_MAX," % c.upper())
+    out.append("    .cmd_num = CAPS_%s_CMD_MAX," % c.upper())
+    out.append("    .state_size = sizeof(caps_%s_state_t)," % c)
+    out.append("};")
+    out.append("")
+    return "\n".join(out)
+
+
+# Size of members of capability data struct on the 32bit MCUs(ESP8266, RTL8195...)
+type_size = {"pointer": 4, "int": 4, "int64_t": 8, "double": 8}
+
+
+# C++ bindings(--cpp). The schema of a capability becomes constexpr tables and
+# enum classes checked against the helper, and caps::{Capability}<Derived> calls
+# the handlers of Derived directly(CRTP), so there is no function pointer per
+# instance and no virtual call.
+
+def pascal(name):
+    parts = [p for p in re.split(r"[^A-Za-z0-9]+", name) if p]
+    name = "".join(p[0].upper() + p[1:] for p in parts)
+    if not name or name[0].isdigit():
+        name = "V" + name
+    return name
+
+
+def cpp_literal(value):
+    return '"%s"' % value.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def cpp_milli(value):
+    return str(int(round(float(value) * 1000)))
+
+
+def gen_cpp_schema(cap):
+    c = cap.id
+    s = pascal(c) + "Schema"
+    out = []
+    out.append("struct %s {" % s)
+    out.append("    static constexpr const char *id = %s;" % cpp_literal(c))
+    for attr in cap.attrs:
+        out.append("")
+        out.append("    struct Attr%s {" % pascal(attr.name))
+        out.append("        static constexpr const char *name = %s;" % cpp_literal(attr.name))
+        if attr.kind == ATTR_ENUM:
+            out.append("        static constexpr const char *values[] = {%s};" % ", ".join(cpp_literal(v) for v in attr.values))
+            out.append("        enum class Value : int8_t {")
+            for index, value in enumerate(attr.values):
+                out.append("            %s = %d," % (pascal(value), index))
+            out.append("        };")
+        elif attr.kind == ATTR_INTEGER:
+            if attr.min is not None:
+                out.append("        static constexpr int min = %d;" % int(float(attr.min)))
+            if attr.max is not None:
+                out.append("        static constexpr int max = %d;" % int(float(attr.max)))
+        elif attr.kind == ATTR_NUMBER:
+            if attr.min is not None:
+                out.append("        static constexpr int64_t min_milli = %s;" % cpp_milli(attr.min))
+            if attr.max is not None:
+                out.append("        static constexpr int64_t max_milli = %s;" % cpp_milli(attr.max))
+        if attr.units:
+            out.append("        static constexpr const char *units[] = {%s};" % ", ".join(cpp_literal(u) for u in attr.units))
+        out.append("    };")
+    for cmd in cap.cmds:
+        out.append("")
+        out.append("    struct Cmd%s {" % pascal(cmd))
+        out.append("        static constexpr const char *name = %s;" % cpp_literal(cmd))
+        out.append("    };")
+    out.append("};")
+    out.append("")
+
+    # the tables are copies of the helper, make sure they still match it
+    for attr in cap.attrs:
+        a = "%s::Attr%s" % (s, pascal(attr.name))
+        if attr.kind == ATTR_ENUM:
+            out.append("static_assert(table_size(%s::values) == %s," % (a, enum_max(cap, attr)))
+            out.append('        "%s values differ from %s");' % (attr.name, helper(cap)))
+            for value in attr.values:
+                out.append("static_assert(static_cast<int>(%s::Value::%s) == %s," % (a, pascal(value), enum_name(cap, attr, value)))
+                out.append('        "%s of %s differs from %s");' % (value, attr.name, helper(cap)))
+        if attr.units:
+            out.append("static_assert(table_size(%s::units) == CAP_ENUM_%s_%s_UNIT_MAX," % (a, c.upper(), attr.name.upper()))
+            out.append('        "%s units differ from %s");' % (attr.name, helper(cap)))
+    if cap.attrs:
+        out.append("")
+    return out
+
+
+def gen_cpp_accessors(cap, attr):
+    a = attr.name
+    t = "Attr%s" % pascal(a)
+    out = []
+    out.append("    /* %s */" % a)
+    if attr.kind == ATTR_ENUM:
+        out.append("    bool has_%s_value() const { return %s_idx_ >= 0; }" % (a, a))
+        out.append("    %s::Value get_%s_value() const { return static_cast<%s::Value>(%s_idx_); }" % (t, a, t, a))
+        out.append("    void set_%s_value(%s::Value value) { %s_idx_ = static_cast<int8_t>(value); }" % (a, t, a))
+        out.append("    int get_%s_idx() const { return %s_idx_; }" % (a, a))
+    elif attr.kind == ATTR_INTEGER:
+        out.append("    int get_%s_value() const { return %s_value_; }" % (a, a))
+        out.append("    bool set_%s_value(int value)" % a)
+        out.append("    {")
+        checks = []
+        if attr.min is not None:
+            checks.append("value < %s::min" % t)
+        if attr.max is not None:
+            checks.append("value > %s::max" % t)
+        if checks:
+            out.append("        if (%s) {" % " || ".join(checks))
+            out.append('            printf("%%d is out of range for %s\\n", value);' % a)
+            out.append("            return false;")
+            out.append("        }")
+        out.append("        %s_value_ = value;" % a)
+        out.append("        return true;")
+        out.append("    }")
+        out.append("    template <int value>")
+        out.append("    void set_%s_value()" % a)
+        out.append("    {")
+        if attr.min is not None:
+            out.append('        static_assert(value >= %s::min, "%s is below the minimum");' % (t, a))
+        if attr.max is not None:
+            out.append('        static_assert(value <= %s::max, "%s is above the maximum");' % (t, a))
+        out.append("        %s_value_ = value;" % a)
+        out.append("    }")
+    elif attr.kind == ATTR_NUMBER:
+        out.append("    int64_t get_%s_milli() const { return %s_milli_; }" % (a, a))
+        out.append("    double get_%s_value() const { return caps_util_milli_to_double(%s_milli_); }" % (a, a))
+        out.append("    bool set_%s_milli(int64_t milli)" % a)
+        out.append("    {")
+        checks = []
+        if attr.min is not None:
+            checks.append("milli < %s::min_milli" % t)
+        if attr.max is not None:
+            checks.append("milli > %s::max_milli" % t)
+        if checks:
+            out.append("        if (%s) {" % " || ".join(checks))
+            out.append('            printf("%%lld is out of range for %s\\n", (long long)milli);' % a)
+            out.append("            return false;")
+            out.append("        }")
+        out.append("        %s_milli_ = milli;" % a)
+        out.append("        return true;")
+        out.append("    }")
+        out.append("    bool set_%s_value(double value)" % a)
+        out.append("    {")
+        out.append("        int64_t milli;")
+        out.append("")
+        out.append("        if (caps_util_double_to_milli(value, &milli) < 0) {")
+        out.append('            printf("value is out of range for %s\\n");' % a)
+        out.append("            return false;")
+        out.append("        }")
+        out.append("        return set_%s_milli(milli);" % a)
+        out.append("    }")
+        out.append("    template <int64_t milli>")
+        out.append("    void set_%s_milli()" % a)
+        out.append("    {")
+        if attr.min is not None:
+            out.append('        static_assert(milli >= %s::min_milli, "%s is below the minimum");' % (t, a))
+        if attr.max is not None:
+            out.append('        static_assert(milli <= %s::max_milli, "%s is above the maximum");' % (t, a))
+        out.append("        %s_milli_ = milli;" % a)
+        out.append("    }")
+    elif attr.kind == ATTR_ARRAY:
+        out.append("    const char *const *get_%s_value(int *size) const" % a)
+        out.append("    {")
+        out.append("        if (size)")
+        out.append("            *size = %s_size_;" % a)
+        out.append("        return %s_value_;" % a)
+        out.append("    }")
+        out.append("    /* value is borrowed, it has to outlive the object or the next set */")
+        out.append("    void set_%s_value(const char *const *value, int size) { %s_value_ = value; %s_size_ = size; }" % (a, a, a))
+    else:
+        out.append("    const char *get_%s_value() const { return %s_value_; }" % (a, a))
+        out.append("    /* value is borrowed, it has to outlive the object or the next set */")
+        out.append("    void set_%s_value(const char *value) { %s_value_ = value; }" % (a, a))
+    if attr.units:
+        out.append("    const char *get_%s_unit() const { return %s_unit_; }" % (a, a))
+        out.append("    void set_%s_unit(const char *unit) { %s_unit_ = unit; }" % (a, a))
+    out.append("    int attr_%s_send()" % a)
+    out.append("    {")
+    out.append("        caps_attr_t attr;")
+    out.append("")
+    out.append("        if (!fill_%s(attr))" % a)
+    out.append("            return -1;")
+    out.append("        return send(&attr, 1);")
+    out.append("    }")
+    out.append("")
+    return out
+
+
+def gen_cpp_fill(cap, attr):
+    a = attr.name
+    t = "Attr%s" % pascal(a)
+    unit = "%s_unit_" % a if attr.units else "nullptr"
+    out = []
+    out.append("    bool fill_%s(caps_attr_t &attr) const" % a)
+    out.append("    {")
+    if attr.kind == ATTR_ENUM:
+        out.append("        if (!handle_ || %s_idx_ < 0)" % a)
+    elif attr.kind in (ATTR_INTEGER, ATTR_NUMBER):
+        out.append("        if (!handle_)")
+    else:
+        out.append("        if (!handle_ || !%s_value_)" % a)
+    out.append("            return false;")
+    out.append("        set_attr(attr, handle_, %s::name, %s);" % (t, unit))
+    if attr.kind == ATTR_ENUM:
+        out.append("        set_string(attr, %s::values[%s_idx_]);" % (t, a))
+    elif attr.kind == ATTR_INTEGER:
+        out.append("        set_integer(attr, %s_value_);" % a)
+    elif attr.kind == ATTR_NUMBER:
+        out.append("        caps_util_milli_to_val(%s_milli_, &attr.value);" % a)
+    elif attr.kind == ATTR_ARRAY:
+        out.append("        set_strings(attr, %s_value_, %s_size_);" % (a, a))
+    elif attr.kind == ATTR_OBJECT:
+        out.append("        set_json(attr, %s_value_);" % a)
+    else:
+        out.append("        set_string(attr, %s_value_);" % a)
+    out.append("        return true;")
+    out.append("    }")
+    out.append("")
+    return out
+
+
+def gen_cpp_cmd(cap, cmd):
+    c = cap.id
+    k = pascal(c)
+    kind, attr, value = command_target(cap, cmd)
+    out = []
+    out.append("    static void cmd_%s_cb(IOT_CAP_HANDLE *handle, iot_cap_cmd_data_t *cmd_data, void *usr_data)" % cmd)
+    out.append("    {")
+    out.append("        %s *self = static_cast<%s *>(usr_data);" % (k, k))
+    if kind == "arg" and attr.kind == ATTR_ENUM:
+        out.append("        int index = table_index(Attr%s::values, cmd_data->cmd_data[0].string);" % pascal(attr.name))
+    elif kind == "arg" and attr.kind == ATTR_NUMBER:
+        out.append("        int64_t milli;")
+    out.append("")
+    if kind == "enum":
+        out.append("        self->%s_idx_ = static_cast<int8_t>(Attr%s::Value::%s);" % (attr.name, pascal(attr.name), pascal(value)))
+    elif kind == "arg" and attr.kind == ATTR_ENUM:
+        out.append("        if (index < 0) {")
+        out.append('            printf("%%s is not supported value for %s\\n", cmd_data->cmd_data[0].string);' % cmd)
+        out.append("            return;")
+        out.append("        }")
+        out.append("        self->%s_idx_ = static_cast<int8_t>(index);" % attr.name)
+    elif kind == "arg" and attr.kind == ATTR_INTEGER:
+        out.append("        if (!self->set_%s_value(cmd_data->cmd_data[0].integer))" % attr.name)
+        out.append("            return;")
+    elif kind == "arg" and attr.kind == ATTR_NUMBER:
+        out.append("        if (caps_util_double_to_milli(cmd_data->cmd_data[0].number, &milli) < 0 ||")
+        out.append("                !self->set_%s_milli(milli))" % attr.name)
+        out.append("            return;")
+    elif kind == "arg":
+        out.append("        /* cmd_data goes away after the callback */")
+        out.append("        copy_string(self->%s_buf_, cmd_data->cmd_data[0].string);" % attr.name)
+        out.append("        self->%s_value_ = self->%s_buf_;" % (attr.name, attr.name))
+    if attr:
+        out.append("        static_cast<Derived *>(self)->on_cmd_%s();" % cmd)
+        out.append("        self->attr_%s_send();" % attr.name)
+    else:
+        out.append("        static_cast<Derived *>(self)->on_cmd_%s(*cmd_data);" % cmd)
+    out.append("    }")
+    out.append("")
+    return out
+
+
+def gen_cpp_header(cap):
+    c = cap.id
+    k = pascal(c)
+    out = [license_header]
+    out.append("#ifndef _CAPS_%s_HPP_" % c.upper())
+    out.append("#define _CAPS_%s_HPP_" % c.upper())
+    out.append("")
+    out.append('#include "caps/iot_caps_helper_%s.h"' % c)
+    out.append('#include "caps_binding.hpp"')
+    out.append("")
+    out.append("namespace caps {")
+    out.append("")
+    out += gen_cpp_schema(cap)
+
+    out.append("template <typename Derived>")
+    out.append("class %s : public %sSchema {" % (k, k))
+    out.append("public:")
+    out.append("    %s() = default;" % k)
+    out.append("    /* registered to iot-core by address */")
+    out.append("    %s(const %s &) = delete;" % (k, k))
+    out.append("    %s &operator=(const %s &) = delete;" % (k, k))
+    out.append("")
+    out.append("    bool init(IOT_CTX *ctx, const char *component)")
+    out.append("    {")
+    out.append("        handle_ = caps_sender_handle_init(ctx, component, id, init_cb, this);")
+    out.append("        if (!handle_) {")
+    out.append('            printf("fail to init %s handle\\n");' % c)
+    out.append("            return false;")
+    out.append("        }")
+    for attr in critical_attrs(cap):
+        out.append("        caps_sender_set_priority(handle_, Attr%s::name, CAPS_SEND_PRIORITY_CRITICAL);" % pascal(attr.name))
+    for cmd in cap.cmds:
+        out.append("        if (caps_cmd_set_cb(handle_, Cmd%s::name, cmd_%s_cb, this))" % (pascal(cmd), cmd))
+        out.append('            printf("fail to set cmd_cb for %s of %s\\n");' % (cmd, c))
+    out.append("        return true;")
+    out.append("    }")
+    out.append("")
+    out.append("    void deinit()")
+    out.append("    {")
+    out.append("        if (!handle_)")
+    out.append("            return;")
+    if cap.cmds:
+        out.append("        caps_cmd_unset_cb(handle_);")
+    out.append("        caps_sender_handle_detach(handle_);")
+    out.append("        handle_ = nullptr;")
+    out.append("    }")
+    out.append("")
+    out.append("    IOT_CAP_HANDLE *handle() const { return handle_; }")
+    out.append("")
+    for attr in cap.attrs:
+        out += gen_cpp_accessors(cap, attr)
+    out.append("    /* every attribute in one message */")
+    out.append("    int attr_send_all()")
+    out.append("    {")
+    if cap.attrs:
+        out.append("        caps_attr_t attrs[%d];" % len(cap.attrs))
+        out.append("        int attr_num = 0;")
+        out.append("")
+        for attr in cap.attrs:
+            out.append("        if (fill_%s(attrs[attr_num]))" % attr.name)
+            out.append("            attr_num++;")
+        out.append("        return send(attrs, attr_num);")
+    else:
+        out.append("        return CAPS_SEND_SUPPRESSED;")
+    out.append("    }")
+    out.append("")
+    out.append("    /* Default handlers, Derived hides the ones it needs. They run after the")
+    out.append("     * attribute is updated and before it is sent. */")
+    out.append("    void on_init() {}")
+    for cmd in cap.cmds:
+        kind, attr, value = command_target(cap, cmd)
+        if attr:
+            out.append("    void on_cmd_%s() {}" % cmd)
+        else:
+            out.append("    void on_cmd_%s(const iot_cap_cmd_data_t &) {}" % cmd)
+    out.append("")
+    out.append("private:")
+    for attr in cap.attrs:
+        out += gen_cpp_fill(cap, attr)
+    out.append("    static void init_cb(IOT_CAP_HANDLE *handle, void *usr_data)")
+    out.append("    {")
+    out.append("        %s *self = static_cast<%s *>(usr_data);" % (k, k))
+    out.append("")
+    out.append("        caps_sender_init_cb_begin(handle);")
+    out.append("        static_cast<Derived *>(self)->on_init();")
+    out.append("        self->attr_send_all();")
+    out.append("        caps_sender_init_cb_end(handle);")
+    out.append("    }")
+    out.append("")
+    for cmd in cap.cmds:
+        out += gen_cpp_cmd(cap, cmd)
+    out.append("    IOT_CAP_HANDLE *handle_ = nullptr;")
+    for attr in cap.attrs:
+        a = attr.name
+        if attr.kind == ATTR_ENUM:
+            out.append("    int8_t %s_idx_ = -1;" % a)
+        elif attr.kind == ATTR_INTEGER:
+            out.append("    int %s_value_ = 0;" % a)
+        elif attr.kind == ATTR_NUMBER:
+            out.append("    int64_t %s_milli_ = 0;" % a)
+        elif attr.kind == ATTR_ARRAY:
+            out.append("    const char *const *%s_value_ = nullptr;" % a)
+            out.append("    int %s_size_ = 0;" % a)
+        else:
+            out.append("    const char *%s_value_ = nullptr;" % a)
+        if attr.units:
+            out.append("    const char *%s_unit_ = nullptr;" % a)
+    for cmd in cap.cmds:
+        kind, attr, value = command_target(cap, cmd)
+        if kind == "arg" and attr.kind == ATTR_STRING:
+            out.append("    char %s_buf_[CAPS_BINDING_STRING_SIZE] = {};" % attr.name)
+    out.append("};")
+    out.append("")
+    out.append("} // namespace caps")
+    out.append("")
+    out.append("#endif /* _CAPS_%s_HPP_ */" % c.upper())
+    out.append("")
+    return "\n".join(out)
+
+
+def member_size(decl):
+    decl = decl.strip()
+    if "(*" in decl or "*" in decl:
+        return type_size["pointer"]
+    if decl.startswith("double"):
+        return type_size["double"]
+    if decl.startswith("int64_t"):
+        return type_size["int64_t"]
+    return type_size["int"]
+
+
+def struct_size(members):
+    size = 0
+    align = 1
+    for member in members:
+        msize = member_size(member)
+        size = (size + msize - 1) // msize * msize + msize
+        align = max(align, msize)
+    return (size + align - 1) // align * align
+
+
+def parse_struct(path, struct_name):
+    if not os.path.exists(path):
+        return None
+    text = open(path).read()
+    match = re.search(r"typedef struct %s \{(.*?)\n\}" % struct_name, text, re.S)
+    if not match:
+        return None
+    members = []
+    for line in match.group(1).split(";"):
+        line = " ".join(line.split())
+        if line:
+            members.append(line)
+    return members
+
+
+def ram_report(sample_path, output_path):
+    rows = []
+    for path in sorted(glob.glob(os.path.join(output_path, "caps_*.h"))):
+        cap_id = os.path.basename(path)[len("caps_"):-len(".h")]
+        generated = parse_struct(path, "caps_%s_data" % cap_id)
+        current = parse_struct(os.path.join(sample_path, "caps_%s.h" % cap_id), "caps_%s_data" % cap_id)
+        if generated is None or current is None:
+            continue
+        fp_current = len([m for m in current if "(*" in m])
+        rows.append((cap_id, fp_current, struct_size(current), struct_size(generated)))
+
+    print("| capability | function pointers | current (bytes) | generated (bytes) | saved (bytes) |")
+    print("|---|---:|---:|---:|---:|")
+    total_current = 0
+    total_generated = 0
+    for cap_id, fp_current, current, generated in rows:
+        total_current += current
+        total_generated += generated
+        print("| %s | %d | %d | %d | %d |" % (cap_id, fp_current, current, generated, current - generated))
+    print("| total | | %d | %d | %d |" % (total_current, total_generated, total_current - total_generated))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="capability wrapper generator")
+    parser.add_argument("-i", "--input", default=default_helper_path, help="path of iot_caps_helper_*.h")
+    parser.add_argument("-o", "--output", default=default_output_path, help="path for generated caps_*.h/.c")
+    parser.add_argument("-s", "--sample", default=default_sample_path, help="path of current capability samples")
+    parser.add_argument("-c", "--capabilities", default="", help="comma separated capability list (default: all)")
+    parser.add_argument("--engine", action="store_true", help="generate descriptor tables and typed facades for caps_engine")
+    parser.add_argument("--cpp", action="store_true", help="generate header-only C++17 bindings")
+    parser.add_argument("--report", action="store_true", help="print RAM comparison against current capability samples")
+    args = parser.parse_args()
+
+    if args.report:
+        ram_report(os.path.abspath(args.sample), os.path.abspath(args.output))
+        return
+
+    wanted = [c for c in args.capabilities.split(",") if c]
+    helpers = sorted(glob.glob(os.path.join(args.input, "iot_caps_helper_*.h")))
+    if not helpers:
+        print("Cannot find capability helper files in " + args.input)
+        sys.exit(1)
+
+    if not os.path.exists(args.output):
+        os.makedirs(args.output)
+
+    count = 0
+    for path in helpers:
+        cap = parse_helper(path)
+        if not cap or (wanted and cap.id not in wanted):
+            continue
+        if args.cpp:
+            open(os.path.join(args.output, "caps_%s.hpp" % cap.id), "w").write(gen_cpp_header(cap))
+            count += 1
+            continue
+        if args.engine:
+            header, source = gen_engine_header(cap), gen_engine_source(cap)
+        else:
+            header, source = gen_header(cap), gen_source(cap)
+        open(os.path.join(args.output, "caps_%s.h" % cap.id), "w").write(header)
+        open(os.path.join(args.output, "caps_%s.c" % cap.id), "w").write(source)
+        count += 1
+    print("Generated %d capability %s in %s" % (count, "bindings" if args.cpp else "wrappers", os.path.abspath(args.output)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+#-*- coding: utf-8 -*-
+
+# Compile a device profile into the capability code of an app.
+#
+# The profile lists the components and capabilities of the device with their initial
+# values, units, send cache registrations and report policies. From it this tool
+# generates, into one output directory,
+#   - caps_{CAPABILITY}.h/.c      static wrappers (caps_generator.py) of the used capabilities only
+#   - caps_*.h/.c                 the shared modules they need, copied from apps/capability_sample
+#   - caps_profile.h/.c           a single state block holding every capability instance and
+#                                 caps_profile_init() replacing the hand written capability_init()
+#   - caps_profile.cmake/.mk      the source list and the CAPS_SENDER_USE_* flags for
+#                                 CMakeLists.txt and component.mk
+#
+# profile)
+#   {
+#     "components": [
+#       {
+#         "id": "main",
+#         "capabilities": [
+#           { "id": "switch", "initial": { "switch": "on" } },
+#           { "id": "switchLevel", "initial": { "level": 50 }, "units": { "level": "%" } }
+#         ]
+#       },
+#       {
+#         "id": "monitor",
+#         "capabilities": [
+#           {
+#             "id": "dustSensor",
+#             "initial": { "dustLevel": 0 },
+#             "sendCache": [ "dustLevel" ],
+#             "reportPolicy": { "dustLevel": { "minInterval": 10, "maxInterval": 600, "change": "10%" } }
+#           }
+#         ]
+#       }
+#     ]
+#   }
+#
+# usage)
+#   python3 device_profile_compiler.py PROFILE [-i HELPER_PATH] [-o OUTPUT_PATH] [-p SOURCE_PREFIX]
+
+import os
+import re
+import sys
+import json
+import shutil
+import argparse
+
+import caps_generator
+from caps_generator import ATTR_ENUM, ATTR_STRING, ATTR_INTEGER, ATTR_NUMBER, ATTR_ARRAY, ATTR_OBJECT
+
+tool_path = os.path.dirname(os.path.abspath(__file__))
+default_output_path = os.path.join(tool_path, "../../output/capability_profile")
+
+
+class Instance:
+    def __init__(self, component, cap, spec):
+        self.component = component
+        self.cap = cap
+        self.name = re.sub(r"[^A-Za-z0-9_]", "_", "%s_%s" % (component, cap.id))
+        self.initial = spec.get("initial", {})
+        self.units = spec.get("units", {})
+        self.send_cache = spec.get("sendCache", [])
+        self.report_policy = spec.get("reportPolicy", {})
+
+
+def fail(msg):
+    print("profile error: " + msg)
+    sys.exit(1)
+
+
+def c_string(value):
+    return json.dumps(value, ensure_ascii=False)
+
+
+def check_attr(inst, name, what):
+    attr = inst.cap.find_attr(name)
+    if not attr:
+        fail("%s of %s/%s has unknown attribute '%s'" % (what, inst.component, inst.cap.id, name))
+    return attr
+
+
+def check_range(inst, attr, value):
+    if attr.min is not None and value < float(attr.min):
+        fail("initial %s of %s/%s is below %s" % (attr.name, inst.component, inst.cap.id, attr.min))
+    if attr.max is not None and value > float(attr.max):
+        fail("initial %s of %s/%s is above %s" % (attr.name, inst.component, inst.cap.id, attr.max))
+
+
+def gen_initial(inst, attr, value, out, arrays):
+    data = "&caps_profile_state.%s" % inst.name
+    ops = "caps_profile_state.%s.ops" % inst.name
+    a = attr.name
+
+    if attr.kind == ATTR_ENUM:
+        if value not in attr.values:
+            fail("initial %s of %s/%s must be one of %s" % (a, inst.component, inst.cap.id, attr.values))
+        out.append("    %s->set_%s_idx(%s, %s);" % (ops, a, data, caps_generator.enum_name(inst.cap, attr, value)))
+    elif attr.kind == ATTR_INTEGER:
+        if not isinstance(value, int):
+            fail("initial %s of %s/%s must be an integer" % (a, inst.component, inst.cap.id))
+        check_range(inst, attr, value)
+        out.append("    %s->set_%s_value(%s, %d);" % (ops, a, data, value))
+    elif attr.kind == ATTR_NUMBER:
+        if not isinstance(value, (int, float)):
+            fail("initial %s of %s/%s must be a number" % (a, inst.component, inst.cap.id))
+        check_range(inst, attr, value)
+        out.append("    %s->set_%s_milli(%s, %d);" % (ops, a, data, int(round(value * 1000))))
+    elif attr.kind == ATTR_ARRAY:
+        if not isinstance(value, list):
+            fail("initial %s of %s/%s must be an array of strings" % (a, inst.component, inst.cap.id))
+        table = "%s_%s_initial" % (inst.name, a)
+        arrays.append("static const char * const %s[] = { %s };" % (table, ", ".join([c_string(v) for v in value]) or "NULL"))
+        out.append("    %s->set_%s_value_borrowed(%s, %s, %d);" % (ops, a, data, table, len(value)))
+    else:
+        if attr.kind == ATTR_OBJECT and not isinstance(value, str):
+            value = json.dumps(value, separators=(",", ":"), ensure_ascii=False)
+        out.append("    %s->set_%s_value(%s, %s);" % (ops, a, data, c_string(value)))
+        return 1
+    return 0
+
+
+def gen_unit(inst, attr, out):
+    unit = inst.units.get(attr.name, attr.units[0])
+    if unit not in attr.units:
+        fail("unit of %s of %s/%s must be one of %s" % (attr.name, inst.component, inst.cap.id, attr.units))
+    out.append("    caps_profile_state.%s.ops->set_%s_unit(&caps_profile_state.%s, %s.attr_%s.units[%d]);" % (
+            inst.name, attr.name, inst.name, caps_generator.helper(inst.cap), attr.name, attr.units.index(unit)))
+
+
+def gen_policy(inst, name, policy):
+    change = policy.get("change", 0)
+    percent = 0
+    if isinstance(change, str):
+        percent = 1 if change.strip().endswith("%") else 0
+        change = float(change.strip().rstrip("%"))
+    return "    { &caps_profile_state.%s.handle, %s, { %d, %d, %g, %d } }," % (
+            inst.name, c_string(name),
+            int(policy.get("minInterval", 0) * 1000), int(policy.get("maxInterval", 0) * 1000), change, percent)
+
+
+def gen_profile_header(instances, counts):
+    out = [caps_generator.license_header]
+    out.append("#ifndef _CAPS_PROFILE_H_")
+    out.append("#define _CAPS_PROFILE_H_")
+    out.append("")
+    out.append('#include "st_dev.h"')
+    for cap_id in sorted(set([inst.cap.id for inst in instances])):
+        out.append('#include "caps_%s.h"' % cap_id)
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append('extern "C" {')
+    out.append("#endif")
+    out.append("")
+    out.append("#define CAPS_PROFILE_HANDLE_NUM %d" % len(instances))
+    out.append("#define CAPS_PROFILE_CMD_NUM %d" % counts["cmd"])
+    out.append("#define CAPS_PROFILE_SEND_CACHE_NUM %d" % counts["send_cache"])
+    out.append("#define CAPS_PROFILE_REPORT_POLICY_NUM %d" % counts["policy"])
+    out.append("#define CAPS_PROFILE_STRING_NUM %d" % counts["string"])
+    out.append("")
+    out.append("/* every capability instance of the device, named {component}_{capability} */")
+    out.append("typedef struct caps_profile_state {")
+    for inst in instances:
+        out.append("    caps_%s_data_t %s;" % (inst.cap.id, inst.name))
+    out.append("} caps_profile_state_t;")
+    out.append("")
+    out.append("extern caps_profile_state_t caps_profile_state;")
+    out.append("")
+    out.append("/* Initialize every capability with its initial value, send cache and report policy.")
+    out.append(" * Command callbacks are left to the app. Returns 0 or -1 when a handle failed. */")
+    out.append("int caps_profile_init(IOT_CTX *ctx);")
+    out.append("void caps_profile_deinit(void);")
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append("}")
+    out.append("#endif")
+    out.append("")
+    out.append("#endif /* _CAPS_PROFILE_H_ */")
+    out.append("")
+    return "\n".join(out)
+
+
+def gen_profile_source(instances, counts):
+    arrays = []
+    body = []
+    policies = []
+    caches = []
+
+    for inst in instances:
+        body.append("")
+        body.append('    if (!caps_%s_initialize_static(ctx, "%s", &caps_profile_state.%s, NULL, NULL)' % (
+                inst.cap.id, inst.component, inst.name))
+        body.append("            || !caps_profile_state.%s.handle) {" % inst.name)
+        body.append('        printf("fail to init %s of %s\\n");' % (inst.cap.id, inst.component))
+        body.append("        err = -1;")
+        body.append("    }")
+        for name in inst.initial:
+            attr = check_attr(inst, name, "initial")
+            counts["string"] += gen_initial(inst, attr, inst.initial[name], body, arrays)
+        for name in inst.units:
+            attr = check_attr(inst, name, "units")
+            if attr.kind not in (ATTR_INTEGER, ATTR_NUMBER) or not attr.units:
+                fail("%s of %s/%s has no unit" % (name, inst.component, inst.cap.id))
+        for attr in inst.cap.attrs:
+            if attr.kind in (ATTR_INTEGER, ATTR_NUMBER) and attr.units:
+                gen_unit(inst, attr, body)
+        for name in inst.send_cache:
+            check_attr(inst, name, "sendCache")
+            caches.append("    { &caps_profile_state.%s.handle, %s }," % (inst.name, c_string(name)))
+        for name in inst.report_policy:
+            check_attr(inst, name, "reportPolicy")
+            policies.append(gen_policy(inst, name, inst.report_policy[name]))
+
+    counts["send_cache"] = len(caches)
+    counts["policy"] = len(policies)
+
+    out = [caps_generator.license_header]
+    out.append("#include <stdio.h>")
+    out.append("")
+    out.append('#include "st_dev.h"')
+    out.append('#include "caps_profile.h"')
+    out.append('#include "caps_sender.h"')
+    out.append('#include "caps_send_cache.h"')
+    if policies:
+        out.append('#include "caps_report_policy.h"')
+    out.append("")
+    out.append("#if CAPS_PROFILE_SEND_CACHE_NUM > CAPS_SEND_CACHE_SIZE")
+    out.append("#error CAPS_SEND_CACHE_SIZE is smaller than the send cache entries of the profile")
+    out.append("#endif")
+    if policies:
+        out.append("#if CAPS_PROFILE_REPORT_POLICY_NUM > CAPS_REPORT_POLICY_SIZE")
+        out.append("#error CAPS_REPORT_POLICY_SIZE is smaller than the report policies of the profile")
+        out.append("#endif")
+    out.append("")
+    out.append("caps_profile_state_t caps_profile_state;")
+    out.append("")
+    if arrays:
+        out.extend(arrays)
+        out.append("")
+    if caches:
+        out.append("static const struct {")
+        out.append("    IOT_CAP_HANDLE **handle;")
+        out.append("    const char *attribute;")
+        out.append("} caps_profile_send_cache[] = {")
+        out.extend(caches)
+        out.append("};")
+        out.append("")
+    if policies:
+        out.append("static const struct {")
+        out.append("    IOT_CAP_HANDLE **handle;")
+        out.append("    const char *attribute;")
+        out.append("    caps_report_policy_t policy;")
+        out.append("} caps_profile_report_policy[] = {")
+        out.extend(policies)
+        out.append("};")
+        out.append("")
+    out.append("int caps_profile_init(IOT_CTX *ctx)")
+    out.append("{")
+    out.append("    int err = 0;")
+    if caches or policies:
+        out.append("    unsigned int i;")
+    out.extend(body)
+    if caches:
+        out.append("")
+        out.append("    for (i = 0; i < sizeof(caps_profile_send_cache) / sizeof(caps_profile_send_cache[0]); i++) {")
+        out.append("        if (*caps_profile_send_cache[i].handle)")
+        out.append("            caps_send_cache_register(*caps_profile_send_cache[i].handle, caps_profile_send_cache[i].attribute);")
+        out.append("    }")
+    if policies:
+        out.append("")
+        out.append("    for (i = 0; i < sizeof(caps_profile_report_policy) / sizeof(caps_profile_report_policy[0]); i++) {")
+        out.append("        if (*caps_profile_report_policy[i].handle)")
+        out.append("            caps_report_policy_set(*caps_profile_report_policy[i].handle, caps_profile_report_policy[i].attribute,")
+        out.append("                    &caps_profile_report_policy[i].policy);")
+        out.append("    }")
+    out.append("")
+    out.append("    return err;")
+    out.append("}")
+    out.append("")
+    out.append("void caps_profile_deinit(void)")
+    out.append("{")
+    for inst in instances:
+        out.append("    caps_%s_deinitialize(&caps_profile_state.%s);" % (inst.cap.id, inst.name))
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+
+def shared_modules(output_path, sample_path, generated):
+    modules = []
+    pending = sorted(generated)
+    while pending:
+        path = os.path.join(output_path, pending.pop(0))
+        # the optional stages of caps_sender come in through the profile, not through caps_sender
+        text = re.sub(r'#ifdef CAPS_SENDER_USE_\w+\n.*?#endif', '', open(path).read(), flags=re.S)
+        for name in re.findall(r'#include "(caps_\w+)\.h"', text):
+            if name in modules or name + ".h" in generated:
+                continue
+            if not os.path.exists(os.path.join(sample_path, name + ".h")):
+                continue
+            modules.append(name)
+            for ext in (".h", ".c"):
+                src = os.path.join(sample_path, name + ext)
+                if os.path.exists(src):
+                    shutil.copy(src, output_path)
+                    pending.append(name + ext)
+    return modules
+
+
+# optional caps_sender stages, enabled when their module is copied
+sender_flags = {
+    "caps_report_policy": "CAPS_SENDER_USE_REPORT_POLICY",
+    "caps_payload_cache": "CAPS_SENDER_USE_PAYLOAD_CACHE",
+    "caps_state_journal": "CAPS_SENDER_USE_STATE_JOURNAL",
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="device profile compiler")
+    parser.add_argument("profile", help="device profile json")
+    parser.add_argument("-i", "--input", default=caps_generator.default_helper_path, help="path of iot_caps_helper_*.h")
+    parser.add_argument("-o", "--output", default=default_output_path, help="path for generated files")
+    parser.add_argument("-s", "--sample", default=caps_generator.default_sample_path, help="path of shared caps modules")
+    parser.add_argument("-p", "--prefix", default="", help="directory of the generated files in the source list")
+    args = parser.parse_args()
+
+    profile = json.load(open(args.profile))
+    caps = {}
+    instances = []
+    for component in profile.get("components", []):
+        for spec in component.get("capabilities", []):
+            cap_id = spec["id"]
+            if cap_id not in caps:
+                path = os.path.join(args.input, "iot_caps_helper_%s.h" % cap_id)
+                if not os.path.exists(path):
+                    fail("cannot find %s" % path)
+                caps[cap_id] = caps_generator.parse_helper(path)
+            instances.append(Instance(component["id"], caps[cap_id], spec))
+    if not instances:
+        fail("no capability in " + args.profile)
+    names = [inst.name for inst in instances]
+    for name in names:
+        if names.count(name) > 1:
+            fail("%s is used twice" % name)
+
+    if not os.path.exists(args.output):
+        os.makedirs(args.output)
+
+    generated = []
+    for cap_id in sorted(caps):
+        cap = caps[cap_id]
+        open(os.path.join(args.output, "caps_%s.h" % cap_id), "w").write(caps_generator.gen_header(cap))
+        open(os.path.join(args.output, "caps_%s.c" % cap_id), "w").write(caps_generator.gen_source(cap))
+        generated += ["caps_%s.h" % cap_id, "caps_%s.c" % cap_id]
+
+    counts = {"cmd": sum([len(inst.cap.cmds) for inst in instances]), "string": 0}
+    source = gen_profile_source(instances, counts)
+    open(os.path.join(args.output, "caps_profile.c"), "w").write(source)
+    open(os.path.join(args.output, "caps_profile.h"), "w").write(gen_profile_header(instances, counts))
+    generated += ["caps_profile.h", "caps_profile.c"]
+
+    modules = shared_modules(args.output, args.sample, generated)
+    sources = ["caps_profile.c"] + ["caps_%s.c" % cap_id for cap_id in sorted(caps)]
+    sources += sorted([m + ".c" for m in modules if os.path.exists(os.path.join(args.output, m + ".c"))])
+    sources = [os.path.join(args.prefix, s) for s in sources]
+
+    flags = sorted([sender_flags[m] for m in modules if m in sender_flags])
+    # the static handles of caps_sender fit the profile, more would come from the heap
+    flags.append("CAPS_SENDER_MAX_HANDLES=%d" % len(instances))
+
+    open(os.path.join(args.output, "caps_profile.cmake"), "w").write(
+            "# Auto-generated file\nset(CAPS_PROFILE_SRCS\n%s\n)\nset(CAPS_PROFILE_DEFINITIONS %s)\n" % (
+            "\n".join(['    "%s"' % s for s in sources]), " ".join(flags)))
+    open(os.path.join(args.output, "caps_profile.mk"), "w").write(
+            "# Auto-generated file\nCAPS_PROFILE_OBJS := %s\nCAPS_PROFILE_CFLAGS := %s\n" % (
+            " ".join([os.path.splitext(s)[0] + ".o" for s in sources]), " ".join(["-D" + f for f in flags])))
+
+    state = sum([caps_generator.struct_size(caps_generator.parse_struct(
+            os.path.join(args.output, "caps_%s.h" % inst.cap.id), "caps_%s_data" % inst.cap.id)) for inst in instances])
+    print("Compiled %d capabilities of %d components into %s" % (len(instances),
+            len(profile.get("components", [])), os.path.abspath(args.output)))
+    print("  state block : %d bytes (32-bit)" % state)
+    print("  handles : %d, commands : %d, send cache : %d, report policies : %d, string copies : %d" % (
+            len(instances), counts["cmd"], counts["send_cache"], counts["policy"], counts["string"]))
+    print("  sources : %d files" % len(sources))
+
+
+if __name__ == "__main__":
+    main()